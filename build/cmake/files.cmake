@@ -44,6 +44,7 @@ set(BASE_UNIX_AND_DARWIN_NOTWXMAC_HDR
 
 set(BASE_UNIX_SRC
     ${BASE_UNIX_AND_DARWIN_NOTWXMAC_SRC}
+    src/unix/asyncfile_uring.cpp
     src/unix/fswatcher_inotify.cpp
     src/unix/secretstore.cpp
     src/unix/stdpaths.cpp
@@ -409,6 +410,7 @@ set(BASE_CMN_SRC
     src/common/arcfind.cpp
     src/common/archive.cpp
     src/common/arrstr.cpp
+    src/common/asyncfile.cpp
     src/common/base64.cpp
     src/common/clntdata.cpp
     src/common/cmdline.cpp
@@ -422,6 +424,7 @@ set(BASE_CMN_SRC
     src/common/dynload.cpp
     src/common/encconv.cpp
     src/common/evtloopcmn.cpp
+    src/common/evtloopstats.cpp
     src/common/extended.c
     src/common/ffile.cpp
     src/common/file.cpp
@@ -437,6 +440,7 @@ set(BASE_CMN_SRC
     src/common/fs_filter.cpp
     src/common/hash.cpp
     src/common/hashmap.cpp
+    src/common/idlesched.cpp
     src/common/init.cpp
     src/common/intl.cpp
     src/common/ipcbase.cpp
@@ -444,6 +448,7 @@ set(BASE_CMN_SRC
     src/common/list.cpp
     src/common/log.cpp
     src/common/longlong.cpp
+    src/common/lz4stream.cpp
     src/common/mimecmn.cpp
     src/common/module.cpp
     src/common/mstream.cpp
@@ -483,6 +488,7 @@ set(BASE_CMN_SRC
     src/common/xti.cpp
     src/common/xtistrm.cpp
     src/common/zipstrm.cpp
+    src/common/zstdstream.cpp
     src/common/zstream.cpp
     src/common/fswatchercmn.cpp
     src/generic/fswatcherg.cpp
@@ -507,6 +513,7 @@ set(BASE_CMN_HDR
     wx/archive.h
     wx/arrimpl.cpp
     wx/arrstr.h
+    wx/asyncfile.h
     wx/atomic.h
     wx/base64.h
     wx/beforestd.h
@@ -541,6 +548,7 @@ set(BASE_CMN_HDR
     wx/eventfilter.h
     wx/evtloop.h
     wx/evtloopsrc.h
+    wx/evtloopstats.h
     wx/except.h
     wx/features.h
     wx/flags.h
@@ -560,6 +568,7 @@ set(BASE_CMN_HDR
     wx/hashmap.h
     wx/hashset.h
     wx/iconloc.h
+    wx/idlesched.h
     wx/init.h
     wx/intl.h
     wx/iosfwrap.h
@@ -573,6 +582,7 @@ set(BASE_CMN_HDR
     wx/listimpl.cpp
     wx/log.h
     wx/longlong.h
+    wx/lz4stream.h
     wx/math.h
     wx/memconf.h
     wx/memory.h
@@ -613,6 +623,7 @@ set(BASE_CMN_HDR
     wx/strvararg.h
     wx/sysopt.h
     wx/tarstrm.h
+    wx/task.h
     wx/textbuf.h
     wx/textfile.h
     wx/thread.h
@@ -652,6 +663,7 @@ set(BASE_CMN_HDR
     wx/xtiprop.h
     wx/xtitypes.h
     wx/zipstrm.h
+    wx/zstdstream.h
     wx/zstream.h
     wx/meta/convertible.h
     wx/meta/if.h
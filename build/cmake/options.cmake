@@ -134,6 +134,10 @@ wx_add_thirdparty_library(wxUSE_LIBWEBP WebP "use libwebp (WebP file format)")
 wx_add_thirdparty_library(wxUSE_NANOSVG NanoSVG "use NanoSVG for rasterizing SVG" DEFAULT builtin)
 wx_option(wxUSE_LIBLZMA "use LZMA compression" OFF)
 set(wxTHIRD_PARTY_LIBRARIES ${wxTHIRD_PARTY_LIBRARIES} wxUSE_LIBLZMA "use liblzma for LZMA compression")
+wx_option(wxUSE_LIBZSTD "use Zstandard compression" OFF)
+set(wxTHIRD_PARTY_LIBRARIES ${wxTHIRD_PARTY_LIBRARIES} wxUSE_LIBZSTD "use libzstd for Zstandard compression")
+wx_option(wxUSE_LIBLZ4 "use LZ4 compression" OFF)
+set(wxTHIRD_PARTY_LIBRARIES ${wxTHIRD_PARTY_LIBRARIES} wxUSE_LIBLZ4 "use liblz4 for LZ4 compression")
 
 wx_option(wxUSE_OPENGL "use OpenGL (or Mesa)")
 
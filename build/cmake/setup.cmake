@@ -586,6 +586,16 @@ if(wxUSE_FSWATCHER)
     endif()
 endif()
 
+if(UNIX AND NOT APPLE AND wxUSE_THREADS)
+    wx_check_cxx_source_compiles(
+        "io_uring_params p;
+        unsigned op = IORING_OP_READ | IORING_FEAT_RW_CUR_POS;
+        return syscall(__NR_io_uring_setup, op, &p);"
+        wxHAS_IO_URING
+        linux/io_uring.h sys/syscall.h unistd.h
+        )
+endif()
+
 if(wxUSE_XLOCALE)
     check_include_file(xlocale.h HAVE_XLOCALE_H)
     set(CMAKE_EXTRA_INCLUDE_FILES locale.h)
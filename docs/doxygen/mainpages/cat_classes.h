@@ -710,6 +710,10 @@ Related overview: @ref overview_stream
 @li wxStringOutputStream: String output stream class
 @li wxLZMAInputStream: LZMA decompression stream class
 @li wxLZMAOutputStream: LZMA compression stream class
+@li wxLZ4InputStream: LZ4 decompression stream class
+@li wxLZ4OutputStream: LZ4 compression stream class
+@li wxZstdInputStream: Zstandard decompression stream class
+@li wxZstdOutputStream: Zstandard compression stream class
 @li wxZlibInputStream: Zlib and gzip (compression) input stream class
 @li wxZlibOutputStream: Zlib and gzip (compression) output stream class
 @li wxZipInputStream: Input stream for reading from ZIP archives
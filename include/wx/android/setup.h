@@ -531,6 +531,29 @@
 // Recommended setting: 1 if you need LZMA compression.
 #define wxUSE_LIBLZMA       0
 
+// Set to 1 if libzstd is available to enable wxZstd{Input,Output}Stream
+// classes.
+//
+// Notice that if you enable this build option when not using configure or
+// CMake, you need to ensure that libzstd headers and libraries are available
+// and can be found by the compiler and linker, as explained for
+// wxUSE_LIBLZMA above.
+//
+// Default is 0 under MSW, auto-detected by configure.
+//
+// Recommended setting: 1 if you need fast compression.
+#define wxUSE_LIBZSTD       0
+
+// Set to 1 if liblz4 is available to enable wxLZ4{Input,Output}Stream
+// classes.
+//
+// The same remarks as for wxUSE_LIBZSTD above apply to this option too.
+//
+// Default is 0 under MSW, auto-detected by configure.
+//
+// Recommended setting: 1 if you need very fast compression.
+#define wxUSE_LIBLZ4        0
+
 // If enabled, the code written by Apple will be used to write, in a portable
 // way, float on the disk. See extended.c for the license which is different
 // from wxWidgets one.
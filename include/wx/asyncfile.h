@@ -0,0 +1,168 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/asyncfile.h
+// Purpose:     wxAsyncFile class for asynchronous file I/O
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_ASYNCFILE_H_
+#define _WX_ASYNCFILE_H_
+
+#include "wx/defs.h"
+
+#if wxUSE_FILE && wxUSE_THREADS
+
+#include "wx/event.h"
+#include "wx/file.h"
+
+class WXDLLIMPEXP_FWD_BASE wxAsyncFileEvent;
+
+namespace wxPrivate
+{
+
+// Object performing the I/O using one of the backends.
+class wxAsyncFileImpl;
+
+} // namespace wxPrivate
+
+// ----------------------------------------------------------------------------
+// Constants
+// ----------------------------------------------------------------------------
+
+// Mechanism used for performing the asynchronous operations.
+enum wxAsyncFileBackend
+{
+    // Use the most efficient backend available on the current system.
+    wxASYNC_FILE_BACKEND_DEFAULT,
+
+    // Perform blocking I/O in the background threads.
+    wxASYNC_FILE_BACKEND_THREADS,
+
+    // Use io_uring, only available under Linux.
+    wxASYNC_FILE_BACKEND_IO_URING
+};
+
+// ----------------------------------------------------------------------------
+// wxAsyncFile: file with asynchronous reads and writes
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxAsyncFile : public wxEvtHandler
+{
+public:
+    // If the parent is specified, the events not processed by this object
+    // itself are passed to it, just as with wxProcess.
+    explicit wxAsyncFile(wxEvtHandler *parent = nullptr, int id = wxID_ANY);
+    virtual ~wxAsyncFile();
+
+    bool Open(const wxString& filename,
+              wxFile::OpenMode mode = wxFile::read,
+              int access = wxS_DEFAULT,
+              wxAsyncFileBackend backend = wxASYNC_FILE_BACKEND_DEFAULT);
+
+    // Cancel all pending operations, wait until they finish and close the
+    // file.
+    bool Close();
+
+    bool IsOpened() const { return m_file.IsOpened(); }
+    wxFileOffset Length() const { return m_file.Length(); }
+    wxAsyncFileBackend GetBackend() const;
+
+    // Start reading or writing at the given offset and return the identifier
+    // of the request, always positive, or 0 on error. The buffer must remain
+    // valid until the completion event for this request is received.
+    long ReadAt(wxFileOffset offset, void *buffer, size_t count);
+    long WriteAt(wxFileOffset offset, const void *buffer, size_t count);
+
+    // Request cancelling the given operation or all of them. The completion
+    // events are still sent for the cancelled requests.
+    bool Cancel(long requestId);
+    void CancelAll();
+
+    // Return the number of operations for which no completion event has been
+    // queued yet.
+    size_t GetPendingCount() const;
+
+    // Block until all pending operations complete. Their completion events
+    // are queued, but not processed, by this function.
+    void WaitAll();
+
+    int GetId() const { return m_id; }
+
+private:
+    long DoSubmit(bool write, wxFileOffset offset, void *buffer, size_t count);
+
+    wxFile m_file;
+    wxPrivate::wxAsyncFileImpl *m_impl;
+    long m_lastRequestId;
+    int m_id;
+
+    wxDECLARE_NO_COPY_CLASS(wxAsyncFile);
+};
+
+// ----------------------------------------------------------------------------
+// wxAsyncFileEvent: sent when an asynchronous operation completes
+// ----------------------------------------------------------------------------
+
+wxDECLARE_EXPORTED_EVENT( WXDLLIMPEXP_BASE, wxEVT_ASYNC_FILE_READ, wxAsyncFileEvent );
+wxDECLARE_EXPORTED_EVENT( WXDLLIMPEXP_BASE, wxEVT_ASYNC_FILE_WRITE, wxAsyncFileEvent );
+
+class WXDLLIMPEXP_BASE wxAsyncFileEvent : public wxEvent
+{
+public:
+    wxAsyncFileEvent(wxEventType type = wxEVT_NULL, int id = wxID_ANY)
+        : wxEvent(id, type)
+    {
+        m_requestId = 0;
+        m_offset = 0;
+        m_buffer = nullptr;
+        m_requested = 0;
+        m_count = 0;
+        m_error = 0;
+        m_cancelled = false;
+    }
+
+    long GetRequestId() const { return m_requestId; }
+    wxFileOffset GetOffset() const { return m_offset; }
+    void *GetBuffer() const { return m_buffer; }
+    size_t GetRequestedCount() const { return m_requested; }
+
+    // Number of bytes actually transferred, may be less than requested at
+    // the end of file, in case of error or cancellation.
+    size_t GetCount() const { return m_count; }
+
+    // System error code, 0 if there was no error.
+    unsigned long GetErrorCode() const { return m_error; }
+    bool IsCancelled() const { return m_cancelled; }
+    bool IsOk() const { return !m_error && !m_cancelled; }
+
+    wxNODISCARD virtual wxEvent *Clone() const override { return new wxAsyncFileEvent(*this); }
+
+private:
+    long m_requestId;
+    wxFileOffset m_offset;
+    void *m_buffer;
+    size_t m_requested;
+    size_t m_count;
+    unsigned long m_error;
+    bool m_cancelled;
+
+    friend class wxPrivate::wxAsyncFileImpl;
+
+    wxDECLARE_DYNAMIC_CLASS_NO_ASSIGN_DEF_COPY(wxAsyncFileEvent);
+};
+
+typedef void (wxEvtHandler::*wxAsyncFileEventFunction)(wxAsyncFileEvent&);
+
+#define wxAsyncFileEventHandler(func) \
+    wxEVENT_HANDLER_CAST(wxAsyncFileEventFunction, func)
+
+#define EVT_ASYNC_FILE_READ(id, func) \
+   wx__DECLARE_EVT1(wxEVT_ASYNC_FILE_READ, id, wxAsyncFileEventHandler(func))
+#define EVT_ASYNC_FILE_WRITE(id, func) \
+   wx__DECLARE_EVT1(wxEVT_ASYNC_FILE_WRITE, id, wxAsyncFileEventHandler(func))
+
+#endif // wxUSE_FILE && wxUSE_THREADS
+
+#endif // _WX_ASYNCFILE_H_
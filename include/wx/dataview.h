@@ -272,6 +272,10 @@ public:
                          unsigned int column, bool ascending ) const;
     virtual bool HasDefaultCompare() const { return false; }
 
+    // return true if Compare() is not overridden, i.e. only compares the
+    // column values, allowing the control to sort items faster
+    virtual bool UsesDefaultCompare() const { return false; }
+
     // internal
     virtual bool IsListModel() const { return false; }
     virtual bool IsVirtualListModel() const { return false; }
@@ -1128,10 +1132,20 @@ public:
     virtual bool SetValueByRow( const wxVariant &value,
                            unsigned int row, unsigned int col ) override;
 
+    virtual bool UsesDefaultCompare() const override
+        { return m_usesDefaultCompare; }
+
+    // Must be called only if Compare() is not overridden in the derived class.
+    void SetUsesDefaultCompare(bool uses = true)
+        { m_usesDefaultCompare = uses; }
+
 
 public:
     wxVector<wxDataViewListStoreLine*> m_data;
     wxArrayString                      m_cols;
+
+private:
+    bool m_usesDefaultCompare = false;
 };
 
 //-----------------------------------------------------------------------------
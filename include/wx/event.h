@@ -1325,7 +1325,11 @@ enum wxIdleMode
 
         // Send idle events to windows that have
         // the wxWS_EX_PROCESS_IDLE flag specified
-    wxIDLE_PROCESS_SPECIFIED
+    wxIDLE_PROCESS_SPECIFIED,
+
+        // Send idle events only to windows that have
+        // handlers for them or wxWS_EX_PROCESS_IDLE flag
+    wxIDLE_PROCESS_HANDLED
 };
 
 class WXDLLIMPEXP_BASE wxIdleEvent : public wxEvent
@@ -3664,6 +3668,9 @@ public:
     // and call self->ProcessEvent() if a match was found.
     bool HandleEvent(wxEvent& event, wxEvtHandler *self);
 
+    // Return true if there are any entries for the given event type.
+    bool HasEntriesFor(wxEventType eventType);
+
     // Clear table
     void Clear();
 
@@ -3718,6 +3725,12 @@ public:
     void Unlink();
     bool IsUnlinked() const;
 
+    // Return true if this handler may process events of the given type, i.e.
+    // if it has any handlers for them in its event table or bound dynamically
+    // or if it is chained with other handlers. Note that this doesn't take
+    // into account any overridden ProcessEvent(), TryBefore() or TryAfter().
+    bool HasHandlersFor(wxEventType eventType) const;
+
 
     // Global event filters
     // --------------------
@@ -0,0 +1,312 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/evtloopstats.h
+// Purpose:     wxEventLoopStats: event loop latency instrumentation
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_EVTLOOPSTATS_H_
+#define _WX_EVTLOOPSTATS_H_
+
+#include "wx/event.h"
+#include "wx/stopwatch.h"
+
+#include <atomic>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+// wxEventLoopHistogram: distribution of durations using power of 2 buckets
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxEventLoopHistogram
+{
+public:
+    // Bucket n contains the durations in [2^n, 2^(n+1)) microseconds range,
+    // except for the first one which contains all durations less than 2us and
+    // the last one which contains all durations greater than 2^NUM_BUCKETS.
+    enum { NUM_BUCKETS = 25 };
+
+    wxEventLoopHistogram() { Reset(); }
+
+    void Add(wxLongLong_t durationUS);
+    void Reset();
+
+    // Total number of samples and their total and maximal duration.
+    size_t GetCount() const { return m_count; }
+    wxLongLong_t GetTotal() const { return m_total; }
+    wxLongLong_t GetMax() const { return m_max; }
+    wxLongLong_t GetAverage() const
+        { return m_count ? m_total / static_cast<wxLongLong_t>(m_count) : 0; }
+
+    // Number of samples in the given bucket.
+    size_t GetBucketCount(int n) const;
+
+    // Return the upper limit of the given bucket in microseconds.
+    static wxLongLong_t GetBucketLimit(int n);
+
+    // Return the approximate value of the given percentile, i.e. the upper
+    // limit of the bucket containing it.
+    wxLongLong_t GetPercentile(double percent) const;
+
+private:
+    size_t m_buckets[NUM_BUCKETS];
+    size_t m_count;
+    wxLongLong_t m_total;
+    wxLongLong_t m_max;
+};
+
+// ----------------------------------------------------------------------------
+// Information about a single call of an event handler
+// ----------------------------------------------------------------------------
+
+struct wxEventLoopHandlerInfo
+{
+    // The type and ID of the handled event.
+    wxEventType eventType = wxEVT_NULL;
+    int id = wxID_ANY;
+
+    // The class names of the object whose handler was called and of the
+    // event source, i.e. wxEvent::GetEventObject(), if any.
+    wxString handlerClass;
+    wxString sourceClass;
+
+    // Time when the handler was called, in milliseconds since the Epoch, and
+    // its duration in microseconds.
+    wxLongLong_t timestamp = 0;
+    wxLongLong_t duration = 0;
+};
+
+// ----------------------------------------------------------------------------
+// Information about the stall passed to wxEventLoopStats stall handler
+// ----------------------------------------------------------------------------
+
+struct wxEventLoopStallInfo
+{
+    // For how long the event loop has been blocked, in milliseconds.
+    long duration = 0;
+
+    // True if the loop is blocked while processing idle events, in which case
+    // the fields below are not meaningful.
+    bool isIdle = false;
+
+    // The event being handled when the loop got blocked.
+    wxEventType eventType = wxEVT_NULL;
+    int id = wxID_ANY;
+    wxString handlerClass;
+};
+
+// ----------------------------------------------------------------------------
+// wxEventLoopStats: collects statistics about the main event loop
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxEventLoopStats
+{
+public:
+    // Start or stop collecting the statistics. Does nothing by default.
+    static void Enable(bool enable = true);
+
+    // Return the statistics object if collecting them is enabled or null.
+    static wxEventLoopStats* Get() { return ms_enabled ? &ms_stats : nullptr; }
+
+    // Reset all statistics, except for the stall detector state.
+    void Reset();
+
+
+    // Busy time of every event loop iteration in microseconds. An iteration
+    // ends when idle events are processed, i.e. when the loop has no more
+    // events to handle, and only the time spent in event and idle handlers is
+    // counted, but not the time spent waiting for events.
+    const wxEventLoopHistogram& GetIterationTimes() const
+        { return m_iterationTimes; }
+
+    // Durations of all event handler calls.
+    const wxEventLoopHistogram& GetHandlerTimes() const
+        { return m_handlerTimes; }
+
+    // Durations of idle processing passes.
+    const wxEventLoopHistogram& GetIdleTimes() const
+        { return m_idleTimes; }
+
+    // Number of pending events, i.e. queued using wxEvtHandler::QueueEvent()
+    // or AddPendingEvent(), processed.
+    size_t GetPendingEventsCount() const { return m_pendingEvents; }
+
+    // Number of events of the given type which were processed.
+    size_t GetEventCount(wxEventType eventType) const;
+
+    // Return all event types which were processed with their counts, sorted
+    // in order of decreasing count.
+    std::vector<std::pair<wxEventType, size_t>> GetEventCounts() const;
+
+    // Return the slowest event handler calls, from the slowest to the
+    // fastest one.
+    const std::vector<wxEventLoopHandlerInfo>& GetSlowestHandlers() const
+        { return m_slowestHandlers; }
+
+    // Change the number of the slowest handlers to remember (default 10).
+    void SetMaxSlowestHandlers(size_t count);
+
+    // Return a human-readable summary of all the statistics.
+    wxString Dump() const;
+
+
+#if wxUSE_THREADS
+    typedef std::function<void (const wxEventLoopStallInfo&)> StallHandler;
+
+    // Call the given function from a background thread if the main event
+    // loop is blocked for longer than the given number of milliseconds. By
+    // default, i.e. if the handler is empty, a warning is logged.
+    bool StartStallDetector(long thresholdMS,
+                            const StallHandler& handler = StallHandler());
+
+    // Stop the stall detector if it's running.
+    void StopStallDetector();
+#endif // wxUSE_THREADS
+
+
+    // Implementation only from now on.
+
+    // Called when an event is processed by wxEvtHandler::ProcessEvent().
+    void OnEvent(const wxEvent& event);
+
+    // Called when a pending event is processed.
+    void OnPendingEvent() { m_pendingEvents++; }
+
+    // Helper class used for timing the event handler calls.
+    class HandlerScope
+    {
+    public:
+        HandlerScope(wxEvtHandler* handler, const wxEvent& event)
+            : m_stats(Get())
+        {
+            if ( m_stats )
+                m_stats->OnHandlerStart(*this, handler, event);
+        }
+
+        ~HandlerScope()
+        {
+            if ( m_stats )
+                m_stats->OnHandlerEnd(*this);
+        }
+
+    private:
+        wxEventLoopStats* const m_stats;
+
+        // These fields are initialized by OnHandlerStart() as the handler
+        // object and the event source may be destroyed by the handler.
+        wxLongLong_t m_start;
+        wxEventType m_eventType;
+        int m_id;
+        const wxChar* m_handlerClass;
+        const wxChar* m_sourceClass;
+        bool m_isOutermost;
+
+        friend class wxEventLoopStats;
+
+        wxDECLARE_NO_COPY_CLASS(HandlerScope);
+    };
+
+    // Helper class used for timing idle processing.
+    class IdleScope
+    {
+    public:
+        IdleScope()
+            : m_stats(Get())
+        {
+            if ( m_stats )
+                m_stats->OnIdleStart(*this);
+        }
+
+        ~IdleScope()
+        {
+            if ( m_stats )
+                m_stats->OnIdleEnd(*this);
+        }
+
+    private:
+        wxEventLoopStats* const m_stats;
+
+        wxLongLong_t m_start;
+        bool m_isOutermost;
+
+        friend class wxEventLoopStats;
+
+        wxDECLARE_NO_COPY_CLASS(IdleScope);
+    };
+
+private:
+    wxEventLoopStats();
+    ~wxEventLoopStats();
+
+    // Return the current time in microseconds using a monotonic clock.
+    wxLongLong_t Now() const { return m_clock.TimeInMicro().GetValue(); }
+
+    // Start and end a period during which the event loop is busy.
+    bool BeginBusy(wxLongLong_t start,
+                   bool isIdle,
+                   wxEventType eventType = wxEVT_NULL,
+                   int id = wxID_ANY,
+                   const wxChar* handlerClass = nullptr);
+    void EndBusy(wxLongLong_t duration);
+
+    void OnHandlerStart(HandlerScope& scope,
+                        wxEvtHandler* handler,
+                        const wxEvent& event);
+    void OnHandlerEnd(HandlerScope& scope);
+
+    void OnIdleStart(IdleScope& scope);
+    void OnIdleEnd(IdleScope& scope);
+
+    // Called at the end of each iteration of the event loop.
+    void OnIterationEnd();
+
+
+    static wxEventLoopStats ms_stats;
+    static bool ms_enabled;
+
+    wxStopWatch m_clock;
+
+    // The nesting level of the busy periods, we only measure the outermost
+    // one. This is only used from the main thread.
+    int m_busyLevel;
+
+    // The nesting level of idle processing.
+    int m_idleLevel;
+
+    // Busy time accumulated during the current loop iteration.
+    wxLongLong_t m_iterationBusy;
+
+    wxEventLoopHistogram m_iterationTimes,
+                         m_handlerTimes,
+                         m_idleTimes;
+
+    size_t m_pendingEvents;
+
+    std::unordered_map<wxEventType, size_t> m_eventCounts;
+
+    std::vector<wxEventLoopHandlerInfo> m_slowestHandlers;
+    size_t m_maxSlowestHandlers;
+
+#if wxUSE_THREADS
+    // These fields are used by the stall detector thread and so are atomic.
+    // Note that they are not updated together, so the detector can see an
+    // inconsistent state, but this is not a problem for its purposes.
+    std::atomic<wxLongLong_t> m_busySince;
+    std::atomic<bool> m_busyIsIdle;
+    std::atomic<wxEventType> m_busyEventType;
+    std::atomic<int> m_busyId;
+    std::atomic<const wxChar*> m_busyHandlerClass;
+
+    class wxEventLoopStallThread* m_stallThread;
+
+    friend class wxEventLoopStallThread;
+#endif // wxUSE_THREADS
+
+    wxDECLARE_NO_COPY_CLASS(wxEventLoopStats);
+};
+
+#endif // _WX_EVTLOOPSTATS_H_
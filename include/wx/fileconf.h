@@ -91,6 +91,7 @@
 class WXDLLIMPEXP_FWD_BASE wxFileConfigGroup;
 class WXDLLIMPEXP_FWD_BASE wxFileConfigEntry;
 class WXDLLIMPEXP_FWD_BASE wxFileConfigLineList;
+class WXDLLIMPEXP_FWD_BASE wxFileConfigText;
 
 #if wxUSE_STREAMS
 class WXDLLIMPEXP_FWD_BASE wxInputStream;
@@ -210,6 +211,10 @@ public:
   void      LineListRemove(wxFileConfigLineList *pLine);
   bool      LineListIsEmpty();
 
+private:
+  // append an already existing line without logging anything
+  void LineListAppend(wxFileConfigLineList *pLine);
+
 protected:
   virtual bool DoReadString(const wxString& key, wxString *pStr) const override;
   virtual bool DoReadLong(const wxString& key, long *pl) const override;
@@ -235,8 +240,10 @@ private:
   // common part of from dtor and DeleteAll
   void CleanUp();
 
-  // parse the whole file
-  void Parse(const wxTextBuffer& buffer, bool bLocal);
+  // parse the whole file contents, splitting the text buffer in lines in
+  // place: for the local file, the lines keep referencing it
+  void Parse(wxWCharBuffer& text, size_t len,
+             const wxString& name, bool bLocal);
 
   // the same as SetPath("/")
   void SetRootPath();
@@ -255,6 +262,7 @@ private:
   // ----------------
   wxFileConfigLineList *m_linesHead,    // head of the linked list
                        *m_linesTail;    // tail
+  wxFileConfigText     *m_localText;    // contents of the local file
 
   wxFileName  m_fnLocalFile,            // local  file name passed to ctor
               m_fnGlobalFile;           // global
@@ -34,6 +34,16 @@ public:
     void Cleanup();
     virtual ~wxArchiveFSHandler();
 
+    // Default limit for the memory used by the cached archive catalogs.
+    enum { DEFAULT_CACHE_LIMIT = 16*1024*1024 };
+
+    static void SetCacheLimit(size_t limit);
+    static size_t GetCacheLimit();
+
+    // Share the cached catalogs between all wxFileSystem objects.
+    static void EnableSharedCache(bool enable = true);
+    static void ClearSharedCache();
+
 private:
     class wxArchiveFSCache *m_cache;
     wxFileSystem m_fs;
@@ -14,9 +14,11 @@
 #if wxUSE_FILESYSTEM
 
 #include "wx/filesys.h"
+#include "wx/buffer.h"
 
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 class wxMemoryFSFile;
 
@@ -46,6 +48,21 @@ public:
                                     const void *binarydata, size_t size,
                                     const wxString& mimetype);
 
+    // Add file sharing the data of the given buffer instead of copying it, the
+    // buffer must not be modified after adding it
+    static void AddFile(const wxString& filename, const wxMemoryBuffer& buf);
+    static void AddFileWithMimeType(const wxString& filename,
+                                    const wxMemoryBuffer& buf,
+                                    const wxString& mimetype);
+
+    // Add file using the data which must remain valid until the file is
+    // removed, e.g. static data, without copying it
+    static void AddStaticFile(const wxString& filename,
+                              const void *binarydata, size_t size);
+    static void AddStaticFileWithMimeType(const wxString& filename,
+                                          const void *binarydata, size_t size,
+                                          const wxString& mimetype);
+
     // Remove file from memory FS and free occupied memory
     static void RemoveFile(const wxString& filename);
 
@@ -59,22 +76,21 @@ protected:
     // error and returns false if it does exist
     static bool CheckDoesntExist(const wxString& filename);
 
-    // add the given object to m_Hash, taking ownership of the pointer
-    static void DoAddFile(const wxString& filename, wxMemoryFSFile* file);
+    // add the given object to m_Hash, taking ownership of the pointer; logs an
+    // error, deletes the object and returns false if the file already exists
+    static bool DoAddFile(const wxString& filename, wxMemoryFSFile* file);
 
 private:
     // the hash map indexed by the names of the files stored in the memory FS
     using wxMemoryFSHash =
-        std::unordered_map<wxString, std::unique_ptr<wxMemoryFSFile>>;
+        std::unordered_map<wxString, std::shared_ptr<wxMemoryFSFile>>;
     static wxMemoryFSHash m_Hash;
 
-    // the file name currently being searched for, i.e. the argument of the
-    // last FindFirst() call or empty string if FindFirst() hasn't been called
-    // yet
-    wxString m_findArgument;
-
-    // iterator into m_Hash used by FindFirst/Next(), possibly m_Hash.end()
-    wxMemoryFSHash::const_iterator m_findIter;
+    // the URLs matching the argument of the last FindFirst() call which
+    // haven't been returned by FindNext() yet, in reverse order: they are
+    // collected by FindFirst() instead of keeping an iterator into m_Hash, as
+    // it could be invalidated by adding or removing files in the meanwhile
+    std::vector<wxString> m_findResults;
 };
 
 // ----------------------------------------------------------------------------
@@ -101,6 +117,10 @@ public:
     {
         wxMemoryFSHandlerBase::AddFile(filename, binarydata, size);
     }
+    static void AddFile(const wxString& filename, const wxMemoryBuffer& buf)
+    {
+        wxMemoryFSHandlerBase::AddFile(filename, buf);
+    }
     static void AddFileWithMimeType(const wxString& filename,
                                     const wxString& textdata,
                                     const wxString& mimetype)
@@ -117,6 +137,12 @@ public:
                                                    binarydata, size,
                                                    mimetype);
     }
+    static void AddFileWithMimeType(const wxString& filename,
+                                    const wxMemoryBuffer& buf,
+                                    const wxString& mimetype)
+    {
+        wxMemoryFSHandlerBase::AddFileWithMimeType(filename, buf, mimetype);
+    }
 
 #if wxUSE_IMAGE
     static void AddFile(const wxString& filename,
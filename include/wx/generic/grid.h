@@ -21,6 +21,7 @@
 #include <memory>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 // ----------------------------------------------------------------------------
 // constants
@@ -94,6 +95,7 @@ enum wxGridRenderStyle
 class WXDLLIMPEXP_FWD_CORE wxGrid;
 class WXDLLIMPEXP_FWD_CORE wxGridCellAttr;
 class WXDLLIMPEXP_FWD_CORE wxGridCellAttrProviderData;
+class WXDLLIMPEXP_FWD_CORE wxGridBlockCoords;
 class WXDLLIMPEXP_FWD_CORE wxGridColLabelWindow;
 class WXDLLIMPEXP_FWD_CORE wxGridCornerLabelWindow;
 class WXDLLIMPEXP_FWD_CORE wxGridEvent;
@@ -984,6 +986,12 @@ public:
     virtual void SetRowAttr(wxGridCellAttr *attr, int row);
     virtual void SetColAttr(wxGridCellAttr *attr, int col);
 
+    // set the attribute shared by all cells of the block: it is stored only
+    // once, whatever the block size, and has lower priority than the
+    // attributes set for individual cells but higher than row/col ones
+    virtual void SetAttrForBlock(wxGridCellAttr *attr,
+                                 const wxGridBlockCoords& block);
+
     // these functions must be called whenever some rows/cols are deleted
     // because the internal data must be updated then
     void UpdateAttrRows( size_t pos, int numRows );
@@ -1301,6 +1309,12 @@ public:
     virtual wxString GetValue( int row, int col ) = 0;
     virtual void SetValue( int row, int col, const wxString& value ) = 0;
 
+    // Get the values of all cells in the given block at once, storing them in
+    // row-major order. Return false if not supported, as is the case by
+    // default, in which case GetValue() is used for each cell instead.
+    virtual bool GetValuesBlock( const wxGridBlockCoords& block,
+                                 std::vector<wxString>& values );
+
     // Data type determination and value access
     virtual wxString GetTypeName( int row, int col );
     virtual bool CanGetValueAs( int row, int col, const wxString& typeName );
@@ -1377,6 +1391,8 @@ public:
     virtual void SetAttr(wxGridCellAttr* attr, int row, int col);
     virtual void SetRowAttr(wxGridCellAttr *attr, int row);
     virtual void SetColAttr(wxGridCellAttr *attr, int col);
+    virtual void SetAttrForBlock(wxGridCellAttr *attr,
+                                 const wxGridBlockCoords& block);
 
 private:
     wxGrid * m_view;
@@ -1542,6 +1558,100 @@ struct WXDLLIMPEXP_CORE wxGridSizesInfo
     wxUnsignedToIntHashMap m_customSizes;
 };
 
+// ----------------------------------------------------------------------------
+// wxGridLinePositions is used by wxGrid to find the positions of its rows or
+// columns having non-default sizes.
+//
+// It stores the line sizes in display order in a Fenwick (binary indexed)
+// tree, allowing to update the size of any line, compute its start and end
+// coordinates and find the line at the given coordinate in O(log n) time.
+//
+// This class is for wxGrid internal use only.
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_CORE wxGridLinePositions
+{
+public:
+    wxGridLinePositions() = default;
+
+    bool IsEmpty() const { return m_tree.empty(); }
+    void Clear();
+
+    // (Re)initialize from the sizes indexed by line index, with negative
+    // values for the hidden lines, and the array mapping positions to line
+    // indices, which may be empty if the lines are not reordered.
+    //
+    // This takes O(n) time and is done whenever the lines are added, removed
+    // or reordered.
+    void Init(const wxArrayInt& sizes, const wxArrayInt& lineAt);
+
+    // Return the number of lines.
+    int GetCount() const { return static_cast<int>(m_tree.size()) - 1; }
+
+    // Return the position of the line with the given index.
+    int GetPos(int line) const
+        { return m_posOf.empty() ? line : m_posOf[line]; }
+
+    // Change the size of the line at the given position by the given amount.
+    void Add(int pos, int diff);
+
+    // Return the coordinate of the end of the line at the given position,
+    // i.e. the total size of all lines up to and including it.
+    int GetEnd(int pos) const;
+
+    // Return the coordinate of the start of the line at the given position.
+    int GetStart(int pos) const { return pos > 0 ? GetEnd(pos - 1) : 0; }
+
+    // Return the position of the visible line containing the given
+    // non-negative coordinate or GetCount() if it is beyond the last line.
+    int FindPos(int coord) const;
+
+private:
+    // 1-based Fenwick tree of the line sizes: element i contains the sum of
+    // the sizes of the lines at positions in (i - (i & -i), i] range.
+    std::vector<int> m_tree;
+
+    // Maps line indices to their positions, empty if they're the same.
+    std::vector<int> m_posOf;
+
+    // The highest power of 2 less than or equal to the number of lines.
+    int m_topBit = 0;
+};
+
+// ----------------------------------------------------------------------------
+// wxGridTextExtentCache is used by wxGrid to avoid measuring the same strings
+// using the same font many times while auto-sizing its columns or rows.
+//
+// This class is for wxGrid internal use only.
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_CORE wxGridTextExtentCache
+{
+public:
+    wxGridTextExtentCache() = default;
+
+    // Start and stop using the cache, these calls can be nested and the cache
+    // is cleared when it's not used any more.
+    void Start() { m_users++; }
+    void Stop();
+
+    bool IsActive() const { return m_users > 0; }
+
+    // Return the extent of the possibly multiline text using the current font
+    // of the given DC, taking it from the cache if it's active.
+    wxSize GetMultiLineTextExtent(const wxReadOnlyDC& dc, const wxString& text);
+
+private:
+    using Extents = std::unordered_map<wxString, wxSize>;
+
+    // Cached extents for each of the recently used fonts.
+    std::vector<std::pair<wxFont, Extents>> m_fonts;
+
+    int m_users = 0;
+
+    wxDECLARE_NO_COPY_CLASS(wxGridTextExtentCache);
+};
+
 // ----------------------------------------------------------------------------
 // wxGrid
 // ----------------------------------------------------------------------------
@@ -1747,6 +1857,13 @@ public:
                          const wxArrayString& lines,
                          long *width, long *height ) const;
 
+    // Return the extent of the possibly multiline text using the current font
+    // of the given DC. This is used by the cell renderers and is faster than
+    // calling wxDC::GetMultiLineTextExtent() directly while auto-sizing
+    // columns or rows, as the extents of the same strings are cached.
+    wxSize GetCellTextExtent(const wxReadOnlyDC& dc, const wxString& text)
+        { return m_textExtentCache.GetMultiLineTextExtent(dc, text); }
+
     // If bottomRight is invalid, i.e. == wxGridNoCellCoords, it defaults to
     // topLeft. If topLeft itself is invalid, the function simply returns.
     void RefreshBlock(const wxGridCellCoords& topLeft,
@@ -2081,6 +2198,15 @@ public:
     virtual wxPen GetColGridLinePen(int col);
 
 
+    // rendering cache
+    // ---------------
+
+    // keep the contents of the cells area in a bitmap to avoid redrawing the
+    // cells which didn't change when scrolling or repainting
+    void EnableRenderCache(bool enable = true);
+    bool IsRenderCacheEnabled() const { return m_renderCacheEnabled; }
+
+
     // attributes
     // ----------
 
@@ -2089,6 +2215,10 @@ public:
     void     SetRowAttr(int row, wxGridCellAttr *attr);
     void     SetColAttr(int col, wxGridCellAttr *attr);
 
+    // this sets the attribute shared by all the cells of the given block
+    void     SetAttrForBlock(const wxGridBlockCoords& block,
+                             wxGridCellAttr *attr);
+
     // the grid can cache attributes for the recently used cells (currently it
     // only caches one attribute for the most recently used one) and might
     // notice that its value in the attribute provider has changed -- if this
@@ -2253,6 +2383,13 @@ public:
     void     AutoSizeColumns( bool setAsMin = true );
     void     AutoSizeRows( bool setAsMin = true );
 
+    // limit the number of cells measured when auto sizing a column or row to
+    // the visible ones and the given number of the others (0, the default,
+    // means to measure all of them), optionally measuring the remaining cells
+    // in idle time later and enlarging the column or row if necessary
+    void     SetAutoSizeSampling( int numSamples, bool refineInIdleTime = false );
+    int      GetAutoSizeSampling() const { return m_autoSizeSamples; }
+
     // auto size the grid, that is make the columns/rows of the "right" size
     // and also set the grid size to just fit its contents
     void     AutoSize();
@@ -2326,6 +2463,10 @@ public:
     {
         if ( m_table )
         {
+            if ( !m_prefetchedValues.empty() &&
+                    m_prefetchedBlock.Contains(wxGridCellCoords(row, col)) )
+                return GetPrefetchedValue( row, col );
+
             return m_table->GetValue( row, col );
         }
         else
@@ -2594,21 +2735,21 @@ protected:
     // NB: *never* access m_row/col arrays directly because they are created
     //     on demand, *always* use accessor functions instead!
 
-    // init the m_rowHeights/Bottoms arrays with default values
+    // init the m_rowHeights/Positions with default values
     void InitRowHeights();
 
     int        m_defaultRowHeight;
     int        m_minAcceptableRowHeight;
     wxArrayInt m_rowHeights;
-    wxArrayInt m_rowBottoms;
+    wxGridLinePositions m_rowPositions;
 
-    // init the m_colWidths/Rights arrays
+    // init the m_colWidths/Positions with default values
     void InitColWidths();
 
     int        m_defaultColWidth;
     int        m_minAcceptableColWidth;
     wxArrayInt m_colWidths;
-    wxArrayInt m_colRights;
+    wxGridLinePositions m_colPositions;
 
     int m_sortCol;
     bool m_sortIsAscending;
@@ -2663,10 +2804,80 @@ protected:
     int        m_cellHighlightROPenWidth;
     wxColour   m_gridFrozenBorderColour;
     int        m_gridFrozenBorderPenWidth;
+    bool       m_renderCacheEnabled;
 
     // common part of AutoSizeColumn/Row()
     void AutoSizeColOrRow(int n, bool setAsMin, wxGridDirection direction);
 
+    // return the maximal best extent of the cells of the given column or row
+    // in the rows or columns with indices from first to last (exclusive) or,
+    // if lines is not null, with the indices stored in it at these positions;
+    // exact is set to true if the result is valid for all the cells even
+    // though only some of them were measured
+    wxCoord GetBestCellsExtent(int colOrRow,
+                               wxGridDirection direction,
+                               wxDC& dc,
+                               int first,
+                               int last,
+                               const std::vector<int>* lines = nullptr,
+                               bool* exact = nullptr);
+
+    // return the visible rows or columns and the evenly spaced samples of
+    // the other ones to measure when auto sizing a column or row
+    std::vector<int> GetAutoSizeSamples(wxGridDirection direction) const;
+
+    // the number of samples to use when auto sizing, 0 to measure all cells
+    int m_autoSizeSamples;
+    bool m_autoSizeRefine;
+
+    // the columns and rows which were auto sized using sampling and whose
+    // remaining cells are measured in idle time
+    struct AutoSizeRefinement
+    {
+        int colOrRow;
+        wxGridDirection direction;
+        bool setAsMin;
+
+        // the index of the next row or column to measure
+        int next;
+
+        // the size set by the last auto sizing: if it changes, e.g. because
+        // the user resized the column, its auto sizing is cancelled
+        int size;
+    };
+
+    std::vector<AutoSizeRefinement> m_autoSizeRefinements;
+    int m_autoSizeTaskId;
+
+    void ScheduleAutoSizeRefinement(int colOrRow,
+                                    wxGridDirection direction,
+                                    bool setAsMin);
+    void CancelAutoSizeRefinement();
+
+    // measure some of the remaining cells, return true if there is more
+    // work to do
+    bool DoRefineAutoSize();
+
+    wxGridTextExtentCache m_textExtentCache;
+
+    // the values of the cells in m_prefetchedBlock, only non-empty while the
+    // grid is being drawn or copied and if the table supports GetValuesBlock()
+    wxGridBlockCoords m_prefetchedBlock;
+    std::vector<wxString> m_prefetchedValues;
+
+    // fetch the values of all cells in the given block at once, if possible
+    void PrefetchValues(const wxGridBlockCoords& block);
+    void ClearPrefetchedValues();
+
+    const wxString& GetPrefetchedValue(int row, int col) const
+    {
+        const int width = m_prefetchedBlock.GetRightCol() -
+                            m_prefetchedBlock.GetLeftCol() + 1;
+        const size_t n = static_cast<size_t>(row - m_prefetchedBlock.GetTopRow())
+                            * width + col - m_prefetchedBlock.GetLeftCol();
+        return m_prefetchedValues[n];
+    }
+
     // Calculate the minimum acceptable size for labels area
     wxCoord CalcColOrRowLabelAreaMinSize(wxGridDirection direction);
 
@@ -54,6 +54,13 @@ protected:
     wxSize DoGetBestSize(const wxGridCellAttr& attr,
                          wxReadOnlyDC& dc,
                          const wxString& text);
+
+    // same as above but uses wxGrid::GetCellTextExtent() which is faster when
+    // auto-sizing the grid columns or rows
+    wxSize DoGetBestSize(wxGrid& grid,
+                         const wxGridCellAttr& attr,
+                         wxReadOnlyDC& dc,
+                         const wxString& text);
 };
 
 // the default renderer for the cells containing numeric (long) data
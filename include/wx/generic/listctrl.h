@@ -165,6 +165,12 @@ public:
 
     virtual void EnableBellOnNoMatch(bool on = true) override;
 
+    // generic version extension, don't use in portable code: allow the items
+    // to have different heights in report view, the height of each item is
+    // then given by OnGetItemHeight()
+    void EnableVariableLineHeight(bool enable = true);
+    bool HasVariableLineHeight() const;
+
     // overridden base class virtuals
     // ------------------------------
 
@@ -220,6 +226,10 @@ protected:
 
     virtual wxSize DoGetBestClientSize() const override;
 
+    // return the height of the given item or -1 to use the default height,
+    // only used if variable line height support is enabled
+    virtual int OnGetItemHeight(long item) const;
+
     // it calls our OnGetXXX() functions
     friend class WXDLLIMPEXP_FWD_CORE wxListMainWindow;
 
@@ -28,6 +28,7 @@
 #include <iterator>
 #include <set>
 #include <map>
+#include <vector>
 
 // ----------------------------------------------------------------------------
 // array classes
@@ -423,13 +424,36 @@ public:
 
     virtual void ScrollWindow( int dx, int dy, const wxRect *rect ) override;
 
+    virtual void Refresh(bool eraseBackground = true,
+                         const wxRect *rect = nullptr) override;
+
     virtual bool AcceptsFocus() const override { return true; }
 
     wxGridWindowType GetType() const { return m_type; }
 
+    // Mark the given rectangle, in window coordinates, or everything if it's
+    // null, as needing to be redrawn when the render cache is used.
+    void InvalidateRenderCache(const wxRect *rect = nullptr);
+
+    // Free the memory used by the render cache.
+    void ResetRenderCache();
+
 private:
     const wxGridWindowType m_type;
 
+    // Draw the cells, the grid lines and the space after the last cell of the
+    // given region using the render cache and updating it if necessary.
+    void DrawUsingRenderCache(wxDC& dc, const wxRegion& reg);
+
+    // The contents of the window when it was scrolled to m_cacheOrigin, with
+    // m_cacheValid being the part of it, in unscrolled coordinates, which is
+    // still up to date. The other bitmap is only used when scrolling, to copy
+    // the part of the old contents still remaining visible to its new place.
+    wxBitmap m_cacheBitmap,
+             m_cacheBitmapOld;
+    wxPoint m_cacheOrigin;
+    wxRegion m_cacheValid;
+
     void OnPaint( wxPaintEvent &event );
     void OnMouseWheel( wxMouseEvent& event );
     void OnMouseEvent( wxMouseEvent& event );
@@ -481,12 +505,70 @@ private:
     wxArrayAttrs m_attrs;
 };
 
-// NB: this is just a wrapper around 3 objects: one which stores cell
-//     attributes, and 2 others for row/col ones
+// this class stores attributes shared by all cells of a block
+class WXDLLIMPEXP_ADV wxGridBlockAttrData
+{
+public:
+    wxGridBlockAttrData() = default;
+    ~wxGridBlockAttrData();
+
+    void SetAttr(wxGridCellAttr *attr, const wxGridBlockCoords& block);
+    wxGridCellAttr *GetAttr(int row, int col) const;
+    void UpdateAttrRows( size_t pos, int numRows );
+    void UpdateAttrCols( size_t pos, int numCols );
+
+private:
+    struct Entry
+    {
+        wxGridBlockCoords block;
+        wxGridCellAttr* attr;
+    };
+
+    // Rebuild m_maxBottoms from the (already sorted) blocks.
+    void RebuildTree();
+
+    // Update m_maxBottoms after changing the block with the given index, which
+    // must be covered by it.
+    void UpdateTree(size_t n);
+
+    // Return the number of blocks starting at or above the given row.
+    size_t GetCountStartingAtOrAbove(int row) const;
+
+    // Return the index of the block containing the given cell among the
+    // blocks with indices in [first, min(last, end)) or -1. The node indexes
+    // into m_maxBottoms which contains the maximal bottom row of these blocks.
+    int DoFind(int node, int first, int last, int end, int row, int col) const;
+
+    // Append the indices of all the blocks intersecting the given one among
+    // the same blocks as for DoFind() to the found vector.
+    void DoFindOverlapping(int node, int first, int last, int end,
+                           const wxGridBlockCoords& block,
+                           std::vector<size_t>& found) const;
+
+    // Non-overlapping blocks sorted by their top rows, so that there is only
+    // a single attribute for any cell.
+    std::vector<Entry> m_entries;
+
+    // Segment tree of the maximal bottom rows of m_entries used to skip the
+    // blocks ending above the given row. Finding the block containing a cell
+    // takes O((k + 1) log n) time, where n is the number of blocks and k the
+    // number of those spanning the cell row, which is usually small as the
+    // blocks don't overlap, but can be up to the number of columns. Setting
+    // an attribute takes O(n) time, to update the blocks vector and this
+    // tree, except when adding the non-overlapping blocks from top to bottom,
+    // which takes O(log n) amortized time.
+    std::vector<int> m_maxBottoms;
+
+    wxDECLARE_NO_COPY_CLASS(wxGridBlockAttrData);
+};
+
+// NB: this is just a wrapper around 4 objects: one which stores cell
+//     attributes, one for the block ones and 2 others for row/col ones
 class WXDLLIMPEXP_ADV wxGridCellAttrProviderData
 {
 public:
     wxGridCellAttrData m_cellAttrs;
+    wxGridBlockAttrData m_blockAttrs;
     wxGridRowOrColAttrData m_rowAttrs,
                            m_colAttrs;
 };
@@ -587,8 +669,8 @@ public:
     // Get the height/width of the given row/column
     virtual int GetLineSize(const wxGrid *grid, int line) const = 0;
 
-    // Get wxGrid::m_rowBottoms/m_colRights array
-    virtual const wxArrayInt& GetLineEnds(const wxGrid *grid) const = 0;
+    // Get wxGrid::m_rowPositions/m_colPositions object
+    virtual const wxGridLinePositions& GetLinePositions(const wxGrid *grid) const = 0;
 
     // Get default height row height or column width
     virtual int GetDefaultLineSize(const wxGrid *grid) const = 0;
@@ -747,8 +829,8 @@ public:
         { return grid->GetRowBottom(line); }
     virtual int GetLineSize(const wxGrid *grid, int line) const override
         { return grid->GetRowHeight(line); }
-    virtual const wxArrayInt& GetLineEnds(const wxGrid *grid) const override
-        { return grid->m_rowBottoms; }
+    virtual const wxGridLinePositions& GetLinePositions(const wxGrid *grid) const override
+        { return grid->m_rowPositions; }
     virtual int GetDefaultLineSize(const wxGrid *grid) const override
         { return grid->GetDefaultRowSize(); }
     virtual int GetMinimalAcceptableLineSize(const wxGrid *grid) const override
@@ -903,8 +985,8 @@ public:
         { return grid->GetColRight(line); }
     virtual int GetLineSize(const wxGrid *grid, int line) const override
         { return grid->GetColWidth(line); }
-    virtual const wxArrayInt& GetLineEnds(const wxGrid *grid) const override
-        { return grid->m_colRights; }
+    virtual const wxGridLinePositions& GetLinePositions(const wxGrid *grid) const override
+        { return grid->m_colPositions; }
     virtual int GetDefaultLineSize(const wxGrid *grid) const override
         { return grid->GetDefaultColSize(); }
     virtual int GetMinimalAcceptableLineSize(const wxGrid *grid) const override
@@ -19,6 +19,8 @@
 #include "wx/timer.h"
 #include "wx/settings.h"
 
+#include "wx/generic/private/rowheightcache.h"
+
 #include <memory>
 
 // ============================================================================
@@ -722,6 +724,7 @@ public:
             return false;
 
         m_lineHeight = 0;
+        InvalidateLineHeights();
 
         return true;
     }
@@ -743,9 +746,34 @@ public:
     // get the height of all lines (assuming they all do have the same height)
     wxCoord GetLineHeight() const;
 
+    // get the height of the given line, which is always the same as the
+    // value returned by GetLineHeight() above unless variable line height
+    // support is enabled (only for report view)
+    wxCoord GetLineHeight(size_t line) const;
+
     // get the y position of the given line (only for report view)
     wxCoord GetLineY(size_t line) const;
 
+    // get the line at the given y position, the returned value is greater
+    // than or equal to the number of items if it's below the last one (only
+    // for report view)
+    size_t GetLineAt(int y) const;
+
+    // enable or disable support for lines of different heights, which are
+    // then retrieved using wxGenericListCtrl::OnGetItemHeight()
+    void EnableVariableLineHeight(bool enable);
+    bool HasVariableLineHeight() const { return m_lineHeightCache != nullptr; }
+
+    // forget the heights of all lines starting from the given one, must be
+    // called whenever they may have changed, e.g. when inserting or deleting
+    // lines
+    void InvalidateLineHeights(size_t from = 0);
+
+    // retrieve the heights of the lines in the given inclusive range again,
+    // without affecting the other lines, after their contents has changed,
+    // return true if any of them changed
+    bool UpdateLineHeights(size_t from, size_t to);
+
     // get the brush to use for the item highlighting
     wxBrush *GetHighlightBrush() const
     {
@@ -850,6 +878,10 @@ protected:
         wxListMainWindow *self = wxConstCast(this, wxListMainWindow);
         if ( IsVirtual() )
         {
+            wxListLineData * const ld = self->GetCachedLine(n);
+            if ( ld )
+                return ld;
+
             self->CacheLineData(n);
             n = 0;
         }
@@ -868,6 +900,9 @@ protected:
     // cache the line data of the n-th line in m_lines[0]
     void CacheLineData(size_t line);
 
+    // retrieve the data of the given line of a virtual control from it
+    void FillLineData(wxListLineData *ld, size_t line);
+
     // get the range of visible lines
     void GetVisibleLinesRange(size_t *from, size_t *to);
 
@@ -916,9 +951,43 @@ private:
     // Always returns false if there are no checkboxes.
     bool IsInsideCheckBox(long item, int x, int y);
 
+    // Data of a line of a virtual control stored in m_linesCache.
+    struct CachedLine
+    {
+        explicit CachedLine(wxListMainWindow *owner) : data(owner) { }
+
+        wxListLineData data;
+
+        // copy of the attribute returned by OnGetItemAttr(), as the pointer
+        // returned by it doesn't necessarily remain valid for long
+        std::unique_ptr<wxItemAttr> attr;
+    };
+
+    // cache the data of all lines in the given range in m_linesCache,
+    // reusing the data of the lines which had been already cached
+    void CacheLinesData(size_t from, size_t to);
+
+    // return the line data from m_linesCache or nullptr if it's not there
+    wxListLineData *GetCachedLine(size_t line);
+
+    // forget all the cached lines data or just the data of the lines in the
+    // given range, must be called whenever it changes
+    void ResetLinesCache() { m_linesCache.clear(); }
+    void ResetLinesCache(size_t from, size_t to);
+
+    // make sure that the heights of the first count lines are cached in
+    // m_lineHeightCache, which must be non-null
+    void CacheLineHeights(size_t count) const;
+
     // the height of one line using the current font
     wxCoord m_lineHeight;
 
+    // the heights of the lines if variable line height support is enabled or
+    // nullptr otherwise, only the heights of the first m_lineHeightCacheCount
+    // lines are stored in it as they're only retrieved when needed
+    std::unique_ptr<HeightCache> m_lineHeightCache;
+    mutable size_t m_lineHeightCacheCount = 0;
+
     // the total header width or 0 if not calculated yet
     wxCoord m_headerWidth;
 
@@ -940,6 +1009,13 @@ private:
     // rulers on empty rows
     bool m_extendRulesAndAlternateColour;
 
+    // the data of the lines of a virtual control starting from the line
+    // m_linesCacheFrom retrieved when painting, to avoid calling OnGetItemXXX()
+    // for each line again on every repaint, with null elements for the lines
+    // which are not cached
+    size_t m_linesCacheFrom = 0;
+    std::vector<std::unique_ptr<CachedLine>> m_linesCache;
+
     wxDECLARE_EVENT_TABLE();
 
     friend class wxGenericListCtrl;
@@ -10,7 +10,6 @@
 #ifndef _WX_PRIVATE_ROWHEIGHTCACHE_H_
 #define _WX_PRIVATE_ROWHEIGHTCACHE_H_
 
-#include <unordered_map>
 #include <vector>
 
 // struct describing a range of rows which contains rows <from> .. <to-1>
@@ -84,17 +83,20 @@ private:
     * the y-coordinate where a row starts (GetLineStart)
     * and vice versa (GetLineAt)
 
-    The layout of the cache is a hashmap where the keys are all existing row
-    heights in pixels. The values are RowRange objects that represent all rows
-    having the specified height.
+    The cache stores a sorted vector of runs of consecutive rows having the
+    same height. Each run also stores the sum of the heights of all the rows
+    before it, and the number of these rows, which are updated lazily, when
+    they're needed after modifying the cache.
 
     An example:
     @code
-    {
-    22: RowRange([0..10], [15..17], [20..2000]),
-    42: RowRange([11..12], [18..18]),
-    62: RowRange([13..14], [19..19])
-    }
+    [
+    { rows [0..10],    height 22, start 0   },
+    { rows [11..12],   height 42, start 242 },
+    { rows [13..14],   height 62, start 326 },
+    { rows [15..17],   height 22, start 450 },
+    ...
+    ]
     @endcode
 
     Examples
@@ -102,28 +104,25 @@ private:
 
     GetLineStart
     ------------
-    To retrieve the y-coordinate of item 1000 it is necessary to look into
-    each key of the hashmap *m_heightToRowRange*. Get the row count of
-    indices lower than 1000 (RowRange::CountTo) and multiplies it which the
-    according height.
-
-    RowRange([0..10], [15..17], [20..2000]).CountTo(1000)
-    --> 0..10 are 11 items, 15..17 are 3 items and 20..1000 are 980 items (1000-20)
-    = 11 + 3 + 980 = 994 items
-
-    GetLineStart(1000) --> (22 * 994) + (42 * 3) + (62 * 3) = 22180
+    To retrieve the y-coordinate of item 16, find the run containing it using
+    binary search and add the heights of the rows of this run before it to
+    the start of the run: 450 + 22 * (16 - 15) = 472.
 
     GetLineHeight
     -------------
-    To retrieve the line height look into each key and check if row is
-    contained in RowRange (RowRange::Has)
+    To retrieve the line height, find the run containing the row using binary
+    search.
 
     GetLineAt
     ---------
-    To retrieve the row that starts at a specific y-coordinate.
-    Look into each key and count all rows.
-    Use bisect algorithm in combination with GetLineStart() to
-    find the appropriate item
+    To retrieve the row that starts at a specific y-coordinate, find the
+    first run ending after it using binary search on the runs starts and
+    divide the offset from the run start by its height.
+
+    All these operations are O(log(N)) in the number of runs, as is adding
+    the height of the row following the last one to the cache. Adding the
+    heights of the rows in the middle is O(N), however, as is the first
+    lookup after doing it.
 */
 class WXDLLIMPEXP_CORE HeightCache
 {
@@ -145,9 +144,38 @@ public:
     void Clear();
 
 private:
-    using HeightToRowRangesMap = std::unordered_map<int, RowRanges>;
+    // A run of the consecutive rows <from> .. <to-1> all having the same
+    // height.
+    struct HeightRun
+    {
+        unsigned int from;
+        unsigned int to;
+        int height;
+
+        // The sum of the heights of all the cached rows before this run and
+        // their number, only valid if this run index is less than
+        // m_firstDirty.
+        int start;
+        unsigned int countBefore;
+
+        int GetEnd() const { return start + static_cast<int>(to - from)*height; }
+    };
+
+    // Return the index of the run containing the given row or -1.
+    int FindRun(unsigned int row) const;
+
+    // Merge the run at the given index with its neighbours if possible.
+    void MergeRuns(size_t idx);
+
+    // Make the start and countBefore fields of all runs valid.
+    void UpdateStarts();
+
+    // Non-overlapping runs sorted by their first row, contiguous runs always
+    // have different heights as they're merged otherwise.
+    std::vector<HeightRun> m_runs;
 
-    HeightToRowRangesMap m_heightToRowRange;
+    // Index of the first run whose start is not up to date.
+    size_t m_firstDirty = 0;
 };
 
 
@@ -0,0 +1,106 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/idlesched.h
+// Purpose:     wxIdleTaskScheduler: running background tasks in idle time
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_IDLESCHED_H_
+#define _WX_IDLESCHED_H_
+
+#include "wx/defs.h"
+
+#include <functional>
+#include <vector>
+
+// Values returned by the idle tasks.
+enum wxIdleTaskResult
+{
+    // The task is finished and should be removed.
+    wxIDLE_TASK_DONE,
+
+    // The task has more work to do and should be called again as soon as
+    // possible.
+    wxIDLE_TASK_MORE,
+
+    // The task has nothing to do right now and shouldn't be called again
+    // until wxIdleTaskScheduler::WakeUp() is called for it.
+    wxIDLE_TASK_WAIT
+};
+
+// ----------------------------------------------------------------------------
+// wxIdleTaskScheduler: runs tasks in idle time within the given time budget
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxIdleTaskScheduler
+{
+public:
+    // Each call to the task should perform a small amount of work.
+    typedef std::function<wxIdleTaskResult ()> Task;
+
+    // The scheduler used by wxApp.
+    static wxIdleTaskScheduler& Get();
+
+    wxIdleTaskScheduler();
+
+    // Add a new task. Tasks with higher priority are executed first and each
+    // task is called repeatedly for at most the given time (in milliseconds)
+    // during each idle processing pass.
+    //
+    // Returns the task ID which can be used with the other functions.
+    int AddTask(const Task& task, int priority = 0, long budget = 5);
+
+    // Remove the task with the given ID, return false if not found.
+    bool RemoveTask(int id);
+
+    // Make the task which returned wxIDLE_TASK_WAIT runnable again.
+    void WakeUp(int id);
+
+    // Return true if there are any (runnable or waiting) tasks.
+    bool HasTasks() const { return !m_tasks.empty(); }
+
+    // Maximal time in milliseconds to spend running the tasks during a single
+    // idle processing pass, 10ms by default.
+    void SetTimeSlice(long timeSlice) { m_timeSlice = timeSlice; }
+    long GetTimeSlice() const { return m_timeSlice; }
+
+    // Run the tasks until the time slice is exhausted or there are no more
+    // runnable tasks. Returns true if some tasks have more work to do.
+    //
+    // This is called by wxApp::ProcessIdle() for the global scheduler.
+    bool ProcessIdle();
+
+private:
+    struct TaskData
+    {
+        Task task;
+        int id;
+        int priority;
+        long budget;
+
+        // The number of the last pass during which the task was run, used to
+        // run the tasks with the same priority in round-robin order.
+        unsigned long lastPass;
+
+        // True if the task returned wxIDLE_TASK_WAIT.
+        bool waiting;
+    };
+
+    // Find the task with the given ID or return null.
+    TaskData* FindTask(int id);
+
+    std::vector<TaskData> m_tasks;
+
+    long m_timeSlice;
+    int m_lastId;
+    unsigned long m_pass;
+
+    // Used to prevent reentrancy if a task calls wxYield().
+    bool m_isRunning;
+
+    wxDECLARE_NO_COPY_CLASS(wxIdleTaskScheduler);
+};
+
+#endif // _WX_IDLESCHED_H_
@@ -0,0 +1,156 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/lz4stream.h
+// Purpose:     Filters streams using LZ4 compression
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_LZ4STREAM_H_
+#define _WX_LZ4STREAM_H_
+
+#include "wx/defs.h"
+
+#if wxUSE_LIBLZ4 && wxUSE_STREAMS
+
+#include "wx/stream.h"
+#include "wx/buffer.h"
+#include "wx/versioninfo.h"
+
+namespace wxPrivate
+{
+
+// Private wrappers for LZ4F_dctx and LZ4F_cctx.
+struct wxLZ4Decoder;
+struct wxLZ4Encoder;
+
+} // namespace wxPrivate
+
+// ----------------------------------------------------------------------------
+// Filter for decompressing data compressed using LZ4
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxLZ4InputStream : public wxFilterInputStream
+{
+public:
+    explicit wxLZ4InputStream(wxInputStream& stream)
+        : wxFilterInputStream(stream)
+    {
+        Init();
+    }
+
+    explicit wxLZ4InputStream(wxInputStream* stream)
+        : wxFilterInputStream(stream)
+    {
+        Init();
+    }
+
+    virtual ~wxLZ4InputStream();
+
+    char Peek() override { return wxInputStream::Peek(); }
+    wxFileOffset GetLength() const override { return wxInputStream::GetLength(); }
+
+    // Must be called before reading anything from the stream.
+    bool SetDictionary(const char *data, size_t datalen);
+    bool SetDictionary(const wxMemoryBuffer &buf);
+
+protected:
+    size_t OnSysRead(void *buffer, size_t size) override;
+    wxFileOffset OnSysTell() const override { return m_pos; }
+
+private:
+    void Init();
+
+    wxPrivate::wxLZ4Decoder* m_decoder;
+    wxFileOffset m_pos;
+
+    wxDECLARE_NO_COPY_CLASS(wxLZ4InputStream);
+};
+
+// ----------------------------------------------------------------------------
+// Filter for compressing data using LZ4 algorithm
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxLZ4OutputStream : public wxFilterOutputStream
+{
+public:
+    explicit wxLZ4OutputStream(wxOutputStream& stream, int level = -1)
+        : wxFilterOutputStream(stream)
+    {
+        Init(level);
+    }
+
+    explicit wxLZ4OutputStream(wxOutputStream* stream, int level = -1)
+        : wxFilterOutputStream(stream)
+    {
+        Init(level);
+    }
+
+    virtual ~wxLZ4OutputStream();
+
+    void Sync() override { DoFlush(false); }
+    bool Close() override;
+    wxFileOffset GetLength() const override { return m_pos; }
+
+    // Must be called before writing anything to the stream.
+    bool SetDictionary(const char *data, size_t datalen);
+    bool SetDictionary(const wxMemoryBuffer &buf);
+
+    static int GetMaxLevel();
+
+protected:
+    size_t OnSysWrite(const void *buffer, size_t size) override;
+    wxFileOffset OnSysTell() const override { return m_pos; }
+
+private:
+    void Init(int level);
+
+    // Write the frame header if it hadn't been written yet.
+    bool BeginFrameIfNecessary();
+
+    // Write the given number of bytes from the internal buffer to the output
+    // stream, after checking the return value of the LZ4 function which
+    // produced them.
+    bool UpdateOutput(size_t rc);
+
+    // Compress all the data after finishing the frame (if argument is true)
+    // or just flushing it, return true on success or false on error.
+    bool DoFlush(bool finish);
+
+    wxPrivate::wxLZ4Encoder* m_encoder;
+    wxFileOffset m_pos;
+
+    wxDECLARE_NO_COPY_CLASS(wxLZ4OutputStream);
+};
+
+// ----------------------------------------------------------------------------
+// Support for creating LZ4 streams from extension/MIME type
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxLZ4ClassFactory: public wxFilterClassFactory
+{
+public:
+    wxLZ4ClassFactory();
+
+    wxFilterInputStream *NewStream(wxInputStream& stream) const override
+        { return new wxLZ4InputStream(stream); }
+    wxFilterOutputStream *NewStream(wxOutputStream& stream) const override
+        { return new wxLZ4OutputStream(stream, -1); }
+    wxFilterInputStream *NewStream(wxInputStream *stream) const override
+        { return new wxLZ4InputStream(stream); }
+    wxFilterOutputStream *NewStream(wxOutputStream *stream) const override
+        { return new wxLZ4OutputStream(stream, -1); }
+
+    const wxChar * const *GetProtocols(wxStreamProtocolType type
+                                       = wxSTREAM_PROTOCOL) const override;
+
+private:
+    wxDECLARE_DYNAMIC_CLASS(wxLZ4ClassFactory);
+};
+
+WXDLLIMPEXP_BASE wxVersionInfo wxGetLibLZ4VersionInfo();
+
+#endif // wxUSE_LIBLZ4 && wxUSE_STREAMS
+
+#endif // _WX_LZ4STREAM_H_
@@ -18,11 +18,15 @@
 
 #if wxUSE_THREADS
 
+#include "wx/event.h"
 #include "wx/stopwatch.h"
 
 #include "wx/beforestd.h"
+#include <atomic>
+#include <new>
 #include <queue>
 #include <utility>
+#include <vector>
 #include "wx/afterstd.h"
 
 enum wxMessageQueueError
@@ -180,6 +184,324 @@ private:
     std::queue<T>   m_messages;
 };
 
+// ---------------------------------------------------------------------------
+// Bounded message queue
+//
+// This class provides the same functionality as wxMessageQueue but has a fixed
+// capacity: posting a message to a full queue blocks until a consumer removes
+// some messages from it, which allows to limit the memory used by the queue
+// when the consumer can't keep up with the producers.
+//
+// The messages are stored in a ring buffer which is accessed without locking
+// from any number of producers and consumers, only waiting for the queue to
+// become non-full or non-empty uses wxSemaphore.
+// ---------------------------------------------------------------------------
+template <typename T>
+class wxBoundedMessageQueue
+{
+public:
+    // The type of the messages transported by this queue
+    typedef T Message;
+
+    // Create a queue able to hold at least the given number of messages: the
+    // capacity is rounded up to the next power of 2.
+    explicit wxBoundedMessageQueue(size_t capacity)
+        : m_capacity(RoundUpToPowerOf2(capacity)),
+          m_cells(m_capacity),
+          m_semFree(static_cast<int>(m_capacity)),
+          m_semUsed(0),
+          m_enqueuePos(0),
+          m_dequeuePos(0),
+          m_notifyHandler(nullptr),
+          m_notifyEventType(wxEVT_NULL),
+          m_notifyId(wxID_ANY),
+          m_notifyPending(false)
+    {
+        for ( size_t n = 0; n < m_capacity; n++ )
+            m_cells[n].sequence.store(n, std::memory_order_relaxed);
+    }
+
+    ~wxBoundedMessageQueue()
+    {
+        // Destroy any messages remaining in the queue: as there can be no
+        // other threads using the queue any more, we don't need to wait for
+        // the cells to become ready here.
+        const size_t end = m_enqueuePos.load();
+        for ( size_t pos = m_dequeuePos.load(); pos != end; pos++ )
+            m_cells[pos & (m_capacity - 1)].GetPtr()->~Message();
+    }
+
+    // Return false only if there was a fatal error in ctor
+    bool IsOk() const
+    {
+        return m_semFree.IsOk() && m_semUsed.IsOk();
+    }
+
+    // Return the maximal number of messages the queue can hold.
+    size_t GetCapacity() const { return m_capacity; }
+
+    // Wake up the event loop when a message is posted to an empty queue by
+    // queuing a wxThreadEvent of the given type to the specified handler: its
+    // event handler should then call ReceiveMany() to process all available
+    // messages. Only one event is queued until the consumer starts receiving
+    // messages, so the event loop is not flooded with them.
+    //
+    // This function must be called before any messages are posted.
+    void SetNotifyHandler(wxEvtHandler* handler,
+                          wxEventType eventType = wxEVT_THREAD,
+                          int id = wxID_ANY)
+    {
+        m_notifyHandler = handler;
+        m_notifyEventType = eventType;
+        m_notifyId = id;
+    }
+
+    // Add a message to the queue, waiting until there is space for it.
+    wxMessageQueueError Post(const Message& msg)
+    {
+        return DoPost(m_semFree.Wait(), msg);
+    }
+
+    wxMessageQueueError Post(Message&& msg)
+    {
+        return DoPost(m_semFree.Wait(), std::move(msg));
+    }
+
+    // Add a message to the queue, waiting no more than the given number of
+    // milliseconds for the space to become available.
+    wxMessageQueueError PostTimeout(long timeout, const Message& msg)
+    {
+        return DoPost(m_semFree.WaitTimeout(timeout), msg);
+    }
+
+    wxMessageQueueError PostTimeout(long timeout, Message&& msg)
+    {
+        return DoPost(m_semFree.WaitTimeout(timeout), std::move(msg));
+    }
+
+    // Add a message to the queue only if it can be done without blocking,
+    // return wxMSGQUEUE_TIMEOUT if the queue is full.
+    wxMessageQueueError TryPost(const Message& msg)
+    {
+        return DoPost(m_semFree.TryWait(), msg);
+    }
+
+    wxMessageQueueError TryPost(Message&& msg)
+    {
+        return DoPost(m_semFree.TryWait(), std::move(msg));
+    }
+
+    // Wait until a message becomes available and remove it from the queue.
+    wxMessageQueueError Receive(Message& msg)
+    {
+        m_notifyPending.store(false);
+
+        return DoReceive(m_semUsed.Wait(), msg);
+    }
+
+    // Same as Receive() but waits for no more than the given number of
+    // milliseconds and returns wxMSGQUEUE_TIMEOUT if no message is available.
+    wxMessageQueueError ReceiveTimeout(long timeout, Message& msg)
+    {
+        m_notifyPending.store(false);
+
+        return DoReceive(m_semUsed.WaitTimeout(timeout), msg);
+    }
+
+    // Append up to maxCount messages to the provided vector and return the
+    // number of appended messages.
+    //
+    // If the queue is empty, wait for at most timeout milliseconds for a
+    // message to become available, or indefinitely if timeout is negative.
+    // After receiving the first message, this function takes all the other
+    // messages available in the queue without waiting any more.
+    size_t ReceiveMany(std::vector<Message>& out,
+                       size_t maxCount,
+                       long timeout = 0)
+    {
+        m_notifyPending.store(false);
+
+        if ( !maxCount )
+            return 0;
+
+        wxSemaError rc;
+        if ( timeout < 0 )
+            rc = m_semUsed.Wait();
+        else if ( timeout == 0 )
+            rc = m_semUsed.TryWait();
+        else
+            rc = m_semUsed.WaitTimeout(timeout);
+
+        if ( rc != wxSEMA_NO_ERROR )
+            return 0;
+
+        size_t count = 0;
+        for ( ;; )
+        {
+            Dequeue([&out](Message&& msg) { out.push_back(std::move(msg)); });
+            count++;
+
+            if ( count == maxCount || m_semUsed.TryWait() != wxSEMA_NO_ERROR )
+                break;
+        }
+
+        // Release all the slots at once.
+        for ( size_t n = 0; n < count; n++ )
+            m_semFree.Post();
+
+        return count;
+    }
+
+private:
+    static size_t RoundUpToPowerOf2(size_t n)
+    {
+        size_t capacity = 2;
+        while ( capacity < n )
+            capacity *= 2;
+
+        return capacity;
+    }
+
+    template <typename U>
+    wxMessageQueueError DoPost(wxSemaError rc, U&& msg)
+    {
+        switch ( rc )
+        {
+            case wxSEMA_NO_ERROR:
+                break;
+
+            case wxSEMA_BUSY:
+            case wxSEMA_TIMEOUT:
+                return wxMSGQUEUE_TIMEOUT;
+
+            default:
+                return wxMSGQUEUE_MISC_ERROR;
+        }
+
+        Enqueue(std::forward<U>(msg));
+
+        m_semUsed.Post();
+
+        if ( m_notifyHandler && !m_notifyPending.exchange(true) )
+        {
+            m_notifyHandler->QueueEvent(new wxThreadEvent(m_notifyEventType,
+                                                          m_notifyId));
+        }
+
+        return wxMSGQUEUE_NO_ERROR;
+    }
+
+    wxMessageQueueError DoReceive(wxSemaError rc, Message& msg)
+    {
+        switch ( rc )
+        {
+            case wxSEMA_NO_ERROR:
+                break;
+
+            case wxSEMA_BUSY:
+            case wxSEMA_TIMEOUT:
+                return wxMSGQUEUE_TIMEOUT;
+
+            default:
+                return wxMSGQUEUE_MISC_ERROR;
+        }
+
+        Dequeue([&msg](Message&& m) { msg = std::move(m); });
+
+        m_semFree.Post();
+
+        return wxMSGQUEUE_NO_ERROR;
+    }
+
+    // The functions below implement the ring buffer itself. They can only be
+    // called after successfully waiting on the corresponding semaphore, so
+    // the queue is guaranteed to have a free slot or a message, but it may
+    // still not be ready yet if another thread which reserved its position
+    // before us hasn't finished using it, in which case we just need to wait
+    // a bit.
+    template <typename U>
+    void Enqueue(U&& msg)
+    {
+        Cell& cell = ReservePosition(m_enqueuePos, 0);
+
+        new (cell.GetPtr()) Message(std::forward<U>(msg));
+
+        cell.sequence.store(cell.reserved + 1, std::memory_order_release);
+    }
+
+    // Remove the next message from the queue and pass it to the given
+    // function taking Message&&.
+    template <typename F>
+    void Dequeue(F consume)
+    {
+        Cell& cell = ReservePosition(m_dequeuePos, 1);
+
+        Message* const ptr = cell.GetPtr();
+        consume(std::move(*ptr));
+        ptr->~Message();
+
+        cell.sequence.store(cell.reserved + m_capacity,
+                            std::memory_order_release);
+    }
+
+    struct Cell
+    {
+        Message* GetPtr() { return reinterpret_cast<Message*>(storage); }
+
+        // The sequence number is equal to the position of this cell when it
+        // is free and to this position plus 1 when it contains a message.
+        std::atomic<size_t> sequence;
+
+        // The position reserved by the thread currently using this cell.
+        size_t reserved;
+
+        alignas(Message) unsigned char storage[sizeof(Message)];
+    };
+
+    // Reserve the next position in the queue, given by the provided counter,
+    // and return the corresponding cell when its sequence number becomes
+    // equal to this position plus the given offset.
+    Cell& ReservePosition(std::atomic<size_t>& counter, size_t offset)
+    {
+        size_t pos = counter.fetch_add(1, std::memory_order_relaxed);
+
+        Cell& cell = m_cells[pos & (m_capacity - 1)];
+        for ( unsigned spin = 0;
+              cell.sequence.load(std::memory_order_acquire) != pos + offset;
+              spin++ )
+        {
+            if ( spin > 100 )
+                wxThread::Yield();
+        }
+
+        cell.reserved = pos;
+
+        return cell;
+    }
+
+    const size_t m_capacity;
+    std::vector<Cell> m_cells;
+
+    // The number of free slots and the number of messages in the queue.
+    wxSemaphore m_semFree,
+                m_semUsed;
+
+    // Positions of the next message to post and to receive.
+    std::atomic<size_t> m_enqueuePos,
+                        m_dequeuePos;
+
+    // Optional handler to notify about new messages.
+    wxEvtHandler* m_notifyHandler;
+    wxEventType m_notifyEventType;
+    int m_notifyId;
+
+    // Set to true after sending the notification event, reset when the
+    // consumer starts receiving messages.
+    std::atomic<bool> m_notifyPending;
+
+    wxDECLARE_NO_COPY_TEMPLATE_CLASS(wxBoundedMessageQueue, T);
+};
+
 #endif // wxUSE_THREADS
 
 #endif // _WX_MSGQUEUE_H_
@@ -0,0 +1,100 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/private/asyncfile.h
+// Purpose:     Backend interface for wxAsyncFile implementation
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_PRIVATE_ASYNCFILE_H_
+#define _WX_PRIVATE_ASYNCFILE_H_
+
+#include "wx/asyncfile.h"
+#include "wx/evtloop.h"
+#include "wx/thread.h"
+
+// io_uring completions are delivered via an event loop source.
+#if defined(wxHAS_IO_URING) && wxUSE_EVENTLOOP_SOURCE
+    #define wxHAS_ASYNC_FILE_IO_URING
+#endif
+
+namespace wxPrivate
+{
+
+// A single read or write operation.
+struct wxAsyncFileRequest
+{
+    long id;
+    bool write;
+    wxFileOffset offset;
+    void *buffer;
+    size_t count;
+};
+
+// Base class for the objects actually performing the I/O.
+class wxAsyncFileImpl
+{
+public:
+    wxAsyncFileImpl(wxAsyncFile& file, int fd)
+        : m_file(file),
+          m_fd(fd),
+          m_cond(m_mutex)
+    {
+        m_pending = 0;
+    }
+
+    virtual ~wxAsyncFileImpl() = default;
+
+    virtual wxAsyncFileBackend GetBackend() const = 0;
+
+    // Start the operation, return false if it couldn't be done.
+    bool Submit(const wxAsyncFileRequest& req);
+
+    // Return true if cancelling the request was started or done, false if the
+    // request is not pending or can't be cancelled any more.
+    virtual bool Cancel(long id) = 0;
+    virtual void CancelAll() = 0;
+
+    // Wait until there are no pending requests.
+    virtual void WaitAll() = 0;
+
+    size_t GetPendingCount() const
+    {
+        wxMutexLocker lock(m_mutex);
+        return m_pending;
+    }
+
+    // Factory functions for the different backends, return null if the
+    // backend is not available.
+    static wxAsyncFileImpl* CreateThreads(wxAsyncFile& file, int fd);
+    static wxAsyncFileImpl* CreateIoUring(wxAsyncFile& file, int fd);
+
+protected:
+    virtual bool DoSubmit(const wxAsyncFileRequest& req) = 0;
+
+    // Queue the completion event for the given request. This may be called
+    // from any thread.
+    void Complete(const wxAsyncFileRequest& req,
+                  size_t count,
+                  unsigned long error,
+                  bool cancelled);
+
+    // Block until the pending count becomes 0, for the backends completing
+    // the requests in other threads.
+    void WaitForCompletions();
+
+    wxAsyncFile& m_file;
+    const int m_fd;
+
+private:
+    mutable wxMutex m_mutex;
+    wxCondition m_cond;
+    size_t m_pending;
+
+    wxDECLARE_NO_COPY_CLASS(wxAsyncFileImpl);
+};
+
+} // namespace wxPrivate
+
+#endif // _WX_PRIVATE_ASYNCFILE_H_
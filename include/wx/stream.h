@@ -18,6 +18,17 @@
 #include "wx/string.h"
 #include "wx/filefn.h"  // for wxFileOffset, wxInvalidOffset and wxSeekMode
 
+// Check if C++20 <span> is available
+#if wxCHECK_CXX_STD(202002L) && wxHAS_CXX17_INCLUDE(<span>)
+    #include "wx/beforestd.h"
+    #include <span>
+    #include "wx/afterstd.h"
+
+    #ifdef __cpp_lib_span
+        #define wxHAS_STD_SPAN
+    #endif
+#endif
+
 class WXDLLIMPEXP_FWD_BASE wxStreamBase;
 class WXDLLIMPEXP_FWD_BASE wxInputStream;
 class WXDLLIMPEXP_FWD_BASE wxOutputStream;
@@ -41,6 +52,20 @@ enum wxStreamError
 
 const int wxEOF = -1;
 
+// Buffers used by the scatter/gather I/O functions, see wxInputStream::ReadV()
+// and wxOutputStream::WriteV().
+struct wxStreamIOVec
+{
+    void *data;
+    size_t size;
+};
+
+struct wxStreamConstIOVec
+{
+    const void *data;
+    size_t size;
+};
+
 // ============================================================================
 // base stream classes: wxInputStream and wxOutputStream
 // ============================================================================
@@ -130,6 +155,21 @@ public:
     // method either reads all the data or returns false.
     bool ReadAll(void *buffer, size_t size);
 
+    // read data into several buffers in turn, filling each of them before
+    // going to the next one and stopping if less data than requested could
+    // be read into one of them
+    //
+    // LastRead() returns the total number of bytes read into all buffers
+    //
+    // the default implementation calls Read() for each buffer, but it's
+    // overridden to read all of them at once by the streams supporting it
+    virtual wxInputStream& ReadV(const wxStreamIOVec *vec, size_t count);
+
+#ifdef wxHAS_STD_SPAN
+    wxInputStream& ReadV(std::span<const wxStreamIOVec> vec)
+        { return ReadV(vec.data(), vec.size()); }
+#endif // wxHAS_STD_SPAN
+
     // copy the entire contents of this stream into streamOut, stopping only
     // when EOF is reached or an error occurs
     wxInputStream& Read(wxOutputStream& streamOut);
@@ -241,6 +281,19 @@ public:
     // less data than requested but still return without error.
     bool WriteAll(const void *buffer, size_t size);
 
+    // Write the data from several buffers in turn, stopping if any of them
+    // couldn't be written completely. LastWrite() returns the total number of
+    // bytes written from all buffers.
+    //
+    // As with ReadV(), the default implementation just calls Write() for each
+    // buffer.
+    virtual wxOutputStream& WriteV(const wxStreamConstIOVec *vec, size_t count);
+
+#ifdef wxHAS_STD_SPAN
+    wxOutputStream& WriteV(std::span<const wxStreamConstIOVec> vec)
+        { return WriteV(vec.data(), vec.size()); }
+#endif // wxHAS_STD_SPAN
+
     wxOutputStream& Write(wxInputStream& stream_in);
 
     virtual wxFileOffset SeekO(wxFileOffset pos, wxSeekMode mode = wxFromStart);
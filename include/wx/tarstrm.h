@@ -89,6 +89,7 @@ public:
     // is accessors
     bool IsDir() const override;
     bool IsReadOnly() const override                     { return !(m_Mode & 0222); }
+    bool IsSparse() const                       { return m_Sparse != nullptr; }
 
     // set accessors
     void SetName(const wxString& name, wxPathFormat format = wxPATH_NATIVE) override;
@@ -139,6 +140,7 @@ private:
     wxString     m_GroupName;
     int          m_DevMajor;
     int          m_DevMinor;
+    class wxTarSparseMap *m_Sparse;
 
     friend class wxTarInputStream;
 
@@ -183,6 +185,11 @@ private:
     wxStreamError ReadHeaders();
     bool ReadExtendedHeader(wxTarHeaderRecords*& recs);
 
+    bool ReadSparseMap(wxTarEntry& entry);
+    bool ReadGnuSparseMap(wxTarSparseMap& map);
+    bool ReadPaxSparseMap(wxTarSparseMap& map, wxFileOffset& datasize);
+    size_t ReadSparse(void *buffer, size_t size);
+
     wxString GetExtendedHeader(const wxString& key) const;
     wxString GetHeaderPath() const;
     wxFileOffset GetHeaderNumber(int id) const;
@@ -192,10 +199,13 @@ private:
     wxFileOffset m_pos;     // position within the current entry
     wxFileOffset m_offset;  // offset to the start of the entry's data
     wxFileOffset m_size;    // size of the current entry's data
+    wxFileOffset m_datapos; // position within the data stored for a sparse
+                            // entry, which doesn't include its holes
 
     int m_sumType;
     int m_tarType;
     class wxTarHeaderBlock *m_hdr;
+    class wxTarSparseMap *m_sparse;
     wxTarHeaderRecords *m_HeaderRecs;
     wxTarHeaderRecords *m_GlobalHeaderRecs;
 
@@ -209,6 +219,9 @@ private:
 class WXDLLIMPEXP_BASE wxTarOutputStream : public wxArchiveOutputStream
 {
 public:
+    // Default size of the buffer used for writing to the parent stream.
+    enum { DEFAULT_BUFFER_SIZE = 64*1024 };
+
     wxTarOutputStream(wxOutputStream& stream,
                       wxTarFormat format = wxTAR_PAX,
                       wxMBConv& conv = wxConvLocal);
@@ -238,6 +251,13 @@ public:
     void SetBlockingFactor(int factor)  { m_BlockingFactor = factor; }
     int GetBlockingFactor() const       { return m_BlockingFactor; }
 
+    void SetBufferSize(size_t size);
+    size_t GetBufferSize() const        { return m_bufSize; }
+
+    // Write to the parent stream from a background thread.
+    bool SetPipelined(bool pipelined = true);
+    bool IsPipelined() const            { return m_pipeline != nullptr; }
+
 protected:
     size_t OnSysWrite(const void *buffer, size_t size) override;
     wxFileOffset OnSysTell() const override      { return m_pos; }
@@ -251,6 +271,12 @@ private:
     bool CopyArchiveMetaData(wxArchiveInputStream& WXUNUSED(s)) override { return true; }
     bool IsOpened() const               { return m_pos != wxInvalidOffset; }
 
+    void AllocBuffer();
+    bool WriteRaw(const void *buffer, size_t size);
+    bool WriteZeros(size_t size);
+    bool WriteBuffer();
+    bool FlushBuffer();
+
     bool WriteHeaders(wxTarEntry& entry);
     bool ModifyHeader();
     wxString PaxHeaderPath(const wxString& format, const wxString& path);
@@ -282,6 +308,11 @@ private:
     wxString m_badfit;
     bool m_endrecWritten;
 
+    char *m_buf;            // buffer holding whole records to write
+    size_t m_bufSize;
+    size_t m_bufLen;
+    class wxTarPipeline *m_pipeline;
+
     wxDECLARE_NO_COPY_CLASS(wxTarOutputStream);
 };
 
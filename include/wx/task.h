@@ -0,0 +1,656 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/task.h
+// Purpose:     wxTask<T> and awaitables for C++20 coroutines
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_TASK_H_
+#define _WX_TASK_H_
+
+#include "wx/defs.h"
+
+// Coroutines are only available when compiling in C++20 mode with a compiler
+// implementing them, this header doesn't define anything otherwise.
+#if wxCHECK_CXX_STD(202002L) && defined(__cpp_impl_coroutine)
+
+#define wxHAS_COROUTINES
+
+#include "wx/app.h"
+#include "wx/event.h"
+
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+// ----------------------------------------------------------------------------
+// wxResumeOnEventLoop: resume a suspended coroutine from the event loop
+// ----------------------------------------------------------------------------
+
+// All the awaitables defined here resume the coroutine by queuing a call to
+// the application object instead of doing it directly from the event handler
+// which completed the operation: this ensures that the coroutine always runs
+// in the main thread and that it can safely destroy the objects whose event
+// handler would otherwise still be executing.
+inline void wxResumeOnEventLoop(std::coroutine_handle<> coro)
+{
+    if ( wxTheApp )
+        wxTheApp->CallAfter([coro]() { coro.resume(); });
+    else
+        coro.resume();
+}
+
+template <typename T> class wxTask;
+
+namespace wxPrivate
+{
+
+// Base class for the promise types used by wxTask<T>, containing everything
+// not depending on the type of the value returned by the coroutine.
+class wxTaskPromiseBase
+{
+public:
+    // Tasks are started eagerly, i.e. the coroutine runs until its first
+    // suspension point as soon as it is called.
+    std::suspend_never initial_suspend() const noexcept { return {}; }
+
+    // On completion, transfer control to the coroutine awaiting this one, if
+    // any, or destroy the coroutine frame if the task had been detached.
+    struct FinalAwaiter
+    {
+        bool await_ready() const noexcept { return false; }
+
+        template <typename Promise>
+        std::coroutine_handle<>
+        await_suspend(std::coroutine_handle<Promise> coro) const noexcept
+        {
+            wxTaskPromiseBase& promise = coro.promise();
+            if ( promise.m_continuation )
+                return promise.m_continuation;
+
+            if ( promise.m_detached )
+            {
+                promise.ReportUnhandledException();
+                coro.destroy();
+            }
+
+            return std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept { }
+    };
+
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+
+    void unhandled_exception()
+    {
+#if wxUSE_EXCEPTIONS
+        m_exception = std::current_exception();
+#else
+        std::terminate();
+#endif
+    }
+
+    void RethrowIfFailed() const
+    {
+#if wxUSE_EXCEPTIONS
+        if ( m_exception )
+            std::rethrow_exception(m_exception);
+#endif
+    }
+
+    void ReportUnhandledException() const noexcept
+    {
+#if wxUSE_EXCEPTIONS
+        // Nobody is going to retrieve the exception from a detached task, so
+        // handle it in the same way as an exception escaping an event handler.
+        if ( !m_exception )
+            return;
+
+        try
+        {
+            std::rethrow_exception(m_exception);
+        }
+        catch ( ... )
+        {
+            if ( wxTheApp )
+                wxTheApp->OnUnhandledException();
+        }
+#endif
+    }
+
+    std::coroutine_handle<> m_continuation;
+#if wxUSE_EXCEPTIONS
+    std::exception_ptr m_exception;
+#endif
+    bool m_detached = false;
+};
+
+template <typename T>
+class wxTaskPromise : public wxTaskPromiseBase
+{
+public:
+    wxTask<T> get_return_object() noexcept;
+
+    template <typename U>
+    void return_value(U&& value)
+    {
+        m_value.emplace(std::forward<U>(value));
+    }
+
+    T TakeResult()
+    {
+        RethrowIfFailed();
+
+        return std::move(*m_value);
+    }
+
+private:
+    std::optional<T> m_value;
+};
+
+template <>
+class wxTaskPromise<void> : public wxTaskPromiseBase
+{
+public:
+    wxTask<void> get_return_object() noexcept;
+
+    void return_void() noexcept { }
+
+    void TakeResult() const
+    {
+        RethrowIfFailed();
+    }
+};
+
+} // namespace wxPrivate
+
+// ----------------------------------------------------------------------------
+// wxTask<T>: result of a coroutine which can be awaited by other coroutines
+// ----------------------------------------------------------------------------
+
+template <typename T = void>
+class wxTask
+{
+public:
+    typedef wxPrivate::wxTaskPromise<T> promise_type;
+    typedef std::coroutine_handle<promise_type> Handle;
+
+    // Default ctor creates an invalid task not associated with any coroutine.
+    wxTask() = default;
+
+    wxTask(wxTask&& other) noexcept
+        : m_coro(std::exchange(other.m_coro, {}))
+    {
+    }
+
+    wxTask& operator=(wxTask&& other) noexcept
+    {
+        if ( this != &other )
+        {
+            Release();
+            m_coro = std::exchange(other.m_coro, {});
+        }
+
+        return *this;
+    }
+
+    // Destroying the task before its completion doesn't cancel it, the
+    // coroutine keeps running and cleans up after itself when it finishes.
+    ~wxTask() { Release(); }
+
+    bool IsOk() const { return static_cast<bool>(m_coro); }
+
+    bool IsDone() const { return m_coro && m_coro.done(); }
+
+    // Let the coroutine run to completion on its own: this is the same as
+    // just destroying this object, but is more explicit.
+    void Detach() { Release(); }
+
+    // Awaiting a task suspends the awaiting coroutine until this task
+    // completes and then returns the value returned by it or rethrows the
+    // exception thrown by it. A task can only be awaited once.
+    class Awaiter
+    {
+    public:
+        explicit Awaiter(Handle coro) noexcept : m_coro(coro) { }
+
+        bool await_ready() const noexcept { return !m_coro || m_coro.done(); }
+
+        void await_suspend(std::coroutine_handle<> continuation) const noexcept
+        {
+            m_coro.promise().m_continuation = continuation;
+        }
+
+        T await_resume() const
+        {
+            // Awaiting a default-constructed or moved-from task is a logic
+            // error, but we can't return anything meaningful from here, so
+            // report it as an exception in the awaiting coroutine.
+            if ( !m_coro )
+            {
+                wxFAIL_MSG( "can't await an invalid task" );
+
+#if wxUSE_EXCEPTIONS
+                throw std::logic_error("awaiting an invalid wxTask");
+#else
+                std::terminate();
+#endif
+            }
+
+            return m_coro.promise().TakeResult();
+        }
+
+    private:
+        const Handle m_coro;
+    };
+
+    Awaiter operator co_await() const noexcept { return Awaiter(m_coro); }
+
+private:
+    friend class wxPrivate::wxTaskPromise<T>;
+
+    explicit wxTask(Handle coro) noexcept : m_coro(coro) { }
+
+    void Release() noexcept
+    {
+        if ( !m_coro )
+            return;
+
+        if ( m_coro.done() )
+            m_coro.destroy();
+        else
+            m_coro.promise().m_detached = true;
+
+        m_coro = {};
+    }
+
+    Handle m_coro;
+};
+
+namespace wxPrivate
+{
+
+template <typename T>
+inline wxTask<T> wxTaskPromise<T>::get_return_object() noexcept
+{
+    return wxTask<T>(wxTask<T>::Handle::from_promise(*this));
+}
+
+inline wxTask<void> wxTaskPromise<void>::get_return_object() noexcept
+{
+    return wxTask<void>(wxTask<void>::Handle::from_promise(*this));
+}
+
+} // namespace wxPrivate
+
+// ----------------------------------------------------------------------------
+// wxEventAwaiter: wait for the next event of the given type
+// ----------------------------------------------------------------------------
+
+// The event is skipped after being received, so that any other handlers for
+// it are still called.
+template <typename Tag>
+class wxEventAwaiter
+{
+public:
+    typedef typename Tag::EventClass EventClass;
+
+    wxEventAwaiter(wxEvtHandler& source, const Tag& eventType, int id = wxID_ANY)
+        : m_source(source),
+          m_eventType(eventType),
+          m_id(id)
+    {
+    }
+
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> coro)
+    {
+        m_coro = coro;
+        m_source.Bind(m_eventType, &wxEventAwaiter::OnEvent, this, m_id);
+    }
+
+    EventClass await_resume() const
+    {
+        return *static_cast<EventClass*>(m_event.get());
+    }
+
+private:
+    void OnEvent(EventClass& event)
+    {
+        event.Skip();
+
+        m_source.Unbind(m_eventType, &wxEventAwaiter::OnEvent, this, m_id);
+        m_event.reset(event.Clone());
+
+        wxResumeOnEventLoop(m_coro);
+    }
+
+    wxEvtHandler& m_source;
+    const Tag m_eventType;
+    const int m_id;
+
+    std::coroutine_handle<> m_coro;
+    std::unique_ptr<wxEvent> m_event;
+
+    wxDECLARE_NO_COPY_TEMPLATE_CLASS(wxEventAwaiter, Tag);
+};
+
+template <typename Tag>
+inline wxEventAwaiter<Tag>
+wxAwaitEvent(wxEvtHandler& source, const Tag& eventType, int id = wxID_ANY)
+{
+    return wxEventAwaiter<Tag>(source, eventType, id);
+}
+
+// ----------------------------------------------------------------------------
+// wxSleepAsync: suspend the coroutine for the given time
+// ----------------------------------------------------------------------------
+
+#if wxUSE_TIMER
+
+#include "wx/timer.h"
+
+class wxTimerAwaiter
+{
+public:
+    explicit wxTimerAwaiter(int milliseconds) : m_milliseconds(milliseconds) { }
+
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> coro)
+    {
+        // Zero or negative delay just yields to the event loop.
+        if ( m_milliseconds <= 0 )
+        {
+            wxResumeOnEventLoop(coro);
+            return;
+        }
+
+        m_coro = coro;
+        m_timer.Bind(wxEVT_TIMER, &wxTimerAwaiter::OnTimer, this);
+        m_timer.StartOnce(m_milliseconds);
+    }
+
+    void await_resume() const noexcept { }
+
+private:
+    void OnTimer(wxTimerEvent& WXUNUSED(event))
+    {
+        wxResumeOnEventLoop(m_coro);
+    }
+
+    const int m_milliseconds;
+    std::coroutine_handle<> m_coro;
+    wxTimer m_timer;
+
+    wxDECLARE_NO_COPY_CLASS(wxTimerAwaiter);
+};
+
+inline wxTimerAwaiter wxSleepAsync(int milliseconds)
+{
+    return wxTimerAwaiter(milliseconds);
+}
+
+#endif // wxUSE_TIMER
+
+// ----------------------------------------------------------------------------
+// wxAsyncProcess: launch a child process and wait for its termination
+// ----------------------------------------------------------------------------
+
+#include "wx/process.h"
+#include "wx/utils.h"
+
+class wxAsyncProcess
+{
+public:
+    // The flags are the same as for wxExecute(), except that wxEXEC_ASYNC is
+    // always added to them, and processFlags are passed to wxProcess ctor.
+    explicit wxAsyncProcess(const wxString& command,
+                            int flags = 0,
+                            int processFlags = wxPROCESS_DEFAULT)
+        : m_process(processFlags),
+          m_command(command),
+          m_flags(flags | wxEXEC_ASYNC)
+    {
+    }
+
+    // Allows to access the process streams if wxPROCESS_REDIRECT is used.
+    wxProcess& GetProcess() { return m_process; }
+
+    // Only valid after the process was launched.
+    long GetPid() const { return m_pid; }
+
+    // Awaiting this object launches the command and resumes the coroutine
+    // with the process exit code once it terminates or -1 if it couldn't be
+    // launched at all.
+    bool await_ready() const noexcept { return false; }
+
+    bool await_suspend(std::coroutine_handle<> coro)
+    {
+        m_coro = coro;
+        m_process.Bind(wxEVT_END_PROCESS, &wxAsyncProcess::OnEndProcess, this);
+
+        m_pid = wxExecute(m_command, m_flags, &m_process);
+        if ( !m_pid )
+        {
+            m_process.Unbind(wxEVT_END_PROCESS,
+                             &wxAsyncProcess::OnEndProcess, this);
+            return false;
+        }
+
+        return true;
+    }
+
+    int await_resume() const noexcept { return m_exitCode; }
+
+private:
+    void OnEndProcess(wxProcessEvent& event)
+    {
+        // Don't skip the event: this prevents wxProcess from deleting itself.
+        m_exitCode = event.GetExitCode();
+
+        m_process.Unbind(wxEVT_END_PROCESS, &wxAsyncProcess::OnEndProcess, this);
+
+        wxResumeOnEventLoop(m_coro);
+    }
+
+    wxProcess m_process;
+    const wxString m_command;
+    const int m_flags;
+
+    long m_pid = 0;
+    int m_exitCode = -1;
+    std::coroutine_handle<> m_coro;
+
+    wxDECLARE_NO_COPY_CLASS(wxAsyncProcess);
+};
+
+// ----------------------------------------------------------------------------
+// wxAsyncConnect: connect a socket without blocking
+// ----------------------------------------------------------------------------
+
+#if wxUSE_SOCKETS
+
+#include "wx/socket.h"
+
+class wxSocketConnectAwaiter
+{
+public:
+    wxSocketConnectAwaiter(wxSocketClient& socket,
+                           wxEvtHandler& handler,
+                           const wxSockAddress& addr)
+        : m_socket(socket),
+          m_handler(handler),
+          m_addr(addr)
+    {
+    }
+
+    bool await_ready() const noexcept { return false; }
+
+    bool await_suspend(std::coroutine_handle<> coro)
+    {
+        m_coro = coro;
+
+        m_handler.Bind(wxEVT_SOCKET, &wxSocketConnectAwaiter::OnSocket, this);
+        m_socket.SetEventHandler(m_handler);
+        m_socket.SetNotify(wxSOCKET_CONNECTION_FLAG | wxSOCKET_LOST_FLAG);
+        m_socket.Notify(true);
+
+        if ( m_socket.Connect(m_addr, false) )
+        {
+            m_connected = true;
+        }
+        else if ( m_socket.LastError() == wxSOCKET_WOULDBLOCK )
+        {
+            // Connection is in progress, wait for its outcome.
+            return true;
+        }
+
+        m_handler.Unbind(wxEVT_SOCKET, &wxSocketConnectAwaiter::OnSocket, this);
+
+        return false;
+    }
+
+    bool await_resume() const noexcept { return m_connected; }
+
+private:
+    void OnSocket(wxSocketEvent& event)
+    {
+        if ( event.GetSocket() != &m_socket )
+        {
+            event.Skip();
+            return;
+        }
+
+        switch ( event.GetSocketEvent() )
+        {
+            case wxSOCKET_CONNECTION:
+                m_connected = true;
+                break;
+
+            case wxSOCKET_LOST:
+                m_connected = false;
+                break;
+
+            default:
+                event.Skip();
+                return;
+        }
+
+        m_handler.Unbind(wxEVT_SOCKET, &wxSocketConnectAwaiter::OnSocket, this);
+
+        wxResumeOnEventLoop(m_coro);
+    }
+
+    wxSocketClient& m_socket;
+    wxEvtHandler& m_handler;
+    const wxSockAddress& m_addr;
+
+    bool m_connected = false;
+    std::coroutine_handle<> m_coro;
+
+    wxDECLARE_NO_COPY_CLASS(wxSocketConnectAwaiter);
+};
+
+// The handler is associated with the socket and remains so after the
+// connection is established, so it must outlive the socket.
+inline wxSocketConnectAwaiter
+wxAsyncConnect(wxSocketClient& socket,
+               wxEvtHandler& handler,
+               const wxSockAddress& addr)
+{
+    return wxSocketConnectAwaiter(socket, handler, addr);
+}
+
+#endif // wxUSE_SOCKETS
+
+// ----------------------------------------------------------------------------
+// wxAsyncWebRequest: perform a wxWebRequest and wait for its completion
+// ----------------------------------------------------------------------------
+
+#if wxUSE_WEBREQUEST
+
+#include "wx/webrequest.h"
+
+class wxAsyncWebRequest
+{
+public:
+    wxAsyncWebRequest(wxWebSession& session,
+                      const wxString& url,
+                      int id = wxID_ANY)
+        : m_request(session.CreateRequest(&m_handler, url, id))
+    {
+    }
+
+    // Use this to configure the request before awaiting it and to access its
+    // response after it completes.
+    wxWebRequest& GetRequest() { return m_request; }
+    wxWebRequest* operator->() { return &m_request; }
+
+    // Awaiting this object starts the request, if it hadn't been started
+    // yet, and resumes the coroutine when it reaches one of the final states
+    // or State_Unauthorized. In the latter case, the request may be awaited
+    // again after providing the credentials.
+    bool await_ready() const noexcept { return !m_request.IsOk(); }
+
+    void await_suspend(std::coroutine_handle<> coro)
+    {
+        m_coro = coro;
+        m_handler.Bind(wxEVT_WEBREQUEST_STATE,
+                       &wxAsyncWebRequest::OnState, this);
+
+        if ( m_request.GetState() == wxWebRequest::State_Idle )
+            m_request.Start();
+    }
+
+    wxWebRequest::State await_resume() const noexcept
+    {
+        return m_request.IsOk() ? m_state : wxWebRequest::State_Failed;
+    }
+
+private:
+    void OnState(wxWebRequestEvent& event)
+    {
+        m_state = event.GetState();
+        switch ( m_state )
+        {
+            case wxWebRequest::State_Idle:
+            case wxWebRequest::State_Active:
+                return;
+
+            case wxWebRequest::State_Unauthorized:
+            case wxWebRequest::State_Completed:
+            case wxWebRequest::State_Failed:
+            case wxWebRequest::State_Cancelled:
+                break;
+        }
+
+        m_handler.Unbind(wxEVT_WEBREQUEST_STATE,
+                         &wxAsyncWebRequest::OnState, this);
+
+        wxResumeOnEventLoop(m_coro);
+    }
+
+    // Note that the handler must be declared before the request as it's used
+    // when initializing it.
+    wxEvtHandler m_handler;
+    wxWebRequest m_request;
+
+    wxWebRequest::State m_state = wxWebRequest::State_Idle;
+    std::coroutine_handle<> m_coro;
+
+    wxDECLARE_NO_COPY_CLASS(wxAsyncWebRequest);
+};
+
+#endif // wxUSE_WEBREQUEST
+
+#endif // C++20 with coroutines
+
+#endif // _WX_TASK_H_
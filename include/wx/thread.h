@@ -114,6 +114,7 @@ enum wxMutexType
 class WXDLLIMPEXP_FWD_BASE wxThreadHelper;
 class WXDLLIMPEXP_FWD_BASE wxConditionInternal;
 class WXDLLIMPEXP_FWD_BASE wxMutexInternal;
+class WXDLLIMPEXP_FWD_BASE wxRWLockInternal;
 class WXDLLIMPEXP_FWD_BASE wxSemaphoreInternal;
 class WXDLLIMPEXP_FWD_BASE wxThreadInternal;
 
@@ -420,6 +421,94 @@ private:
     wxDECLARE_NO_COPY_CLASS(wxSemaphore);
 };
 
+// ----------------------------------------------------------------------------
+// wxRWLock: a lock which can be held by any number of readers or by a single
+//           writer
+// ----------------------------------------------------------------------------
+
+// you should consider wxRWLockReadLocker and wxRWLockWriteLocker whenever
+// possible instead of directly working with wxRWLock class - it is safer
+class WXDLLIMPEXP_BASE wxRWLock
+{
+public:
+    wxRWLock();
+
+    // dtor is not virtual, don't use this class polymorphically
+    ~wxRWLock();
+
+    // return true if the lock has been created successfully
+    bool IsOk() const;
+
+    // Acquire the lock for reading, blocking while it is held by a writer.
+    // Read locks are not recursive: acquiring the lock for reading again in
+    // the same thread may deadlock if a writer is waiting for it.
+    wxMutexError LockRead();
+
+    // Same as LockRead() but returns wxMUTEX_BUSY immediately if the lock is
+    // currently held by a writer
+    wxMutexError TryLockRead();
+
+    // Release the read lock previously acquired by this thread
+    wxMutexError UnlockRead();
+
+    // Acquire the lock for writing, blocking while it is held by anybody else
+    wxMutexError LockWrite();
+
+    // Same as LockWrite() but returns wxMUTEX_BUSY immediately if the lock is
+    // currently held
+    wxMutexError TryLockWrite();
+
+    // Release the write lock previously acquired by this thread
+    wxMutexError UnlockWrite();
+
+private:
+    wxRWLockInternal *m_internal;
+
+    wxDECLARE_NO_COPY_CLASS(wxRWLock);
+};
+
+// helpers acquiring the lock for reading or writing in their ctor and
+// releasing it in their dtor
+class WXDLLIMPEXP_BASE wxRWLockReadLocker
+{
+public:
+    explicit wxRWLockReadLocker(wxRWLock& lock)
+        : m_lock(lock)
+        { m_isOk = m_lock.LockRead() == wxMUTEX_NO_ERROR; }
+
+    bool IsOk() const
+        { return m_isOk; }
+
+    ~wxRWLockReadLocker()
+        { if ( IsOk() ) m_lock.UnlockRead(); }
+
+private:
+    wxRWLock& m_lock;
+    bool      m_isOk;
+
+    wxDECLARE_NO_COPY_CLASS(wxRWLockReadLocker);
+};
+
+class WXDLLIMPEXP_BASE wxRWLockWriteLocker
+{
+public:
+    explicit wxRWLockWriteLocker(wxRWLock& lock)
+        : m_lock(lock)
+        { m_isOk = m_lock.LockWrite() == wxMUTEX_NO_ERROR; }
+
+    bool IsOk() const
+        { return m_isOk; }
+
+    ~wxRWLockWriteLocker()
+        { if ( IsOk() ) m_lock.UnlockWrite(); }
+
+private:
+    wxRWLock& m_lock;
+    bool      m_isOk;
+
+    wxDECLARE_NO_COPY_CLASS(wxRWLockWriteLocker);
+};
+
 // ----------------------------------------------------------------------------
 // wxThread: class encapsulating a thread of execution
 // ----------------------------------------------------------------------------
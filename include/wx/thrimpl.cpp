@@ -336,6 +336,78 @@ wxSemaError wxSemaphore::Post()
     return m_internal->Post();
 }
 
+// --------------------------------------------------------------------------
+// wxRWLock
+// --------------------------------------------------------------------------
+
+wxRWLock::wxRWLock()
+{
+    m_internal = new wxRWLockInternal();
+    if ( !m_internal->IsOk() )
+    {
+        delete m_internal;
+        m_internal = nullptr;
+    }
+}
+
+wxRWLock::~wxRWLock()
+{
+    delete m_internal;
+}
+
+bool wxRWLock::IsOk() const
+{
+    return m_internal != nullptr;
+}
+
+wxMutexError wxRWLock::LockRead()
+{
+    wxCHECK_MSG( m_internal, wxMUTEX_INVALID,
+                 wxT("wxRWLock::LockRead(): not initialized") );
+
+    return m_internal->LockRead();
+}
+
+wxMutexError wxRWLock::TryLockRead()
+{
+    wxCHECK_MSG( m_internal, wxMUTEX_INVALID,
+                 wxT("wxRWLock::TryLockRead(): not initialized") );
+
+    return m_internal->TryLockRead();
+}
+
+wxMutexError wxRWLock::UnlockRead()
+{
+    wxCHECK_MSG( m_internal, wxMUTEX_INVALID,
+                 wxT("wxRWLock::UnlockRead(): not initialized") );
+
+    return m_internal->UnlockRead();
+}
+
+wxMutexError wxRWLock::LockWrite()
+{
+    wxCHECK_MSG( m_internal, wxMUTEX_INVALID,
+                 wxT("wxRWLock::LockWrite(): not initialized") );
+
+    return m_internal->LockWrite();
+}
+
+wxMutexError wxRWLock::TryLockWrite()
+{
+    wxCHECK_MSG( m_internal, wxMUTEX_INVALID,
+                 wxT("wxRWLock::TryLockWrite(): not initialized") );
+
+    return m_internal->TryLockWrite();
+}
+
+wxMutexError wxRWLock::UnlockWrite()
+{
+    wxCHECK_MSG( m_internal, wxMUTEX_INVALID,
+                 wxT("wxRWLock::UnlockWrite(): not initialized") );
+
+    return m_internal->UnlockWrite();
+}
+
 // ----------------------------------------------------------------------------
 // wxThread
 // ----------------------------------------------------------------------------
@@ -13,6 +13,12 @@
 #include "wx/unix/pipe.h"
 #include "wx/evtloopsrc.h"
 
+// Under Linux we use eventfd() instead of a real pipe: it needs only a single
+// file descriptor and writing to it never blocks nor requires copying data.
+#ifdef __LINUX__
+    #define wxHAS_EVENTFD
+#endif
+
 // ----------------------------------------------------------------------------
 // wxWakeUpPipe: allows to wake up the event loop by writing to it
 // ----------------------------------------------------------------------------
@@ -29,6 +35,10 @@ public:
     // returned by GetReadFd(), to the code blocking on input.
     wxWakeUpPipe();
 
+#ifdef wxHAS_EVENTFD
+    virtual ~wxWakeUpPipe();
+#endif
+
     // Wake up the blocking operation involving this pipe.
     //
     // It simply writes to the write end of the pipe.
@@ -40,7 +50,11 @@ public:
     // Same as WakeUp() but without locking.
 
     // Return the read end of the pipe.
+#ifdef wxHAS_EVENTFD
+    int GetReadFd() { return m_eventFd; }
+#else
     int GetReadFd() { return m_pipe[wxPipe::Read]; }
+#endif
 
 
     // Implement wxEventLoopSourceHandler pure virtual methods
@@ -49,7 +63,12 @@ public:
     virtual void OnExceptionWaiting() override { }
 
 private:
+#ifdef wxHAS_EVENTFD
+    // The descriptor used for both reading and writing.
+    int m_eventFd;
+#else
     wxPipe m_pipe;
+#endif
 
     // This flag is set to true after writing to the pipe and reset to false
     // after reading from it in the main thread. Having it allows us to avoid
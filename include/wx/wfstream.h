@@ -42,6 +42,9 @@ public:
 
     wxFile* GetFile() const { return m_file; }
 
+    virtual wxInputStream& ReadV(const wxStreamIOVec *vec, size_t count) override;
+    using wxInputStream::ReadV;
+
 protected:
     wxFileInputStream();
 
@@ -74,6 +77,9 @@ public:
 
     wxFile* GetFile() const { return m_file; }
 
+    virtual wxOutputStream& WriteV(const wxStreamConstIOVec *vec, size_t count) override;
+    using wxOutputStream::WriteV;
+
 protected:
     wxFileOutputStream();
 
@@ -174,6 +180,66 @@ private:
     wxDECLARE_NO_COPY_CLASS(wxFileStream);
 };
 
+// ----------------------------------------------------------------------------
+// wxMappedFileInputStream: read-only stream over a memory-mapped file
+// ----------------------------------------------------------------------------
+
+// Hint about how the mapped file is going to be accessed.
+enum wxMappedFileAccess
+{
+    wxMAPPED_ACCESS_NORMAL,
+    wxMAPPED_ACCESS_SEQUENTIAL,
+    wxMAPPED_ACCESS_RANDOM
+};
+
+class WXDLLIMPEXP_BASE wxMappedFileInputStream : public wxInputStream
+{
+public:
+    explicit wxMappedFileInputStream(const wxString& fileName,
+                                     wxMappedFileAccess access
+                                        = wxMAPPED_ACCESS_SEQUENTIAL);
+    virtual ~wxMappedFileInputStream();
+
+    virtual wxFileOffset GetLength() const override { return m_size; }
+    virtual bool IsSeekable() const override { return true; }
+    virtual bool CanRead() const override;
+    virtual char Peek() override;
+
+    // Access to the entire file contents, valid as long as the stream exists.
+    const void* GetData() const { return m_data; }
+    size_t GetDataLen() const { return m_size; }
+
+    // Return the pointer to the data at the current position and the number
+    // of bytes available there, without consuming them.
+    const void* PeekData(size_t* len) const;
+
+    // Consume the given number of bytes without copying them anywhere and
+    // return the number of bytes actually skipped.
+    size_t Skip(size_t len);
+
+    // Change the access hint, return false if it's not supported.
+    bool SetAccessHint(wxMappedFileAccess access);
+
+    // Return true if the file is really mapped and not just read in memory.
+    bool IsMapped() const { return m_mapped; }
+
+protected:
+    virtual size_t OnSysRead(void *buffer, size_t size) override;
+    virtual wxFileOffset OnSysSeek(wxFileOffset pos, wxSeekMode mode) override;
+    virtual wxFileOffset OnSysTell() const override { return m_pos; }
+
+private:
+    // Try to map the file into memory, return false if it couldn't be done.
+    bool DoMap(wxFile& file);
+
+    const char* m_data;
+    size_t m_size;
+    size_t m_pos;
+    bool m_mapped;
+
+    wxDECLARE_NO_COPY_CLASS(wxMappedFileInputStream);
+};
+
 #endif //wxUSE_FILE
 
 #if wxUSE_FFILE
@@ -16,6 +16,7 @@
 #include "wx/archive.h"
 #include "wx/filename.h"
 
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -393,6 +394,12 @@ public:
 
     wxZipEntry *GetNextEntry();
 
+    // For seekable streams only: position of the central directory record of
+    // the entry returned by the next GetNextEntry() call and reading the entry
+    // from the record at the given position.
+    wxFileOffset WXZIPFIX GetCentralPosition();
+    wxZipEntry * WXZIPFIX GetEntryAt(wxFileOffset pos);
+
     wxString WXZIPFIX GetComment();
     int WXZIPFIX GetTotalEntries();
 
@@ -514,6 +521,87 @@ private:
 };
 
 
+/////////////////////////////////////////////////////////////////////////////
+// wxZipParallelReader
+//
+// Reads the central directory of a zip file once and then inflates its
+// entries concurrently, each worker thread using its own file handle.
+
+class WXDLLIMPEXP_BASE wxZipParallelReader
+{
+public:
+    // Called for each entry with the stream positioned at its data, must
+    // return false to stop reading the remaining entries. It is called from
+    // several threads at once, so it must be thread-safe.
+    typedef std::function<bool (const wxZipEntry& entry,
+                                wxInputStream& stream)> EntryFunc;
+
+    wxZipParallelReader(const wxString& filename,
+                        wxMBConv& conv = wxConvLocal);
+
+    bool IsOk() const { return m_ok; }
+
+    size_t GetEntryCount() const { return m_entries.size(); }
+    const wxZipEntry& GetEntry(size_t n) const { return *m_entries[n]; }
+
+    // Use 0 threads to use as many of them as there are CPUs.
+    bool ReadEntries(const EntryFunc& func, unsigned numThreads = 0);
+    bool ExtractTo(const wxString& dir, unsigned numThreads = 0);
+
+private:
+    typedef std::function<bool (size_t n, wxInputStream& stream)> IndexFunc;
+
+    bool DoReadEntries(const IndexFunc& func, unsigned numThreads);
+
+    wxString m_filename;
+    wxMBConv& m_conv;
+    std::vector<std::unique_ptr<wxZipEntry>> m_entries;
+    bool m_ok;
+
+    wxDECLARE_NO_COPY_CLASS(wxZipParallelReader);
+};
+
+
+/////////////////////////////////////////////////////////////////////////////
+// wxZipParallelWriter
+//
+// Deflates the added entries concurrently into temporary memory buffers and
+// then copies them, in the order in which they were added, to the output.
+
+class WXDLLIMPEXP_BASE wxZipParallelWriter
+{
+public:
+    // Called to write the data of an entry, must return false on error. It is
+    // called from several threads at once, so it must be thread-safe.
+    typedef std::function<bool (wxOutputStream& stream)> DataFunc;
+
+    explicit wxZipParallelWriter(wxZipOutputStream& zip) : m_zip(zip) { }
+
+    // Takes ownership of the entry, func may be empty for directories.
+    void AddEntry(wxZipEntry *entry, const DataFunc& func = DataFunc());
+    bool AddFile(const wxString& filename, const wxString& name);
+
+    size_t GetEntryCount() const { return m_jobs.size(); }
+
+    // Use 0 threads to use as many of them as there are CPUs.
+    bool Write(unsigned numThreads = 0);
+
+private:
+    struct Job
+    {
+        std::unique_ptr<wxZipEntry> entry;
+        DataFunc func;
+    };
+
+    bool DoWriteSequentially();
+
+    wxZipOutputStream& m_zip;
+    std::vector<Job> m_jobs;
+
+    wxDECLARE_NO_COPY_CLASS(wxZipParallelWriter);
+};
+
+
 /////////////////////////////////////////////////////////////////////////////
 // wxZipEntry inlines
 
@@ -0,0 +1,152 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/zstdstream.h
+// Purpose:     Filters streams using Zstandard compression
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_ZSTDSTREAM_H_
+#define _WX_ZSTDSTREAM_H_
+
+#include "wx/defs.h"
+
+#if wxUSE_LIBZSTD && wxUSE_STREAMS
+
+#include "wx/stream.h"
+#include "wx/buffer.h"
+#include "wx/versioninfo.h"
+
+namespace wxPrivate
+{
+
+// Private wrappers for ZSTD_DCtx and ZSTD_CCtx.
+struct wxZstdDecoder;
+struct wxZstdEncoder;
+
+} // namespace wxPrivate
+
+// ----------------------------------------------------------------------------
+// Filter for decompressing data compressed using Zstandard
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxZstdInputStream : public wxFilterInputStream
+{
+public:
+    explicit wxZstdInputStream(wxInputStream& stream)
+        : wxFilterInputStream(stream)
+    {
+        Init();
+    }
+
+    explicit wxZstdInputStream(wxInputStream* stream)
+        : wxFilterInputStream(stream)
+    {
+        Init();
+    }
+
+    virtual ~wxZstdInputStream();
+
+    char Peek() override { return wxInputStream::Peek(); }
+    wxFileOffset GetLength() const override { return wxInputStream::GetLength(); }
+
+    // Must be called before reading anything from the stream.
+    bool SetDictionary(const char *data, size_t datalen);
+    bool SetDictionary(const wxMemoryBuffer &buf);
+
+protected:
+    size_t OnSysRead(void *buffer, size_t size) override;
+    wxFileOffset OnSysTell() const override { return m_pos; }
+
+private:
+    void Init();
+
+    wxPrivate::wxZstdDecoder* m_decoder;
+    wxFileOffset m_pos;
+
+    wxDECLARE_NO_COPY_CLASS(wxZstdInputStream);
+};
+
+// ----------------------------------------------------------------------------
+// Filter for compressing data using Zstandard algorithm
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxZstdOutputStream : public wxFilterOutputStream
+{
+public:
+    explicit wxZstdOutputStream(wxOutputStream& stream, int level = -1)
+        : wxFilterOutputStream(stream)
+    {
+        Init(level);
+    }
+
+    explicit wxZstdOutputStream(wxOutputStream* stream, int level = -1)
+        : wxFilterOutputStream(stream)
+    {
+        Init(level);
+    }
+
+    virtual ~wxZstdOutputStream();
+
+    void Sync() override { DoFlush(false); }
+    bool Close() override;
+    wxFileOffset GetLength() const override { return m_pos; }
+
+    // These functions must be called before writing anything to the stream.
+    bool SetDictionary(const char *data, size_t datalen);
+    bool SetDictionary(const wxMemoryBuffer &buf);
+    bool SetThreadCount(unsigned numThreads);
+
+    static int GetMaxLevel();
+
+protected:
+    size_t OnSysWrite(const void *buffer, size_t size) override;
+    wxFileOffset OnSysTell() const override { return m_pos; }
+
+private:
+    void Init(int level);
+
+    // Write the contents of the internal buffer to the output stream.
+    bool UpdateOutput();
+
+    // Compress all the data after finishing the frame (if argument is true)
+    // or just flushing it, return true on success or false on error.
+    bool DoFlush(bool finish);
+
+    wxPrivate::wxZstdEncoder* m_encoder;
+    wxFileOffset m_pos;
+
+    wxDECLARE_NO_COPY_CLASS(wxZstdOutputStream);
+};
+
+// ----------------------------------------------------------------------------
+// Support for creating Zstandard streams from extension/MIME type
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxZstdClassFactory: public wxFilterClassFactory
+{
+public:
+    wxZstdClassFactory();
+
+    wxFilterInputStream *NewStream(wxInputStream& stream) const override
+        { return new wxZstdInputStream(stream); }
+    wxFilterOutputStream *NewStream(wxOutputStream& stream) const override
+        { return new wxZstdOutputStream(stream, -1); }
+    wxFilterInputStream *NewStream(wxInputStream *stream) const override
+        { return new wxZstdInputStream(stream); }
+    wxFilterOutputStream *NewStream(wxOutputStream *stream) const override
+        { return new wxZstdOutputStream(stream, -1); }
+
+    const wxChar * const *GetProtocols(wxStreamProtocolType type
+                                       = wxSTREAM_PROTOCOL) const override;
+
+private:
+    wxDECLARE_DYNAMIC_CLASS(wxZstdClassFactory);
+};
+
+WXDLLIMPEXP_BASE wxVersionInfo wxGetLibZstdVersionInfo();
+
+#endif // wxUSE_LIBZSTD && wxUSE_STREAMS
+
+#endif // _WX_ZSTDSTREAM_H_
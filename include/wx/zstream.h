@@ -63,6 +63,86 @@ class WXDLLIMPEXP_BASE wxZlibInputStream: public wxFilterInputStream {
   wxDECLARE_NO_COPY_CLASS(wxZlibInputStream);
 };
 
+namespace wxPrivate
+{
+
+// Decompression state and the index of checkpoints.
+struct wxGzipIndexData;
+
+} // namespace wxPrivate
+
+// Input stream allowing to seek to arbitrary positions in the uncompressed
+// data by using the index of the checkpoints created while decompressing it.
+class WXDLLIMPEXP_BASE wxIndexedGzipInputStream : public wxFilterInputStream
+{
+public:
+    // Default distance between the checkpoints in the uncompressed data.
+    enum { DEFAULT_SPAN = 1024*1024 };
+
+    wxIndexedGzipInputStream(wxInputStream& stream,
+                             int flags = wxZLIB_AUTO,
+                             size_t span = DEFAULT_SPAN);
+    wxIndexedGzipInputStream(wxInputStream *stream,
+                             int flags = wxZLIB_AUTO,
+                             size_t span = DEFAULT_SPAN);
+    virtual ~wxIndexedGzipInputStream();
+
+    char Peek() override { return wxInputStream::Peek(); }
+    wxFileOffset GetLength() const override;
+    bool IsSeekable() const override;
+
+    // Decompress all the remaining data to complete the index.
+    bool BuildIndex();
+    bool IsIndexComplete() const;
+    size_t GetCheckpointCount() const;
+
+    bool SaveIndex(wxOutputStream& stream) const;
+    bool LoadIndex(wxInputStream& stream);
+
+#if wxUSE_FILE
+    bool SaveIndex(const wxString& filename) const;
+    bool LoadIndex(const wxString& filename);
+#endif // wxUSE_FILE
+
+    // Return the name of the index file to use for the given compressed file.
+    static wxString GetIndexFileName(const wxString& filename);
+
+protected:
+    size_t OnSysRead(void *buffer, size_t size) override;
+    wxFileOffset OnSysSeek(wxFileOffset pos, wxSeekMode mode) override;
+    wxFileOffset OnSysTell() const override { return m_pos; }
+
+private:
+    void Init(int flags, size_t span);
+
+    // Read or, if buffer is null, skip the given amount of data.
+    size_t DoRead(void *buffer, size_t size);
+
+    // Decompress more data into the window, return false on error or EOF.
+    bool Decompress();
+
+    // Called when the end of the compressed stream is reached.
+    bool OnStreamEnd();
+
+    // Ensure that there is some input data available, return false if not.
+    bool FillInput();
+
+    // Remember the current decompression state as a checkpoint.
+    void AddCheckpoint();
+
+    // Restart decompression from the given checkpoint or from the start of the
+    // stream if n is -1.
+    bool RestoreCheckpoint(int n);
+
+    // Decompress everything until the end to complete the index.
+    bool DoBuildIndex();
+
+    wxPrivate::wxGzipIndexData* m_data;
+    wxFileOffset m_pos;
+
+    wxDECLARE_NO_COPY_CLASS(wxIndexedGzipInputStream);
+};
+
 class WXDLLIMPEXP_BASE wxZlibOutputStream: public wxFilterOutputStream {
  public:
   wxZlibOutputStream(wxOutputStream& stream, int level = -1, int flags = wxZLIB_ZLIB);
@@ -0,0 +1,288 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        wx/asyncfile.h
+// Purpose:     interface of wxAsyncFile and wxAsyncFileEvent
+// Author:      wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+    Mechanisms which can be used by wxAsyncFile for performing the I/O.
+
+    @since 3.3.1
+ */
+enum wxAsyncFileBackend
+{
+    /**
+        Use the most efficient mechanism available.
+
+        This is io_uring under Linux if it is supported by the kernel and
+        allowed by the security policy, and the threads otherwise.
+     */
+    wxASYNC_FILE_BACKEND_DEFAULT,
+
+    /// Perform blocking I/O in a pool of background threads.
+    wxASYNC_FILE_BACKEND_THREADS,
+
+    /**
+        Use Linux io_uring interface.
+
+        Opening the file fails if io_uring can't be used.
+     */
+    wxASYNC_FILE_BACKEND_IO_URING
+};
+
+/**
+    @class wxAsyncFile
+
+    File allowing to read and write its data asynchronously, i.e. without
+    blocking the calling thread.
+
+    The operations started by ReadAt() and WriteAt() are performed in the
+    background and, when each of them completes, a wxAsyncFileEvent is sent
+    to this object. These events are processed by the event loop of the
+    thread that created the file, so no special synchronization is needed to
+    use the data read from the file in their handlers, e.g.
+    @code
+    m_file.Bind(wxEVT_ASYNC_FILE_READ, &MyFrame::OnChunkRead, this);
+    if ( m_file.Open(path) )
+        m_file.ReadAt(0, m_buffer, CHUNK_SIZE);
+
+    ...
+
+    void MyFrame::OnChunkRead(wxAsyncFileEvent& event)
+    {
+        if ( !event.IsOk() )
+        {
+            wxLogError("Reading failed: %s",
+                       wxSysErrorMsgStr(event.GetErrorCode()));
+            return;
+        }
+
+        AppendText(m_buffer, event.GetCount());
+
+        // Continue with the next chunk if we haven't reached the end yet.
+        if ( event.GetCount() == CHUNK_SIZE )
+            m_file.ReadAt(event.GetOffset() + CHUNK_SIZE, m_buffer, CHUNK_SIZE);
+    }
+    @endcode
+
+    Under Linux, io_uring is used if available: the operations are submitted
+    to the kernel directly and their completion is signalled via a file
+    descriptor monitored by the event loop, so that no threads are used at
+    all. Everywhere else, and if io_uring can't be used, the operations are
+    executed by a pool of threads shared by all wxAsyncFile objects. Use
+    GetBackend() to find out which mechanism is actually used.
+
+    Any number of operations may be pending at the same time, and they may
+    complete in any order. Notice that each of them is independent of all
+    the others, so the file contents is undefined if the overlapping areas
+    of the file are written by several pending operations.
+
+    The file object must be used from the thread which runs the event loop
+    delivering its events, usually the main one.
+
+    @beginEventEmissionTable{wxAsyncFileEvent}
+    @event{EVT_ASYNC_FILE_READ(id, func)}
+        Process a @c wxEVT_ASYNC_FILE_READ event, sent when an operation
+        started by ReadAt() completes.
+    @event{EVT_ASYNC_FILE_WRITE(id, func)}
+        Process a @c wxEVT_ASYNC_FILE_WRITE event, sent when an operation
+        started by WriteAt() completes.
+    @endEventTable
+
+    @library{wxbase}
+    @category{file}
+
+    @since 3.3.1
+
+    @see wxFile
+ */
+class wxAsyncFile : public wxEvtHandler
+{
+public:
+    /**
+        Constructor.
+
+        @param parent
+            If not @NULL, the events not processed by this object itself are
+            passed to this handler, just as for wxProcess.
+        @param id
+            The identifier used for the events sent by this object.
+     */
+    explicit wxAsyncFile(wxEvtHandler* parent = nullptr, int id = wxID_ANY);
+
+    /**
+        Destructor closes the file.
+
+        Notice that it waits for all pending operations to complete, see
+        Close().
+     */
+    virtual ~wxAsyncFile();
+
+    /**
+        Opens the file.
+
+        The parameters are the same as for wxFile::Open(), except for the
+        last one, which allows to choose the mechanism used for performing
+        the I/O and which should usually be left at its default value.
+
+        Returns @true on success or @false if the file couldn't be opened,
+        in which case an error message is logged.
+     */
+    bool Open(const wxString& filename,
+              wxFile::OpenMode mode = wxFile::read,
+              int access = wxS_DEFAULT,
+              wxAsyncFileBackend backend = wxASYNC_FILE_BACKEND_DEFAULT);
+
+    /**
+        Closes the file.
+
+        This cancels all pending operations and waits until they complete
+        before closing the file, so it may block if some of them can't be
+        cancelled. The events are still sent for all these operations.
+
+        Does nothing if the file is not opened.
+     */
+    bool Close();
+
+    /// Returns @true if the file is opened.
+    bool IsOpened() const;
+
+    /// Returns the current length of the file.
+    wxFileOffset Length() const;
+
+    /**
+        Returns the mechanism actually used for performing the I/O.
+
+        This is never ::wxASYNC_FILE_BACKEND_DEFAULT for an opened file.
+     */
+    wxAsyncFileBackend GetBackend() const;
+
+    /**
+        Starts reading data at the given position in the file.
+
+        The buffer must remain valid until the @c wxEVT_ASYNC_FILE_READ
+        event for this request is received. If there are less than @a count
+        bytes available in the file after the given @a offset, the operation
+        completes successfully and wxAsyncFileEvent::GetCount() returns the
+        number of bytes actually read.
+
+        Returns the positive identifier of the new request or 0 if it
+        couldn't be started, in which case no event is sent.
+     */
+    long ReadAt(wxFileOffset offset, void* buffer, size_t count);
+
+    /**
+        Starts writing data at the given position in the file.
+
+        The buffer must remain valid, and its contents unchanged, until the
+        @c wxEVT_ASYNC_FILE_WRITE event for this request is received.
+
+        Returns the positive identifier of the new request or 0 if it
+        couldn't be started, in which case no event is sent.
+     */
+    long WriteAt(wxFileOffset offset, const void* buffer, size_t count);
+
+    /**
+        Requests cancelling the given operation.
+
+        The completion event is still sent for the cancelled operation, with
+        wxAsyncFileEvent::IsCancelled() returning @true if it was actually
+        cancelled. Notice that the operation may also complete normally if
+        it was too late to cancel it.
+
+        Returns @false if the request is not pending any more or can't be
+        cancelled because it's already being executed.
+     */
+    bool Cancel(long requestId);
+
+    /**
+        Requests cancelling all pending operations.
+
+        @see Cancel()
+     */
+    void CancelAll();
+
+    /**
+        Returns the number of operations which haven't completed yet.
+
+        Notice that the events for the completed operations may still be
+        waiting to be processed.
+     */
+    size_t GetPendingCount() const;
+
+    /**
+        Blocks until all pending operations complete.
+
+        The completion events are queued by this function, but not processed,
+        so they will be received once the control returns to the event loop.
+     */
+    void WaitAll();
+
+    /// Returns the identifier specified in the constructor.
+    int GetId() const;
+};
+
+/**
+    @class wxAsyncFileEvent
+
+    Event sent by wxAsyncFile when an asynchronous operation completes.
+
+    Exactly one such event is sent for each request successfully started by
+    wxAsyncFile::ReadAt() or wxAsyncFile::WriteAt(), whether it succeeded,
+    failed or was cancelled.
+
+    @beginEventTable{wxAsyncFileEvent}
+    @event{EVT_ASYNC_FILE_READ(id, func)}
+        Process a @c wxEVT_ASYNC_FILE_READ event.
+    @event{EVT_ASYNC_FILE_WRITE(id, func)}
+        Process a @c wxEVT_ASYNC_FILE_WRITE event.
+    @endEventTable
+
+    @library{wxbase}
+    @category{events}
+
+    @since 3.3.1
+ */
+class wxAsyncFileEvent : public wxEvent
+{
+public:
+    /// Constructor is only used by wxWidgets itself.
+    wxAsyncFileEvent(wxEventType type = wxEVT_NULL, int id = wxID_ANY);
+
+    /// Returns the identifier returned by the function starting the request.
+    long GetRequestId() const;
+
+    /// Returns the position in the file passed to the request.
+    wxFileOffset GetOffset() const;
+
+    /// Returns the buffer passed to the request.
+    void* GetBuffer() const;
+
+    /// Returns the number of bytes which were requested to be transferred.
+    size_t GetRequestedCount() const;
+
+    /**
+        Returns the number of bytes actually transferred.
+
+        This may be less than GetRequestedCount() when reading past the end
+        of file or if an error occurred or the request was cancelled.
+     */
+    size_t GetCount() const;
+
+    /**
+        Returns the system error code or 0 if there was no error.
+
+        The error message can be obtained using wxSysErrorMsgStr().
+     */
+    unsigned long GetErrorCode() const;
+
+    /// Returns @true if the request was cancelled.
+    bool IsCancelled() const;
+
+    /// Returns @true if the request completed without errors.
+    bool IsOk() const;
+};
+
+wxEventType wxEVT_ASYNC_FILE_READ;
+wxEventType wxEVT_ASYNC_FILE_WRITE;
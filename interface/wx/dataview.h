@@ -384,6 +384,27 @@ public:
                           const wxDataViewItem& item,
                           unsigned int col) = 0;
 
+    /**
+        Override this to indicate that the model uses the default Compare()
+        implementation.
+
+        If this function returns @true, the generic wxDataViewCtrl version
+        sorts the items by a column by retrieving the values of all of them
+        using GetValue() just once, before sorting, instead of calling
+        Compare() for each pair of items compared, which is much faster for
+        models with many items.
+
+        Notice that this must not be overridden to return @true if Compare()
+        is overridden, but it's fine to do it if only DoCompareValues() is.
+
+        The base class version returns @false. wxDataViewListStore allows
+        to change this using wxDataViewListStore::SetUsesDefaultCompare()
+        and wxDataViewListCtrl does it for the store it creates.
+
+        @since 3.3.1
+    */
+    virtual bool UsesDefaultCompare() const;
+
     /**
         Call this to inform this model that a value in the model has been changed.
         This is also called from wxDataViewCtrl's internal editing code, e.g. when
@@ -3567,6 +3588,27 @@ public:
     */
     virtual bool SetValueByRow( const wxVariant &value,
                            unsigned int row, unsigned int col );
+
+    /**
+        Overridden from wxDataViewModel to return the value set by
+        SetUsesDefaultCompare().
+
+        @since 3.3.1
+    */
+    virtual bool UsesDefaultCompare() const;
+
+    /**
+        Indicate whether the default Compare() is used by this store.
+
+        By default, UsesDefaultCompare() returns @false, as a class deriving
+        from this one may override Compare(). Call this function with @true
+        argument to allow the generic wxDataViewCtrl to sort the items faster
+        if this is not the case. wxDataViewListCtrl calls it for the store it
+        creates itself.
+
+        @since 3.3.1
+    */
+    void SetUsesDefaultCompare(bool uses = true);
 };
 
 
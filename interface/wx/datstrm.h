@@ -29,6 +29,12 @@
     The "<<" operator is overloaded and you can use this class like a standard
     C++ iostream. See wxDataInputStream for its usage and caveats.
 
+    When writing many values of the same type, prefer using the overloads
+    taking arrays, e.g. WriteDouble(const double*, size_t), to writing them
+    one by one: they convert the values in bulk and write them using only a
+    few calls to the underlying stream, which is much faster (unless extended
+    precision is used for floating point values).
+
     @library{wxbase}
     @category{streams}
 
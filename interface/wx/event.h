@@ -1172,6 +1172,22 @@ public:
     */
     bool IsUnlinked() const;
 
+    /**
+        Returns @true if this handler may process events of the given type.
+
+        This function returns @true if this handler has any handlers for the
+        events of the given type, either in its static event table or bound
+        dynamically using Bind(), or if it is linked with any other event
+        handlers, as they could process these events.
+
+        Note that it doesn't take into account any overridden ProcessEvent(),
+        TryBefore() or TryAfter() functions nor the global event filters, so
+        the events may still be processed even if it returns @false.
+
+        @since 3.3.1
+     */
+    bool HasHandlersFor(wxEventType eventType) const;
+
     ///@}
 
     /**
@@ -4346,7 +4362,16 @@ enum wxIdleMode
     wxIDLE_PROCESS_ALL,
 
         /** Send idle events to windows that have the wxWS_EX_PROCESS_IDLE flag specified */
-    wxIDLE_PROCESS_SPECIFIED
+    wxIDLE_PROCESS_SPECIFIED,
+
+        /**
+            Send idle events only to windows that have wxEVT_IDLE handlers,
+            as determined by wxEvtHandler::HasHandlersFor(), or the
+            wxWS_EX_PROCESS_IDLE flag.
+
+            @since 3.3.1
+         */
+    wxIDLE_PROCESS_HANDLED
 };
 
 
@@ -4377,7 +4402,18 @@ enum wxIdleMode
     your application, you can call wxIdleEvent::SetMode with the value
     wxIDLE_PROCESS_SPECIFIED, and set the wxWS_EX_PROCESS_IDLE extra window
     style for every window which should receive idle events, all the other ones
-    will not receive them in this case.
+    will not receive them in this case. Alternatively, wxIDLE_PROCESS_HANDLED
+    can be used to only send idle events to the windows which have handlers
+    for them, which avoids the overhead of sending them to all the other
+    windows without having to specify wxWS_EX_PROCESS_IDLE explicitly. Note
+    that in this case the windows which process idle events in an overridden
+    wxEvtHandler::ProcessEvent() or wxEvtHandler::TryBefore(), e.g. the
+    document-view frames forwarding them to their views, still need to use
+    wxWS_EX_PROCESS_IDLE.
+
+    Also note that wxIdleTaskScheduler provides a better alternative to the
+    idle event handlers for performing the background work, as it doesn't
+    use any CPU when there is no work to do.
 
     @beginEventTable{wxIdleEvent}
     @event{EVT_IDLE(func)}
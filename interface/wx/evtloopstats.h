@@ -0,0 +1,255 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        wx/evtloopstats.h
+// Purpose:     interface of wxEventLoopStats
+// Author:      wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+    Distribution of durations collected by wxEventLoopStats.
+
+    The durations are stored in buckets with power of 2 limits, i.e. the
+    bucket @c n contains the durations from @c 2^n to @c 2^(n+1) microseconds,
+    which allows to estimate the percentiles with sufficient precision for
+    the purpose of detecting latency problems.
+
+    @since 3.3.1
+
+    @category{events}
+ */
+class wxEventLoopHistogram
+{
+public:
+    /// Number of buckets, durations longer than 2^NUM_BUCKETS microseconds
+    /// are all stored in the last bucket.
+    enum { NUM_BUCKETS = 25 };
+
+    /// Add a duration, in microseconds, to the histogram.
+    void Add(wxLongLong_t durationUS);
+
+    /// Remove all the samples.
+    void Reset();
+
+    /// Return the number of samples.
+    size_t GetCount() const;
+
+    /// Return the sum of all durations in microseconds.
+    wxLongLong_t GetTotal() const;
+
+    /// Return the maximal duration in microseconds.
+    wxLongLong_t GetMax() const;
+
+    /// Return the average duration in microseconds.
+    wxLongLong_t GetAverage() const;
+
+    /// Return the number of samples in the given bucket.
+    size_t GetBucketCount(int n) const;
+
+    /// Return the upper limit of the given bucket, i.e. @c 2^(n+1).
+    static wxLongLong_t GetBucketLimit(int n);
+
+    /**
+        Return the approximate value of the given percentile.
+
+        For example, @c GetPercentile(99) returns the value such that 99% of
+        all durations are less than it. The value returned is the upper limit
+        of the bucket containing the percentile, or the maximal duration if it
+        is smaller.
+     */
+    wxLongLong_t GetPercentile(double percent) const;
+};
+
+/**
+    Information about an event handler call stored by wxEventLoopStats.
+
+    @since 3.3.1
+
+    @category{events}
+ */
+struct wxEventLoopHandlerInfo
+{
+    /// The type of the event.
+    wxEventType eventType;
+
+    /// The ID of the event.
+    int id;
+
+    /**
+        Class name of the object whose handler was called.
+
+        Note that this is the name of the most derived class using
+        wxDECLARE_DYNAMIC_CLASS() or similar macro, so it may be a base class
+        of the actual object.
+     */
+    wxString handlerClass;
+
+    /// Class name of the event source, as returned by
+    /// wxEvent::GetEventObject(), or empty if there is no event source.
+    wxString sourceClass;
+
+    /// Time of the handler call in milliseconds since the Epoch.
+    wxLongLong_t timestamp;
+
+    /// Duration of the handler call in microseconds.
+    wxLongLong_t duration;
+};
+
+/**
+    Information about the event loop stall passed to the function specified
+    in wxEventLoopStats::StartStallDetector().
+
+    @since 3.3.1
+
+    @category{events}
+ */
+struct wxEventLoopStallInfo
+{
+    /// For how long the event loop has been blocked, in milliseconds.
+    long duration;
+
+    /// @true if the loop is blocked by the idle events processing, in
+    /// which case the remaining fields are not used.
+    bool isIdle;
+
+    /// The type of the event whose handler blocks the event loop.
+    wxEventType eventType;
+
+    /// The ID of the event whose handler blocks the event loop.
+    int id;
+
+    /// Class name of the object whose handler blocks the event loop.
+    wxString handlerClass;
+};
+
+/**
+    Collects statistics about the main event loop.
+
+    This class allows to find out what makes the application unresponsive
+    without using any external tools: when enabled, it measures the duration
+    of all event handler calls and idle events processing in the main thread
+    and can report the event handlers which block the event loop for too long
+    while they are still running.
+
+    Collecting the statistics is disabled by default and has negligible cost
+    when it's not enabled. It can be enabled at any moment, even temporarily:
+    @code
+    wxEventLoopStats::Enable();
+
+    // Report handlers blocking the UI for more than 200ms.
+    wxEventLoopStats::Get()->StartStallDetector(200);
+
+    ... later ...
+
+    wxLogMessage("%s", wxEventLoopStats::Get()->Dump());
+    @endcode
+
+    Note that only the events processed in the main thread are taken into
+    account and that all functions of this class, except for Enable() and
+    Get(), must be called from the main thread too.
+
+    @since 3.3.1
+
+    @category{events}
+ */
+class wxEventLoopStats
+{
+public:
+    /**
+        Function called when the event loop is blocked.
+
+        Notice that it is called from a background thread and so can't use
+        any GUI functions. Using wxLog functions is fine.
+     */
+    typedef std::function<void (const wxEventLoopStallInfo&)> StallHandler;
+
+    /**
+        Start or stop collecting the statistics.
+
+        Disabling the statistics also stops the stall detector if it's
+        running, but keeps the already collected data.
+     */
+    static void Enable(bool enable = true);
+
+    /**
+        Return the object containing the statistics.
+
+        Returns @NULL if collecting the statistics is not enabled.
+     */
+    static wxEventLoopStats* Get();
+
+    /// Remove all the data collected so far.
+    void Reset();
+
+    /**
+        Return the busy time of each event loop iteration.
+
+        An iteration ends when the idle events are processed, i.e. when the
+        event loop has handled all the events available to it. The duration of
+        the iteration only includes the time spent in the event handlers and
+        idle processing, but not the time spent waiting for the events, so it
+        corresponds to the time during which the application is unresponsive.
+     */
+    const wxEventLoopHistogram& GetIterationTimes() const;
+
+    /// Return the durations of all event handler calls.
+    const wxEventLoopHistogram& GetHandlerTimes() const;
+
+    /// Return the durations of idle processing passes.
+    const wxEventLoopHistogram& GetIdleTimes() const;
+
+    /**
+        Return the number of processed pending events.
+
+        Pending events are those posted using wxEvtHandler::QueueEvent(),
+        wxEvtHandler::AddPendingEvent() or wxEvtHandler::CallAfter().
+     */
+    size_t GetPendingEventsCount() const;
+
+    /// Return the number of processed events of the given type.
+    size_t GetEventCount(wxEventType eventType) const;
+
+    /// Return all processed event types with the number of events of each
+    /// type, in order of decreasing number of events.
+    std::vector<std::pair<wxEventType, size_t>> GetEventCounts() const;
+
+    /// Return the slowest event handler calls, slowest first.
+    const std::vector<wxEventLoopHandlerInfo>& GetSlowestHandlers() const;
+
+    /// Change the number of the slowest handler calls to keep, 10 by
+    /// default.
+    void SetMaxSlowestHandlers(size_t count);
+
+    /// Return the summary of all collected statistics as a multiline string.
+    wxString Dump() const;
+
+    /**
+        Start detecting the event loop stalls.
+
+        This function starts a background thread which checks whether the
+        main event loop is blocked by an event handler or idle processing for
+        more than the given time and calls the provided function if it is. It
+        is called only once for each stall, while the handler blocking the
+        event loop is still running, which allows to e.g. capture the stack
+        trace of the main thread from it.
+
+        If @a handler is not specified, a warning with the information about
+        the event handler blocking the loop is logged.
+
+        Calling this function again replaces the previously used threshold and
+        handler.
+
+        Only available if @c wxUSE_THREADS is 1.
+
+        @param thresholdMS
+            Time in milliseconds, must be positive.
+        @param handler
+            The function to call.
+        @return @true if the stall detector was started, @false if creating
+            the thread failed.
+     */
+    bool StartStallDetector(long thresholdMS,
+                            const StallHandler& handler = StallHandler());
+
+    /// Stop the stall detector started by StartStallDetector().
+    void StopStallDetector();
+};
@@ -10,13 +10,83 @@
     @class wxArchiveFSHandler
 
     A file system handler for accessing files inside of archives.
+
+    The handler caches the catalogs of the archives it opens, so that the
+    archive doesn't need to be read again when accessing another file inside
+    it. The catalog is read incrementally, only as far as necessary to find
+    the requested file. For zip archives on seekable streams, only the
+    positions of the entries in the zip central directory are kept in memory,
+    and the entries themselves are read again from it when they are opened.
+
+    The memory used by the cached catalogs is limited, see SetCacheLimit(),
+    and the least recently used archives are removed from the cache when the
+    limit is exceeded.
 */
 class wxArchiveFSHandler : public wxFileSystemHandler
 {
 public:
+    /**
+        Default value of the cache limit.
+
+        @since 3.3.1
+    */
+    enum { DEFAULT_CACHE_LIMIT = 16*1024*1024 };
+
     wxArchiveFSHandler();
     virtual ~wxArchiveFSHandler();
     void Cleanup();
+
+    /**
+        Sets the approximate maximal amount of memory, in bytes, used by the
+        catalogs of the archives in each cache.
+
+        The most recently used archive is always kept in the cache, even if
+        its catalog alone exceeds the limit, so setting the limit to 0 means
+        that only a single archive is cached.
+
+        The limit applies to all the handlers.
+
+        @since 3.3.1
+    */
+    static void SetCacheLimit(size_t limit);
+
+    /**
+        Returns the cache limit set by SetCacheLimit().
+
+        By default, it is DEFAULT_CACHE_LIMIT.
+
+        @since 3.3.1
+    */
+    static size_t GetCacheLimit();
+
+    /**
+        Enables or disables sharing the cached catalogs between all the
+        handlers.
+
+        By default, each wxFileSystem object uses its own handler object and
+        hence has its own cache, so that the same archive is read again when
+        it is accessed using a different wxFileSystem. When the shared cache
+        is enabled, the catalogs of the archives on seekable streams, e.g.
+        local files, are cached only once and reused by all wxFileSystem
+        objects, including those used by different threads.
+
+        Note that the shared cache is not updated if the archive file changes,
+        ClearSharedCache() needs to be called explicitly in this case.
+
+        Disabling the shared cache also clears it.
+
+        @since 3.3.1
+    */
+    static void EnableSharedCache(bool enable = true);
+
+    /**
+        Removes all the archives from the shared cache.
+
+        The archives currently being used are not affected.
+
+        @since 3.3.1
+    */
+    static void ClearSharedCache();
 };
 
 
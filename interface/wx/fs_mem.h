@@ -63,6 +63,14 @@
     }
     @endcode
 
+    The files can be added, opened and removed from different threads. The
+    stream of a file opened from the memory file system remains valid even if
+    the file is removed from it while the stream is still being used.
+    However, just as wxFileSystem::FindFirst() and wxFileSystem::FindNext(),
+    searching for files in the memory file system keeps the state of the
+    search in the handler object and so must not be done concurrently from
+    several threads.
+
     @library{wxbase}
     @category{vfs}
 
@@ -121,8 +129,54 @@ public:
                                     const wxString& mimetype);
     ///@}
 
+    ///@{
+    /**
+        Adds a file using the data of the given buffer.
+
+        Unlike the other overloads, these functions don't copy the data, but
+        share it with @a buf, as wxMemoryBuffer is reference counted. The
+        buffer must not be modified after adding it, as this could reallocate
+        its data while it's still used by the memory file system.
+
+        Notice that wxMemoryBuffer reference counting is not thread-safe, so
+        if the memory file system is used from several threads, neither this
+        buffer nor any of its copies should be used by other threads while
+        the file exists. The simplest way to ensure this is to not keep any
+        references to the buffer after adding it.
+
+        @since 3.3.1
+    */
+    static void AddFile(const wxString& filename, const wxMemoryBuffer& buf);
+    static void AddFileWithMimeType(const wxString& filename,
+                                    const wxMemoryBuffer& buf,
+                                    const wxString& mimetype);
+    ///@}
+
+    ///@{
+    /**
+        Adds a file using the given data without copying it.
+
+        This is useful for the data compiled into the program, e.g. when
+        embedding resources. The data must remain valid until the file is
+        removed or until the end of the program if it is never removed.
+
+        @since 3.3.1
+    */
+    static void AddStaticFile(const wxString& filename,
+                              const void* binarydata,
+                              size_t size);
+    static void AddStaticFileWithMimeType(const wxString& filename,
+                                          const void* binarydata,
+                                          size_t size,
+                                          const wxString& mimetype);
+    ///@}
+
     /**
         Removes a file from memory FS and frees the occupied memory.
+
+        The file must not be used when it is removed, i.e. the streams
+        returned by wxFileSystem::OpenFile() for it must have been already
+        destroyed.
     */
     static void RemoveFile(const wxString& filename);
 };
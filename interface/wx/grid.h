@@ -1782,6 +1782,29 @@ public:
     /// Set attribute for the specified column.
     virtual void SetColAttr(wxGridCellAttr *attr, int col);
 
+    /**
+        Set attribute for all cells of the specified block.
+
+        The attribute is stored only once, independently of the number of
+        cells in the block, which makes this function much more efficient
+        than calling SetAttr() for each cell of a big block.
+
+        The block attributes have lower priority than the attributes set for
+        the individual cells using SetAttr() but higher than the row or
+        column ones. Setting the attribute for a block overlapping another
+        one replaces its attribute for the cells of the new block, and
+        passing @NULL as @a attr removes the attributes of all cells of the
+        block.
+
+        Note that the block attributes can't be used for the cells spanning
+        multiple rows or columns, i.e. wxGridCellAttr::SetSize() must not be
+        called for them.
+
+        @since 3.3.1
+     */
+    virtual void SetAttrForBlock(wxGridCellAttr *attr,
+                                 const wxGridBlockCoords& block);
+
     ///@}
 
     /**
@@ -2363,6 +2386,45 @@ public:
      */
     virtual void SetValue(int row, int col, const wxString& value) = 0;
 
+    /**
+        May be overridden to get the values of all cells in a block at once.
+
+        wxGrid calls this function to get the values of all cells it needs to
+        draw when repainting and of all the selected cells when copying them
+        to the clipboard. Overriding it allows tables retrieving their data
+        from a database or another external source to serve the entire
+        visible area using a single query instead of returning the value of
+        each cell from a separate GetValue() call.
+
+        The values must be stored in @a values in row-major order, i.e. the
+        value of the cell at @c (row, col) must be at index
+        @code
+        (row - block.GetTopRow())*(block.GetRightCol() - block.GetLeftCol() + 1)
+            + col - block.GetLeftCol()
+        @endcode
+        and the vector must contain exactly as many elements as there are
+        cells in the block.
+
+        Note that the values returned by this function are only used until
+        the end of the current repaint or copy operation, so they don't need
+        to be kept in sync with the table contents.
+
+        The default implementation returns @false, meaning that the values
+        are retrieved using GetValue() one by one.
+
+        @param block
+            The block of cells to get the values of, always valid.
+        @param values
+            The vector to fill with the values, empty on entry.
+        @return
+            @true if the values were retrieved or @false if this function is
+            not supported.
+
+        @since 3.3.1
+     */
+    virtual bool GetValuesBlock(const wxGridBlockCoords& block,
+                                std::vector<wxString>& values);
+
     /**
         Returns the type of the value in the given cell.
 
@@ -2702,6 +2764,19 @@ public:
      */
     virtual void SetColAttr(wxGridCellAttr *attr, int col);
 
+    /**
+        Set attribute of all cells of the specified block.
+
+        By default this function is simply forwarded to
+        wxGridCellAttrProvider::SetAttrForBlock().
+
+        The table takes ownership of @a attr, i.e. will call DecRef() on it.
+
+        @since 3.3.1
+     */
+    virtual void SetAttrForBlock(wxGridCellAttr *attr,
+                                 const wxGridBlockCoords& block);
+
     ///@}
 
     /**
@@ -4087,6 +4162,43 @@ public:
     */
     void AutoSizeRows(bool setAsMin = true);
 
+    /**
+        Limits the number of cells measured when auto-sizing columns or rows.
+
+        By default, AutoSizeColumn() measures all the cells of the column,
+        which can take a long time for grids with many rows. This function
+        allows to measure only the currently visible cells and the given
+        number of other cells, evenly distributed over the entire column (and
+        similarly for AutoSizeRow()). The column may then be too narrow for
+        some of the cells that were not measured.
+
+        If @a refineInIdleTime is @true, the remaining cells are measured later,
+        when the application is idle (see wxIdleTaskScheduler), and the column
+        or row is enlarged if any of them doesn't fit. This is stopped if the
+        column or row size is changed in the meanwhile, or if any rows or
+        columns are added to or removed from the grid.
+
+        @param numSamples
+            Number of cells to measure in addition to the visible ones, or 0
+            to measure all of them, which is the default.
+        @param refineInIdleTime
+            Whether to measure the remaining cells in idle time.
+
+        @see GetAutoSizeSampling()
+
+        @since 3.3.1
+    */
+    void SetAutoSizeSampling(int numSamples, bool refineInIdleTime = false);
+
+    /**
+        Returns the number of cells measured when auto-sizing.
+
+        @see SetAutoSizeSampling()
+
+        @since 3.3.1
+    */
+    int GetAutoSizeSampling() const;
+
     /**
         Returns the cell fitting mode.
 
@@ -5351,6 +5463,43 @@ public:
      */
     ///@{
 
+    /**
+        Enables or disables caching of the cells area contents.
+
+        When the cache is enabled, the grid keeps the last drawn contents of
+        its main cells area in a bitmap and only redraws the parts of it that
+        were refreshed since then. In particular, scrolling the grid only
+        draws the cells which became newly visible, while the contents of the
+        rest of the window is copied from the cache, which can make scrolling
+        grids with many small cells much smoother.
+
+        The cache is invalidated by all changes to the grid which refresh it,
+        e.g. changing the cell values or attributes or the selection. However
+        if the cell renderers use any external data, the corresponding parts
+        of the grid must be explicitly refreshed when it changes, e.g. using
+        RefreshBlock(), for the cache to be updated.
+
+        The cache is not used for the frozen rows and columns areas.
+
+        The cache is disabled by default because it uses additional memory
+        and because the contents of the cells is not always redrawn when it
+        is enabled.
+
+        @see IsRenderCacheEnabled()
+
+        @since 3.3.1
+    */
+    void EnableRenderCache(bool enable = true);
+
+    /**
+        Returns @true if caching of the cells area contents is enabled.
+
+        @see EnableRenderCache()
+
+        @since 3.3.1
+    */
+    bool IsRenderCacheEnabled() const;
+
     /**
         Returns the number of pixels per horizontal scroll increment.
 
@@ -6017,6 +6166,20 @@ public:
     */
     void SetColAttr(int col, wxGridCellAttr* attr);
 
+    /**
+        Sets the cell attributes for all cells in the specified block.
+
+        The grid takes ownership of the attribute pointer, which is shared
+        by all the cells of the block, so that using this function is much
+        more efficient than calling SetAttr() for each of them when the
+        block is big.
+
+        See wxGridCellAttrProvider::SetAttrForBlock() for more details.
+
+        @since 3.3.1
+    */
+    void SetAttrForBlock(const wxGridBlockCoords& block, wxGridCellAttr *attr);
+
     /**
         Sets the extra margins used around the grid area.
 
@@ -0,0 +1,158 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        wx/idlesched.h
+// Purpose:     interface of wxIdleTaskScheduler
+// Author:      wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+    Values returned by the tasks executed by wxIdleTaskScheduler.
+
+    @since 3.3.1
+ */
+enum wxIdleTaskResult
+{
+    /// The task is finished and is removed from the scheduler.
+    wxIDLE_TASK_DONE,
+
+    /// The task has more work to do and should be called again as soon as
+    /// possible.
+    wxIDLE_TASK_MORE,
+
+    /// The task has nothing to do right now and shouldn't be called again
+    /// until wxIdleTaskScheduler::WakeUp() is called for it.
+    wxIDLE_TASK_WAIT
+};
+
+/**
+    Runs background tasks in the main thread when the application is idle.
+
+    This class provides a better alternative to performing background work
+    in wxEVT_IDLE handlers calling wxIdleEvent::RequestMore(): such handlers
+    keep being called, and so use 100% of CPU, even when they don't have
+    anything to do, and don't limit the time spent in them, which can make
+    the application unresponsive if there are many of them.
+
+    Instead, the tasks registered with the scheduler are called repeatedly
+    while the application is idle, but only for the given time budget during
+    each idle processing pass and only until the total time slice expires or
+    a new event arrives. And if a task doesn't have anything to do at the
+    moment, it can return wxIDLE_TASK_WAIT to stop being called at all until
+    WakeUp() is called for it, e.g. when new data to process becomes
+    available. When there are no tasks with work to do, the event loop
+    sleeps while waiting for the events.
+
+    Each call to the task function should do only a small amount of work,
+    e.g.
+    @code
+    m_taskId = wxIdleTaskScheduler::Get().AddTask([this]()
+        {
+            if ( m_queue.empty() )
+                return wxIDLE_TASK_WAIT;
+
+            ProcessItem(m_queue.front());
+            m_queue.pop_front();
+
+            return wxIDLE_TASK_MORE;
+        });
+
+    ...
+
+    void MyFrame::AddItem(const Item& item)
+    {
+        m_queue.push_back(item);
+        wxIdleTaskScheduler::Get().WakeUp(m_taskId);
+    }
+    @endcode
+
+    All functions of this class must be called from the main thread only,
+    use wxEvtHandler::CallAfter() to call WakeUp() from the other threads.
+
+    @since 3.3.1
+
+    @library{wxbase}
+    @category{events}
+
+    @see wxIdleEvent
+ */
+class wxIdleTaskScheduler
+{
+public:
+    /// The type of the task functions.
+    typedef std::function<wxIdleTaskResult ()> Task;
+
+    /**
+        Return the scheduler whose tasks are run by the application.
+
+        Its tasks are executed by wxApp::ProcessIdle() after sending
+        wxEVT_IDLE to the application object.
+     */
+    static wxIdleTaskScheduler& Get();
+
+    /**
+        Default constructor.
+
+        Usually the global scheduler returned by Get() is used, but it's also
+        possible to create other schedulers and call their ProcessIdle()
+        manually.
+     */
+    wxIdleTaskScheduler();
+
+    /**
+        Add a new task.
+
+        @param task
+            The function to call, it should return one of ::wxIdleTaskResult
+            values.
+        @param priority
+            Tasks with higher priority are run before the tasks with lower
+            priority. Tasks with the same priority are run in round-robin
+            order.
+        @param budget
+            The maximal time in milliseconds during which this task is
+            called repeatedly during each idle processing pass.
+        @return The ID of the new task which can be passed to RemoveTask()
+            and WakeUp().
+     */
+    int AddTask(const Task& task, int priority = 0, long budget = 5);
+
+    /**
+        Remove the task with the given ID.
+
+        Returns @false if there is no such task, e.g. because it already
+        finished. This function may be called from the task itself.
+     */
+    bool RemoveTask(int id);
+
+    /**
+        Resume calling the task which previously returned wxIDLE_TASK_WAIT.
+
+        Does nothing if the task is not waiting.
+     */
+    void WakeUp(int id);
+
+    /// Return @true if there are any tasks, including the waiting ones.
+    bool HasTasks() const;
+
+    /**
+        Set the maximal time in milliseconds spent running all the tasks
+        during a single idle processing pass.
+
+        The default time slice is 10ms.
+     */
+    void SetTimeSlice(long timeSlice);
+
+    /// Return the time slice set by SetTimeSlice().
+    long GetTimeSlice() const;
+
+    /**
+        Run the tasks.
+
+        The tasks are run in the order of their priorities until the time
+        slice is exhausted, there are no more tasks to run or there are
+        events pending in the active event loop.
+
+        Returns @true if any of the tasks has more work to do.
+     */
+    bool ProcessIdle();
+};
@@ -507,6 +507,43 @@ public:
     */
     void EnableBellOnNoMatch(bool on = true);
 
+    /**
+        Enable or disable support for items of different heights in report
+        view.
+
+        By default all items have the same height, determined by the font and
+        the small images used by the control. When this support is enabled,
+        OnGetItemHeight() is called to retrieve the height of each item
+        instead, e.g. to leave more space around some of them. The item
+        contents are centered vertically in the item rectangle.
+
+        The item heights are retrieved when they're needed for the first time
+        and cached afterwards, so RefreshItem() or RefreshItems() must be
+        called if the height of an item changes. Notice that the heights of
+        all items are needed to determine the total height of the control, so
+        OnGetItemHeight() should be fast even for a large number of items.
+
+        @note This function is only available in the generic version of this
+              control and not in wxMSW or wxQt ports.
+
+        @see HasVariableLineHeight()
+
+        @since 3.3.1
+    */
+    void EnableVariableLineHeight(bool enable = true);
+
+    /**
+        Returns @true if support for items of different heights is enabled.
+
+        @note This function is only available in the generic version of this
+              control and not in wxMSW or wxQt ports.
+
+        @see EnableVariableLineHeight()
+
+        @since 3.3.1
+    */
+    bool HasVariableLineHeight() const;
+
     /**
         Finish editing the label.
 
@@ -1043,6 +1080,12 @@ public:
         function the displayed value of the item doesn't change even when the
         underlying data does change.
 
+        Notice that the generic implementation of this control, used under
+        all platforms except MSW, retrieves the data of all the visible items
+        at once when it is repainted, after sending @c wxEVT_LIST_CACHE_HINT,
+        and reuses it until this function, RefreshItems() or Refresh() is
+        called, so one of them must be called whenever the data changes.
+
         @see RefreshItems()
     */
     void RefreshItem(long item);
@@ -1612,6 +1655,22 @@ protected:
         @since 3.1.2
     */
     virtual bool OnGetItemIsChecked(long item) const;
+
+    /**
+        This function may be overridden in the derived class for a control
+        using EnableVariableLineHeight() to return the height of the given
+        @a item in pixels.
+
+        It is called for both virtual and non-virtual controls, but only in
+        report view. The base class version always returns -1, meaning that
+        the default item height is used.
+
+        @note This function is only available in the generic version of this
+              control and not in wxMSW or wxQt ports.
+
+        @since 3.3.1
+    */
+    virtual int OnGetItemHeight(long item) const;
 };
 
 
@@ -0,0 +1,139 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/lz4stream.h
+// Purpose:     LZ4 [de]compression classes documentation
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+    @class wxLZ4InputStream
+
+    This filter stream decompresses data in LZ4 frame format.
+
+    LZ4 format is used by .lz4 files and is optimized for the speed of
+    compression and, especially, decompression, rather than for the
+    compression ratio. Several concatenated frames are decompressed as a
+    single stream, as with the lz4 command line utility.
+
+    This class is only available if wxWidgets was built with @c wxUSE_LIBLZ4
+    set to 1, which requires liblz4 library.
+
+    @library{wxbase}
+    @category{archive,streams}
+
+    @see wxInputStream, wxZstdInputStream, wxLZ4OutputStream.
+
+    @since 3.3.1
+*/
+class wxLZ4InputStream : public wxFilterInputStream
+{
+public:
+    /**
+        Create decompressing stream associated with the given underlying
+        stream.
+
+        This overload does not take ownership of the @a stream.
+    */
+    wxLZ4InputStream(wxInputStream& stream);
+
+    /**
+        Create decompressing stream associated with the given underlying
+        stream and takes ownership of it.
+
+        As with the base wxFilterInputStream class, passing @a stream by
+        pointer indicates that this object takes ownership of it and will
+        delete it when it is itself destroyed.
+     */
+    wxLZ4InputStream(wxInputStream* stream);
+
+    ///@{
+    /**
+        Sets the dictionary to use for decompressing the data.
+
+        This must be the same dictionary as was used for compressing it.
+
+        It must be called before reading anything from the stream.
+
+        Returns @true if the dictionary was set successfully.
+    */
+    bool SetDictionary(const char *data, size_t datalen);
+    bool SetDictionary(const wxMemoryBuffer &buf);
+    ///@}
+};
+
+/**
+    @class wxLZ4OutputStream
+
+    This filter stream compresses data using LZ4 frame format.
+
+    The output is compatible with the lz4 utility working with .lz4 files.
+
+    This class is only available if wxWidgets was built with @c wxUSE_LIBLZ4
+    set to 1, which requires liblz4 library.
+
+    @library{wxbase}
+    @category{archive,streams}
+
+    @see wxOutputStream, wxZstdOutputStream, wxLZ4InputStream
+
+    @since 3.3.1
+*/
+class wxLZ4OutputStream : public wxFilterOutputStream
+{
+public:
+    /**
+        Create compressing stream associated with the given underlying
+        stream.
+
+        The compression @a level can be -1 to use the default and fastest
+        compression, or a value up to GetMaxLevel(). Levels of 3 and higher
+        use the slower LZ4 HC algorithm which compresses better.
+
+        This overload does not take ownership of the @a stream.
+    */
+    wxLZ4OutputStream(wxOutputStream& stream, int level = -1);
+
+    /**
+        Create compressing stream associated with the given underlying
+        stream and takes ownership of it.
+
+        As with the base wxFilterOutputStream class, passing @a stream by
+        pointer indicates that this object takes ownership of it and will
+        delete it when it is itself destroyed.
+     */
+    wxLZ4OutputStream(wxOutputStream* stream, int level = -1);
+
+    ///@{
+    /**
+        Sets the dictionary to use for compressing the data.
+
+        The same dictionary must then be used when decompressing the data
+        with wxLZ4InputStream::SetDictionary().
+
+        It must be called before writing anything to the stream.
+
+        Returns @true if the dictionary was set successfully.
+    */
+    bool SetDictionary(const char *data, size_t datalen);
+    bool SetDictionary(const wxMemoryBuffer &buf);
+    ///@}
+
+    /**
+        Returns the maximal compression level supported by liblz4.
+    */
+    static int GetMaxLevel();
+};
+
+/**
+    Return the version of liblz4 library used by LZ4 stream classes.
+
+    @see wxVersionInfo
+
+    @header{wx/lz4stream.h}
+    @library{wxbase}
+
+    @since 3.3.1
+*/
+wxVersionInfo wxGetLibLZ4VersionInfo();
@@ -119,3 +119,181 @@ public:
     wxMessageQueueError ReceiveTimeout(long timeout, T& msg);
 };
 
+
+/**
+    Message queue with fixed capacity.
+
+    This class provides the same functionality as wxMessageQueue, but can't
+    contain more than the number of messages specified when creating it:
+    posting a message to a full queue blocks until a message is received by
+    another thread. This allows to limit the memory used by the queue when
+    the producers generate messages faster than the consumer can handle them.
+
+    The messages are stored in a ring buffer accessed without taking any locks,
+    so posting and receiving messages is cheaper than with wxMessageQueue,
+    especially when multiple threads post messages concurrently. Receiving
+    many messages at once with ReceiveMany() is even more efficient.
+
+    Unlike wxMessageQueue, this class can also notify the main thread about the
+    new messages by sending wxThreadEvent to the handler specified by
+    SetNotifyHandler(). Only a single event is sent until the main thread
+    starts receiving the messages, so the event loop is not flooded with them
+    even if many messages are posted.
+
+    Example of using this class for sending results from a worker thread:
+    @code
+    MyFrame::MyFrame()
+        : m_results(1024)
+    {
+        m_results.SetNotifyHandler(this);
+        Bind(wxEVT_THREAD, &MyFrame::OnResults, this);
+    }
+
+    void MyFrame::OnResults(wxThreadEvent&)
+    {
+        std::vector<Result> results;
+        while ( m_results.ReceiveMany(results, 256) )
+            ;
+
+        for ( const Result& result : results )
+            ... use the result ...
+    }
+
+    // Called from the worker thread.
+    void MyFrame::AddResult(Result&& result)
+    {
+        m_results.Post(std::move(result));
+    }
+    @endcode
+
+    @tparam T
+        The type of the messages, must be movable.
+
+    @since 3.3.1
+
+    @nolibrary
+    @category{threading}
+
+    @see wxMessageQueue
+*/
+template <typename T>
+class wxBoundedMessageQueue<T>
+{
+public:
+    /**
+        Create the queue with the given capacity.
+
+        The capacity is rounded up to the next power of 2. Use IsOk() to check
+        if the object was successfully initialized.
+    */
+    explicit wxBoundedMessageQueue(size_t capacity);
+
+    /**
+        Destroy the queue and all messages remaining in it.
+
+        The queue must not be used by any other threads when it is destroyed.
+     */
+    ~wxBoundedMessageQueue();
+
+    /**
+        Returns @true if the object had been initialized successfully, @false
+        if an error occurred.
+    */
+    bool IsOk() const;
+
+    /**
+        Returns the maximal number of messages in the queue.
+
+        This is the value passed to the constructor rounded up to the next
+        power of 2.
+     */
+    size_t GetCapacity() const;
+
+    /**
+        Send an event to the given handler when a message is posted.
+
+        After calling this function, posting a message to the queue queues a
+        wxThreadEvent with the given type and ID to the specified handler,
+        unless such event had been already sent and none of Receive(),
+        ReceiveTimeout() or ReceiveMany() was called since then. The handler
+        of this event should receive all the messages available in the queue.
+
+        Because of this, the handler is typically a window or the application
+        object and the messages are received in the main thread.
+
+        This function must be called before posting any messages.
+     */
+    void SetNotifyHandler(wxEvtHandler* handler,
+                          wxEventType eventType = wxEVT_THREAD,
+                          int id = wxID_ANY);
+
+    /**
+        Add a message to the queue, waiting until there is space for it if
+        the queue is full.
+
+        This method is safe to call from multiple threads in parallel.
+    */
+    wxMessageQueueError Post(const T& msg);
+
+    /// @overload
+    wxMessageQueueError Post(T&& msg);
+
+    /**
+        Add a message to the queue, waiting until there is space for it for
+        at most @a timeout milliseconds.
+
+        Returns @c wxMSGQUEUE_TIMEOUT if the queue is still full after waiting
+        for the given time.
+    */
+    wxMessageQueueError PostTimeout(long timeout, const T& msg);
+
+    /// @overload
+    wxMessageQueueError PostTimeout(long timeout, T&& msg);
+
+    /**
+        Add a message to the queue if it is not full.
+
+        Returns @c wxMSGQUEUE_TIMEOUT immediately if the queue is full.
+    */
+    wxMessageQueueError TryPost(const T& msg);
+
+    /// @overload
+    wxMessageQueueError TryPost(T&& msg);
+
+    /**
+        Block until a message becomes available in the queue.
+
+        The message is returned in @a msg.
+    */
+    wxMessageQueueError Receive(T& msg);
+
+    /**
+        Block until a message becomes available in the queue, but for no more
+        than @a timeout milliseconds.
+
+        If no message is available after @a timeout milliseconds then returns
+        @c wxMSGQUEUE_TIMEOUT.
+    */
+    wxMessageQueueError ReceiveTimeout(long timeout, T& msg);
+
+    /**
+        Receive several messages at once.
+
+        Appends up to @a maxCount messages to @a out and returns the number
+        of appended messages, which may be 0 if no messages became available
+        during the given @a timeout.
+
+        @param out
+            Vector to which the messages are appended. Note that it is not
+            cleared by this function.
+        @param maxCount
+            Maximal number of messages to receive.
+        @param timeout
+            Time to wait for the first message in milliseconds. If it is 0,
+            which is the default, the function doesn't wait at all and if it
+            is negative, it waits until a message is posted. Once the first
+            message is received, the function never waits for any more
+            messages and just takes those already in the queue.
+     */
+    size_t ReceiveMany(std::vector<T>& out, size_t maxCount, long timeout = 0);
+};
@@ -18,6 +18,28 @@ enum wxStreamError
     wxSTREAM_READ_ERROR         //!< generic read error on the last read call.
 };
 
+/**
+    Buffer used by wxInputStream::ReadV().
+
+    @since 3.3.1
+*/
+struct wxStreamIOVec
+{
+    void *data;     //!< Pointer to the buffer to read the data into.
+    size_t size;    //!< Size of the buffer in bytes.
+};
+
+/**
+    Buffer used by wxOutputStream::WriteV().
+
+    @since 3.3.1
+*/
+struct wxStreamConstIOVec
+{
+    const void *data;   //!< Pointer to the data to write.
+    size_t size;        //!< Size of the data in bytes.
+};
+
 /**
     @class wxStreamBase
 
@@ -550,6 +572,37 @@ public:
     */
     bool WriteAll(const void* buffer, size_t size);
 
+    /**
+        Writes the data from several buffers in turn.
+
+        This is equivalent to calling Write() for each of the buffers, but
+        stops as soon as any of them can't be written completely. It can be
+        used to write data stored in separate buffers without copying it into
+        a single one first.
+
+        LastWrite() returns the total number of bytes written from all buffers
+        after calling this function.
+
+        The default implementation just calls Write() for each buffer, but
+        this function is overridden in wxFileOutputStream to use a single
+        system call for all of them under Unix.
+
+        @param vec Array of buffers to write, buffers of size 0 are skipped.
+        @param count Number of elements in @a vec.
+
+        @since 3.3.1
+    */
+    virtual wxOutputStream& WriteV(const wxStreamConstIOVec* vec, size_t count);
+
+    /**
+        Writes the data from several buffers in turn.
+
+        This overload is only available when using C++20 or later.
+
+        @since 3.3.1
+    */
+    wxOutputStream& WriteV(std::span<const wxStreamConstIOVec> vec);
+
 protected:
     /**
         Internal function. It is called when the stream wants to write data of the
@@ -665,6 +718,38 @@ public:
     */
     bool ReadAll(void* buffer, size_t size);
 
+    /**
+        Reads data into several buffers in turn.
+
+        Each buffer is filled completely before reading data into the next
+        one. If less data than the buffer size could be read, e.g. because
+        the end of the stream was reached, this function stops and doesn't
+        use the remaining buffers.
+
+        LastRead() returns the total number of bytes read into all buffers
+        after calling this function.
+
+        The default implementation just calls Read() for each buffer, but
+        this function is overridden in wxFileInputStream to use a single
+        system call for all of them under Unix.
+
+        @param vec Array of buffers to read the data into, buffers of size 0
+            are skipped.
+        @param count Number of elements in @a vec.
+
+        @since 3.3.1
+    */
+    virtual wxInputStream& ReadV(const wxStreamIOVec* vec, size_t count);
+
+    /**
+        Reads data into several buffers in turn.
+
+        This overload is only available when using C++20 or later.
+
+        @since 3.3.1
+    */
+    wxInputStream& ReadV(std::span<const wxStreamIOVec> vec);
+
     /**
         Changes the stream current position.
 
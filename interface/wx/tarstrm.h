@@ -45,6 +45,12 @@ enum wxTarFormat
     usually means they are only seekable if the tar is stored as a local file and
     is not compressed.
 
+    Sparse files stored by GNU tar, using either the old GNU format or the pax
+    format versions 0.1 and 1.0, are read with their holes filled with zeros,
+    see wxTarEntry::IsSparse(). Numbers stored in the GNU base-256 format,
+    which is used for the sizes of 8GB and more in the non-pax tars, are
+    supported as well.
+
     @library{wxbase}
     @category{archive,streams}
 
@@ -152,6 +158,9 @@ public:
 
         When the @a format is @e wxTAR_USTAR, no extended headers are generated,
         and instead a warning message is logged if any header field overflows.
+        Numeric fields which overflow, such as the sizes of entries of 8GB or
+        more, are stored in the GNU base-256 format instead, which is
+        understood by GNU tar and most other tar programs.
     */
     wxTarOutputStream(wxOutputStream& stream,
                       wxTarFormat format = wxTAR_PAX,
@@ -213,6 +222,73 @@ public:
     void SetBlockingFactor(int factor);
     ///@}
 
+    /**
+        Default size of the buffer used for writing to the parent stream.
+
+        @since 3.3.1
+    */
+    enum { DEFAULT_BUFFER_SIZE = 64*1024 };
+
+    ///@{
+    /**
+        Gets/sets the size of the buffer used for writing to the parent stream.
+
+        The output is collected in this buffer and written to the parent
+        stream in chunks of this size, which is rounded up to a multiple of
+        the record size, i.e. @e BlockingFactor * 512 bytes, when writing
+        starts. So the parent stream is only written in whole records, except
+        when the stream has to be flushed before seeking back to update the
+        header of an entry whose size wasn't given in advance.
+
+        The default size is @c DEFAULT_BUFFER_SIZE. Larger buffers reduce the
+        number of writes to the parent stream. This function should be called
+        before writing the first entry, together with SetBlockingFactor() if
+        necessary.
+
+        @since 3.3.1
+    */
+    void SetBufferSize(size_t size);
+    size_t GetBufferSize() const;
+    ///@}
+
+    /**
+        Enables or disables writing to the parent stream on a background
+        thread.
+
+        When the pipeline is enabled, the full buffers (see SetBufferSize())
+        are queued to be written to the parent stream by a separate thread.
+        If the parent stream is a filter stream, e.g. wxZlibOutputStream,
+        the compression, or any other processing done by the chain of the
+        parent streams, then runs concurrently with the code producing the
+        entries' data in the current thread, instead of alternating with it.
+
+        At most a few buffers are queued at any time, so writing blocks when
+        the parent stream can't keep up. The parent stream must not be used
+        directly while the pipeline is enabled. Errors in it are reported by
+        the subsequent calls to Write(), CloseEntry() or Close().
+
+        This function should be called before writing the first entry.
+        Disabling the pipeline waits until all the queued data has been
+        written. It is disabled automatically when the stream is destroyed.
+
+        @return @true if the pipeline was enabled or disabled as requested,
+            @false if the thread couldn't be created, including when
+            @c wxUSE_THREADS is 0, or if an error occurred while writing
+            the queued data when disabling it.
+
+        @since 3.3.1
+    */
+    bool SetPipelined(bool pipelined = true);
+
+    /**
+        Returns @true if the pipeline is enabled.
+
+        @see SetPipelined()
+
+        @since 3.3.1
+    */
+    bool IsPipelined() const;
+
     /**
         Create a new directory entry (see wxArchiveEntry::IsDir()) with the given
         name and timestamp.
@@ -364,6 +440,19 @@ public:
     wxFileOffset GetSize() const;
     ///@}
 
+    /**
+        Returns @true if this is a sparse file read from the tar.
+
+        Only the regions of sparse files that contain data are stored in the
+        tar, while the holes between them are not. wxTarInputStream fills the
+        holes with zeros when reading the entry, and GetSize() returns the
+        full size of the file. The holes are not recreated when the entry is
+        copied to a wxTarOutputStream, so it is then stored as a regular file.
+
+        @since 3.3.1
+    */
+    bool IsSparse() const;
+
     ///@{
     /**
         Returns/Sets the type of the entry as a ::wxTarType value.
@@ -0,0 +1,244 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        wx/task.h
+// Purpose:     interface of wxTask<T> and coroutine awaitables
+// Author:      wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+    Result type of C++20 coroutines integrated with wxWidgets event loop.
+
+    Any function returning wxTask<T> can use @c co_await to wait for the
+    completion of the asynchronous operations represented by the awaitables
+    defined in this header, e.g. wxSleepAsync() or wxAsyncProcess, or by other
+    tasks, without blocking the event loop and without defining any event
+    handlers:
+    @code
+    wxTask<int> CountLines(const wxString& command)
+    {
+        wxAsyncProcess process(command, 0, wxPROCESS_REDIRECT);
+        if ( co_await process != 0 )
+            co_return -1;
+
+        wxTextInputStream text(*process.GetProcess().GetInputStream());
+        int lines = 0;
+        while ( !text.ReadLine().empty() )
+            lines++;
+
+        co_return lines;
+    }
+
+    wxTask<> MyFrame::UpdateStatus()
+    {
+        SetStatusText(wxString::Format("%d lines", co_await CountLines("ls")));
+    }
+    @endcode
+
+    Tasks start running immediately when the coroutine is called and run
+    until its first suspension point. When the awaited operation completes,
+    the coroutine is resumed from the main event loop. Destroying a wxTask
+    object doesn't cancel the coroutine, it keeps running and cleans up after
+    itself, so it's fine to ignore the tasks which are not going to be
+    awaited, e.g. @c UpdateStatus() above can be just called from an event
+    handler.
+
+    Exceptions thrown by a coroutine are rethrown when awaiting its task. If
+    the task was detached, wxApp::OnUnhandledException() is called instead.
+
+    This class and everything else in this header is only available when
+    using C++20 compiler supporting coroutines, in which case @c
+    wxHAS_COROUTINES symbol is defined. It has no effect whatsoever on the
+    code not including this header.
+
+    @tparam T
+        Type of the value returned by the coroutine using @c co_return, may
+        be @c void (which is also the default).
+
+    @since 3.3.1
+
+    @nolibrary
+    @category{events}
+ */
+template <typename T = void>
+class wxTask
+{
+public:
+    /**
+        Default constructor creates an invalid task.
+
+        Valid tasks are only created by calling coroutines.
+     */
+    wxTask();
+
+    /// Tasks are movable but not copyable.
+    wxTask(wxTask&& other);
+
+    /// Tasks are movable but not copyable.
+    wxTask& operator=(wxTask&& other);
+
+    /**
+        Destructor detaches the coroutine if it's still running.
+
+        See Detach().
+     */
+    ~wxTask();
+
+    /// Return @true if the task is associated with a coroutine.
+    bool IsOk() const;
+
+    /// Return @true if the coroutine has already finished.
+    bool IsDone() const;
+
+    /**
+        Let the coroutine run on its own.
+
+        After calling this function the task is not valid any more and the
+        coroutine destroys its state when it finishes.
+     */
+    void Detach();
+
+    /**
+        Suspend the calling coroutine until this task completes.
+
+        Returns the value returned by the task coroutine or rethrows the
+        exception thrown by it. Note that a task can be awaited only once.
+
+        Awaiting an invalid task, i.e. one for which IsOk() returns @false,
+        is a programming error: it results in an assertion failure and then
+        @c std::logic_error being thrown from the @c co_await expression.
+     */
+    Awaiter operator co_await() const;
+};
+
+/**
+    Resume a suspended coroutine from the event loop.
+
+    This function queues resumption of the coroutine for execution by the
+    main thread event loop using wxEvtHandler::CallAfter() on the application
+    object, which is also how all the awaitables in this header resume the
+    coroutines waiting for them. It can be used to implement custom
+    awaitables.
+
+    @since 3.3.1
+ */
+void wxResumeOnEventLoop(std::coroutine_handle<> coro);
+
+/**
+    Suspend the coroutine until the next event of the given type.
+
+    Returns a copy of the event once it is received, e.g.
+    @code
+    wxCommandEvent event = co_await wxAwaitEvent(*button, wxEVT_BUTTON);
+    @endcode
+
+    The event is skipped, so any other handlers for it are still executed.
+
+    @since 3.3.1
+ */
+template <typename Tag>
+wxEventAwaiter<Tag>
+wxAwaitEvent(wxEvtHandler& source, const Tag& eventType, int id = wxID_ANY);
+
+/**
+    Suspend the coroutine for the given number of milliseconds.
+
+    This is implemented using a one-shot wxTimer. If @a milliseconds is
+    zero or negative, the coroutine just yields to the event loop and is
+    resumed as soon as the pending events are processed.
+
+    Only available if @c wxUSE_TIMER is 1.
+
+    @since 3.3.1
+ */
+wxTimerAwaiter wxSleepAsync(int milliseconds);
+
+/**
+    Launches a process asynchronously and allows to wait for its termination.
+
+    Awaiting an object of this class calls wxExecute() and suspends the
+    coroutine until the process terminates. The result of @c co_await is the
+    process exit code or -1 if it couldn't be launched.
+
+    @since 3.3.1
+ */
+class wxAsyncProcess
+{
+public:
+    /**
+        Constructor doesn't launch the process yet.
+
+        @param command
+            Command to execute.
+        @param flags
+            Flags for wxExecute(), wxEXEC_ASYNC is always added to them.
+        @param processFlags
+            Flags for wxProcess constructor, e.g. wxPROCESS_REDIRECT.
+     */
+    explicit wxAsyncProcess(const wxString& command,
+                            int flags = 0,
+                            int processFlags = wxPROCESS_DEFAULT);
+
+    /// Return the underlying process object, e.g. to access its streams.
+    wxProcess& GetProcess();
+
+    /// Return the PID of the process after it was launched.
+    long GetPid() const;
+};
+
+/**
+    Connect the socket without blocking.
+
+    The result of awaiting the returned object is @true if the connection was
+    established or @false otherwise.
+
+    The specified @a handler is associated with the socket using
+    wxSocketBase::SetEventHandler() and the socket is configured to send
+    wxSOCKET_CONNECTION and wxSOCKET_LOST notifications to it, so it must
+    remain alive as long as the socket is. The notifications flags may be
+    changed after the connection is established.
+
+    Only available if @c wxUSE_SOCKETS is 1 and requires linking with the
+    net library.
+
+    @since 3.3.1
+ */
+wxSocketConnectAwaiter
+wxAsyncConnect(wxSocketClient& socket,
+               wxEvtHandler& handler,
+               const wxSockAddress& addr);
+
+/**
+    Executes wxWebRequest and allows to wait for its completion.
+
+    Example of use:
+    @code
+    wxAsyncWebRequest request(wxWebSession::GetDefault(), url);
+    request->SetHeader("Accept", "application/json");
+    if ( co_await request == wxWebRequest::State_Completed )
+        ProcessJSON(request->GetResponse().AsString());
+    @endcode
+
+    Awaiting this object starts the request, if necessary, and returns its
+    state when it becomes final or wxWebRequest::State_Unauthorized. In the
+    latter case, the request can be awaited again after providing the
+    credentials using wxWebAuthChallenge::SetCredentials().
+
+    Only available if @c wxUSE_WEBREQUEST is 1 and requires linking with the
+    net library.
+
+    @since 3.3.1
+ */
+class wxAsyncWebRequest
+{
+public:
+    /// Create the request in the given session without starting it.
+    wxAsyncWebRequest(wxWebSession& session,
+                      const wxString& url,
+                      int id = wxID_ANY);
+
+    /// Return the request object, e.g. to configure it before starting.
+    wxWebRequest& GetRequest();
+
+    /// Convenient shortcut for GetRequest().
+    wxWebRequest* operator->();
+};
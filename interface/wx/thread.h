@@ -1517,6 +1517,143 @@ public:
 };
 
 
+/**
+    @class wxRWLock
+
+    wxRWLock is a synchronization object which can be held either by any
+    number of readers at the same time or by a single writer.
+
+    It is useful for protecting data which is read much more often than it
+    is modified, as, unlike with wxMutex, the readers don't block each other.
+    Under Unix this class uses POSIX @c pthread_rwlock_t and under MSW it uses
+    slim reader/writer locks, so acquiring the lock doesn't involve any system
+    calls when it is not contended.
+
+    Note that read locks are not recursive: a thread already holding the lock
+    for reading must not try to acquire it again as this may deadlock if
+    another thread is waiting to acquire it for writing in the meanwhile.
+
+    It is usually more convenient to use wxRWLockReadLocker and
+    wxRWLockWriteLocker instead of calling this class methods directly.
+
+    @since 3.3.1
+
+    @library{wxbase}
+    @category{threading}
+
+    @see wxMutex
+*/
+class wxRWLock
+{
+public:
+    /**
+        Default constructor.
+
+        Use IsOk() to check if the lock was successfully initialized.
+     */
+    wxRWLock();
+
+    /**
+        Destructor is not virtual, don't use this class polymorphically.
+     */
+    ~wxRWLock();
+
+    /**
+        Returns @true if the lock was created successfully.
+     */
+    bool IsOk() const;
+
+    /**
+        Acquires the lock for reading, blocking while it is held for writing.
+
+        @return wxMUTEX_NO_ERROR if the lock was acquired or an error code.
+     */
+    wxMutexError LockRead();
+
+    /**
+        Tries to acquire the lock for reading without blocking.
+
+        @return wxMUTEX_NO_ERROR if the lock was acquired, wxMUTEX_BUSY if it
+            is currently held for writing or another error code.
+     */
+    wxMutexError TryLockRead();
+
+    /**
+        Releases the lock acquired with LockRead() or TryLockRead().
+     */
+    wxMutexError UnlockRead();
+
+    /**
+        Acquires the lock for writing, blocking while it is held by any
+        other reader or writer.
+
+        @return wxMUTEX_NO_ERROR if the lock was acquired or an error code.
+     */
+    wxMutexError LockWrite();
+
+    /**
+        Tries to acquire the lock for writing without blocking.
+
+        @return wxMUTEX_NO_ERROR if the lock was acquired, wxMUTEX_BUSY if it
+            is currently held by anybody or another error code.
+     */
+    wxMutexError TryLockWrite();
+
+    /**
+        Releases the lock acquired with LockWrite() or TryLockWrite().
+     */
+    wxMutexError UnlockWrite();
+};
+
+/**
+    @class wxRWLockReadLocker
+
+    Helper class acquiring wxRWLock for reading in its constructor and
+    releasing it in its destructor.
+
+    @since 3.3.1
+
+    @library{wxbase}
+    @category{threading}
+*/
+class wxRWLockReadLocker
+{
+public:
+    /// Acquires the lock for reading.
+    explicit wxRWLockReadLocker(wxRWLock& lock);
+
+    /// Returns @true if the lock was successfully acquired in the constructor.
+    bool IsOk() const;
+
+    /// Releases the lock if it was acquired.
+    ~wxRWLockReadLocker();
+};
+
+/**
+    @class wxRWLockWriteLocker
+
+    Helper class acquiring wxRWLock for writing in its constructor and
+    releasing it in its destructor.
+
+    @since 3.3.1
+
+    @library{wxbase}
+    @category{threading}
+*/
+class wxRWLockWriteLocker
+{
+public:
+    /// Acquires the lock for writing.
+    explicit wxRWLockWriteLocker(wxRWLock& lock);
+
+    /// Returns @true if the lock was successfully acquired in the constructor.
+    bool IsOk() const;
+
+    /// Releases the lock if it was acquired.
+    ~wxRWLockWriteLocker();
+};
+
+
 
 /**
     @class wxMutexLocker
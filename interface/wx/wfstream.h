@@ -265,6 +265,138 @@ public:
 
 
 
+/**
+    Hint about the expected access pattern for wxMappedFileInputStream.
+
+    @since 3.3.1
+*/
+enum wxMappedFileAccess
+{
+    /// No special access pattern, use the system defaults.
+    wxMAPPED_ACCESS_NORMAL,
+
+    /// The data will be read from the beginning to the end.
+    wxMAPPED_ACCESS_SEQUENTIAL,
+
+    /// The data will be accessed in random order.
+    wxMAPPED_ACCESS_RANDOM
+};
+
+/**
+    @class wxMappedFileInputStream
+
+    Read-only stream giving access to the file mapped in memory.
+
+    Unlike wxFileInputStream, this stream doesn't read the file contents in
+    an intermediate buffer, but maps it into the process address space, so
+    that the data is only read from disk when it is accessed. Besides the
+    usual wxInputStream functions, it also allows to access the data directly
+    using GetData() or PeekData() and Skip(), which can be used to avoid
+    copying it at all: e.g. wxXmlDocument parses the data of this stream in
+    place.
+
+    If the file can't be mapped, e.g. because it is located on a file system
+    not supporting this, its entire contents is read into memory instead, so
+    the stream can still be used, but IsMapped() returns @false for it.
+
+    This stream is always seekable, however, unlike with wxFileInputStream,
+    seeking beyond the end of the file is not allowed.
+
+    Note that the file must not be truncated while it is mapped, as accessing
+    the data beyond its new end would result in a crash.
+
+    @since 3.3.1
+
+    @library{wxbase}
+    @category{streams}
+
+    @see wxFileInputStream, wxMemoryInputStream
+*/
+class wxMappedFileInputStream : public wxInputStream
+{
+public:
+    /**
+        Opens the specified file and maps it in memory.
+
+        The @a access parameter is passed to SetAccessHint().
+
+        @warning
+        You should use wxStreamBase::IsOk() to verify if the constructor succeeded.
+    */
+    explicit wxMappedFileInputStream(const wxString& fileName,
+                                     wxMappedFileAccess access
+                                        = wxMAPPED_ACCESS_SEQUENTIAL);
+
+    /**
+        Destructor unmaps the file.
+
+        All pointers returned by GetData() and PeekData() become invalid
+        after the stream is destroyed.
+    */
+    virtual ~wxMappedFileInputStream();
+
+    /**
+        Returns the pointer to the contents of the entire file.
+
+        The returned pointer may be @NULL if the file is empty.
+    */
+    const void* GetData() const;
+
+    /**
+        Returns the size of the file, i.e. of the data returned by GetData().
+    */
+    size_t GetDataLen() const;
+
+    /**
+        Returns the pointer to the data at the current position.
+
+        This function doesn't change the current position, call Skip() to
+        advance it after using the data.
+
+        Note that if any data was put back into the stream using
+        wxInputStream::Ungetch(), this function returns just this data first
+        and so @a len may be less than the number of bytes remaining in the
+        file. Call this function again after skipping over the returned data
+        to get the rest of it.
+
+        @param len Receives the number of bytes available at the returned
+            pointer, 0 if the end of file was reached. Must be non-@NULL.
+    */
+    const void* PeekData(size_t* len) const;
+
+    /**
+        Advances the current position by the given number of bytes.
+
+        This is equivalent to reading the data, but doesn't copy it.
+
+        @return The number of bytes actually skipped, which is less than @a
+            len only if the end of the file was reached.
+    */
+    size_t Skip(size_t len);
+
+    /**
+        Tells the system how the mapped data is going to be accessed.
+
+        This is only a hint allowing the system to optimize reading the data
+        from disk, it doesn't affect the behaviour of the stream.
+
+        Currently this is only implemented under Unix systems.
+
+        @return @true if the hint was applied, @false if it's not supported.
+    */
+    bool SetAccessHint(wxMappedFileAccess access);
+
+    /**
+        Returns @true if the file is mapped in memory.
+
+        Returns @false if the file contents was read in memory instead, as
+        well as for the empty files which can't be mapped.
+    */
+    bool IsMapped() const;
+};
+
+
+
 /**
     @class wxFFileInputStream
 
@@ -417,6 +417,32 @@ public:
     */
     wxZipEntry* GetNextEntry();
 
+    /**
+        Returns the position of the central directory record of the entry
+        which will be returned by the next call to GetNextEntry().
+
+        This position can be passed to GetEntryAt() later to read the entry
+        again without having to keep the wxZipEntry object itself.
+
+        Returns ::wxInvalidOffset if the stream is not seekable or if there
+        are no more entries.
+
+        @since 3.3.1
+    */
+    wxFileOffset GetCentralPosition();
+
+    /**
+        Reads the meta-data for the entry with the central directory record at
+        the given position, returned by GetCentralPosition(), and returns it in
+        a wxZipEntry object, giving away ownership.
+
+        After calling this function, GetNextEntry() continues with the entry
+        following the returned one. The zip must be on a seekable stream.
+
+        @since 3.3.1
+    */
+    wxZipEntry* GetEntryAt(wxFileOffset pos);
+
     /**
         For a zip on a seekable stream returns the total number of entries in
         the zip. For zips on non-seekable streams returns the number of entries
@@ -621,3 +647,184 @@ public:
     wxZipArchiveFormat GetFormat() const;
 };
 
+
+
+
+/**
+    @class wxZipParallelReader
+
+    Reads the entries of a zip file using several threads.
+
+    The central directory of the zip file is read only once, when this object
+    is created. After this, ReadEntries() or ExtractTo() inflate the entries
+    concurrently. Each worker thread opens its own stream for the file, so the
+    entries can be read independently of each other.
+
+    Example of extracting a zip file using all the available CPUs:
+    @code
+    wxZipParallelReader reader("bundle.zip");
+    if ( !reader.IsOk() || !reader.ExtractTo("/path/to/bundle") )
+        wxLogError("Failed to extract the bundle.");
+    @endcode
+
+    @library{wxbase}
+    @category{archive,streams}
+
+    @see wxZipInputStream, wxZipParallelWriter
+
+    @since 3.3.1
+*/
+class wxZipParallelReader
+{
+public:
+    /**
+        The type of the function called by ReadEntries() for each entry.
+
+        It is passed the entry and a stream positioned at the start of its
+        data. It must return @false to stop reading the entries.
+    */
+    typedef std::function<bool (const wxZipEntry& entry,
+                                wxInputStream& stream)> EntryFunc;
+
+    /**
+        Constructor reads the central directory of the given file.
+
+        Use IsOk() to check whether this succeeded.
+
+        @a conv is used to translate the entry names and comments.
+    */
+    wxZipParallelReader(const wxString& filename,
+                        wxMBConv& conv = wxConvLocal);
+
+    /**
+        Returns @true if the zip file could be opened and its directory read.
+    */
+    bool IsOk() const;
+
+    /**
+        Returns the number of entries in the zip file.
+    */
+    size_t GetEntryCount() const;
+
+    /**
+        Returns the entry with the given index.
+
+        The entries are in the order of the zip central directory.
+    */
+    const wxZipEntry& GetEntry(size_t n) const;
+
+    /**
+        Calls the given function for all the entries.
+
+        The function is called from up to @a numThreads threads at once,
+        including the calling one, so it must be thread-safe. The order in
+        which the entries are processed is unspecified. If @a numThreads is
+        0, as many threads as wxThread::GetCPUCount() are used.
+
+        Returns @true if all the entries were read successfully, or @false if
+        an error occurred or if @a func returned @false.
+    */
+    bool ReadEntries(const EntryFunc& func, unsigned numThreads = 0);
+
+    /**
+        Extracts all entries into the given directory.
+
+        The directories are created before extracting the files, which is
+        done concurrently as with ReadEntries(). The modification times of
+        the extracted files are set to those of the entries.
+
+        Nothing is extracted if any entry name would result in a path outside
+        of @a dir, i.e. if it contains ".." components.
+
+        Returns @true if all entries were extracted successfully.
+    */
+    bool ExtractTo(const wxString& dir, unsigned numThreads = 0);
+};
+
+
+
+/**
+    @class wxZipParallelWriter
+
+    Writes entries to a zip file compressing them using several threads.
+
+    The entries are added using AddEntry() or AddFile() and are then written
+    by Write(), which deflates them concurrently into temporary memory buffers
+    and copies them to the output zip stream in the order in which they were
+    added. Only a limited number of compressed entries is kept in memory at
+    any time.
+
+    Example:
+    @code
+    wxFileOutputStream file("bundle.zip");
+    wxZipOutputStream zip(file);
+
+    wxZipParallelWriter writer(zip);
+    for ( const wxString& name : names )
+        writer.AddFile(name, name);
+
+    if ( !writer.Write() || !zip.Close() )
+        wxLogError("Failed to create the bundle.");
+    @endcode
+
+    @library{wxbase}
+    @category{archive,streams}
+
+    @see wxZipOutputStream, wxZipParallelReader
+
+    @since 3.3.1
+*/
+class wxZipParallelWriter
+{
+public:
+    /**
+        The type of the function writing the data of an entry.
+
+        It must write all the data to the provided stream and return @true,
+        or return @false if an error occurred.
+    */
+    typedef std::function<bool (wxOutputStream& stream)> DataFunc;
+
+    /**
+        Constructor takes the stream to write the entries to.
+
+        The compression level of @a zip is used for all entries. The stream
+        must remain valid until Write() returns and the caller is still
+        responsible for closing it after that.
+    */
+    explicit wxZipParallelWriter(wxZipOutputStream& zip);
+
+    /**
+        Adds an entry with the data written by the given function.
+
+        This object takes ownership of @a entry. @a func may be empty for
+        directory entries or empty files. Otherwise it is called from one of
+        the worker threads, so it must be thread-safe.
+    */
+    void AddEntry(wxZipEntry* entry, const DataFunc& func = DataFunc());
+
+    /**
+        Adds an entry with the given name and the contents of the file.
+
+        Returns @false if the file doesn't exist.
+    */
+    bool AddFile(const wxString& filename, const wxString& name);
+
+    /**
+        Returns the number of entries added and not written yet.
+    */
+    size_t GetEntryCount() const;
+
+    /**
+        Writes all the added entries using up to the given number of threads.
+
+        If @a numThreads is 0, as many threads as wxThread::GetCPUCount() are
+        used. If it is 1, or if threads are not available, the entries are
+        compressed directly into the output stream instead.
+
+        All the entries are consumed by this function, even if it fails.
+
+        Returns @true if all entries were written successfully.
+    */
+    bool Write(unsigned numThreads = 0);
+};
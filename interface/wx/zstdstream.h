@@ -0,0 +1,156 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/zstdstream.h
+// Purpose:     Zstandard [de]compression classes documentation
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+    @class wxZstdInputStream
+
+    This filter stream decompresses data in Zstandard format.
+
+    Zstandard format is used by .zst files and is both significantly faster
+    and usually more efficient than GZip format supported by
+    wxZlibInputStream. Several concatenated frames are decompressed as a
+    single stream, as with the zstd command line utility.
+
+    This class is only available if wxWidgets was built with @c wxUSE_LIBZSTD
+    set to 1, which requires libzstd library.
+
+    @library{wxbase}
+    @category{archive,streams}
+
+    @see wxInputStream, wxZlibInputStream, wxZstdOutputStream.
+
+    @since 3.3.1
+*/
+class wxZstdInputStream : public wxFilterInputStream
+{
+public:
+    /**
+        Create decompressing stream associated with the given underlying
+        stream.
+
+        This overload does not take ownership of the @a stream.
+    */
+    wxZstdInputStream(wxInputStream& stream);
+
+    /**
+        Create decompressing stream associated with the given underlying
+        stream and takes ownership of it.
+
+        As with the base wxFilterInputStream class, passing @a stream by
+        pointer indicates that this object takes ownership of it and will
+        delete it when it is itself destroyed.
+     */
+    wxZstdInputStream(wxInputStream* stream);
+
+    ///@{
+    /**
+        Sets the dictionary to use for decompressing the data.
+
+        This must be the same dictionary as was used for compressing it,
+        i.e. either a dictionary created by the zstd utility or just any
+        data to be used as raw content dictionary.
+
+        It must be called before reading anything from the stream.
+
+        Returns @true if the dictionary was set successfully.
+    */
+    bool SetDictionary(const char *data, size_t datalen);
+    bool SetDictionary(const wxMemoryBuffer &buf);
+    ///@}
+};
+
+/**
+    @class wxZstdOutputStream
+
+    This filter stream compresses data using Zstandard format.
+
+    The output is compatible with the zstd utility working with .zst files.
+
+    This class is only available if wxWidgets was built with @c wxUSE_LIBZSTD
+    set to 1, which requires libzstd library.
+
+    @library{wxbase}
+    @category{archive,streams}
+
+    @see wxOutputStream, wxZlibOutputStream, wxZstdInputStream
+
+    @since 3.3.1
+*/
+class wxZstdOutputStream : public wxFilterOutputStream
+{
+public:
+    /**
+        Create compressing stream associated with the given underlying
+        stream.
+
+        The compression @a level can be between 1 and GetMaxLevel(), with
+        higher levels compressing better but more slowly, or -1 to use the
+        default level.
+
+        This overload does not take ownership of the @a stream.
+    */
+    wxZstdOutputStream(wxOutputStream& stream, int level = -1);
+
+    /**
+        Create compressing stream associated with the given underlying
+        stream and takes ownership of it.
+
+        As with the base wxFilterOutputStream class, passing @a stream by
+        pointer indicates that this object takes ownership of it and will
+        delete it when it is itself destroyed.
+     */
+    wxZstdOutputStream(wxOutputStream* stream, int level = -1);
+
+    ///@{
+    /**
+        Sets the dictionary to use for compressing the data.
+
+        The same dictionary must then be used when decompressing the data
+        with wxZstdInputStream::SetDictionary().
+
+        It must be called before writing anything to the stream.
+
+        Returns @true if the dictionary was set successfully.
+    */
+    bool SetDictionary(const char *data, size_t datalen);
+    bool SetDictionary(const wxMemoryBuffer &buf);
+    ///@}
+
+    /**
+        Use the given number of worker threads for compressing the data.
+
+        By default, and if @a numThreads is 0, the data is compressed in the
+        thread writing it. Otherwise it is compressed by the given number of
+        worker threads while the writing thread continues, which is much
+        faster for big amounts of data.
+
+        It must be called before writing anything to the stream.
+
+        Returns @false if libzstd was built without multithreading support,
+        in which case the data is still compressed in a single thread.
+    */
+    bool SetThreadCount(unsigned numThreads);
+
+    /**
+        Returns the maximal compression level supported by libzstd.
+    */
+    static int GetMaxLevel();
+};
+
+/**
+    Return the version of libzstd library used by Zstandard stream classes.
+
+    @see wxVersionInfo
+
+    @header{wx/zstdstream.h}
+    @library{wxbase}
+
+    @since 3.3.1
+*/
+wxVersionInfo wxGetLibZstdVersionInfo();
@@ -149,3 +149,139 @@ public:
     ///@}
 };
 
+
+
+/**
+    @class wxIndexedGzipInputStream
+
+    This filter stream decompresses a stream in zlib or gzip format and, unlike
+    wxZlibInputStream, allows seeking to arbitrary positions in the
+    uncompressed data if the parent stream is seekable.
+
+    To make this efficient, the stream remembers the decompressor state every
+    @e span bytes of uncompressed data while reading it. Seeking then only
+    needs to decompress the data from the closest preceding checkpoint instead
+    of starting from the beginning of the stream. The index of checkpoints is
+    built incrementally while reading the data, but BuildIndex() can be used to
+    create it for the entire stream at once. As creating the index requires
+    decompressing all the data, it can also be saved using SaveIndex() and
+    loaded later using LoadIndex() to make seeking in the same data fast from
+    the start.
+
+    Each checkpoint stores up to 32KiB of (compressed) data, so the span should
+    be chosen as a compromise between the memory used by the index and the
+    speed of seeking.
+
+    Concatenated gzip streams are decompressed as a single stream, as with the
+    @c gzip utility.
+
+    wxFilterFSHandler uses this class for the "gzip" and "zlib" protocols if
+    the underlying stream is seekable and loads the index from the file with
+    the name returned by GetIndexFileName() if it exists.
+
+    @library{wxbase}
+    @category{archive,streams}
+
+    @since 3.3.1
+
+    @see wxZlibInputStream
+*/
+class wxIndexedGzipInputStream : public wxFilterInputStream
+{
+public:
+    /// Default distance between the checkpoints in uncompressed data.
+    enum { DEFAULT_SPAN = 1024*1024 };
+
+    ///@{
+    /**
+        Create the stream reading compressed data from the given parent stream.
+
+        If the parent stream is passed as a pointer then the new filter stream
+        takes ownership of it. If it is passed by reference then it does not.
+
+        The @a flags have the same meaning as for wxZlibInputStream.
+
+        The @a span parameter specifies the distance between checkpoints in
+        the uncompressed data, it can't be less than 32KiB.
+    */
+    wxIndexedGzipInputStream(wxInputStream& stream,
+                             int flags = wxZLIB_AUTO,
+                             size_t span = DEFAULT_SPAN);
+    wxIndexedGzipInputStream(wxInputStream* stream,
+                             int flags = wxZLIB_AUTO,
+                             size_t span = DEFAULT_SPAN);
+    ///@}
+
+    /**
+        Returns the length of the uncompressed data.
+
+        The length is only known once the index is complete, i.e. after the
+        end of the stream was reached or after a successful call to
+        BuildIndex() or LoadIndex(), and ::wxInvalidOffset is returned before
+        this.
+    */
+    wxFileOffset GetLength() const;
+
+    /**
+        Returns @true if the parent stream is seekable.
+    */
+    bool IsSeekable() const;
+
+    /**
+        Decompress all the data remaining after the last checkpoint to
+        complete the index.
+
+        The current position in the stream is preserved.
+
+        Returns @true if the index is complete.
+    */
+    bool BuildIndex();
+
+    /**
+        Returns @true if the index covers the entire stream.
+    */
+    bool IsIndexComplete() const;
+
+    /**
+        Returns the number of checkpoints in the index.
+    */
+    size_t GetCheckpointCount() const;
+
+    ///@{
+    /**
+        Save the index to the given stream or file.
+
+        The index can be saved even if it is not complete yet, but it is
+        usually done after calling BuildIndex().
+    */
+    bool SaveIndex(wxOutputStream& stream) const;
+    bool SaveIndex(const wxString& filename) const;
+    ///@}
+
+    ///@{
+    /**
+        Load the index previously saved by SaveIndex().
+
+        Returns @false if the index couldn't be read, is corrupted or was
+        created for different data, the existing index is preserved then. The
+        index stores the length of the compressed data and a checksum of its
+        beginning and end, including the gzip header and trailer, and is
+        rejected if they don't match the data of this stream, e.g. because
+        the compressed file was modified after saving the index.
+
+        As this requires seeking in the underlying stream, both this function
+        and SaveIndex() fail if it is not seekable.
+    */
+    bool LoadIndex(wxInputStream& stream);
+    bool LoadIndex(const wxString& filename);
+    ///@}
+
+    /**
+        Returns the name of the index file to use for the given compressed
+        file.
+
+        Currently this just appends ".gzidx" extension to the file name.
+    */
+    static wxString GetIndexFileName(const wxString& filename);
+};
+
@@ -35,7 +35,9 @@
 #include "wx/cmdline.h"
 #include "wx/confbase.h"
 #include "wx/evtloop.h"
+#include "wx/evtloopstats.h"
 #include "wx/filename.h"
+#include "wx/idlesched.h"
 #include "wx/msgout.h"
 #include "wx/scopedptr.h"
 #include "wx/sysopt.h"
@@ -428,6 +430,8 @@ void wxAppConsoleBase::WakeUpIdle()
 
 bool wxAppConsoleBase::ProcessIdle()
 {
+    wxEventLoopStats::IdleScope statsScope;
+
     // synthesize an idle event and check if more of them are needed
     wxIdleEvent event;
     event.SetEventObject(this);
@@ -436,6 +440,24 @@ bool wxAppConsoleBase::ProcessIdle()
     // called from an extern "C" callback (e.g. this is the case in wxGTK).
     SafelyProcessEvent(event);
 
+    // Run the background tasks, if any, within their time budget.
+    bool needMore = false;
+    wxIdleTaskScheduler& scheduler = wxIdleTaskScheduler::Get();
+    if ( scheduler.HasTasks() )
+    {
+        needMore = wxSafeCall<bool>([&scheduler]
+        {
+            return scheduler.ProcessIdle();
+        }, []()
+        {
+#if wxUSE_EXCEPTIONS
+            wxEvtHandler::WXConsumeException();
+#endif // wxUSE_EXCEPTIONS
+
+            return false;
+        });
+    }
+
 #if wxUSE_LOG
     // flush the logged messages if any (do this after processing the events
     // which could have logged new messages)
@@ -445,7 +467,7 @@ bool wxAppConsoleBase::ProcessIdle()
     // Garbage collect all objects previously scheduled for destruction.
     DeletePendingObjects();
 
-    return event.MoreRequested();
+    return event.MoreRequested() || needMore;
 }
 
 bool wxAppConsoleBase::UsesEventLoop() const
@@ -38,6 +38,7 @@
 #include "wx/thread.h"
 #include "wx/vidmode.h"
 #include "wx/evtloop.h"
+#include "wx/evtloopstats.h"
 #include "wx/uilocale.h"
 
 #if wxUSE_FONTMAP
@@ -404,6 +405,8 @@ bool wxAppBase::SafeYieldFor(wxWindow *win, long eventsToProcess)
 // Returns true if more time is needed.
 bool wxAppBase::ProcessIdle()
 {
+    wxEventLoopStats::IdleScope statsScope;
+
     // call the base class version first to send the idle event to wxTheApp
     // itself
     bool needMore = wxAppConsoleBase::ProcessIdle();
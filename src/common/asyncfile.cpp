@@ -0,0 +1,702 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/common/asyncfile.cpp
+// Purpose:     wxAsyncFile implementation and thread-based backend
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ============================================================================
+// declarations
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+// for compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+
+#if wxUSE_FILE && wxUSE_THREADS
+
+#include "wx/asyncfile.h"
+
+#ifndef WX_PRECOMP
+    #include "wx/log.h"
+    #include "wx/module.h"
+    #include "wx/translation.h"
+#endif // WX_PRECOMP
+
+#include "wx/private/asyncfile.h"
+
+#ifdef __WINDOWS__
+    #include "wx/msw/wrapwin.h"
+    #include <io.h>
+#else
+    #include <errno.h>
+    #include <unistd.h>
+#endif
+
+#include <deque>
+#include <vector>
+
+using namespace wxPrivate;
+
+wxDEFINE_EVENT( wxEVT_ASYNC_FILE_READ, wxAsyncFileEvent );
+wxDEFINE_EVENT( wxEVT_ASYNC_FILE_WRITE, wxAsyncFileEvent );
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxAsyncFileEvent, wxEvent);
+
+// ============================================================================
+// implementation
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// wxAsyncFileImpl: the common part of all backends
+// ----------------------------------------------------------------------------
+
+bool wxAsyncFileImpl::Submit(const wxAsyncFileRequest& req)
+{
+    {
+        wxMutexLocker lock(m_mutex);
+        m_pending++;
+    }
+
+    if ( !DoSubmit(req) )
+    {
+        wxMutexLocker lock(m_mutex);
+        m_pending--;
+        return false;
+    }
+
+    return true;
+}
+
+void wxAsyncFileImpl::Complete(const wxAsyncFileRequest& req,
+                               size_t count,
+                               unsigned long error,
+                               bool cancelled)
+{
+    wxAsyncFileEvent event(req.write ? wxEVT_ASYNC_FILE_WRITE
+                                     : wxEVT_ASYNC_FILE_READ,
+                           m_file.GetId());
+    event.SetEventObject(&m_file);
+    event.m_requestId = req.id;
+    event.m_offset = req.offset;
+    event.m_buffer = req.buffer;
+    event.m_requested = req.count;
+    event.m_count = count;
+    event.m_error = error;
+    event.m_cancelled = cancelled;
+
+    m_file.QueueEvent(event.Clone());
+
+    // Notice that this must be the last thing we do as the object may be
+    // destroyed as soon as the pending count drops to 0.
+    wxMutexLocker lock(m_mutex);
+    if ( !--m_pending )
+        m_cond.Broadcast();
+}
+
+void wxAsyncFileImpl::WaitForCompletions()
+{
+    wxMutexLocker lock(m_mutex);
+    while ( m_pending )
+        m_cond.Wait();
+}
+
+// ----------------------------------------------------------------------------
+// Thread-based backend
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+class wxAsyncFileImplThreads;
+
+// Pool of threads shared by all files using the thread-based backend.
+class wxAsyncFileThreadPool
+{
+public:
+    // Return the pool, creating it on first use, or null if no threads could
+    // be created at all. Each successful call must be matched by Release().
+    static wxAsyncFileThreadPool* Get();
+    static void Release(wxAsyncFileThreadPool* pool);
+
+    // Stop the pool when the library is shut down. It is only destroyed when
+    // it is not used by any files any more.
+    static void Cleanup();
+
+    // Queue the request for execution or, if the pool is already stopped,
+    // complete it as cancelled immediately.
+    void Add(wxAsyncFileImplThreads* impl, const wxAsyncFileRequest& req);
+
+    // Remove the request from the queue if it hadn't been started yet.
+    bool Remove(wxAsyncFileImplThreads* impl,
+                long id,
+                wxAsyncFileRequest& req);
+
+    // Remove all the not yet started requests for the given file.
+    void RemoveAll(wxAsyncFileImplThreads* impl,
+                   std::vector<wxAsyncFileRequest>& reqs);
+
+private:
+    class Worker : public wxThread
+    {
+    public:
+        explicit Worker(wxAsyncFileThreadPool& pool)
+            : wxThread(wxTHREAD_JOINABLE),
+              m_pool(pool)
+        {
+        }
+
+    protected:
+        virtual ExitCode Entry() override
+        {
+            m_pool.Run();
+            return nullptr;
+        }
+
+    private:
+        wxAsyncFileThreadPool& m_pool;
+    };
+
+    struct Job
+    {
+        wxAsyncFileImplThreads* impl;
+        wxAsyncFileRequest req;
+    };
+
+    wxAsyncFileThreadPool();
+    ~wxAsyncFileThreadPool();
+
+    // Start the worker threads, return false if none could be started.
+    bool Start();
+
+    // Stop the worker threads, waiting until they finish executing the
+    // current requests, and complete all the not yet started ones as
+    // cancelled, as otherwise the files would wait for them forever.
+    void Stop();
+
+    // Main function of the worker threads.
+    void Run();
+
+    wxMutex m_mutex;
+    wxCondition m_cond;
+    std::deque<Job> m_jobs;
+    std::vector<Worker*> m_threads;
+    bool m_stop;
+
+    // Number of files using this pool, protected by gs_csAsyncFilePool.
+    size_t m_users;
+
+    static wxAsyncFileThreadPool* ms_pool;
+
+    wxDECLARE_NO_COPY_CLASS(wxAsyncFileThreadPool);
+};
+
+wxAsyncFileThreadPool* wxAsyncFileThreadPool::ms_pool = nullptr;
+
+wxCRIT_SECT_DECLARE(gs_csAsyncFilePool);
+
+// Perform the blocking I/O for the given request and return the number of
+// bytes transferred, which is less than requested at the end of file or if
+// an error occurred, in which case its code is returned in the last argument.
+size_t DoBlockingIO(int fd, const wxAsyncFileRequest& req, unsigned long& error)
+{
+    // Avoid passing sizes not representable as DWORD or ssize_t.
+    static const size_t MAX_CHUNK = 1 << 30;
+
+    char* const buf = static_cast<char*>(req.buffer);
+    size_t done = 0;
+
+    error = 0;
+    while ( done < req.count )
+    {
+        const size_t chunk = wxMin(req.count - done, MAX_CHUNK);
+        const wxFileOffset pos = req.offset + static_cast<wxFileOffset>(done);
+
+#ifdef __WINDOWS__
+        OVERLAPPED ov;
+        wxZeroMemory(ov);
+        ov.Offset = static_cast<DWORD>(pos & 0xffffffff);
+        ov.OffsetHigh = static_cast<DWORD>(pos >> 32);
+
+        HANDLE h = reinterpret_cast<HANDLE>(_get_osfhandle(fd));
+        DWORD n = 0;
+        const BOOL ok = req.write
+                            ? ::WriteFile(h, buf + done, static_cast<DWORD>(chunk), &n, &ov)
+                            : ::ReadFile(h, buf + done, static_cast<DWORD>(chunk), &n, &ov);
+        if ( !ok )
+        {
+            const DWORD rc = ::GetLastError();
+            if ( rc != ERROR_HANDLE_EOF )
+                error = rc;
+            break;
+        }
+#else // !__WINDOWS__
+        const ssize_t n = req.write ? pwrite(fd, buf + done, chunk, pos)
+                                    : pread(fd, buf + done, chunk, pos);
+        if ( n < 0 )
+        {
+            if ( errno == EINTR )
+                continue;
+
+            error = errno;
+            break;
+        }
+#endif // __WINDOWS__/!__WINDOWS__
+
+        // End of file.
+        if ( !n )
+            break;
+
+        done += n;
+    }
+
+    return done;
+}
+
+class wxAsyncFileImplThreads : public wxAsyncFileImpl
+{
+public:
+    wxAsyncFileImplThreads(wxAsyncFile& file,
+                           int fd,
+                           wxAsyncFileThreadPool* pool)
+        : wxAsyncFileImpl(file, fd),
+          m_pool(pool)
+    {
+    }
+
+    ~wxAsyncFileImplThreads()
+    {
+        CancelAll();
+        WaitAll();
+
+        wxAsyncFileThreadPool::Release(m_pool);
+    }
+
+    wxAsyncFileBackend GetBackend() const override
+    {
+        return wxASYNC_FILE_BACKEND_THREADS;
+    }
+
+    bool Cancel(long id) override
+    {
+        // Operations which are already running can't be cancelled.
+        wxAsyncFileRequest req;
+        if ( !m_pool->Remove(this, id, req) )
+            return false;
+
+        Complete(req, 0, 0, true);
+        return true;
+    }
+
+    void CancelAll() override
+    {
+        std::vector<wxAsyncFileRequest> reqs;
+        m_pool->RemoveAll(this, reqs);
+
+        for ( const auto& req : reqs )
+            Complete(req, 0, 0, true);
+    }
+
+    void WaitAll() override
+    {
+        WaitForCompletions();
+    }
+
+    // Called by the worker thread to perform the operation.
+    void Execute(const wxAsyncFileRequest& req)
+    {
+        unsigned long error;
+        const size_t count = DoBlockingIO(m_fd, req, error);
+
+        Complete(req, count, error, false);
+    }
+
+    // Called by the pool if the operation won't be executed at all.
+    void Abandon(const wxAsyncFileRequest& req)
+    {
+        Complete(req, 0, 0, true);
+    }
+
+protected:
+    bool DoSubmit(const wxAsyncFileRequest& req) override
+    {
+        m_pool->Add(this, req);
+        return true;
+    }
+
+private:
+    wxAsyncFileThreadPool* const m_pool;
+};
+
+wxAsyncFileThreadPool::wxAsyncFileThreadPool()
+    : m_cond(m_mutex)
+{
+    m_stop = false;
+    m_users = 0;
+}
+
+wxAsyncFileThreadPool::~wxAsyncFileThreadPool()
+{
+    Stop();
+}
+
+void wxAsyncFileThreadPool::Stop()
+{
+    {
+        wxMutexLocker lock(m_mutex);
+        m_stop = true;
+        m_cond.Broadcast();
+    }
+
+    for ( auto thread : m_threads )
+    {
+        thread->Wait();
+        delete thread;
+    }
+
+    m_threads.clear();
+
+    // No new jobs can be added once m_stop is set, so we can complete the
+    // remaining ones without holding the lock.
+    std::deque<Job> jobs;
+    {
+        wxMutexLocker lock(m_mutex);
+        jobs.swap(m_jobs);
+    }
+
+    for ( const auto& job : jobs )
+        job.impl->Abandon(job.req);
+}
+
+bool wxAsyncFileThreadPool::Start()
+{
+    // The operations are I/O bound, so use a few threads even on single CPU
+    // machines, but don't create too many of them neither.
+    const int numThreads = wxMax(2, wxMin(wxThread::GetCPUCount(), 8));
+
+    for ( int n = 0; n < numThreads; n++ )
+    {
+        Worker* const thread = new Worker(*this);
+        if ( thread->Run() != wxTHREAD_NO_ERROR )
+        {
+            delete thread;
+            break;
+        }
+
+        m_threads.push_back(thread);
+    }
+
+    return !m_threads.empty();
+}
+
+/* static */
+wxAsyncFileThreadPool* wxAsyncFileThreadPool::Get()
+{
+    wxCRIT_SECT_LOCKER(lock, gs_csAsyncFilePool);
+
+    if ( !ms_pool )
+    {
+        ms_pool = new wxAsyncFileThreadPool;
+        if ( !ms_pool->Start() )
+        {
+            wxLogError(_("Failed to start threads for asynchronous file I/O."));
+            delete ms_pool;
+            ms_pool = nullptr;
+            return nullptr;
+        }
+    }
+
+    ms_pool->m_users++;
+
+    return ms_pool;
+}
+
+/* static */
+void wxAsyncFileThreadPool::Release(wxAsyncFileThreadPool* pool)
+{
+    wxCRIT_SECT_LOCKER(lock, gs_csAsyncFilePool);
+
+    // Delete the pool if it had been already stopped by Cleanup() and this
+    // was the last file still using it.
+    if ( !--pool->m_users && pool != ms_pool )
+        delete pool;
+}
+
+/* static */
+void wxAsyncFileThreadPool::Cleanup()
+{
+    wxCRIT_SECT_LOCKER(lock, gs_csAsyncFilePool);
+
+    if ( !ms_pool )
+        return;
+
+    ms_pool->Stop();
+
+    if ( !ms_pool->m_users )
+        delete ms_pool;
+
+    ms_pool = nullptr;
+}
+
+void wxAsyncFileThreadPool::Add(wxAsyncFileImplThreads* impl,
+                                const wxAsyncFileRequest& req)
+{
+    {
+        wxMutexLocker lock(m_mutex);
+
+        if ( !m_stop )
+        {
+            m_jobs.push_back({impl, req});
+            m_cond.Signal();
+            return;
+        }
+    }
+
+    impl->Abandon(req);
+}
+
+bool wxAsyncFileThreadPool::Remove(wxAsyncFileImplThreads* impl,
+                                   long id,
+                                   wxAsyncFileRequest& req)
+{
+    wxMutexLocker lock(m_mutex);
+
+    for ( auto it = m_jobs.begin(); it != m_jobs.end(); ++it )
+    {
+        if ( it->impl == impl && it->req.id == id )
+        {
+            req = it->req;
+            m_jobs.erase(it);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void wxAsyncFileThreadPool::RemoveAll(wxAsyncFileImplThreads* impl,
+                                      std::vector<wxAsyncFileRequest>& reqs)
+{
+    wxMutexLocker lock(m_mutex);
+
+    for ( auto it = m_jobs.begin(); it != m_jobs.end(); )
+    {
+        if ( it->impl == impl )
+        {
+            reqs.push_back(it->req);
+            it = m_jobs.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void wxAsyncFileThreadPool::Run()
+{
+    for ( ;; )
+    {
+        Job job;
+
+        {
+            wxMutexLocker lock(m_mutex);
+            while ( m_jobs.empty() && !m_stop )
+                m_cond.Wait();
+
+            // Any remaining jobs are completed as cancelled by Stop().
+            if ( m_stop )
+                break;
+
+            job = m_jobs.front();
+            m_jobs.pop_front();
+        }
+
+        job.impl->Execute(job.req);
+    }
+}
+
+} // anonymous namespace
+
+/* static */
+wxAsyncFileImpl* wxAsyncFileImpl::CreateThreads(wxAsyncFile& file, int fd)
+{
+    wxAsyncFileThreadPool* const pool = wxAsyncFileThreadPool::Get();
+    if ( !pool )
+        return nullptr;
+
+    return new wxAsyncFileImplThreads(file, fd, pool);
+}
+
+#ifndef wxHAS_ASYNC_FILE_IO_URING
+
+/* static */
+wxAsyncFileImpl* wxAsyncFileImpl::CreateIoUring(wxAsyncFile& WXUNUSED(file),
+                                                int WXUNUSED(fd))
+{
+    return nullptr;
+}
+
+#endif // !wxHAS_ASYNC_FILE_IO_URING
+
+class wxAsyncFileModule : public wxModule
+{
+public:
+    bool OnInit() override { return true; }
+    void OnExit() override { wxAsyncFileThreadPool::Cleanup(); }
+
+private:
+    wxDECLARE_DYNAMIC_CLASS(wxAsyncFileModule);
+};
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxAsyncFileModule, wxModule);
+
+// ----------------------------------------------------------------------------
+// wxAsyncFile
+// ----------------------------------------------------------------------------
+
+wxAsyncFile::wxAsyncFile(wxEvtHandler *parent, int id)
+{
+    if ( parent )
+        SetNextHandler(parent);
+
+    m_impl = nullptr;
+    m_lastRequestId = 0;
+    m_id = id;
+}
+
+wxAsyncFile::~wxAsyncFile()
+{
+    Close();
+}
+
+bool wxAsyncFile::Open(const wxString& filename,
+                       wxFile::OpenMode mode,
+                       int access,
+                       wxAsyncFileBackend backend)
+{
+    wxCHECK_MSG( !IsOpened(), false, wxS("File is already opened") );
+
+    if ( !m_file.Open(filename, mode, access) )
+        return false;
+
+    switch ( backend )
+    {
+        case wxASYNC_FILE_BACKEND_DEFAULT:
+            m_impl = wxAsyncFileImpl::CreateIoUring(*this, m_file.fd());
+            if ( !m_impl )
+                m_impl = wxAsyncFileImpl::CreateThreads(*this, m_file.fd());
+            break;
+
+        case wxASYNC_FILE_BACKEND_THREADS:
+            m_impl = wxAsyncFileImpl::CreateThreads(*this, m_file.fd());
+            break;
+
+        case wxASYNC_FILE_BACKEND_IO_URING:
+            m_impl = wxAsyncFileImpl::CreateIoUring(*this, m_file.fd());
+            break;
+    }
+
+    if ( !m_impl )
+    {
+        wxLogError(_("Asynchronous I/O is not available for the file \"%s\"."),
+                   filename);
+        m_file.Close();
+        return false;
+    }
+
+    return true;
+}
+
+bool wxAsyncFile::Close()
+{
+    if ( !IsOpened() )
+        return true;
+
+    if ( m_impl )
+    {
+        m_impl->CancelAll();
+        m_impl->WaitAll();
+        wxDELETE(m_impl);
+    }
+
+    return m_file.Close();
+}
+
+wxAsyncFileBackend wxAsyncFile::GetBackend() const
+{
+    wxCHECK_MSG( m_impl, wxASYNC_FILE_BACKEND_DEFAULT,
+                 wxS("File must be opened") );
+
+    return m_impl->GetBackend();
+}
+
+long wxAsyncFile::DoSubmit(bool write,
+                           wxFileOffset offset,
+                           void *buffer,
+                           size_t count)
+{
+    wxCHECK_MSG( m_impl, 0, wxS("File must be opened") );
+    wxCHECK_MSG( offset >= 0, 0, wxS("Invalid offset") );
+    wxCHECK_MSG( buffer || !count, 0, wxS("Invalid buffer") );
+
+    // Request identifiers are always positive.
+    if ( ++m_lastRequestId <= 0 )
+        m_lastRequestId = 1;
+
+    wxAsyncFileRequest req;
+    req.id = m_lastRequestId;
+    req.write = write;
+    req.offset = offset;
+    req.buffer = buffer;
+    req.count = count;
+
+    if ( !m_impl->Submit(req) )
+        return 0;
+
+    return req.id;
+}
+
+long wxAsyncFile::ReadAt(wxFileOffset offset, void *buffer, size_t count)
+{
+    return DoSubmit(false, offset, buffer, count);
+}
+
+long wxAsyncFile::WriteAt(wxFileOffset offset, const void *buffer, size_t count)
+{
+    return DoSubmit(true, offset, const_cast<void*>(buffer), count);
+}
+
+bool wxAsyncFile::Cancel(long requestId)
+{
+    wxCHECK_MSG( m_impl, false, wxS("File must be opened") );
+
+    return m_impl->Cancel(requestId);
+}
+
+void wxAsyncFile::CancelAll()
+{
+    wxCHECK_RET( m_impl, wxS("File must be opened") );
+
+    m_impl->CancelAll();
+}
+
+size_t wxAsyncFile::GetPendingCount() const
+{
+    return m_impl ? m_impl->GetPendingCount() : 0;
+}
+
+void wxAsyncFile::WaitAll()
+{
+    wxCHECK_RET( m_impl, wxS("File must be opened") );
+
+    m_impl->WaitAll();
+}
+
+#endif // wxUSE_FILE && wxUSE_THREADS
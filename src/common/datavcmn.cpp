@@ -2480,7 +2480,10 @@ bool wxDataViewListCtrl::Create( wxWindow *parent, wxWindowID id,
     if ( !wxDataViewCtrl::Create( parent, id, pos, size, style, validator ) )
         return false;
 
+    // Compare() can't be overridden in our own store, so it can be sorted
+    // using the faster method.
     wxDataViewListStore *store = new wxDataViewListStore;
+    store->SetUsesDefaultCompare();
     AssociateModel( store );
     store->DecRef();
 
@@ -18,6 +18,7 @@
 
 #ifndef WX_PRECOMP
     #include "wx/math.h"
+    #include "wx/utils.h"
 #endif //WX_PRECOMP
 
 namespace
@@ -30,11 +31,78 @@ union Float32Data
     wxUint32 i;
 };
 
-union Float64Data
+// Size of the buffer used for converting the data before writing it: this
+// allows to write many values at once instead of calling Write() for each of
+// them.
+const size_t DATA_CHUNK_SIZE = 4096;
+
+inline wxUint16 SwapBytes(wxUint16 v) { return wxUINT16_SWAP_ALWAYS(v); }
+inline wxUint32 SwapBytes(wxUint32 v) { return wxUINT32_SWAP_ALWAYS(v); }
+inline wxUint64 SwapBytes(wxUint64 v) { return wxUINT64_SWAP_ALWAYS(v); }
+
+// Return true if the data in the given byte order must be swapped.
+inline bool NeedsSwap(bool be_order)
 {
-    wxFloat64 f;
-    wxUint32 i[2];
-};
+    return be_order != (wxBYTE_ORDER == wxBIG_ENDIAN);
+}
+
+// Swap bytes of all values of type T stored in the given buffer, which may
+// contain values of another type of the same size, e.g. doubles for wxUint64.
+//
+// Note that this loop is simple enough to be vectorized by the compiler.
+template <typename T>
+void SwapBytesInPlace(void *buffer, size_t size)
+{
+    char* const p = static_cast<char*>(buffer);
+    for ( size_t n = 0; n < size; n++ )
+    {
+        T v;
+        memcpy(&v, p + n*sizeof(T), sizeof(T));
+        v = SwapBytes(v);
+        memcpy(p + n*sizeof(T), &v, sizeof(T));
+    }
+}
+
+// Read size values of type T in the given byte order into the buffer.
+template <typename T>
+void DoReadArray(void *buffer, size_t size, wxInputStream *input, bool be_order)
+{
+    input->Read(buffer, size*sizeof(T));
+
+    if ( NeedsSwap(be_order) )
+        SwapBytesInPlace<T>(buffer, size);
+}
+
+// Write size values of type T from the buffer in the given byte order.
+template <typename T>
+void DoWriteArray(const void *buffer, size_t size, wxOutputStream *output, bool be_order)
+{
+    if ( !NeedsSwap(be_order) )
+    {
+        output->Write(buffer, size*sizeof(T));
+        return;
+    }
+
+    // Convert the data in chunks to avoid allocating a copy of all of it.
+    char chunk[DATA_CHUNK_SIZE];
+    const size_t chunkSize = DATA_CHUNK_SIZE / sizeof(T);
+
+    const char* p = static_cast<const char*>(buffer);
+    while ( size )
+    {
+        const size_t count = wxMin(size, chunkSize);
+        const size_t len = count*sizeof(T);
+
+        memcpy(chunk, p, len);
+        SwapBytesInPlace<T>(chunk, count);
+
+        if ( output->Write(chunk, len).LastWrite() != len )
+            break;
+
+        p += len;
+        size -= count;
+    }
+}
 
 } // anonymous namespace
 
@@ -130,20 +198,9 @@ double wxDataInputStream::ReadDouble()
     else
 #endif // wxUSE_APPLE_IEEE
     {
-        Float64Data floatData;
-
-        if ( m_be_order == (wxBYTE_ORDER == wxBIG_ENDIAN) )
-        {
-            floatData.i[0] = Read32();
-            floatData.i[1] = Read32();
-        }
-        else
-        {
-            floatData.i[1] = Read32();
-            floatData.i[0] = Read32();
-        }
-
-        return static_cast<double>(floatData.f);
+        double d;
+        ReadDouble(&d, 1);
+        return d;
     }
 }
 
@@ -264,66 +321,14 @@ static void DoWriteLL(const T *buffer, size_t size, wxOutputStream *output, bool
     delete[] pchBuffer;
 }
 
-template <class T>
-static
-void DoReadI64(T *buffer, size_t size, wxInputStream *input, bool be_order)
-{
-    typedef T DataType;
-    unsigned char *pchBuffer = (unsigned char*) buffer;
-    // TODO: Check for overflow when size is of type uint and is > than 512m
-    input->Read(pchBuffer, size * 8);
-    if ( be_order )
-    {
-        for ( wxUint32 i = 0; i < size; i++ )
-        {
-            DataType v = wxUINT64_SWAP_ON_LE(*buffer);
-            *(buffer++) = v;
-        }
-    }
-    else // little endian
-    {
-        for ( wxUint32 i=0; i<size; i++ )
-        {
-            DataType v = wxUINT64_SWAP_ON_BE(*buffer);
-            *(buffer++) = v;
-        }
-    }
-}
-
-template <class T>
-static
-void DoWriteI64(const T *buffer, size_t size, wxOutputStream *output, bool be_order)
-{
-  typedef T DataType;
-  if ( be_order )
-  {
-    for ( size_t i = 0; i < size; i++ )
-    {
-      DataType i64 = wxUINT64_SWAP_ON_LE(*buffer);
-      buffer++;
-      output->Write(&i64, 8);
-    }
-  }
-  else // little endian
-  {
-    for ( size_t i=0; i < size; i++ )
-    {
-      DataType i64 = wxUINT64_SWAP_ON_BE(*buffer);
-      buffer++;
-      output->Write(&i64, 8);
-    }
-  }
-}
-
-
 void wxDataInputStream::Read64(wxUint64 *buffer, size_t size)
 {
-    DoReadI64(buffer, size, m_input, m_be_order);
+    DoReadArray<wxUint64>(buffer, size, m_input, m_be_order);
 }
 
 void wxDataInputStream::Read64(wxInt64 *buffer, size_t size)
 {
-    DoReadI64(buffer, size, m_input, m_be_order);
+    DoReadArray<wxUint64>(buffer, size, m_input, m_be_order);
 }
 
 void wxDataInputStream::Read64(wxULongLong *buffer, size_t size)
@@ -355,46 +360,12 @@ wxLongLong wxDataInputStream::ReadLL(void)
 
 void wxDataInputStream::Read32(wxUint32 *buffer, size_t size)
 {
-    m_input->Read(buffer, size * 4);
-
-    if (m_be_order)
-    {
-        for (wxUint32 i=0; i<size; i++)
-        {
-            wxUint32 v = wxUINT32_SWAP_ON_LE(*buffer);
-            *(buffer++) = v;
-        }
-    }
-    else
-    {
-        for (wxUint32 i=0; i<size; i++)
-        {
-            wxUint32 v = wxUINT32_SWAP_ON_BE(*buffer);
-            *(buffer++) = v;
-        }
-    }
+    DoReadArray<wxUint32>(buffer, size, m_input, m_be_order);
 }
 
 void wxDataInputStream::Read16(wxUint16 *buffer, size_t size)
 {
-  m_input->Read(buffer, size * 2);
-
-  if (m_be_order)
-  {
-    for (wxUint32 i=0; i<size; i++)
-    {
-      wxUint16 v = wxUINT16_SWAP_ON_LE(*buffer);
-      *(buffer++) = v;
-    }
-  }
-  else
-  {
-    for (wxUint32 i=0; i<size; i++)
-    {
-      wxUint16 v = wxUINT16_SWAP_ON_BE(*buffer);
-      *(buffer++) = v;
-    }
-  }
+    DoReadArray<wxUint16>(buffer, size, m_input, m_be_order);
 }
 
 void wxDataInputStream::Read8(wxUint8 *buffer, size_t size)
@@ -404,18 +375,44 @@ void wxDataInputStream::Read8(wxUint8 *buffer, size_t size)
 
 void wxDataInputStream::ReadDouble(double *buffer, size_t size)
 {
-  for (wxUint32 i=0; i<size; i++)
-  {
-    *(buffer++) = ReadDouble();
-  }
+#if wxUSE_APPLE_IEEE
+    if ( m_useExtendedPrecision )
+    {
+        for ( size_t i = 0; i < size; i++ )
+        {
+            *(buffer++) = ReadDouble();
+        }
+    }
+    else
+#endif // wxUSE_APPLE_IEEE
+    {
+        // Doubles are stored in the same way as 64 bit integers, so just
+        // read all of them at once.
+        wxCOMPILE_TIME_ASSERT( sizeof(double) == sizeof(wxUint64),
+                               DoubleSizeMismatch );
+
+        DoReadArray<wxUint64>(buffer, size, m_input, m_be_order);
+    }
 }
 
 void wxDataInputStream::ReadFloat(float *buffer, size_t size)
 {
-  for (wxUint32 i=0; i<size; i++)
-  {
-    *(buffer++) = ReadFloat();
-  }
+#if wxUSE_APPLE_IEEE
+    if ( m_useExtendedPrecision )
+    {
+        for ( size_t i = 0; i < size; i++ )
+        {
+            *(buffer++) = ReadFloat();
+        }
+    }
+    else
+#endif // wxUSE_APPLE_IEEE
+    {
+        wxCOMPILE_TIME_ASSERT( sizeof(float) == sizeof(wxUint32),
+                               FloatSizeMismatch );
+
+        DoReadArray<wxUint32>(buffer, size, m_input, m_be_order);
+    }
 }
 
 wxDataInputStream& wxDataInputStream::operator>>(wxString& s)
@@ -566,20 +563,7 @@ void wxDataOutputStream::WriteDouble(double d)
     else
 #endif // wxUSE_APPLE_IEEE
     {
-        Float64Data floatData;
-
-        floatData.f = (wxFloat64)d;
-
-        if ( m_be_order == (wxBYTE_ORDER == wxBIG_ENDIAN) )
-        {
-            Write32(floatData.i[0]);
-            Write32(floatData.i[1]);
-        }
-        else
-        {
-            Write32(floatData.i[1]);
-            Write32(floatData.i[0]);
-        }
+        WriteDouble(&d, 1);
     }
 }
 
@@ -602,12 +586,12 @@ void wxDataOutputStream::WriteFloat(float f)
 
 void wxDataOutputStream::Write64(const wxUint64 *buffer, size_t size)
 {
-    DoWriteI64(buffer, size, m_output, m_be_order);
+    DoWriteArray<wxUint64>(buffer, size, m_output, m_be_order);
 }
 
 void wxDataOutputStream::Write64(const wxInt64 *buffer, size_t size)
 {
-    DoWriteI64(buffer, size, m_output, m_be_order);
+    DoWriteArray<wxUint64>(buffer, size, m_output, m_be_order);
 }
 
 void wxDataOutputStream::Write64(const wxULongLong *buffer, size_t size)
@@ -642,46 +626,12 @@ void wxDataOutputStream::WriteLL(const wxULongLong &ll)
 
 void wxDataOutputStream::Write32(const wxUint32 *buffer, size_t size)
 {
-  if (m_be_order)
-  {
-    for (wxUint32 i=0; i<size ;i++)
-    {
-      wxUint32 i32 = wxUINT32_SWAP_ON_LE(*buffer);
-      buffer++;
-      m_output->Write(&i32, 4);
-    }
-  }
-  else
-  {
-    for (wxUint32 i=0; i<size ;i++)
-    {
-      wxUint32 i32 = wxUINT32_SWAP_ON_BE(*buffer);
-      buffer++;
-      m_output->Write(&i32, 4);
-    }
-  }
+    DoWriteArray<wxUint32>(buffer, size, m_output, m_be_order);
 }
 
 void wxDataOutputStream::Write16(const wxUint16 *buffer, size_t size)
 {
-  if (m_be_order)
-  {
-    for (wxUint32 i=0; i<size ;i++)
-    {
-      wxUint16 i16 = wxUINT16_SWAP_ON_LE(*buffer);
-      buffer++;
-      m_output->Write(&i16, 2);
-    }
-  }
-  else
-  {
-    for (wxUint32 i=0; i<size ;i++)
-    {
-      wxUint16 i16 = wxUINT16_SWAP_ON_BE(*buffer);
-      buffer++;
-      m_output->Write(&i16, 2);
-    }
-  }
+    DoWriteArray<wxUint16>(buffer, size, m_output, m_be_order);
 }
 
 void wxDataOutputStream::Write8(const wxUint8 *buffer, size_t size)
@@ -691,18 +641,37 @@ void wxDataOutputStream::Write8(const wxUint8 *buffer, size_t size)
 
 void wxDataOutputStream::WriteDouble(const double *buffer, size_t size)
 {
-  for (wxUint32 i=0; i<size; i++)
-  {
-    WriteDouble(*(buffer++));
-  }
+#if wxUSE_APPLE_IEEE
+    if ( m_useExtendedPrecision )
+    {
+        for ( size_t i = 0; i < size; i++ )
+        {
+            WriteDouble(*(buffer++));
+        }
+    }
+    else
+#endif // wxUSE_APPLE_IEEE
+    {
+        // As for reading, write all the doubles as 64 bit integers at once.
+        DoWriteArray<wxUint64>(buffer, size, m_output, m_be_order);
+    }
 }
 
 void wxDataOutputStream::WriteFloat(const float *buffer, size_t size)
 {
-  for (wxUint32 i=0; i<size; i++)
-  {
-    WriteFloat(*(buffer++));
-  }
+#if wxUSE_APPLE_IEEE
+    if ( m_useExtendedPrecision )
+    {
+        for ( size_t i = 0; i < size; i++ )
+        {
+            WriteFloat(*(buffer++));
+        }
+    }
+    else
+#endif // wxUSE_APPLE_IEEE
+    {
+        DoWriteArray<wxUint32>(buffer, size, m_output, m_be_order);
+    }
 }
 
 wxDataOutputStream& wxDataOutputStream::operator<<(const wxString& string)
@@ -22,6 +22,7 @@
 #include "wx/event.h"
 #include "wx/eventfilter.h"
 #include "wx/evtloop.h"
+#include "wx/evtloopstats.h"
 
 #ifndef WX_PRECOMP
     #include "wx/list.h"
@@ -1078,6 +1079,22 @@ bool wxEventHashTable::HandleEvent(wxEvent &event, wxEvtHandler *self)
     return false;
 }
 
+bool wxEventHashTable::HasEntriesFor(wxEventType eventType)
+{
+    if (m_rebuildHash)
+    {
+        InitHashTable();
+        m_rebuildHash = false;
+    }
+
+    if (!m_eventTypeTable)
+        return false;
+
+    const EventTypeTablePointer eTTnode = m_eventTypeTable[eventType % m_size];
+
+    return eTTnode && eTTnode->eventType == eventType;
+}
+
 void wxEventHashTable::InitHashTable()
 {
     // Loop over the event tables and all its base tables.
@@ -1261,6 +1278,25 @@ bool wxEvtHandler::IsUnlinked() const
            m_nextHandler == nullptr;
 }
 
+bool wxEvtHandler::HasHandlersFor(wxEventType eventType) const
+{
+    // Any chained handler could process the event, be conservative.
+    if ( !IsUnlinked() )
+        return true;
+
+    if ( m_dynamicEvents )
+    {
+        for ( const wxDynamicEventTableEntry* entry : m_dynamicEvents->m_entries )
+        {
+            // Null entries correspond to the handlers which were unbound.
+            if ( entry && entry->m_eventType == eventType )
+                return true;
+        }
+    }
+
+    return GetEventHashTable().HasEntriesFor(eventType);
+}
+
 wxEventFilter* wxEvtHandler::ms_filterList = nullptr;
 
 /* static */ void wxEvtHandler::AddFilter(wxEventFilter* filter)
@@ -1428,6 +1464,9 @@ void wxEvtHandler::ProcessPendingEvents()
 
     wxLEAVE_CRIT_SECT( m_pendingEventsLock );
 
+    if ( wxEventLoopStats* const stats = wxEventLoopStats::Get() )
+        stats->OnPendingEvent();
+
     // We must not let exceptions escape from here, there is no outer exception
     // handler to catch them and so letting them do it would just terminate the
     // program.
@@ -1458,6 +1497,8 @@ bool wxEvtHandler::ProcessEventIfMatchesId(const wxEventTableEntryBase& entry,
         event.Skip(false);
         event.m_callbackUserData = entry.m_callbackUserData;
 
+        wxEventLoopStats::HandlerScope statsScope(handler, event);
+
 #if wxUSE_EXCEPTIONS
         if ( wxTheApp )
         {
@@ -1535,6 +1576,9 @@ bool wxEvtHandler::ProcessEvent(wxEvent& event)
     // the event handler chain and possibly upwards the window hierarchy.
     if ( !event.WasProcessed() )
     {
+        if ( wxEventLoopStats* const stats = wxEventLoopStats::Get() )
+            stats->OnEvent(event);
+
         for ( wxEventFilter* f = ms_filterList; f; f = f->m_next )
         {
             int rc = f->FilterEvent(event);
@@ -0,0 +1,556 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/common/evtloopstats.cpp
+// Purpose:     wxEventLoopStats implementation
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ============================================================================
+// declarations
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+// for compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+
+#include "wx/evtloopstats.h"
+
+#ifndef WX_PRECOMP
+    #include "wx/log.h"
+    #include "wx/module.h"
+    #include "wx/thread.h"
+    #include "wx/utils.h"
+#endif // WX_PRECOMP
+
+#include "wx/time.h"
+
+#include <algorithm>
+
+// ============================================================================
+// wxEventLoopHistogram implementation
+// ============================================================================
+
+void wxEventLoopHistogram::Reset()
+{
+    for ( int n = 0; n < NUM_BUCKETS; n++ )
+        m_buckets[n] = 0;
+
+    m_count = 0;
+    m_total = 0;
+    m_max = 0;
+}
+
+void wxEventLoopHistogram::Add(wxLongLong_t durationUS)
+{
+    int n = 0;
+    for ( wxLongLong_t d = durationUS / 2; d && n < NUM_BUCKETS - 1; d /= 2 )
+        n++;
+
+    m_buckets[n]++;
+    m_count++;
+    m_total += durationUS;
+    if ( durationUS > m_max )
+        m_max = durationUS;
+}
+
+size_t wxEventLoopHistogram::GetBucketCount(int n) const
+{
+    wxCHECK_MSG( n >= 0 && n < NUM_BUCKETS, 0, "invalid bucket index" );
+
+    return m_buckets[n];
+}
+
+/* static */
+wxLongLong_t wxEventLoopHistogram::GetBucketLimit(int n)
+{
+    wxCHECK_MSG( n >= 0 && n < NUM_BUCKETS, 0, "invalid bucket index" );
+
+    return static_cast<wxLongLong_t>(1) << (n + 1);
+}
+
+wxLongLong_t wxEventLoopHistogram::GetPercentile(double percent) const
+{
+    if ( !m_count )
+        return 0;
+
+    const double threshold = m_count * percent / 100.;
+
+    size_t count = 0;
+    for ( int n = 0; n < NUM_BUCKETS - 1; n++ )
+    {
+        count += m_buckets[n];
+        if ( count >= threshold )
+            return wxMin(GetBucketLimit(n), m_max);
+    }
+
+    return m_max;
+}
+
+// ============================================================================
+// stall detector thread
+// ============================================================================
+
+#if wxUSE_THREADS
+
+class wxEventLoopStallThread : public wxThread
+{
+public:
+    wxEventLoopStallThread(wxEventLoopStats& stats,
+                           long thresholdMS,
+                           const wxEventLoopStats::StallHandler& handler)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_stats(stats),
+          m_threshold(thresholdMS),
+          m_handler(handler)
+    {
+    }
+
+    void Stop()
+    {
+        m_stop.Post();
+        Wait();
+    }
+
+protected:
+    virtual ExitCode Entry() override
+    {
+        // Check a few times per threshold period to avoid detecting the
+        // stalls too late.
+        const long period = wxMax(m_threshold / 4, 1L);
+
+        // The start of the last busy period for which we already reported
+        // the stall, as we only report it once.
+        wxLongLong_t lastReported = 0;
+
+        while ( m_stop.WaitTimeout(period) == wxSEMA_TIMEOUT )
+        {
+            const wxLongLong_t busySince = m_stats.m_busySince;
+            if ( !busySince || busySince == lastReported )
+                continue;
+
+            const long duration =
+                static_cast<long>((m_stats.Now() - busySince) / 1000);
+            if ( duration < m_threshold )
+                continue;
+
+            lastReported = busySince;
+
+            wxEventLoopStallInfo info;
+            info.duration = duration;
+            info.isIdle = m_stats.m_busyIsIdle;
+            info.eventType = m_stats.m_busyEventType;
+            info.id = m_stats.m_busyId;
+            if ( const wxChar* const handlerClass = m_stats.m_busyHandlerClass )
+                info.handlerClass = handlerClass;
+
+            if ( m_handler )
+            {
+                m_handler(info);
+            }
+            else if ( info.isIdle )
+            {
+                wxLogWarning("Event loop blocked for %ldms in idle handlers.",
+                             info.duration);
+            }
+            else
+            {
+                wxLogWarning("Event loop blocked for %ldms in handler of "
+                             "event %d (id=%d) in %s.",
+                             info.duration, info.eventType, info.id,
+                             info.handlerClass);
+            }
+        }
+
+        return nullptr;
+    }
+
+private:
+    wxEventLoopStats& m_stats;
+    const long m_threshold;
+    const wxEventLoopStats::StallHandler m_handler;
+
+    wxSemaphore m_stop;
+};
+
+#endif // wxUSE_THREADS
+
+// ============================================================================
+// wxEventLoopStats implementation
+// ============================================================================
+
+wxEventLoopStats wxEventLoopStats::ms_stats;
+bool wxEventLoopStats::ms_enabled = false;
+
+wxEventLoopStats::wxEventLoopStats()
+{
+    m_busyLevel = 0;
+    m_idleLevel = 0;
+    m_maxSlowestHandlers = 10;
+
+#if wxUSE_THREADS
+    m_busySince = 0;
+    m_busyIsIdle = false;
+    m_busyEventType = wxEVT_NULL;
+    m_busyId = wxID_ANY;
+    m_busyHandlerClass = nullptr;
+
+    m_stallThread = nullptr;
+#endif // wxUSE_THREADS
+
+    Reset();
+}
+
+wxEventLoopStats::~wxEventLoopStats()
+{
+#if wxUSE_THREADS
+    // This should have been already done by wxEventLoopStatsModule.
+    wxASSERT_MSG( !m_stallThread, "stall detector still running" );
+#endif // wxUSE_THREADS
+}
+
+/* static */
+void wxEventLoopStats::Enable(bool enable)
+{
+    ms_enabled = enable;
+
+#if wxUSE_THREADS
+    if ( !enable )
+        ms_stats.StopStallDetector();
+#endif // wxUSE_THREADS
+}
+
+void wxEventLoopStats::Reset()
+{
+    m_iterationBusy = 0;
+
+    m_iterationTimes.Reset();
+    m_handlerTimes.Reset();
+    m_idleTimes.Reset();
+
+    m_pendingEvents = 0;
+
+    m_eventCounts.clear();
+    m_slowestHandlers.clear();
+}
+
+size_t wxEventLoopStats::GetEventCount(wxEventType eventType) const
+{
+    const auto it = m_eventCounts.find(eventType);
+
+    return it == m_eventCounts.end() ? 0 : it->second;
+}
+
+std::vector<std::pair<wxEventType, size_t>>
+wxEventLoopStats::GetEventCounts() const
+{
+    std::vector<std::pair<wxEventType, size_t>>
+        counts(m_eventCounts.begin(), m_eventCounts.end());
+
+    std::sort(counts.begin(), counts.end(),
+              [](const std::pair<wxEventType, size_t>& a,
+                 const std::pair<wxEventType, size_t>& b)
+              {
+                  return a.second > b.second;
+              });
+
+    return counts;
+}
+
+void wxEventLoopStats::SetMaxSlowestHandlers(size_t count)
+{
+    m_maxSlowestHandlers = count;
+
+    if ( m_slowestHandlers.size() > count )
+        m_slowestHandlers.resize(count);
+}
+
+wxString wxEventLoopStats::Dump() const
+{
+    wxString s;
+
+    const auto dumpHistogram = [&s](const char* name,
+                                    const wxEventLoopHistogram& h)
+    {
+        s << wxString::Format
+             (
+                "%s: %zu, average %" wxLongLongFmtSpec "dus, "
+                "50%% < %" wxLongLongFmtSpec "dus, "
+                "99%% < %" wxLongLongFmtSpec "dus, "
+                "max %" wxLongLongFmtSpec "dus\n",
+                name,
+                h.GetCount(),
+                h.GetAverage(),
+                h.GetPercentile(50),
+                h.GetPercentile(99),
+                h.GetMax()
+             );
+    };
+
+    dumpHistogram("Iterations", m_iterationTimes);
+    dumpHistogram("Handler calls", m_handlerTimes);
+    dumpHistogram("Idle passes", m_idleTimes);
+
+    s << wxString::Format("Pending events: %zu\n", m_pendingEvents);
+
+    s << "Events:\n";
+    for ( const auto& count : GetEventCounts() )
+        s << wxString::Format("    %d: %zu\n", count.first, count.second);
+
+    s << "Slowest handlers:\n";
+    for ( const auto& info : m_slowestHandlers )
+    {
+        s << wxString::Format
+             (
+                "    %" wxLongLongFmtSpec "dus: event %d (id=%d) from %s in %s\n",
+                info.duration,
+                info.eventType,
+                info.id,
+                info.sourceClass.empty() ? wxString("unknown")
+                                         : info.sourceClass,
+                info.handlerClass
+             );
+    }
+
+    return s;
+}
+
+// ----------------------------------------------------------------------------
+// hooks called by the event processing code
+// ----------------------------------------------------------------------------
+
+void wxEventLoopStats::OnEvent(const wxEvent& event)
+{
+    if ( !wxIsMainThread() )
+        return;
+
+    m_eventCounts[event.GetEventType()]++;
+}
+
+void wxEventLoopStats::OnIterationEnd()
+{
+    m_iterationTimes.Add(m_iterationBusy);
+    m_iterationBusy = 0;
+}
+
+bool
+wxEventLoopStats::BeginBusy(wxLongLong_t start,
+                            bool isIdle,
+                            wxEventType eventType,
+                            int id,
+                            const wxChar* handlerClass)
+{
+    if ( m_busyLevel++ )
+        return false;
+
+#if wxUSE_THREADS
+    m_busyIsIdle = isIdle;
+    m_busyEventType = eventType;
+    m_busyId = id;
+    m_busyHandlerClass = handlerClass;
+
+    // Set this one last as the stall detector only checks the other fields
+    // if it is non-zero.
+    m_busySince = start ? start : 1;
+#else // !wxUSE_THREADS
+    wxUnusedVar(start);
+    wxUnusedVar(isIdle);
+    wxUnusedVar(eventType);
+    wxUnusedVar(id);
+    wxUnusedVar(handlerClass);
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+
+    return true;
+}
+
+void wxEventLoopStats::EndBusy(wxLongLong_t duration)
+{
+    m_busyLevel--;
+
+    if ( duration >= 0 )
+    {
+        m_iterationBusy += duration;
+
+#if wxUSE_THREADS
+        m_busySince = 0;
+#endif // wxUSE_THREADS
+    }
+}
+
+void wxEventLoopStats::OnHandlerStart(HandlerScope& scope,
+                                      wxEvtHandler* handler,
+                                      const wxEvent& event)
+{
+    // Only the events processed by the main thread are relevant.
+    if ( !wxIsMainThread() )
+    {
+        scope.m_start = -1;
+        return;
+    }
+
+    scope.m_eventType = event.GetEventType();
+    scope.m_id = event.GetId();
+
+    scope.m_handlerClass = handler->GetClassInfo()->GetClassName();
+
+    const wxObject* const source = event.GetEventObject();
+    scope.m_sourceClass = source ? source->GetClassInfo()->GetClassName()
+                                 : nullptr;
+
+    scope.m_start = Now();
+
+    scope.m_isOutermost = BeginBusy(scope.m_start, false,
+                                    scope.m_eventType, scope.m_id,
+                                    scope.m_handlerClass);
+}
+
+void wxEventLoopStats::OnHandlerEnd(HandlerScope& scope)
+{
+    if ( scope.m_start < 0 )
+        return;
+
+    const wxLongLong_t duration = Now() - scope.m_start;
+
+    EndBusy(scope.m_isOutermost ? duration : -1);
+
+    m_handlerTimes.Add(duration);
+
+    if ( !m_maxSlowestHandlers )
+        return;
+
+    if ( m_slowestHandlers.size() == m_maxSlowestHandlers &&
+            duration <= m_slowestHandlers.back().duration )
+        return;
+
+    wxEventLoopHandlerInfo info;
+    info.eventType = scope.m_eventType;
+    info.id = scope.m_id;
+    info.handlerClass = scope.m_handlerClass;
+    if ( scope.m_sourceClass )
+        info.sourceClass = scope.m_sourceClass;
+    info.timestamp = wxGetUTCTimeMillis().GetValue();
+    info.duration = duration;
+
+    const auto it = std::upper_bound
+                    (
+                        m_slowestHandlers.begin(),
+                        m_slowestHandlers.end(),
+                        duration,
+                        [](wxLongLong_t d, const wxEventLoopHandlerInfo& i)
+                        {
+                            return d > i.duration;
+                        }
+                    );
+    m_slowestHandlers.insert(it, info);
+
+    if ( m_slowestHandlers.size() > m_maxSlowestHandlers )
+        m_slowestHandlers.pop_back();
+}
+
+void wxEventLoopStats::OnIdleStart(IdleScope& scope)
+{
+    scope.m_start = -1;
+
+    if ( !wxIsMainThread() )
+        return;
+
+    // Idle processing is nested when wxApp::ProcessIdle() in GUI
+    // applications calls the base class version, only time the outer call.
+    if ( m_idleLevel++ )
+        return;
+
+    scope.m_start = Now();
+    scope.m_isOutermost = BeginBusy(scope.m_start, true);
+}
+
+void wxEventLoopStats::OnIdleEnd(IdleScope& scope)
+{
+    if ( !wxIsMainThread() )
+        return;
+
+    m_idleLevel--;
+
+    if ( scope.m_start < 0 )
+        return;
+
+    const wxLongLong_t duration = Now() - scope.m_start;
+
+    EndBusy(scope.m_isOutermost ? duration : -1);
+
+    m_idleTimes.Add(duration);
+
+    // Idle processing happens when the event loop has processed all the
+    // events, so consider that it completes the current loop iteration,
+    // unless it was done from inside an event handler, e.g. by wxYield().
+    if ( scope.m_isOutermost )
+        OnIterationEnd();
+}
+
+// ----------------------------------------------------------------------------
+// stall detector
+// ----------------------------------------------------------------------------
+
+#if wxUSE_THREADS
+
+bool
+wxEventLoopStats::StartStallDetector(long thresholdMS,
+                                     const StallHandler& handler)
+{
+    wxCHECK_MSG( thresholdMS > 0, false, "invalid stall threshold" );
+
+    StopStallDetector();
+
+    wxEventLoopStallThread* const
+        thread = new wxEventLoopStallThread(*this, thresholdMS, handler);
+    if ( thread->Run() != wxTHREAD_NO_ERROR )
+    {
+        delete thread;
+        return false;
+    }
+
+    m_stallThread = thread;
+
+    return true;
+}
+
+void wxEventLoopStats::StopStallDetector()
+{
+    if ( !m_stallThread )
+        return;
+
+    m_stallThread->Stop();
+    delete m_stallThread;
+    m_stallThread = nullptr;
+}
+
+// ----------------------------------------------------------------------------
+// module stopping the stall detector thread on shutdown
+// ----------------------------------------------------------------------------
+
+class wxEventLoopStatsModule : public wxModule
+{
+public:
+    wxEventLoopStatsModule()
+    {
+        // We need to stop our thread before threads support is cleaned up.
+        AddDependency("wxThreadModule");
+    }
+
+    virtual bool OnInit() override { return true; }
+    virtual void OnExit() override
+    {
+        wxEventLoopStats::Enable(false);
+    }
+
+private:
+    wxDECLARE_DYNAMIC_CLASS(wxEventLoopStatsModule);
+};
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxEventLoopStatsModule, wxModule);
+
+#endif // wxUSE_THREADS
@@ -32,10 +32,10 @@
 
 #include  "wx/file.h"
 #include  "wx/textfile.h"
-#include  "wx/memtext.h"
 #include  "wx/config.h"
 #include  "wx/fileconf.h"
 #include  "wx/filefn.h"
+#include  "wx/wfstream.h"
 
 #include "wx/base64.h"
 
@@ -48,6 +48,9 @@
 #include  <stdlib.h>
 #include  <ctype.h>
 
+#include  <algorithm>
+#include  <vector>
+
 // ----------------------------------------------------------------------------
 // constants
 // ----------------------------------------------------------------------------
@@ -59,8 +62,11 @@
 // ----------------------------------------------------------------------------
 
 // compare functions for sorting the arrays
-static int LINKAGEMODE CompareEntries(wxFileConfigEntry *p1, wxFileConfigEntry *p2);
-static int LINKAGEMODE CompareGroups(wxFileConfigGroup *p1, wxFileConfigGroup *p2);
+static int CompareEntries(wxFileConfigEntry *p1, wxFileConfigEntry *p2);
+static int CompareGroups(wxFileConfigGroup *p1, wxFileConfigGroup *p2);
+
+// hash function consistent with the comparison functions above
+static size_t HashName(const wxString& name);
 
 // filter strings
 static wxString FilterInValue(const wxString& str);
@@ -69,23 +75,128 @@ static wxString FilterOutValue(const wxString& str);
 static wxString FilterInEntryName(const wxString& str);
 static wxString FilterOutEntryName(const wxString& str);
 
+// read the entire file and convert it to wide chars
+static bool ReadFileText(const wxString& path, const wxMBConv& conv,
+                         wxWCharBuffer& text, size_t& len);
+
+// get the text of all the lines starting from the given one
+static wxString GetLinesText(const wxFileConfigLineList *pLine);
+
 // ============================================================================
 // private classes
 // ============================================================================
 
 // ----------------------------------------------------------------------------
-// "template" array types
+// array types
 // ----------------------------------------------------------------------------
 
-#ifdef WXMAKINGDLL_BASE
-    WX_DEFINE_SORTED_USER_EXPORTED_ARRAY(wxFileConfigEntry *, ArrayEntries,
-                                         WXDLLIMPEXP_BASE);
-    WX_DEFINE_SORTED_USER_EXPORTED_ARRAY(wxFileConfigGroup *, ArrayGroups,
-                                         WXDLLIMPEXP_BASE);
-#else
-    WX_DEFINE_SORTED_ARRAY(wxFileConfigEntry *, ArrayEntries);
-    WX_DEFINE_SORTED_ARRAY(wxFileConfigGroup *, ArrayGroups);
-#endif
+// the arrays are not kept sorted, see wxFileConfigGroup::Entries()
+typedef std::vector<wxFileConfigEntry *> ArrayEntries;
+typedef std::vector<wxFileConfigGroup *> ArrayGroups;
+
+// ----------------------------------------------------------------------------
+// wxFileConfigIndex: hash table used for finding entries and subgroups
+// ----------------------------------------------------------------------------
+
+// This is a simple open addressing table storing just the pointers to the
+// items, which must provide Name() and Hash() accessors, so that it needs a
+// single allocation for all of them.
+template <class T>
+class wxFileConfigIndex
+{
+public:
+  wxFileConfigIndex() { m_table = nullptr; m_mask = 0; m_count = 0; }
+  ~wxFileConfigIndex() { delete [] m_table; }
+
+  T *Find(const wxString& name) const
+  {
+    if ( !m_count )
+      return nullptr;
+
+    const size_t hash = HashName(name);
+    for ( size_t n = hash & m_mask; m_table[n]; n = (n + 1) & m_mask ) {
+      T * const item = m_table[n];
+      if ( item->Hash() == hash && IsSameName(item->Name(), name) )
+        return item;
+    }
+
+    return nullptr;
+  }
+
+  void Add(T *item)
+  {
+    // keep the table at most half full for the lookups to remain fast
+    if ( 2*(m_count + 1) > m_mask + 1 )
+      Grow();
+
+    Insert(item);
+    m_count++;
+  }
+
+  void Remove(T *item)
+  {
+    wxCHECK_RET( m_count, wxT("removing item from empty index") );
+
+    size_t n = item->Hash() & m_mask;
+    while ( m_table[n] != item ) {
+      wxCHECK_RET( m_table[n], wxT("removing item not in the index") );
+
+      n = (n + 1) & m_mask;
+    }
+
+    m_table[n] = nullptr;
+    m_count--;
+
+    // reinsert the rest of the cluster to close the gap we've just created
+    for ( n = (n + 1) & m_mask; m_table[n]; n = (n + 1) & m_mask ) {
+      T * const moved = m_table[n];
+      m_table[n] = nullptr;
+      Insert(moved);
+    }
+  }
+
+private:
+  static bool IsSameName(const wxString& name1, const wxString& name2)
+  {
+    #if wxCONFIG_CASE_SENSITIVE
+      return name1 == name2;
+    #else
+      return name1.CmpNoCase(name2) == 0;
+    #endif
+  }
+
+  void Insert(T *item)
+  {
+    size_t n = item->Hash() & m_mask;
+    while ( m_table[n] )
+      n = (n + 1) & m_mask;
+
+    m_table[n] = item;
+  }
+
+  void Grow()
+  {
+    T ** const tableOld = m_table;
+    const size_t sizeOld = m_table ? m_mask + 1 : 0;
+    const size_t size = sizeOld ? 2*sizeOld : 16;
+
+    m_table = new T *[size]();
+    m_mask = size - 1;
+
+    for ( size_t n = 0; n < sizeOld; n++ ) {
+      if ( tableOld[n] )
+        Insert(tableOld[n]);
+    }
+
+    delete [] tableOld;
+  }
+
+  T    **m_table;   // the slots, their number is always a power of 2
+  size_t m_mask,    // number of slots minus 1
+         m_count;   // number of used slots
+
+  wxDECLARE_NO_COPY_TEMPLATE_CLASS(wxFileConfigIndex, T);
+};
 
 // ----------------------------------------------------------------------------
 // wxFileConfigLineList
@@ -101,24 +212,78 @@ public:
   // ctor
   wxFileConfigLineList(const wxString& str,
                        wxFileConfigLineList *pNext = nullptr) : m_strLine(str)
-    { SetNext(pNext); SetPrev(nullptr); }
+    { SetNext(pNext); SetPrev(nullptr); m_pText = nullptr; m_nLen = 0;
+      m_bOwned = true; }
+
+  // default ctor is only used for the lines read from the local file which
+  // are allocated all at once by wxFileConfigText and freed by it too
+  wxFileConfigLineList()
+    { SetNext(nullptr); SetPrev(nullptr); m_pText = nullptr; m_nLen = 0;
+      m_bOwned = false; }
 
   // next/prev nodes in the linked list
   wxFileConfigLineList *Next() const { return m_pNext;  }
   wxFileConfigLineList *Prev() const { return m_pPrev;  }
 
+  // true if this line must be deleted when it's removed from the list
+  bool IsOwned() const { return m_bOwned; }
+
+  // use the unmodified text of the file for this line
+  void SetOriginalText(const wxChar *text, size_t len)
+    { m_pText = text; m_nLen = len; }
+
   // get/change lines text
-  void SetText(const wxString& str) { m_strLine = str;  }
-  const wxString& Text() const { return m_strLine; }
+  void SetText(const wxString& str) { m_strLine = str; m_pText = nullptr; }
+  wxString Text() const
+    { return m_pText ? wxString(m_pText, m_nLen) : m_strLine; }
+
+  // get the length of the text or append it to the given string, which is
+  // more efficient than using Text() for the lines read from the file
+  size_t Length() const { return m_pText ? m_nLen : m_strLine.length(); }
+  void AppendTo(wxString& str) const
+  {
+    if ( m_pText )
+      str.append(m_pText, m_nLen);
+    else
+      str += m_strLine;
+  }
 
 private:
-  wxString  m_strLine;                  // line contents
+  wxString  m_strLine;                  // line contents if it was modified
+  const wxChar *m_pText;                // or its original text in the file
+  size_t    m_nLen;                     // and the length of the latter
   wxFileConfigLineList *m_pNext,        // next node
                        *m_pPrev;        // previous one
+  bool      m_bOwned;                   // allocated individually?
 
     wxDECLARE_NO_COPY_CLASS(wxFileConfigLineList);
 };
 
+// ----------------------------------------------------------------------------
+// wxFileConfigText: contents of the local file
+// ----------------------------------------------------------------------------
+
+// the lines read from the local file are allocated in a single block and
+// reference its text instead of storing their own copies of it, so both of
+// them are kept alive until the wxFileConfig object is cleaned up
+class wxFileConfigText
+{
+public:
+  wxFileConfigText(const wxWCharBuffer& text, size_t nLines)
+    : m_text(text)
+    { m_pLines = new wxFileConfigLineList[nLines]; }
+
+  ~wxFileConfigText() { delete [] m_pLines; }
+
+  wxFileConfigLineList *Lines() const { return m_pLines; }
+
+private:
+  wxWCharBuffer         m_text;         // text of the file
+  wxFileConfigLineList *m_pLines;       // all lines of the file
+
+    wxDECLARE_NO_COPY_CLASS(wxFileConfigText);
+};
+
 // ----------------------------------------------------------------------------
 // wxFileConfigEntry: a name/value pair
 // ----------------------------------------------------------------------------
@@ -134,6 +299,7 @@ private:
                 m_bHasValue:1;  // set after first call to SetValue()
 
   int           m_nLine;        // used if m_pLine == nullptr only
+  size_t        m_nHash;        // hash of the name used by wxFileConfigIndex
 
   // pointer to our line in the linked list or nullptr if it was found in global
   // file (which we don't modify)
@@ -145,6 +311,7 @@ public:
 
   // simple accessors
   const wxString& Name()        const { return m_strName;    }
+  size_t          Hash()        const { return m_nHash;      }
   const wxString& Value()       const { return m_strValue;   }
   wxFileConfigGroup *Group()    const { return m_pParent;    }
   bool            IsImmutable() const { return m_bImmutable; }
@@ -169,9 +336,14 @@ class wxFileConfigGroup
 private:
   wxFileConfig *m_pConfig;          // config object we belong to
   wxFileConfigGroup  *m_pParent;    // parent group (nullptr for root group)
-  ArrayEntries  m_aEntries;         // entries in this group
-  ArrayGroups   m_aSubgroups;       // subgroups
+  mutable ArrayEntries m_aEntries;  // entries in this group
+  mutable ArrayGroups  m_aSubgroups;// subgroups
+  mutable bool  m_bEntriesSorted,   // true if the arrays above are sorted,
+                m_bSubgroupsSorted; // they're only sorted when enumerating
+  wxFileConfigIndex<wxFileConfigEntry> m_indexEntries;   // for finding the
+  wxFileConfigIndex<wxFileConfigGroup> m_indexSubgroups; // items by name
   wxString      m_strName;          // group's name
+  size_t        m_nHash;            // hash of the name
   wxFileConfigLineList *m_pLine;    // pointer to our line in the linked list
   wxFileConfigEntry *m_pLastEntry;  // last entry/subgroup of this group in the
   wxFileConfigGroup *m_pLastGroup;  // local file (we insert new ones after it)
@@ -191,12 +363,14 @@ public:
 
   // simple accessors
   const wxString& Name()    const { return m_strName; }
+  size_t          Hash()    const { return m_nHash; }
   wxFileConfigGroup    *Parent()  const { return m_pParent; }
   wxFileConfig   *Config()  const { return m_pConfig; }
 
-  const ArrayEntries& Entries() const { return m_aEntries;   }
-  const ArrayGroups&  Groups()  const { return m_aSubgroups; }
-  bool  IsEmpty() const { return Entries().IsEmpty() && Groups().IsEmpty(); }
+  // get the entries/subgroups in alphabetical order
+  const ArrayEntries& Entries() const;
+  const ArrayGroups&  Groups()  const;
+  bool  IsEmpty() const { return m_aEntries.empty() && m_aSubgroups.empty(); }
 
   // find entry/subgroup (nullptr if not found)
   wxFileConfigGroup *FindSubgroup(const wxString& name) const;
@@ -444,17 +618,20 @@ void wxFileConfig::Init()
 
     m_linesHead =
     m_linesTail = nullptr;
+    m_localText = nullptr;
 
     // It's not an error if (one of the) file(s) doesn't exist.
 
+    wxWCharBuffer text;
+    size_t len;
+
     // parse the global file
     if ( m_fnGlobalFile.IsOk() && m_fnGlobalFile.FileExists() )
     {
-        wxTextFile fileGlobal(m_fnGlobalFile.GetFullPath());
-
-        if ( fileGlobal.Open(*m_conv/*ignored in ANSI build*/) )
+        const wxString path = m_fnGlobalFile.GetFullPath();
+        if ( ReadFileText(path, *m_conv, text, len) )
         {
-            Parse(fileGlobal, false /* global */);
+            Parse(text, len, path, false /* global */);
             SetRootPath();
         }
         else
@@ -466,15 +643,14 @@ void wxFileConfig::Init()
     // parse the local file
     if ( m_fnLocalFile.IsOk() && m_fnLocalFile.FileExists() )
     {
-        wxTextFile fileLocal(m_fnLocalFile.GetFullPath());
-        if ( fileLocal.Open(*m_conv/*ignored in ANSI build*/) )
+        const wxString path = m_fnLocalFile.GetFullPath();
+        if ( ReadFileText(path, *m_conv, text, len) )
         {
-            Parse(fileLocal, true /* local */);
+            Parse(text, len, path, true /* local */);
             SetRootPath();
         }
         else
         {
-            const wxString path = m_fnLocalFile.GetFullPath();
             wxLogWarning(_("can't open user configuration file '%s'."),
                          path);
 
@@ -565,9 +741,9 @@ wxFileConfig::wxFileConfig(wxInputStream &inStream, const wxMBConv& conv)
 
     m_linesHead =
     m_linesTail = nullptr;
+    m_localText = nullptr;
 
     // read the entire stream contents in memory
-    wxWCharBuffer cbuf;
     static const size_t chunkLen = 1024;
 
     wxMemoryBuffer buf(chunkLen);
@@ -586,41 +762,44 @@ wxFileConfig::wxFileConfig(wxInputStream &inStream, const wxMBConv& conv)
     }
     while ( !inStream.Eof() );
 
-    size_t len;
-    cbuf = conv.cMB2WC((char *)buf.GetData(), buf.GetDataLen() + 1, &len);
-    if ( !len && buf.GetDataLen() )
+    size_t len = 0;
+    wxWCharBuffer cbuf;
+    if ( buf.GetDataLen() )
     {
-        wxLogError(_("Failed to read config options."));
+        cbuf = conv.cMB2WC((char *)buf.GetData(), buf.GetDataLen(), &len);
+        if ( !cbuf )
+        {
+            wxLogError(_("Failed to read config options."));
+        }
     }
 
     // parse the input contents if there is anything to parse
-    if ( cbuf )
+    if ( len )
     {
-        // now break it into lines
-        wxMemoryText memText;
-        for ( const wxChar *s = cbuf; ; ++s )
+        // Throw away the empty lines, as we always did for the streams, and
+        // the original EOL kind, maybe we should preserve it?
+        wxChar * const text = cbuf.data();
+        wxChar *dst = text;
+        for ( const wxChar *src = text; src != text + len; ++src )
         {
-            const wxChar *e = s;
-            while ( *e != '\0' && *e != '\n' && *e != '\r' )
-                ++e;
-
-            // notice that we throw away the original EOL kind here, maybe we
-            // should preserve it?
-            if ( e != s )
-                memText.AddLine(wxString(s, e));
-
-            if ( *e == '\0' )
-                break;
-
-            // skip the second EOL byte if it's a DOS one
-            if ( *e == '\r' && e[1] == '\n' )
-                ++e;
+            if ( *src == '\n' || *src == '\r' )
+            {
+                if ( dst == text || dst[-1] == '\n' )
+                    continue;
 
-            s = e;
+                *dst++ = '\n';
+            }
+            else
+            {
+                *dst++ = *src;
+            }
         }
 
+        len = dst - text;
+        *dst = '\0';
+
         // Finally we can parse it all.
-        Parse(memText, true /* local */);
+        Parse(cbuf, len, wxString(), true /* local */);
     }
 
     SetRootPath();
@@ -636,9 +815,12 @@ void wxFileConfig::CleanUp()
     wxFileConfigLineList *pCur = m_linesHead;
     while ( pCur != nullptr ) {
         wxFileConfigLineList *pNext = pCur->Next();
-        delete pCur;
+        if ( pCur->IsOwned() )
+            delete pCur;
         pCur = pNext;
     }
+
+    delete m_localText;
 }
 
 wxFileConfig::~wxFileConfig()
@@ -655,26 +837,67 @@ wxFileConfig::~wxFileConfig()
 // parse a config file
 // ----------------------------------------------------------------------------
 
-void wxFileConfig::Parse(const wxTextBuffer& buffer, bool bLocal)
+void wxFileConfig::Parse(wxWCharBuffer& text, size_t len,
+                         const wxString& name, bool bLocal)
 {
+  wxChar * const pText = text.data();
+  wxChar * const pTextEnd = pText + len;
+
+  // allocate all lines of the local file at once: count them first, taking
+  // into account that the last one may not be terminated
+  wxFileConfigLineList *pNextLine = nullptr;
+  if ( bLocal )
+  {
+    size_t nLineCount = 0;
+    for ( const wxChar *p = pText; p != pTextEnd; p++ ) {
+      if ( *p == wxT('\n') || (*p == wxT('\r') &&
+                               (p + 1 == pTextEnd || p[1] != wxT('\n'))) )
+        nLineCount++;
+    }
+
+    if ( len && pTextEnd[-1] != wxT('\n') && pTextEnd[-1] != wxT('\r') )
+      nLineCount++;
+
+    wxASSERT_MSG( !m_localText, wxT("local file parsed twice?") );
 
-  size_t nLineCount = buffer.GetLineCount();
+    m_localText = new wxFileConfigText(text, nLineCount);
+    pNextLine = m_localText->Lines();
+  }
 
-  for ( size_t n = 0; n < nLineCount; n++ )
+  wxChar *pNext;
+  size_t n = 0;
+  for ( wxChar *pLine = pText; pLine != pTextEnd; pLine = pNext, n++ )
   {
-    wxString strLine = buffer[n];
-    // FIXME-UTF8: rewrite using iterators
-    wxWCharBuffer buf(strLine.c_str());
+    // find the end of this line and replace the EOL with NUL to terminate it,
+    // notice that the text itself is always NUL-terminated
+    wxChar *pLineEnd = pLine;
+    while ( pLineEnd != pTextEnd && *pLineEnd != wxT('\n') && *pLineEnd != wxT('\r') )
+      pLineEnd++;
+
+    pNext = pLineEnd;
+    if ( pNext != pTextEnd ) {
+      // DOS EOL is the only one consisting of two chars, not one
+      if ( *pNext == wxT('\r') && pNext + 1 != pTextEnd && pNext[1] == wxT('\n') )
+        pNext++;
+
+      pNext++;
+    }
+
+    *pLineEnd = wxT('\0');
+
     const wxChar *pStart;
     const wxChar *pEnd;
 
     // add the line to linked list
     if ( bLocal )
-      LineListAppend(strLine);
-
+    {
+      wxFileConfigLineList * const pNewLine = pNextLine++;
+      pNewLine->SetOriginalText(pLine, pLineEnd - pLine);
+      LineListAppend(pNewLine);
+    }
 
     // skip leading spaces
-    for ( pStart = buf; wxIsspace(*pStart); pStart++ )
+    for ( pStart = pLine; wxIsspace(*pStart); pStart++ )
       ;
 
     // skip blank/comment lines
@@ -698,7 +921,7 @@ void wxFileConfig::Parse(const wxTextBuffer& buffer, bool bLocal)
 
       if ( *pEnd != wxT(']') ) {
         wxLogError(_("file '%s': unexpected character %c at line %zu."),
-                   buffer.GetName(), *pEnd, n + 1);
+                   name, *pEnd, n + 1);
         continue; // skip this line
       }
 
@@ -734,7 +957,7 @@ void wxFileConfig::Parse(const wxTextBuffer& buffer, bool bLocal)
 
           default:
             wxLogWarning(_("file '%s', line %zu: '%s' ignored after group header."),
-                         buffer.GetName(), n + 1, pEnd);
+                         name, n + 1, pEnd);
             bCont = false;
         }
       }
@@ -755,7 +978,13 @@ void wxFileConfig::Parse(const wxTextBuffer& buffer, bool bLocal)
         pEnd++;
       }
 
-      wxString strKey(FilterInEntryName(wxString(pStart, pEnd).Trim()));
+      const wxChar *pKeyEnd = pEnd;
+      while ( pKeyEnd != pStart && wxIsspace(pKeyEnd[-1]) )
+        pKeyEnd--;
+
+      wxString strKey(pStart, pKeyEnd);
+      if ( strKey.find(wxT('\\')) != wxString::npos )
+        strKey = FilterInEntryName(strKey);
 
       // skip whitespace
       while ( wxIsspace(*pEnd) )
@@ -763,7 +992,7 @@ void wxFileConfig::Parse(const wxTextBuffer& buffer, bool bLocal)
 
       if ( *pEnd++ != wxT('=') ) {
         wxLogError(_("file '%s', line %zu: '=' expected."),
-                   buffer.GetName(), n + 1);
+                   name, n + 1);
       }
       else {
         wxFileConfigEntry *pEntry = m_pCurrentGroup->FindEntry(strKey);
@@ -776,7 +1005,7 @@ void wxFileConfig::Parse(const wxTextBuffer& buffer, bool bLocal)
           if ( bLocal && pEntry->IsImmutable() ) {
             // immutable keys can't be changed by user
             wxLogWarning(_("file '%s', line %zu: value for immutable key '%s' ignored."),
-                         buffer.GetName(), n + 1, strKey);
+                         name, n + 1, strKey);
             continue;
           }
           // the condition below catches the cases (a) and (b) but not (c):
@@ -786,7 +1015,7 @@ void wxFileConfig::Parse(const wxTextBuffer& buffer, bool bLocal)
           // which is exactly what we want.
           else if ( !bLocal || pEntry->IsLocal() ) {
             wxLogWarning(_("file '%s', line %zu: key '%s' was first found at line %d."),
-                         buffer.GetName(), n + 1, strKey, pEntry->Line());
+                         name, n + 1, strKey, pEntry->Line());
 
           }
         }
@@ -798,8 +1027,11 @@ void wxFileConfig::Parse(const wxTextBuffer& buffer, bool bLocal)
         while ( wxIsspace(*pEnd) )
           pEnd++;
 
+        // filtering never changes the values without special characters, so
+        // don't waste time on it for them
         wxString value = pEnd;
-        if ( !(GetStyle() & wxCONFIG_USE_NO_ESCAPE_CHARACTERS) )
+        if ( !(GetStyle() & wxCONFIG_USE_NO_ESCAPE_CHARACTERS) &&
+                (*pEnd == wxT('"') || wxStrchr(pEnd, wxT('\\'))) )
             value = FilterInValue(value);
 
         pEntry->SetValue(value, false);
@@ -886,7 +1118,7 @@ bool wxFileConfig::GetFirstGroup(wxString& str, long& lIndex) const
 
 bool wxFileConfig::GetNextGroup (wxString& str, long& lIndex) const
 {
-    if ( size_t(lIndex) < m_pCurrentGroup->Groups().GetCount() ) {
+    if ( size_t(lIndex) < m_pCurrentGroup->Groups().size() ) {
         str = m_pCurrentGroup->Groups()[(size_t)lIndex++]->Name();
         return true;
     }
@@ -902,7 +1134,7 @@ bool wxFileConfig::GetFirstEntry(wxString& str, long& lIndex) const
 
 bool wxFileConfig::GetNextEntry (wxString& str, long& lIndex) const
 {
-    if ( size_t(lIndex) < m_pCurrentGroup->Entries().GetCount() ) {
+    if ( size_t(lIndex) < m_pCurrentGroup->Entries().size() ) {
         str = m_pCurrentGroup->Entries()[(size_t)lIndex++]->Name();
         return true;
     }
@@ -912,12 +1144,12 @@ bool wxFileConfig::GetNextEntry (wxString& str, long& lIndex) const
 
 size_t wxFileConfig::GetNumberOfEntries(bool bRecursive) const
 {
-    size_t n = m_pCurrentGroup->Entries().GetCount();
+    size_t n = m_pCurrentGroup->Entries().size();
     if ( bRecursive ) {
         wxFileConfig * const self = const_cast<wxFileConfig *>(this);
 
         wxFileConfigGroup *pOldCurrentGroup = m_pCurrentGroup;
-        size_t nSubgroups = m_pCurrentGroup->Groups().GetCount();
+        size_t nSubgroups = m_pCurrentGroup->Groups().size();
         for ( size_t nGroup = 0; nGroup < nSubgroups; nGroup++ ) {
             self->m_pCurrentGroup = m_pCurrentGroup->Groups()[nGroup];
             n += GetNumberOfEntries(true);
@@ -930,12 +1162,12 @@ size_t wxFileConfig::GetNumberOfEntries(bool bRecursive) const
 
 size_t wxFileConfig::GetNumberOfGroups(bool bRecursive) const
 {
-    size_t n = m_pCurrentGroup->Groups().GetCount();
+    size_t n = m_pCurrentGroup->Groups().size();
     if ( bRecursive ) {
         wxFileConfig * const self = const_cast<wxFileConfig *>(this);
 
         wxFileConfigGroup *pOldCurrentGroup = m_pCurrentGroup;
-        size_t nSubgroups = m_pCurrentGroup->Groups().GetCount();
+        size_t nSubgroups = m_pCurrentGroup->Groups().size();
         for ( size_t nGroup = 0; nGroup < nSubgroups; nGroup++ ) {
             self->m_pCurrentGroup = m_pCurrentGroup->Groups()[nGroup];
             n += GetNumberOfGroups(true);
@@ -1160,14 +1392,7 @@ bool wxFileConfig::Flush(bool /* bCurrentOnly */)
   }
 
   // write all strings to file
-  wxString filetext;
-  filetext.reserve(4096);
-  for ( wxFileConfigLineList *p = m_linesHead; p != nullptr; p = p->Next() )
-  {
-    filetext << p->Text() << wxTextFile::GetEOL();
-  }
-
-  if ( !file.Write(filetext, *m_conv) )
+  if ( !file.Write(GetLinesText(m_linesHead), *m_conv) )
   {
     wxLogError(_("can't write user configuration file."));
     return false;
@@ -1190,13 +1415,11 @@ bool wxFileConfig::Flush(bool /* bCurrentOnly */)
 bool wxFileConfig::Save(wxOutputStream& os, const wxMBConv& conv)
 {
     // save unconditionally, even if not dirty
-    for ( wxFileConfigLineList *p = m_linesHead; p != nullptr; p = p->Next() )
+    const wxString text = GetLinesText(m_linesHead);
+    if ( !text.empty() )
     {
-        wxString line = p->Text();
-        line += wxTextFile::GetEOL();
-
-        wxCharBuffer buf(line.mb_str(conv));
-        if ( !os.Write(buf, strlen(buf)) )
+        const wxCharBuffer buf(text.mb_str(conv));
+        if ( !buf.length() || !os.Write(buf, buf.length()) )
         {
             wxLogError(_("Error saving user configuration data."));
 
@@ -1341,8 +1564,22 @@ wxFileConfigLineList *wxFileConfig::LineListAppend(const wxString& str)
                 ((m_linesTail) ? m_linesTail->Text()
                                : wxString()) );
 
-    wxFileConfigLineList *pLine = new wxFileConfigLineList(str);
+    LineListAppend(new wxFileConfigLineList(str));
 
+    wxLogTrace( FILECONF_TRACE_MASK,
+                wxT("        head: %s"),
+                ((m_linesHead) ? m_linesHead->Text()
+                               : wxString()) );
+    wxLogTrace( FILECONF_TRACE_MASK,
+                wxT("        tail: %s"),
+                ((m_linesTail) ? m_linesTail->Text()
+                               : wxString()) );
+
+    return m_linesTail;
+}
+
+void wxFileConfig::LineListAppend(wxFileConfigLineList *pLine)
+{
     if ( m_linesTail == nullptr )
     {
         // list is empty
@@ -1356,17 +1593,6 @@ wxFileConfigLineList *wxFileConfig::LineListAppend(const wxString& str)
     }
 
     m_linesTail = pLine;
-
-    wxLogTrace( FILECONF_TRACE_MASK,
-                wxT("        head: %s"),
-                ((m_linesHead) ? m_linesHead->Text()
-                               : wxString()) );
-    wxLogTrace( FILECONF_TRACE_MASK,
-                wxT("        tail: %s"),
-                ((m_linesTail) ? m_linesTail->Text()
-                               : wxString()) );
-
-    return m_linesTail;
 }
 
 // insert a new line after the given one or in the very beginning if !pLine
@@ -1460,7 +1686,9 @@ void wxFileConfig::LineListRemove(wxFileConfigLineList *pLine)
                 ((m_linesTail) ? m_linesTail->Text()
                                : wxString()) );
 
-    delete pLine;
+    // the lines read from the file are freed all at once in CleanUp()
+    if ( pLine->IsOwned() )
+        delete pLine;
 }
 
 bool wxFileConfig::LineListIsEmpty()
@@ -1480,13 +1708,15 @@ bool wxFileConfig::LineListIsEmpty()
 wxFileConfigGroup::wxFileConfigGroup(wxFileConfigGroup *pParent,
                                        const wxString& strName,
                                        wxFileConfig *pConfig)
-                         : m_aEntries(CompareEntries),
-                           m_aSubgroups(CompareGroups),
-                           m_strName(strName)
+                         : m_strName(strName)
 {
   m_pConfig = pConfig;
   m_pParent = pParent;
   m_pLine   = nullptr;
+  m_nHash   = HashName(strName);
+
+  m_bEntriesSorted   =
+  m_bSubgroupsSorted = true;
 
   m_pLastEntry = nullptr;
   m_pLastGroup = nullptr;
@@ -1496,14 +1726,43 @@ wxFileConfigGroup::wxFileConfigGroup(wxFileConfigGroup *pParent,
 wxFileConfigGroup::~wxFileConfigGroup()
 {
   // entries
-  size_t n, nCount = m_aEntries.GetCount();
-  for ( n = 0; n < nCount; n++ )
-    delete m_aEntries[n];
+  for ( wxFileConfigEntry *pEntry : m_aEntries )
+    delete pEntry;
 
   // subgroups
-  nCount = m_aSubgroups.GetCount();
-  for ( n = 0; n < nCount; n++ )
-    delete m_aSubgroups[n];
+  for ( wxFileConfigGroup *pGroup : m_aSubgroups )
+    delete pGroup;
+}
+
+// ----------------------------------------------------------------------------
+// enumeration
+// ----------------------------------------------------------------------------
+
+// The arrays are only sorted when they're enumerated, as keeping them sorted
+// all the time would make adding many items, e.g. when reading a big file with
+// unsorted entries, too slow, while the items are looked up using the index.
+const ArrayEntries& wxFileConfigGroup::Entries() const
+{
+  if ( !m_bEntriesSorted ) {
+    std::sort(m_aEntries.begin(), m_aEntries.end(),
+              [](wxFileConfigEntry *p1, wxFileConfigEntry *p2)
+              { return CompareEntries(p1, p2) < 0; });
+    m_bEntriesSorted = true;
+  }
+
+  return m_aEntries;
+}
+
+const ArrayGroups& wxFileConfigGroup::Groups() const
+{
+  if ( !m_bSubgroupsSorted ) {
+    std::sort(m_aSubgroups.begin(), m_aSubgroups.end(),
+              [](wxFileConfigGroup *p1, wxFileConfigGroup *p2)
+              { return CompareGroups(p1, p2) < 0; });
+    m_bSubgroupsSorted = true;
+  }
+
+  return m_aSubgroups;
 }
 
 // ----------------------------------------------------------------------------
@@ -1664,10 +1923,9 @@ void wxFileConfigGroup::UpdateGroupAndSubgroupsLines()
 
 
     // also update all subgroups as they have this groups name in their lines
-    const size_t nCount = m_aSubgroups.GetCount();
-    for ( size_t n = 0; n < nCount; n++ )
+    for ( wxFileConfigGroup *pGroup : m_aSubgroups )
     {
-        m_aSubgroups[n]->UpdateGroupAndSubgroupsLines();
+        pGroup->UpdateGroupAndSubgroupsLines();
     }
 }
 
@@ -1678,13 +1936,15 @@ void wxFileConfigGroup::Rename(const wxString& newName)
     if ( newName == m_strName )
         return;
 
-    // we need to remove the group from the parent and it back under the new
-    // name to keep the parents array of subgroups alphabetically sorted
-    m_pParent->m_aSubgroups.Remove(this);
+    // we need to remove the group from the parent and add it back under the
+    // new name to keep the parents index of subgroups up to date
+    m_pParent->m_indexSubgroups.Remove(this);
 
     m_strName = newName;
+    m_nHash = HashName(newName);
 
-    m_pParent->m_aSubgroups.Add(this);
+    m_pParent->m_indexSubgroups.Add(this);
+    m_pParent->m_bSubgroupsSorted = false;
 
     // update the group lines recursively
     UpdateGroupAndSubgroupsLines();
@@ -1703,67 +1963,16 @@ wxString wxFileConfigGroup::GetFullName() const
 // find an item
 // ----------------------------------------------------------------------------
 
-// use binary search because the array is sorted
 wxFileConfigEntry *
 wxFileConfigGroup::FindEntry(const wxString& name) const
 {
-  size_t
-       lo = 0,
-       hi = m_aEntries.GetCount();
-  wxFileConfigEntry *pEntry;
-
-  while ( lo < hi ) {
-    size_t i;
-    i = (lo + hi)/2;
-    pEntry = m_aEntries[i];
-
-    int res;
-    #if wxCONFIG_CASE_SENSITIVE
-      res = pEntry->Name().compare(name);
-    #else
-      res = pEntry->Name().CmpNoCase(name);
-    #endif
-
-    if ( res > 0 )
-      hi = i;
-    else if ( res < 0 )
-      lo = i + 1;
-    else
-      return pEntry;
-  }
-
-  return nullptr;
+  return m_indexEntries.Find(name);
 }
 
 wxFileConfigGroup *
 wxFileConfigGroup::FindSubgroup(const wxString& name) const
 {
-  size_t
-       lo = 0,
-       hi = m_aSubgroups.GetCount();
-  wxFileConfigGroup *pGroup;
-
-  while ( lo < hi ) {
-    size_t i;
-    i = (lo + hi)/2;
-    pGroup = m_aSubgroups[i];
-
-    int res;
-    #if wxCONFIG_CASE_SENSITIVE
-      res = pGroup->Name().compare(name);
-    #else
-      res = pGroup->Name().CmpNoCase(name);
-    #endif
-
-    if ( res > 0 )
-      hi = i;
-    else if ( res < 0 )
-      lo = i + 1;
-    else
-      return pGroup;
-  }
-
-  return nullptr;
+  return m_indexSubgroups.Find(name);
 }
 
 // ----------------------------------------------------------------------------
@@ -1777,7 +1986,12 @@ wxFileConfigEntry *wxFileConfigGroup::AddEntry(const wxString& strName, int nLin
 
     wxFileConfigEntry   *pEntry = new wxFileConfigEntry(this, strName, nLine);
 
-    m_aEntries.Add(pEntry);
+    // the array remains sorted if the entries are added in order
+    if ( !m_aEntries.empty() && CompareEntries(m_aEntries.back(), pEntry) > 0 )
+        m_bEntriesSorted = false;
+
+    m_aEntries.push_back(pEntry);
+    m_indexEntries.Add(pEntry);
     return pEntry;
 }
 
@@ -1788,7 +2002,11 @@ wxFileConfigGroup *wxFileConfigGroup::AddSubgroup(const wxString& strName)
 
     wxFileConfigGroup   *pGroup = new wxFileConfigGroup(this, strName, m_pConfig);
 
-    m_aSubgroups.Add(pGroup);
+    if ( !m_aSubgroups.empty() && CompareGroups(m_aSubgroups.back(), pGroup) > 0 )
+        m_bSubgroupsSorted = false;
+
+    m_aSubgroups.push_back(pGroup);
+    m_indexSubgroups.Add(pGroup);
     return pGroup;
 }
 
@@ -1832,14 +2050,14 @@ bool wxFileConfigGroup::DeleteSubgroup(wxFileConfigGroup *pGroup)
                         : wxString() );
 
     // delete all entries...
-    size_t nCount = pGroup->m_aEntries.GetCount();
+    size_t nCount = pGroup->m_aEntries.size();
 
     wxLogTrace(FILECONF_TRACE_MASK,
                wxT("Removing %lu entries"), (unsigned long)nCount );
 
-    for ( size_t nEntry = 0; nEntry < nCount; nEntry++ )
+    for ( wxFileConfigEntry *pEntry : pGroup->m_aEntries )
     {
-        wxFileConfigLineList *pLine = pGroup->m_aEntries[nEntry]->GetLine();
+        wxFileConfigLineList *pLine = pEntry->GetLine();
 
         if ( pLine )
         {
@@ -1851,7 +2069,7 @@ bool wxFileConfigGroup::DeleteSubgroup(wxFileConfigGroup *pGroup)
     }
 
     // ...and subgroups of this subgroup
-    nCount = pGroup->m_aSubgroups.GetCount();
+    nCount = pGroup->m_aSubgroups.size();
 
     wxLogTrace( FILECONF_TRACE_MASK,
                 wxT("Removing %lu subgroups"), (unsigned long)nCount );
@@ -1885,21 +2103,19 @@ bool wxFileConfigGroup::DeleteSubgroup(wxFileConfigGroup *pGroup)
             // our last entry is being deleted, so find the last one which
             // stays by going back until we find a subgroup or reach the
             // group line
-            const size_t nSubgroups = m_aSubgroups.GetCount();
-
             m_pLastGroup = nullptr;
             for ( wxFileConfigLineList *pl = pLine->Prev();
                   pl && !m_pLastGroup;
                   pl = pl->Prev() )
             {
                 // does this line belong to our subgroup?
-                for ( size_t n = 0; n < nSubgroups; n++ )
+                for ( wxFileConfigGroup *pSubgroup : m_aSubgroups )
                 {
                     // do _not_ call GetGroupLine! we don't want to add it to
                     // the local file if it's not already there
-                    if ( m_aSubgroups[n]->m_pLine == pl )
+                    if ( pSubgroup->m_pLine == pl )
                     {
-                        m_pLastGroup = m_aSubgroups[n];
+                        m_pLastGroup = pSubgroup;
                         break;
                     }
                 }
@@ -1918,7 +2134,10 @@ bool wxFileConfigGroup::DeleteSubgroup(wxFileConfigGroup *pGroup)
                     pGroup->Name() );
     }
 
-    m_aSubgroups.Remove(pGroup);
+    // removing the subgroup doesn't change the order of the remaining ones
+    m_aSubgroups.erase(std::find(m_aSubgroups.begin(), m_aSubgroups.end(),
+                                 pGroup));
+    m_indexSubgroups.Remove(pGroup);
     delete pGroup;
 
     return true;
@@ -1945,10 +2164,9 @@ bool wxFileConfigGroup::DeleteEntry(const wxString& name)
       wxFileConfigEntry *pNewLast = nullptr;
       const wxFileConfigLineList * const
         pNewLastLine = m_pLastEntry->GetLine()->Prev();
-      const size_t nEntries = m_aEntries.GetCount();
-      for ( size_t n = 0; n < nEntries; n++ ) {
-        if ( m_aEntries[n]->GetLine() == pNewLastLine ) {
-          pNewLast = m_aEntries[n];
+      for ( wxFileConfigEntry *pOther : m_aEntries ) {
+        if ( pOther->GetLine() == pNewLastLine ) {
+          pNewLast = pOther;
           break;
         }
       }
@@ -1966,7 +2184,8 @@ bool wxFileConfigGroup::DeleteEntry(const wxString& name)
     m_pConfig->LineListRemove(pLine);
   }
 
-  m_aEntries.Remove(pEntry);
+  m_aEntries.erase(std::find(m_aEntries.begin(), m_aEntries.end(), pEntry));
+  m_indexEntries.Remove(pEntry);
   delete pEntry;
 
   return true;
@@ -1995,6 +2214,8 @@ wxFileConfigEntry::wxFileConfigEntry(wxFileConfigGroup *pParent,
   m_bImmutable = strName[0] == wxCONFIG_IMMUTABLE_PREFIX;
   if ( m_bImmutable )
     m_strName.erase(0, 1);  // remove first character
+
+  m_nHash = HashName(m_strName);
 }
 
 // ----------------------------------------------------------------------------
@@ -2091,6 +2312,97 @@ int CompareGroups(wxFileConfigGroup *p1, wxFileConfigGroup *p2)
 #endif
 }
 
+// FNV-1a hash of the name, ignoring its case if the comparison does it too
+static size_t HashName(const wxString& name)
+{
+    size_t hash = 2166136261u;
+    for ( wxString::const_iterator i = name.begin(); i != name.end(); ++i )
+    {
+#if wxCONFIG_CASE_SENSITIVE
+        hash ^= (*i).GetValue();
+#else
+        hash ^= wxTolower(*i).GetValue();
+#endif
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+// ----------------------------------------------------------------------------
+// reading and writing the file contents
+// ----------------------------------------------------------------------------
+
+static bool ReadFileText(const wxString& path, const wxMBConv& conv,
+                         wxWCharBuffer& text, size_t& len)
+{
+#if wxUSE_STREAMS
+    // map the file instead of copying its contents as we only need to
+    // convert them once
+    wxMappedFileInputStream stream(path);
+    if ( !stream.IsOk() )
+    {
+        wxLogError(_("Failed to read text file \"%s\"."), path);
+        return false;
+    }
+
+    const char * const data = static_cast<const char *>(stream.GetData());
+    const size_t size = stream.GetDataLen();
+#else // !wxUSE_STREAMS
+    wxFile file(path);
+    const wxFileOffset length = file.IsOpened() ? file.Length()
+                                                : wxInvalidOffset;
+    wxCharBuffer buf;
+    if ( length == wxInvalidOffset ||
+            !buf.extend(length) ||
+                file.Read(buf.data(), length) != length )
+    {
+        wxLogError(_("Failed to read text file \"%s\"."), path);
+        return false;
+    }
+
+    const char * const data = buf.data();
+    const size_t size = length;
+#endif // wxUSE_STREAMS/!wxUSE_STREAMS
+
+    if ( !size )
+    {
+        text = wxWCharBuffer(size_t(0));
+        len = 0;
+        return true;
+    }
+
+    text = conv.cMB2WC(data, size, &len);
+    if ( !text )
+    {
+        wxLogError(_("Failed to read text file \"%s\"."), path);
+        return false;
+    }
+
+    return true;
+}
+
+static wxString GetLinesText(const wxFileConfigLineList *pLine)
+{
+    const wxChar * const eol = wxTextFile::GetEOL();
+    const size_t eolLen = wxStrlen(eol);
+
+    // compute the total length first to avoid reallocating the string
+    size_t len = 0;
+    for ( const wxFileConfigLineList *p = pLine; p; p = p->Next() )
+        len += p->Length() + eolLen;
+
+    wxString text;
+    text.reserve(len);
+    for ( const wxFileConfigLineList *p = pLine; p; p = p->Next() )
+    {
+        p->AppendTo(text);
+        text.append(eol, eolLen);
+    }
+
+    return text;
+}
+
 // ----------------------------------------------------------------------------
 // filter functions
 // ----------------------------------------------------------------------------
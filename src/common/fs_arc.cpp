@@ -8,6 +8,8 @@
 
 #include "wx/wxprec.h"
 
+#include <atomic>
+#include <list>
 #include <memory>
 
 #if wxUSE_FS_ARCHIVE
@@ -20,8 +22,46 @@
 #endif
 
 #include "wx/archive.h"
+#include "wx/thread.h"
+#include "wx/zipstrm.h"
 #include "wx/private/fileback.h"
 
+namespace
+{
+
+// Approximate amount of memory used by a cached entry in addition to its
+// name and by a wxArchiveEntry object: this doesn't need to be exact and is
+// only used for limiting the size of the cache.
+const size_t ARCHIVE_FS_ENTRY_OVERHEAD = 128;
+const size_t ARCHIVE_FS_ENTRY_SIZE = 512;
+
+// The maximal amount of memory to use for the cached archive catalogs.
+std::atomic<size_t> gs_cacheLimit(wxArchiveFSHandler::DEFAULT_CACHE_LIMIT);
+
+// Whether the catalogs are shared between all wxArchiveFSHandler objects.
+std::atomic<bool> gs_sharedCacheEnabled(false);
+
+} // anonymous namespace
+
+//---------------------------------------------------------------------------
+// wxArchiveFSEntry
+//
+// A single entry of the archive catalog. For zip archives on seekable
+// streams only the position of the entry in the central directory is
+// remembered and the entry itself is read again when it's needed, which
+// uses much less memory than keeping the wxArchiveEntry objects.
+//---------------------------------------------------------------------------
+
+struct wxArchiveFSEntry
+{
+    wxString name;
+    std::unique_ptr<wxArchiveEntry> entry;
+    wxFileOffset pos;
+    wxArchiveFSEntry *next;
+};
+
+using wxArchiveFSEntryHash = std::unordered_map<wxString, wxArchiveFSEntry*>;
+
 //---------------------------------------------------------------------------
 // wxArchiveFSCacheDataImpl
 //
@@ -30,19 +70,10 @@
 //
 // This class is actually the reference counted implementation for the
 // wxArchiveFSCacheData class below. It was done that way to allow sharing
-// between instances of wxFileSystem, though that's a feature not used in this
-// version.
+// between instances of wxFileSystem, possibly used from different threads,
+// which is why all accesses to the catalog are serialized.
 //---------------------------------------------------------------------------
 
-using wxArchiveFSEntryHash =
-    std::unordered_map<wxString, std::unique_ptr<wxArchiveEntry>>;
-
-struct wxArchiveFSEntry
-{
-    wxArchiveEntry *entry;
-    wxArchiveFSEntry *next;
-};
-
 class wxArchiveFSCacheDataImpl
 {
 public:
@@ -56,25 +87,42 @@ public:
     void Release() { if (--m_refcount == 0) delete this; }
     wxArchiveFSCacheDataImpl *AddRef() { m_refcount++; return this; }
 
-    wxArchiveEntry *Get(const wxString& name);
+    wxArchiveFSEntry *Get(const wxString& name);
     wxInputStream *NewStream() const;
 
     wxArchiveFSEntry *GetNext(wxArchiveFSEntry *fse);
 
+    size_t GetMemoryUsage();
+
 private:
-    // Takes ownership of "entry".
-    wxArchiveFSEntry *AddToCache(wxArchiveEntry *entry);
+    void Init();
+
+    // Reads the next entry from the archive and adds it to the cache.
+    wxArchiveFSEntry *ReadNext();
+
+    // Takes ownership of "entry", which may be null if "pos" is valid.
+    wxArchiveFSEntry *AddToCache(const wxString& name,
+                                 wxArchiveEntry *entry,
+                                 wxFileOffset pos);
     void CloseStreams();
 
-    int m_refcount;
+    std::atomic<int> m_refcount;
 
     wxArchiveFSEntryHash m_hash;
     wxArchiveFSEntry *m_begin;
     wxArchiveFSEntry **m_endptr;
+    size_t m_memory;
 
     wxBackingFile m_backer;
     wxInputStream *m_stream;
     wxArchiveInputStream *m_archive;
+
+#if wxUSE_ZIPSTREAM
+    // Non-null if the archive is a zip whose entries can be read lazily.
+    wxZipInputStream *m_zip;
+#endif // wxUSE_ZIPSTREAM
+
+    wxCRIT_SECT_DECLARE_MEMBER(m_cs);
 };
 
 wxArchiveFSCacheDataImpl::wxArchiveFSCacheDataImpl(
@@ -83,10 +131,12 @@ wxArchiveFSCacheDataImpl::wxArchiveFSCacheDataImpl(
  :  m_refcount(1),
     m_begin(nullptr),
     m_endptr(&m_begin),
+    m_memory(0),
     m_backer(backer),
     m_stream(new wxBackedInputStream(backer)),
     m_archive(factory.NewStream(*m_stream))
 {
+    Init();
 }
 
 wxArchiveFSCacheDataImpl::wxArchiveFSCacheDataImpl(
@@ -95,9 +145,19 @@ wxArchiveFSCacheDataImpl::wxArchiveFSCacheDataImpl(
  :  m_refcount(1),
     m_begin(nullptr),
     m_endptr(&m_begin),
+    m_memory(0),
     m_stream(stream),
     m_archive(factory.NewStream(*m_stream))
 {
+    Init();
+}
+
+void wxArchiveFSCacheDataImpl::Init()
+{
+#if wxUSE_ZIPSTREAM
+    m_zip = m_stream->IsSeekable() ? dynamic_cast<wxZipInputStream*>(m_archive)
+                                   : nullptr;
+#endif // wxUSE_ZIPSTREAM
 }
 
 wxArchiveFSCacheDataImpl::~wxArchiveFSCacheDataImpl()
@@ -114,14 +174,26 @@ wxArchiveFSCacheDataImpl::~wxArchiveFSCacheDataImpl()
     CloseStreams();
 }
 
-wxArchiveFSEntry *wxArchiveFSCacheDataImpl::AddToCache(wxArchiveEntry *entry)
+wxArchiveFSEntry *wxArchiveFSCacheDataImpl::AddToCache(
+        const wxString& name,
+        wxArchiveEntry *entry,
+        wxFileOffset pos)
 {
-    m_hash[entry->GetName(wxPATH_UNIX)] = std::unique_ptr<wxArchiveEntry>(entry);
     wxArchiveFSEntry *fse = new wxArchiveFSEntry;
+    fse->name = name;
+    fse->entry.reset(entry);
+    fse->pos = pos;
+    fse->next = nullptr;
+
+    m_hash[name] = fse;
     *m_endptr = fse;
-    (*m_endptr)->entry = entry;
-    (*m_endptr)->next = nullptr;
-    m_endptr = &(*m_endptr)->next;
+    m_endptr = &fse->next;
+
+    // The name is stored twice, in the entry and as the hash key.
+    m_memory += ARCHIVE_FS_ENTRY_OVERHEAD + 2*name.length()*sizeof(wxChar);
+    if (entry)
+        m_memory += ARCHIVE_FS_ENTRY_SIZE + name.length()*sizeof(wxChar);
+
     return fse;
 }
 
@@ -129,26 +201,42 @@ void wxArchiveFSCacheDataImpl::CloseStreams()
 {
     wxDELETE(m_archive);
     wxDELETE(m_stream);
+
+#if wxUSE_ZIPSTREAM
+    m_zip = nullptr;
+#endif // wxUSE_ZIPSTREAM
 }
 
-wxArchiveEntry *wxArchiveFSCacheDataImpl::Get(const wxString& name)
+wxArchiveFSEntry *wxArchiveFSCacheDataImpl::ReadNext()
 {
-    const auto it = m_hash.find(name);
-
-    if (it != m_hash.end())
-        return it->second.get();
-
     if (!m_archive)
         return nullptr;
 
-    wxArchiveEntry *entry;
+#if wxUSE_ZIPSTREAM
+    if (m_zip)
+    {
+        const wxFileOffset pos = m_zip->GetCentralPosition();
+        std::unique_ptr<wxZipEntry> entry(m_zip->GetNextEntry());
 
-    while ((entry = m_archive->GetNextEntry()) != nullptr)
+        if (entry)
+        {
+            const wxString name = entry->GetName(wxPATH_UNIX);
+
+            // Keep the entry itself only if we can't read it again later.
+            return AddToCache(name,
+                              pos == wxInvalidOffset ? entry.release()
+                                                     : nullptr,
+                              pos);
+        }
+    }
+    else
+#endif // wxUSE_ZIPSTREAM
     {
-        AddToCache(entry);
+        wxArchiveEntry *entry = m_archive->GetNextEntry();
 
-        if (entry->GetName(wxPATH_UNIX) == name)
-            return entry;
+        if (entry)
+            return AddToCache(entry->GetName(wxPATH_UNIX), entry,
+                              wxInvalidOffset);
     }
 
     CloseStreams();
@@ -156,6 +244,26 @@ wxArchiveEntry *wxArchiveFSCacheDataImpl::Get(const wxString& name)
     return nullptr;
 }
 
+wxArchiveFSEntry *wxArchiveFSCacheDataImpl::Get(const wxString& name)
+{
+    wxCRIT_SECT_LOCKER(lock, m_cs);
+
+    const auto it = m_hash.find(name);
+
+    if (it != m_hash.end())
+        return it->second;
+
+    wxArchiveFSEntry *fse;
+
+    while ((fse = ReadNext()) != nullptr)
+    {
+        if (fse->name == name)
+            return fse;
+    }
+
+    return nullptr;
+}
+
 wxInputStream* wxArchiveFSCacheDataImpl::NewStream() const
 {
     if (m_backer)
@@ -166,21 +274,23 @@ wxInputStream* wxArchiveFSCacheDataImpl::NewStream() const
 
 wxArchiveFSEntry *wxArchiveFSCacheDataImpl::GetNext(wxArchiveFSEntry *fse)
 {
-    wxArchiveFSEntry *next = fse ? fse->next : m_begin;
+    wxCRIT_SECT_LOCKER(lock, m_cs);
 
-    if (!next && m_archive)
-    {
-        wxArchiveEntry *entry = m_archive->GetNextEntry();
+    wxArchiveFSEntry *next = fse ? fse->next : m_begin;
 
-        if (entry)
-            next = AddToCache(entry);
-        else
-            CloseStreams();
-    }
+    if (!next)
+        next = ReadNext();
 
     return next;
 }
 
+size_t wxArchiveFSCacheDataImpl::GetMemoryUsage()
+{
+    wxCRIT_SECT_LOCKER(lock, m_cs);
+
+    return m_memory;
+}
+
 //---------------------------------------------------------------------------
 // wxArchiveFSCacheData
 //
@@ -203,11 +313,15 @@ public:
 
     ~wxArchiveFSCacheData() { if (m_impl) m_impl->Release(); }
 
-    wxArchiveEntry *Get(const wxString& name) { return m_impl->Get(name); }
+    bool IsOk() const { return m_impl != nullptr; }
+
+    wxArchiveFSEntry *Get(const wxString& name) { return m_impl->Get(name); }
     wxInputStream *NewStream() const { return m_impl->NewStream(); }
     wxArchiveFSEntry *GetNext(wxArchiveFSEntry *fse)
         { return m_impl->GetNext(fse); }
 
+    size_t GetMemoryUsage() { return m_impl->GetMemoryUsage(); }
+
 private:
     wxArchiveFSCacheDataImpl *m_impl;
 };
@@ -253,11 +367,23 @@ wxArchiveFSCacheData& wxArchiveFSCacheData::operator=(
 //
 // wxArchiveFSCacheData caches a single archive, and this class holds a
 // collection of them to cache all the archives accessed by this instance
-// of wxFileSystem.
+// of wxFileSystem or, for the shared cache, by all of them.
+//
+// The least recently used archives are removed from the cache when the
+// memory used by it exceeds the limit. This doesn't affect the archives
+// still being used, as wxArchiveFSCacheData is reference counted.
 //---------------------------------------------------------------------------
 
+using wxArchiveFSCacheList = std::list<wxString>;
+
+struct wxArchiveFSCacheItem
+{
+    wxArchiveFSCacheData data;
+    wxArchiveFSCacheList::iterator lru;
+};
+
 using wxArchiveFSCacheDataHash =
-    std::unordered_map<wxString, wxArchiveFSCacheData>;
+    std::unordered_map<wxString, wxArchiveFSCacheItem>;
 
 class wxArchiveFSCache
 {
@@ -265,39 +391,149 @@ public:
     wxArchiveFSCache() { }
     ~wxArchiveFSCache() { }
 
-    wxArchiveFSCacheData* Add(const wxString& name,
-                              const wxArchiveClassFactory& factory,
-                              wxInputStream *stream);
+    wxArchiveFSCacheData Add(const wxString& name,
+                             const wxArchiveClassFactory& factory,
+                             wxInputStream *stream);
+
+    wxArchiveFSCacheData Get(const wxString& name);
+
+    void Clear();
 
-    wxArchiveFSCacheData *Get(const wxString& name);
+    static wxArchiveFSCache& GetShared();
 
 private:
+    // Removes the least recently used archives exceeding the limit.
+    void Trim();
+
     wxArchiveFSCacheDataHash m_hash;
+
+    // Names of the cached archives, most recently used first.
+    wxArchiveFSCacheList m_lru;
+
+    wxCRIT_SECT_DECLARE_MEMBER(m_cs);
+
+    wxDECLARE_NO_COPY_CLASS(wxArchiveFSCache);
 };
 
-wxArchiveFSCacheData* wxArchiveFSCache::Add(
+wxArchiveFSCacheData wxArchiveFSCache::Add(
         const wxString& name,
         const wxArchiveClassFactory& factory,
         wxInputStream *stream)
 {
-    wxArchiveFSCacheData& data = m_hash[name];
+    wxArchiveFSCacheData data;
 
     if (stream->IsSeekable())
         data = wxArchiveFSCacheData(factory, stream);
     else
         data = wxArchiveFSCacheData(factory, wxBackingFile(stream));
 
-    return &data;
+    wxCRIT_SECT_LOCKER(lock, m_cs);
+
+    wxArchiveFSCacheItem& item = m_hash[name];
+
+    if (item.data.IsOk())
+        m_lru.erase(item.lru);
+
+    item.data = data;
+    item.lru = m_lru.insert(m_lru.begin(), name);
+
+    Trim();
+
+    return data;
 }
 
-wxArchiveFSCacheData *wxArchiveFSCache::Get(const wxString& name)
+wxArchiveFSCacheData wxArchiveFSCache::Get(const wxString& name)
 {
+    wxCRIT_SECT_LOCKER(lock, m_cs);
+
     const auto it = m_hash.find(name);
 
-    if (it != m_hash.end())
-        return &it->second;
+    if (it == m_hash.end())
+        return wxArchiveFSCacheData();
 
-    return nullptr;
+    // Move this archive to the front of the list and check if the catalogs
+    // read since the last time don't exceed the limit now.
+    m_lru.splice(m_lru.begin(), m_lru, it->second.lru);
+
+    const wxArchiveFSCacheData data = it->second.data;
+
+    Trim();
+
+    return data;
+}
+
+void wxArchiveFSCache::Trim()
+{
+    size_t total = 0;
+
+    for (auto& item : m_hash)
+        total += item.second.data.GetMemoryUsage();
+
+    // Always keep the most recently used archive, even if it's too big.
+    const size_t limit = gs_cacheLimit;
+
+    while (total > limit && m_lru.size() > 1)
+    {
+        const auto it = m_hash.find(m_lru.back());
+
+        total -= it->second.data.GetMemoryUsage();
+
+        m_hash.erase(it);
+        m_lru.pop_back();
+    }
+}
+
+void wxArchiveFSCache::Clear()
+{
+    wxCRIT_SECT_LOCKER(lock, m_cs);
+
+    m_hash.clear();
+    m_lru.clear();
+}
+
+/* static */
+wxArchiveFSCache& wxArchiveFSCache::GetShared()
+{
+    static wxArchiveFSCache s_cache;
+
+    return s_cache;
+}
+
+// Returns the catalog of the archive, from the cache if possible.
+static wxArchiveFSCacheData
+GetArchiveFSCacheData(wxArchiveFSCache& cache,
+                      wxFileSystem& fs,
+                      const wxString& key,
+                      const wxString& left,
+                      const wxArchiveClassFactory& factory)
+{
+    wxArchiveFSCacheData data = cache.Get(key);
+    if (data.IsOk())
+        return data;
+
+    const bool shared = gs_sharedCacheEnabled;
+    if (shared)
+    {
+        data = wxArchiveFSCache::GetShared().Get(key);
+        if (data.IsOk())
+            return data;
+    }
+
+    std::unique_ptr<wxFSFile> leftFile(fs.OpenFile(left));
+    if (!leftFile)
+        return data;
+
+    wxInputStream *stream = leftFile->DetachStream();
+    if (!stream)
+        return data;
+
+    // The copy of the data of non-seekable streams can't be used from several
+    // threads at once, so keep such archives in the local cache only.
+    wxArchiveFSCache& target = shared && stream->IsSeekable()
+                                ? wxArchiveFSCache::GetShared()
+                                : cache;
+
+    return target.Add(key, factory, stream);
 }
 
 //----------------------------------------------------------------------------
@@ -319,9 +555,37 @@ wxArchiveFSHandler::wxArchiveFSHandler()
 wxArchiveFSHandler::~wxArchiveFSHandler()
 {
     Cleanup();
+    delete m_Archive;
     delete m_cache;
 }
 
+/* static */
+void wxArchiveFSHandler::SetCacheLimit(size_t limit)
+{
+    gs_cacheLimit = limit;
+}
+
+/* static */
+size_t wxArchiveFSHandler::GetCacheLimit()
+{
+    return gs_cacheLimit;
+}
+
+/* static */
+void wxArchiveFSHandler::EnableSharedCache(bool enable)
+{
+    gs_sharedCacheEnabled = enable;
+
+    if (!enable)
+        ClearSharedCache();
+}
+
+/* static */
+void wxArchiveFSHandler::ClearSharedCache()
+{
+    wxArchiveFSCache::GetShared().Clear();
+}
+
 void wxArchiveFSHandler::Cleanup()
 {
     wxDELETE(m_DirsFound);
@@ -360,21 +624,16 @@ wxFSFile* wxArchiveFSHandler::OpenFile(
     if (!factory)
         return nullptr;
 
-    wxArchiveFSCacheData *cached = m_cache->Get(key);
-    if (!cached)
-    {
-        wxFSFile *leftFile = m_fs.OpenFile(left);
-        if (!leftFile)
-            return nullptr;
-        cached = m_cache->Add(key, *factory, leftFile->DetachStream());
-        delete leftFile;
-    }
+    wxArchiveFSCacheData cached =
+        GetArchiveFSCacheData(*m_cache, m_fs, key, left, *factory);
+    if (!cached.IsOk())
+        return nullptr;
 
-    wxArchiveEntry *entry = cached->Get(right);
-    if (!entry)
+    wxArchiveFSEntry *fse = cached.Get(right);
+    if (!fse)
         return nullptr;
 
-    wxInputStream *leftStream = cached->NewStream();
+    wxInputStream *leftStream = cached.NewStream();
     if (!leftStream)
     {
         wxFSFile *leftFile = m_fs.OpenFile(left);
@@ -388,6 +647,27 @@ wxFSFile* wxArchiveFSHandler::OpenFile(
     if ( !s )
         return nullptr;
 
+    wxArchiveEntry *entry = fse->entry.get();
+
+#if wxUSE_ZIPSTREAM
+    // Entries of zip archives are not kept in the cache, read them again.
+    std::unique_ptr<wxZipEntry> zipEntry;
+    if (!entry)
+    {
+        wxZipInputStream *zip = dynamic_cast<wxZipInputStream*>(s);
+        if (zip)
+            zipEntry.reset(zip->GetEntryAt(fse->pos));
+
+        entry = zipEntry.get();
+    }
+#endif // wxUSE_ZIPSTREAM
+
+    if (!entry)
+    {
+        delete s;
+        return nullptr;
+    }
+
     s->OpenEntry(*entry);
 
     if (!s->IsOk())
@@ -423,15 +703,16 @@ wxString wxArchiveFSHandler::FindFirst(const wxString& spec, int flags)
     if (!factory)
         return wxEmptyString;
 
-    m_Archive = m_cache->Get(key);
-    if (!m_Archive)
-    {
-        wxFSFile *leftFile = m_fs.OpenFile(left);
-        if (!leftFile)
-            return wxEmptyString;
-        m_Archive = m_cache->Add(key, *factory, leftFile->DetachStream());
-        delete leftFile;
-    }
+    wxDELETE(m_Archive);
+
+    wxArchiveFSCacheData cached =
+        GetArchiveFSCacheData(*m_cache, m_fs, key, left, *factory);
+    if (!cached.IsOk())
+        return wxEmptyString;
+
+    // Keep our own reference to the catalog, so that it remains valid even
+    // if the archive is removed from the cache while we're iterating over it.
+    m_Archive = new wxArchiveFSCacheData(cached);
 
     m_FindEntry = nullptr;
 
@@ -483,11 +764,10 @@ wxString wxArchiveFSHandler::DoFind()
 
         if (!m_FindEntry)
         {
-            m_Archive = nullptr;
-            m_FindEntry = nullptr;
+            wxDELETE(m_Archive);
             break;
         }
-        namestr = m_FindEntry->entry->GetName(wxPATH_UNIX);
+        namestr = m_FindEntry->name;
 
         if (m_AllowDirs)
         {
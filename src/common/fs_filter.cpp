@@ -16,6 +16,9 @@
 #ifndef WX_PRECOMP
 #endif
 
+#include "wx/filename.h"
+#include "wx/zstream.h"
+
 #include <memory>
 
 //----------------------------------------------------------------------------
@@ -49,7 +52,34 @@ wxFSFile* wxFilterFSHandler::OpenFile(
     if (!leftStream.get() || !leftStream->IsOk())
         return nullptr;
 
-    std::unique_ptr<wxInputStream> stream(factory->NewStream(leftStream.release()));
+    std::unique_ptr<wxInputStream> stream;
+
+#if wxUSE_ZLIB
+    // Use the stream supporting random access for seekable compressed data,
+    // as this is important for the consumers such as the archive readers.
+    if (leftStream->IsSeekable() &&
+            (wxDynamicCast(factory, wxGzipClassFactory) ||
+                wxDynamicCast(factory, wxZlibClassFactory)))
+    {
+        wxIndexedGzipInputStream *gzStream =
+            new wxIndexedGzipInputStream(leftStream.release());
+        stream.reset(gzStream);
+
+        // Reuse the index saved next to the local file, if there is one.
+        if (GetProtocol(left) == wxT("file"))
+        {
+            const wxString
+                index = wxIndexedGzipInputStream::GetIndexFileName(
+                            wxFileSystem::URLToFileName(left).GetFullPath());
+            if (wxFileName::FileExists(index))
+                gzStream->LoadIndex(index);
+        }
+    }
+    else
+#endif // wxUSE_ZLIB
+    {
+        stream.reset(factory->NewStream(leftStream.release()));
+    }
 
     // The way compressed streams are supposed to be served is e.g.:
     //  Content-type: application/postscript
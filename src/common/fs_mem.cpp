@@ -23,54 +23,113 @@
 #endif
 
 #include "wx/mstream.h"
+#include "wx/thread.h"
 
 // represents a file entry in wxMemoryFS
 class wxMemoryFSFile
 {
 public:
+    // Makes a copy of the data.
     wxMemoryFSFile(const void *data, size_t len, const wxString& mime)
+        : m_Buffer(len)
     {
-        m_Data = new char[len];
-        memcpy(m_Data, data, len);
-        m_Len = len;
-        m_MimeType = mime;
-        InitTime();
+        m_Buffer.AppendData(data, len);
+        Init(mime);
+    }
+
+    // Shares the data of the buffer, which is reference counted. Notice that
+    // we don't store the pointer to its data as it could change if the buffer
+    // were modified, even if this is not supposed to happen.
+    wxMemoryFSFile(const wxMemoryBuffer& buf, const wxString& mime)
+        : m_Buffer(buf)
+    {
+        Init(mime);
     }
 
     wxMemoryFSFile(const wxMemoryOutputStream& stream, const wxString& mime)
+        : m_Buffer(stream.GetSize())
     {
-        m_Len = stream.GetSize();
-        m_Data = new char[m_Len];
-        stream.CopyTo(m_Data, m_Len);
-        m_MimeType = mime;
-        InitTime();
+        const size_t len = stream.GetSize();
+        stream.CopyTo(m_Buffer.GetWriteBuf(len), len);
+        m_Buffer.UngetWriteBuf(len);
+        Init(mime);
     }
 
     virtual ~wxMemoryFSFile()
     {
-        delete[] m_Data;
     }
 
-    char *m_Data;
-    size_t m_Len;
+    // Uses the data which must remain valid as long as this object exists.
+    static wxMemoryFSFile *
+    NewStatic(const void *data, size_t len, const wxString& mime)
+    {
+        wxMemoryFSFile * const file = new wxMemoryFSFile();
+        file->m_StaticData = data;
+        file->m_StaticLen = len;
+        file->Init(mime);
+        return file;
+    }
+
+    const void *GetData() const
+        { return m_StaticData ? m_StaticData : m_Buffer.GetData(); }
+    size_t GetLength() const
+        { return m_StaticData ? m_StaticLen : m_Buffer.GetDataLen(); }
+
     wxString m_MimeType;
 #if wxUSE_DATETIME
-    wxDateTime m_Time;
+    // the time when the file was added, stored as time_t rather than
+    // wxDateTime as wxDateTime::Now() converts it to local time and back, which
+    // is relatively expensive, while we only need wxDateTime in OpenFile()
+    time_t m_Time = 0;
 #endif // wxUSE_DATETIME
 
 private:
-    void InitTime()
+    wxMemoryFSFile() : m_Buffer(0) { }
+
+    void Init(const wxString& mime)
     {
+        m_MimeType = mime;
+
 #if wxUSE_DATETIME
-        m_Time = wxDateTime::Now();
+        m_Time = wxDateTime::GetTimeNow();
 #endif // wxUSE_DATETIME
     }
 
+    // the buffer owning the data, empty if the data is static
+    wxMemoryBuffer m_Buffer;
+
+    // the static data, if any, and its length
+    const void *m_StaticData = nullptr;
+    size_t m_StaticLen = 0;
+
     wxDECLARE_NO_COPY_CLASS(wxMemoryFSFile);
 };
 
 #if wxUSE_BASE
 
+// stream returned by wxMemoryFSHandler::OpenFile(): it keeps a reference to
+// the file to ensure that its data is not freed while it's being read, even if
+// the file is removed from the memory FS in the meanwhile
+class wxMemoryFSInputStream : public wxMemoryInputStream
+{
+public:
+    explicit wxMemoryFSInputStream(const std::shared_ptr<wxMemoryFSFile>& file)
+        : wxMemoryInputStream(file->GetData(), file->GetLength()),
+          m_file(file)
+    {
+    }
+
+private:
+    const std::shared_ptr<wxMemoryFSFile> m_file;
+
+    wxDECLARE_NO_COPY_CLASS(wxMemoryFSInputStream);
+};
+
+static void LogFileAlreadyExists(const wxString& filename)
+{
+    wxLogError(_("Memory VFS already contains file '%s'!"), filename);
+}
+
 
 //--------------------------------------------------------------------------------
 // wxMemoryFSHandler
@@ -79,6 +138,9 @@ private:
 
 wxMemoryFSHandlerBase::wxMemoryFSHash wxMemoryFSHandlerBase::m_Hash;
 
+// protects m_Hash, which may be accessed from several threads
+wxCRIT_SECT_DECLARE(gs_csMemoryFS);
+
 
 wxMemoryFSHandlerBase::wxMemoryFSHandlerBase() : wxFileSystemHandler()
 {
@@ -99,6 +161,8 @@ bool wxMemoryFSHandlerBase::CanOpen(const wxString& location)
 wxFSFile * wxMemoryFSHandlerBase::OpenFile(wxFileSystem& WXUNUSED(fs),
                                            const wxString& location)
 {
+    wxCRIT_SECT_LOCKER(lock, gs_csMemoryFS);
+
     wxMemoryFSHash::const_iterator i = m_Hash.find(GetRightLocation(location));
     if ( i == m_Hash.end() )
         return nullptr;
@@ -107,21 +171,21 @@ wxFSFile * wxMemoryFSHandlerBase::OpenFile(wxFileSystem& WXUNUSED(fs),
 
     return new wxFSFile
                (
-                    new wxMemoryInputStream(obj->m_Data, obj->m_Len),
+                    new wxMemoryFSInputStream(obj),
                     location,
                     obj->m_MimeType,
                     GetAnchor(location)
 #if wxUSE_DATETIME
-                    , obj->m_Time
+                    , wxDateTime(obj->m_Time)
 #endif // wxUSE_DATETIME
                );
 }
 
 wxString wxMemoryFSHandlerBase::FindFirst(const wxString& url, int flags)
 {
-    // Make sure to reset the find iterator, so that calling FindNext() doesn't
-    // reuse its value from the last search that could well be invalid.
-    m_findIter = m_Hash.end();
+    // Make sure to forget the results of the previous search, so that calling
+    // FindNext() doesn't return them.
+    m_findResults.clear();
 
     if ( (flags & wxDIR) && !(flags & wxFILE) )
     {
@@ -131,42 +195,43 @@ wxString wxMemoryFSHandlerBase::FindFirst(const wxString& url, int flags)
     }
 
     const wxString spec = GetRightLocation(url);
+
+    wxCRIT_SECT_LOCKER(lock, gs_csMemoryFS);
+
     if ( spec.find_first_of("?*") == wxString::npos )
     {
         // simple case: there are no wildcard characters so we can return
         // either 0 or 1 results and we can find the potential match quickly
         return m_Hash.count(spec) ? url : wxString();
     }
-    //else: deal with wildcards in FindNext()
 
-    m_findArgument = spec;
-    m_findIter = m_Hash.begin();
+    for ( const auto& kv : m_Hash )
+    {
+        if ( kv.first.Matches(spec) )
+            m_findResults.push_back("memory:" + kv.first);
+    }
 
     return FindNext();
 }
 
 wxString wxMemoryFSHandlerBase::FindNext()
 {
-    while ( m_findIter != m_Hash.end() )
-    {
-        const wxString& path = m_findIter->first;
-
-        // advance m_findIter first as we need to do it anyhow, whether it
-        // matches or not
-        ++m_findIter;
+    if ( m_findResults.empty() )
+        return wxString();
 
-        if ( path.Matches(m_findArgument) )
-            return "memory:" + path;
-    }
+    const wxString path = m_findResults.back();
+    m_findResults.pop_back();
 
-    return wxString();
+    return path;
 }
 
 bool wxMemoryFSHandlerBase::CheckDoesntExist(const wxString& filename)
 {
+    wxCRIT_SECT_LOCKER(lock, gs_csMemoryFS);
+
     if ( m_Hash.count(filename) )
     {
-        wxLogError(_("Memory VFS already contains file '%s'!"), filename);
+        LogFileAlreadyExists(filename);
         return false;
     }
 
@@ -175,10 +240,25 @@ bool wxMemoryFSHandlerBase::CheckDoesntExist(const wxString& filename)
 
 
 /*static*/
-void wxMemoryFSHandlerBase::DoAddFile(const wxString& filename,
+bool wxMemoryFSHandlerBase::DoAddFile(const wxString& filename,
                                       wxMemoryFSFile* file)
 {
-    m_Hash[filename] = std::unique_ptr<wxMemoryFSFile>(file);
+    std::shared_ptr<wxMemoryFSFile> ptr(file);
+
+    // Check that the file doesn't exist and add it atomically, as another
+    // thread could add a file with the same name after CheckDoesntExist()
+    // returned. If the file already exists, the new object is just deleted.
+    bool added;
+    {
+        wxCRIT_SECT_LOCKER(lock, gs_csMemoryFS);
+
+        added = m_Hash.emplace(filename, std::move(ptr)).second;
+    }
+
+    if ( !added )
+        LogFileAlreadyExists(filename);
+
+    return added;
 }
 
 /*static*/
@@ -202,12 +282,26 @@ void wxMemoryFSHandlerBase::AddFileWithMimeType(const wxString& filename,
                                                 const void *binarydata, size_t size,
                                                 const wxString& mimetype)
 {
-    if ( !CheckDoesntExist(filename) )
-        return;
-
     DoAddFile(filename, new wxMemoryFSFile(binarydata, size, mimetype));
 }
 
+/*static*/
+void wxMemoryFSHandlerBase::AddFileWithMimeType(const wxString& filename,
+                                                const wxMemoryBuffer& buf,
+                                                const wxString& mimetype)
+{
+    DoAddFile(filename, new wxMemoryFSFile(buf, mimetype));
+}
+
+/*static*/
+void wxMemoryFSHandlerBase::AddStaticFileWithMimeType(const wxString& filename,
+                                                      const void *binarydata,
+                                                      size_t size,
+                                                      const wxString& mimetype)
+{
+    DoAddFile(filename, wxMemoryFSFile::NewStatic(binarydata, size, mimetype));
+}
+
 /*static*/
 void wxMemoryFSHandlerBase::AddFile(const wxString& filename,
                                     const wxString& textdata)
@@ -223,10 +317,26 @@ void wxMemoryFSHandlerBase::AddFile(const wxString& filename,
     AddFileWithMimeType(filename, binarydata, size, wxEmptyString);
 }
 
+/*static*/
+void wxMemoryFSHandlerBase::AddFile(const wxString& filename,
+                                    const wxMemoryBuffer& buf)
+{
+    AddFileWithMimeType(filename, buf, wxEmptyString);
+}
+
+/*static*/
+void wxMemoryFSHandlerBase::AddStaticFile(const wxString& filename,
+                                          const void *binarydata, size_t size)
+{
+    AddStaticFileWithMimeType(filename, binarydata, size, wxEmptyString);
+}
+
 
 
 /*static*/ void wxMemoryFSHandlerBase::RemoveFile(const wxString& filename)
 {
+    wxCRIT_SECT_LOCKER(lock, gs_csMemoryFS);
+
     if ( !m_Hash.erase(filename) )
     {
         wxLogError(_("Trying to remove file '%s' from memory VFS, "
@@ -245,6 +355,8 @@ wxMemoryFSHandler::AddFile(const wxString& filename,
                            const wxImage& image,
                            wxBitmapType type)
 {
+    // check this before doing the relatively expensive conversion, but
+    // DoAddFile() checks it again as the file could have been added since then
     if ( !CheckDoesntExist(filename) )
         return;
 
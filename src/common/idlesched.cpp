@@ -0,0 +1,199 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/common/idlesched.cpp
+// Purpose:     wxIdleTaskScheduler implementation
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// for compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+
+#include "wx/idlesched.h"
+
+#ifndef WX_PRECOMP
+    #include "wx/app.h"
+#endif // WX_PRECOMP
+
+#include "wx/evtloop.h"
+#include "wx/scopeguard.h"
+#include "wx/stopwatch.h"
+
+#include <algorithm>
+
+// ============================================================================
+// wxIdleTaskScheduler implementation
+// ============================================================================
+
+/* static */
+wxIdleTaskScheduler& wxIdleTaskScheduler::Get()
+{
+    static wxIdleTaskScheduler s_scheduler;
+
+    return s_scheduler;
+}
+
+wxIdleTaskScheduler::wxIdleTaskScheduler()
+{
+    m_timeSlice = 10;
+    m_lastId = 0;
+    m_pass = 0;
+    m_isRunning = false;
+}
+
+wxIdleTaskScheduler::TaskData* wxIdleTaskScheduler::FindTask(int id)
+{
+    for ( auto& data : m_tasks )
+    {
+        if ( data.id == id )
+            return &data;
+    }
+
+    return nullptr;
+}
+
+int wxIdleTaskScheduler::AddTask(const Task& task, int priority, long budget)
+{
+    wxCHECK_MSG( task, wxNOT_FOUND, "invalid task" );
+
+    TaskData data;
+    data.task = task;
+    data.id = ++m_lastId;
+    data.priority = priority;
+    data.budget = budget;
+    data.lastPass = 0;
+    data.waiting = false;
+
+    m_tasks.push_back(data);
+
+    // Make sure the new task gets executed soon.
+    if ( wxTheApp )
+        wxTheApp->WakeUpIdle();
+
+    return data.id;
+}
+
+bool wxIdleTaskScheduler::RemoveTask(int id)
+{
+    for ( auto it = m_tasks.begin(); it != m_tasks.end(); ++it )
+    {
+        if ( it->id == id )
+        {
+            m_tasks.erase(it);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void wxIdleTaskScheduler::WakeUp(int id)
+{
+    TaskData* const data = FindTask(id);
+    wxCHECK_RET( data, "no task with such ID" );
+
+    if ( !data->waiting )
+        return;
+
+    data->waiting = false;
+
+    if ( wxTheApp )
+        wxTheApp->WakeUpIdle();
+}
+
+bool wxIdleTaskScheduler::ProcessIdle()
+{
+    if ( m_tasks.empty() || m_isRunning )
+        return false;
+
+    m_isRunning = true;
+    wxON_BLOCK_EXIT_SET(m_isRunning, false);
+
+    m_pass++;
+
+    // Determine the order in which the tasks should run: by priority first
+    // and then starting with the least recently run ones, so that the tasks
+    // with the same priority share the available time fairly.
+    std::vector<const TaskData*> order;
+    order.reserve(m_tasks.size());
+    for ( const auto& data : m_tasks )
+    {
+        if ( !data.waiting )
+            order.push_back(&data);
+    }
+
+    std::stable_sort(order.begin(), order.end(),
+                     [](const TaskData* a, const TaskData* b)
+                     {
+                         if ( a->priority != b->priority )
+                             return a->priority > b->priority;
+
+                         return a->lastPass < b->lastPass;
+                     });
+
+    // We can't keep pointers to the tasks as the task functions may add or
+    // remove tasks, so use their IDs.
+    std::vector<int> ids;
+    ids.reserve(order.size());
+    for ( const TaskData* data : order )
+        ids.push_back(data->id);
+
+    wxEventLoopBase* const loop = wxEventLoopBase::GetActive();
+
+    wxStopWatch swSlice;
+    for ( int id : ids )
+    {
+        TaskData* data = FindTask(id);
+        if ( !data )
+            continue;
+
+        // Copy the task as it could be removed while it's running.
+        const Task task = data->task;
+        const long budget = data->budget;
+
+        data->lastPass = m_pass;
+
+        wxStopWatch swTask;
+        for ( ;; )
+        {
+            const wxIdleTaskResult result = task();
+
+            data = FindTask(id);
+            if ( !data )
+                break;
+
+            if ( result == wxIDLE_TASK_DONE )
+            {
+                RemoveTask(id);
+                break;
+            }
+
+            if ( result == wxIDLE_TASK_WAIT )
+            {
+                data->waiting = true;
+                break;
+            }
+
+            // Stop running this task if it exhausted its budget or if we
+            // have more important things to do.
+            if ( swTask.Time() >= budget || swSlice.Time() >= m_timeSlice )
+                break;
+
+            if ( loop && loop->Pending() )
+                break;
+        }
+
+        if ( swSlice.Time() >= m_timeSlice || (loop && loop->Pending()) )
+            break;
+    }
+
+    for ( const auto& data : m_tasks )
+    {
+        if ( !data.waiting )
+            return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,485 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/common/lz4stream.cpp
+// Purpose:     Implementation of LZ4 stream classes
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ============================================================================
+// declarations
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+// for compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+
+#if wxUSE_LIBLZ4 && wxUSE_STREAMS
+
+#include "wx/lz4stream.h"
+
+#ifndef WX_PRECOMP
+    #include "wx/log.h"
+    #include "wx/translation.h"
+#endif // WX_PRECOMP
+
+#include <lz4.h>
+
+// The functions for using dictionaries are only declared in this section of
+// the header before lz4 1.10.
+#define LZ4F_STATIC_LINKING_ONLY
+#include <lz4frame.h>
+
+namespace wxPrivate
+{
+
+// ----------------------------------------------------------------------------
+// Constants
+// ----------------------------------------------------------------------------
+
+// Size of the compressed data buffer for decompression and of the largest
+// chunk of data passed to LZ4F_compressUpdate() for compression.
+const size_t wxLZ4_BUF_SIZE = 64*1024;
+
+// ----------------------------------------------------------------------------
+// Private helpers
+// ----------------------------------------------------------------------------
+
+// Decompression context together with the buffer for the compressed data.
+struct wxLZ4Decoder
+{
+    wxLZ4Decoder()
+    {
+        if ( LZ4F_isError(LZ4F_createDecompressionContext(&ctx, LZ4F_VERSION)) )
+            ctx = nullptr;
+
+        buf = new wxUint8[wxLZ4_BUF_SIZE];
+        inPos =
+        inLen = 0;
+
+        inFrame = false;
+        mayHaveOutput = false;
+    }
+
+    ~wxLZ4Decoder()
+    {
+        delete [] buf;
+        LZ4F_freeDecompressionContext(ctx);
+    }
+
+    LZ4F_dctx* ctx;
+    wxUint8* buf;
+    size_t inPos,
+           inLen;
+
+    // Unlike the compression dictionary, this one is not copied by lz4.
+    wxMemoryBuffer dict;
+
+    // True while in the middle of a frame, i.e. if reaching the end of the
+    // underlying stream now would mean that it is truncated.
+    bool inFrame;
+
+    // True if the last call filled the output buffer completely, in which
+    // case the decoder may have more data for us even without any input.
+    bool mayHaveOutput;
+
+    wxDECLARE_NO_COPY_CLASS(wxLZ4Decoder);
+};
+
+// Compression context together with the buffer for the compressed data.
+struct wxLZ4Encoder
+{
+    explicit wxLZ4Encoder(int level)
+    {
+        if ( LZ4F_isError(LZ4F_createCompressionContext(&ctx, LZ4F_VERSION)) )
+            ctx = nullptr;
+
+        cdict = nullptr;
+
+        memset(&prefs, 0, sizeof(prefs));
+        prefs.compressionLevel = level == -1 ? 0 : level;
+        prefs.frameInfo.contentChecksumFlag = LZ4F_contentChecksumEnabled;
+
+        // The buffer must be big enough for the output of any single call.
+        bufSize = LZ4F_compressBound(wxLZ4_BUF_SIZE, &prefs);
+        if ( bufSize < LZ4F_HEADER_SIZE_MAX )
+            bufSize = LZ4F_HEADER_SIZE_MAX;
+        buf = new wxUint8[bufSize];
+
+        started =
+        finished = false;
+    }
+
+    ~wxLZ4Encoder()
+    {
+        delete [] buf;
+        LZ4F_freeCDict(cdict);
+        LZ4F_freeCompressionContext(ctx);
+    }
+
+    LZ4F_cctx* ctx;
+    LZ4F_CDict* cdict;
+    LZ4F_preferences_t prefs;
+    wxUint8* buf;
+    size_t bufSize;
+
+    // True if the frame header had been written and the frame not ended yet.
+    bool started;
+
+    // Set once the frame has been ended, to avoid starting a new one.
+    bool finished;
+
+    wxDECLARE_NO_COPY_CLASS(wxLZ4Encoder);
+};
+
+} // namespace wxPrivate
+
+using namespace wxPrivate;
+
+// ============================================================================
+// implementation
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Functions
+// ----------------------------------------------------------------------------
+
+wxVersionInfo wxGetLibLZ4VersionInfo()
+{
+    const int ver = LZ4_versionNumber();
+
+    return wxVersionInfo
+           (
+            "liblz4",
+            ver / 10000,
+            (ver % 10000) / 100,
+            ver % 100
+           );
+}
+
+// ----------------------------------------------------------------------------
+// wxLZ4InputStream: decompression
+// ----------------------------------------------------------------------------
+
+void wxLZ4InputStream::Init()
+{
+    m_decoder = new wxLZ4Decoder;
+    m_pos = 0;
+
+    if ( !m_decoder->ctx )
+    {
+        wxLogError(_("Failed to allocate memory for LZ4 decompression."));
+        m_lasterror = wxSTREAM_READ_ERROR;
+    }
+}
+
+wxLZ4InputStream::~wxLZ4InputStream()
+{
+    delete m_decoder;
+}
+
+bool wxLZ4InputStream::SetDictionary(const char *data, size_t datalen)
+{
+    // The dictionary can't be changed in the middle of a frame.
+    if ( m_decoder->inFrame )
+        return false;
+
+    m_decoder->dict.Clear();
+    m_decoder->dict.AppendData(data, datalen);
+
+    return true;
+}
+
+bool wxLZ4InputStream::SetDictionary(const wxMemoryBuffer &buf)
+{
+    return SetDictionary((char*)buf.GetData(), buf.GetDataLen());
+}
+
+size_t wxLZ4InputStream::OnSysRead(void* outbuf, size_t size)
+{
+    wxUint8* const out = static_cast<wxUint8*>(outbuf);
+    size_t outPos = 0;
+
+    // Decompress input as long as we don't have any errors (including EOF, as
+    // it doesn't make sense to continue after it either) and have space to
+    // decompress it to.
+    while ( m_lasterror == wxSTREAM_NO_ERROR && outPos < size )
+    {
+        // Get more input data if needed.
+        if ( m_decoder->inPos == m_decoder->inLen && !m_decoder->mayHaveOutput )
+        {
+            m_parent_i_stream->Read(m_decoder->buf, wxLZ4_BUF_SIZE);
+            m_decoder->inLen = m_parent_i_stream->LastRead();
+            m_decoder->inPos = 0;
+
+            if ( !m_decoder->inLen )
+            {
+                if ( m_parent_i_stream->GetLastError() == wxSTREAM_EOF )
+                {
+                    // We have reached end of the underlying stream, which is
+                    // only fine if it happened between the frames.
+                    if ( !m_decoder->inFrame )
+                    {
+                        m_lasterror = wxSTREAM_EOF;
+                        break;
+                    }
+
+                    wxLogError(_("LZ4 decompression error: %s"),
+                               _("input is truncated"));
+                }
+
+                m_lasterror = wxSTREAM_READ_ERROR;
+                return 0;
+            }
+        }
+
+        // Do decompress, these variables are updated to contain the number
+        // of bytes actually written and consumed by LZ4F_decompress().
+        size_t outSize = size - outPos;
+        size_t inSize = m_decoder->inLen - m_decoder->inPos;
+
+        const wxMemoryBuffer& dict = m_decoder->dict;
+        const size_t rc = dict.GetDataLen()
+                            ? LZ4F_decompress_usingDict
+                              (
+                                m_decoder->ctx,
+                                out + outPos, &outSize,
+                                m_decoder->buf + m_decoder->inPos, &inSize,
+                                dict.GetData(), dict.GetDataLen(),
+                                nullptr
+                              )
+                            : LZ4F_decompress
+                              (
+                                m_decoder->ctx,
+                                out + outPos, &outSize,
+                                m_decoder->buf + m_decoder->inPos, &inSize,
+                                nullptr
+                              );
+        if ( LZ4F_isError(rc) )
+        {
+            wxLogError(_("LZ4 decompression error: %s"),
+                       LZ4F_getErrorName(rc));
+
+            m_lasterror = wxSTREAM_READ_ERROR;
+            return 0;
+        }
+
+        outPos += outSize;
+        m_decoder->inPos += inSize;
+
+        // Zero return value means that the frame is complete and the next
+        // call will start decoding the next one, if any.
+        m_decoder->inFrame = rc != 0;
+        m_decoder->mayHaveOutput = outPos == size;
+    }
+
+    // Return the number of bytes actually read, this may be less than the
+    // requested size if we hit EOF.
+    m_pos += outPos;
+    return outPos;
+}
+
+// ----------------------------------------------------------------------------
+// wxLZ4OutputStream: compression
+// ----------------------------------------------------------------------------
+
+void wxLZ4OutputStream::Init(int level)
+{
+    m_encoder = new wxLZ4Encoder(level);
+    m_pos = 0;
+
+    if ( !m_encoder->ctx )
+    {
+        wxLogError(_("Failed to allocate memory for LZ4 compression."));
+        m_lasterror = wxSTREAM_WRITE_ERROR;
+    }
+}
+
+wxLZ4OutputStream::~wxLZ4OutputStream()
+{
+    Close();
+
+    delete m_encoder;
+}
+
+/* static */
+int wxLZ4OutputStream::GetMaxLevel()
+{
+    return LZ4F_compressionLevel_max();
+}
+
+bool wxLZ4OutputStream::SetDictionary(const char *data, size_t datalen)
+{
+    // The dictionary is used when starting the frame, so it's too late to
+    // set it once this had happened.
+    if ( m_encoder->started )
+        return false;
+
+    LZ4F_CDict* const cdict = LZ4F_createCDict(data, datalen);
+    if ( !cdict )
+        return false;
+
+    LZ4F_freeCDict(m_encoder->cdict);
+    m_encoder->cdict = cdict;
+
+    return true;
+}
+
+bool wxLZ4OutputStream::SetDictionary(const wxMemoryBuffer &buf)
+{
+    return SetDictionary((char*)buf.GetData(), buf.GetDataLen());
+}
+
+bool wxLZ4OutputStream::UpdateOutput(size_t rc)
+{
+    if ( LZ4F_isError(rc) )
+    {
+        wxLogError(_("LZ4 compression error: %s"), LZ4F_getErrorName(rc));
+
+        m_lasterror = wxSTREAM_WRITE_ERROR;
+        return false;
+    }
+
+    m_parent_o_stream->Write(m_encoder->buf, rc);
+    if ( m_parent_o_stream->LastWrite() != rc )
+    {
+        m_lasterror = wxSTREAM_WRITE_ERROR;
+        return false;
+    }
+
+    return true;
+}
+
+bool wxLZ4OutputStream::BeginFrameIfNecessary()
+{
+    if ( m_encoder->started )
+        return true;
+
+    const size_t rc = LZ4F_compressBegin_usingCDict
+                      (
+                        m_encoder->ctx,
+                        m_encoder->buf, m_encoder->bufSize,
+                        m_encoder->cdict,
+                        &m_encoder->prefs
+                      );
+    if ( !UpdateOutput(rc) )
+        return false;
+
+    m_encoder->started = true;
+    m_encoder->finished = false;
+
+    return true;
+}
+
+size_t wxLZ4OutputStream::OnSysWrite(const void *inbuf, size_t size)
+{
+    if ( m_lasterror != wxSTREAM_NO_ERROR || !BeginFrameIfNecessary() )
+        return 0;
+
+    const wxUint8* const in = static_cast<const wxUint8*>(inbuf);
+
+    // Compress the data in chunks of at most the size for which the output
+    // buffer is guaranteed to be big enough.
+    for ( size_t inPos = 0; inPos < size; )
+    {
+        size_t inSize = size - inPos;
+        if ( inSize > wxLZ4_BUF_SIZE )
+            inSize = wxLZ4_BUF_SIZE;
+
+        const size_t rc = LZ4F_compressUpdate
+                          (
+                            m_encoder->ctx,
+                            m_encoder->buf, m_encoder->bufSize,
+                            in + inPos, inSize,
+                            nullptr
+                          );
+        if ( !UpdateOutput(rc) )
+            return 0;
+
+        inPos += inSize;
+    }
+
+    m_pos += size;
+    return size;
+}
+
+bool wxLZ4OutputStream::DoFlush(bool finish)
+{
+    if ( m_lasterror != wxSTREAM_NO_ERROR )
+        return false;
+
+    // Nothing to do if the frame was already ended, and flushing now would
+    // start a new one.
+    if ( m_encoder->finished )
+        return true;
+
+    // Note that this does write an empty frame if nothing had been written
+    // yet, which is what we want when closing the stream.
+    if ( !BeginFrameIfNecessary() )
+        return false;
+
+    if ( !finish )
+    {
+        return UpdateOutput(LZ4F_flush(m_encoder->ctx,
+                                       m_encoder->buf, m_encoder->bufSize,
+                                       nullptr));
+    }
+
+    if ( !UpdateOutput(LZ4F_compressEnd(m_encoder->ctx,
+                                        m_encoder->buf, m_encoder->bufSize,
+                                        nullptr)) )
+        return false;
+
+    m_encoder->started = false;
+    m_encoder->finished = true;
+
+    return true;
+}
+
+bool wxLZ4OutputStream::Close()
+{
+    if ( !DoFlush(true) )
+        return false;
+
+    return wxFilterOutputStream::Close() && IsOk();
+}
+
+// ----------------------------------------------------------------------------
+// wxLZ4ClassFactory: allow creating streams from extension/MIME type
+// ----------------------------------------------------------------------------
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxLZ4ClassFactory, wxFilterClassFactory);
+
+static wxLZ4ClassFactory g_wxLZ4ClassFactory;
+
+wxLZ4ClassFactory::wxLZ4ClassFactory()
+{
+    if ( this == &g_wxLZ4ClassFactory )
+        PushFront();
+}
+
+const wxChar * const *
+wxLZ4ClassFactory::GetProtocols(wxStreamProtocolType type) const
+{
+    static const wxChar *mime[] = { wxT("application/x-lz4"), nullptr };
+    static const wxChar *encs[] = { wxT("lz4"), nullptr };
+    static const wxChar *exts[] = { wxT(".lz4"), nullptr };
+
+    const wxChar* const* ret = nullptr;
+    switch ( type )
+    {
+        case wxSTREAM_PROTOCOL: ret = encs; break;
+        case wxSTREAM_MIMETYPE: ret = mime; break;
+        case wxSTREAM_ENCODING: ret = encs; break;
+        case wxSTREAM_FILEEXT:  ret = exts; break;
+    }
+
+    return ret;
+}
+
+#endif // wxUSE_LIBLZ4 && wxUSE_STREAMS
@@ -956,6 +956,30 @@ bool wxInputStream::ReadAll(void *buffer_, size_t size)
     return size == 0;
 }
 
+wxInputStream& wxInputStream::ReadV(const wxStreamIOVec *vec, size_t count)
+{
+    size_t totalCount = 0;
+
+    for ( size_t n = 0; n < count; n++ )
+    {
+        const size_t size = vec[n].size;
+        if ( !size )
+            continue;
+
+        const size_t lastCount = Read(vec[n].data, size).LastRead();
+        totalCount += lastCount;
+
+        // Don't try to read into the next buffer if this one couldn't be
+        // filled, as the data would be discontinuous otherwise.
+        if ( lastCount != size )
+            break;
+    }
+
+    m_lastcount = totalCount;
+
+    return *this;
+}
+
 wxFileOffset wxInputStream::SeekI(wxFileOffset pos, wxSeekMode mode)
 {
     // RR: This code is duplicated in wxBufferedInputStream. This is
@@ -1122,6 +1146,30 @@ bool wxOutputStream::WriteAll(const void *buffer_, size_t size)
     return size == 0;
 }
 
+wxOutputStream&
+wxOutputStream::WriteV(const wxStreamConstIOVec *vec, size_t count)
+{
+    // This mirrors ReadV(), see there for more comments.
+    size_t totalCount = 0;
+
+    for ( size_t n = 0; n < count; n++ )
+    {
+        const size_t size = vec[n].size;
+        if ( !size )
+            continue;
+
+        const size_t lastCount = Write(vec[n].data, size).LastWrite();
+        totalCount += lastCount;
+
+        if ( lastCount != size )
+            break;
+    }
+
+    m_lastcount = totalCount;
+
+    return *this;
+}
+
 wxFileOffset wxOutputStream::TellO() const
 {
     return OnSysTell();
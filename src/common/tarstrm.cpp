@@ -32,7 +32,11 @@
 #include <grp.h>
 #endif
 
+#include <algorithm>
+#include <deque>
 #include <memory>
+#include <string>
+#include <vector>
 
 /////////////////////////////////////////////////////////////////////////////
 // constants
@@ -60,6 +64,15 @@ enum {
 
 static const int TAR_BLOCKSIZE = 512;
 
+// old GNU sparse files, the positions are within the header block
+static const int GNU_SPARSE_POS = 386;      // the first sparse map entries
+static const int GNU_SPARSE_COUNT = 4;      // number of them in the header
+static const int GNU_ISEXTENDED_POS = 482;  // more entries follow the header
+static const int GNU_REALSIZE_POS = 483;    // size of the file with holes
+static const int GNU_SPARSE_EXT_COUNT = 21; // entries in an extension block
+static const int GNU_SPARSE_EXT_ISEXTENDED_POS = 504;
+static const int GNU_NUMBER_LEN = 12;       // length of the numbers in them
+
 // checksum type
 enum {
     SUM_UNKNOWN,
@@ -128,7 +141,7 @@ public:
     void Clear(size_t len = 0) { memset(data, 0, len ? len : sizeof(data)); }
 
     bool Read(wxInputStream& in);
-    bool Write(wxOutputStream& out);
+    void Pack(char *block) const;
     inline bool WriteField(wxOutputStream& out, int id);
 
     bool IsAllZeros() const;
@@ -136,12 +149,15 @@ public:
     wxUint32 SumField(int id);
 
     char *Get(int id) { return data + fields[id].pos + id; }
+    const char *At(size_t pos) const;
     static size_t Len(int id) { return fields[id + 1].pos - fields[id].pos; }
     static const wxChar *Name(int id) { return fields[id].name; }
     static size_t Offset(int id) { return fields[id].pos; }
 
     bool SetOctal(int id, wxTarNumber n);
-    wxTarNumber GetOctal(int id);
+    bool SetBinary(int id, wxTarNumber n);
+    wxTarNumber GetOctal(int id) { return GetNumber(Get(id), Len(id)); }
+    static wxTarNumber GetNumber(const char *p, size_t len);
     bool SetPath(const wxString& name, wxMBConv& conv);
 
 private:
@@ -221,24 +237,33 @@ wxUint32 wxTarHeaderBlock::SumField(int id)
     return n;
 }
 
+// Read and write the block in one go, and only then copy the fields to or
+// from their nul terminated locations in 'data'.
+//
 bool wxTarHeaderBlock::Read(wxInputStream& in)
 {
-    bool ok = true;
+    char block[TAR_BLOCKSIZE];
+    size_t lastread = in.Read(block, sizeof(block)).LastRead();
+    memset(block + lastread, 0, sizeof(block) - lastread);
 
-    for (int id = 0; id < TAR_NUMFIELDS && ok; id++)
-        ok = in.Read(Get(id), Len(id)).LastRead() == Len(id);
+    for (int id = 0; id < TAR_NUMFIELDS; id++)
+        memcpy(Get(id), block + Offset(id), Len(id));
 
-    return ok;
+    return lastread == sizeof(block);
 }
 
-bool wxTarHeaderBlock::Write(wxOutputStream& out)
+void wxTarHeaderBlock::Pack(char *block) const
 {
-    bool ok = true;
-
-    for (int id = 0; id < TAR_NUMFIELDS && ok; id++)
-        ok = WriteField(out, id);
+    for (int id = 0; id < TAR_NUMFIELDS; id++)
+        memcpy(block + Offset(id), data + Offset(id) + id, Len(id));
+}
 
-    return ok;
+const char *wxTarHeaderBlock::At(size_t pos) const
+{
+    int id = 0;
+    while (fields[id + 1].pos <= (int)pos)
+        id++;
+    return data + pos + id;
 }
 
 inline bool wxTarHeaderBlock::WriteField(wxOutputStream& out, int id)
@@ -246,14 +271,25 @@ inline bool wxTarHeaderBlock::WriteField(wxOutputStream& out, int id)
     return out.Write(Get(id), Len(id)).LastWrite() == Len(id);
 }
 
-wxTarNumber wxTarHeaderBlock::GetOctal(int id)
+wxTarNumber wxTarHeaderBlock::GetNumber(const char *p, size_t len)
 {
+    const unsigned char *q = (const unsigned char*)p;
+    const unsigned char *end = q + len;
+
+    // GNU tar stores the numbers which don't fit as octal in base-256, this
+    // is indicated by the high bit of the first byte, the next bit is the sign
+    if (len && (*q & 0x80)) {
+        wxUint64 u = (*q & 0x40) ? ~wxUint64(0) : wxUint64(*q & 0x3f);
+        while (++q < end)
+            u = (u << 8) | *q;
+        return wxTarNumber(u);
+    }
+
     wxTarNumber n = 0;
-    const char *p = Get(id);
-    while (*p == ' ')
-        p++;
-    while (*p >= '0' && *p < '8')
-        n = (n << 3) | (*p++ - '0');
+    while (q < end && *q == ' ')
+        q++;
+    while (q < end && *q >= '0' && *q < '8')
+        n = (n << 3) | (*q++ - '0');
     return n;
 }
 
@@ -270,6 +306,21 @@ bool wxTarHeaderBlock::SetOctal(int id, wxTarNumber n)
     return n == 0;
 }
 
+bool wxTarHeaderBlock::SetBinary(int id, wxTarNumber n)
+{
+    // set a field using the GNU base-256 encoding, return true if it fits
+    if (n < 0)
+        return false;
+    unsigned char *field = (unsigned char*)Get(id);
+    unsigned char *p = field + Len(id);
+    while (p > field + 1) {
+        *--p = (unsigned char)(n & 0xff);
+        n >>= 8;
+    }
+    *field = 0x80;
+    return n == 0;
+}
+
 bool wxTarHeaderBlock::SetPath(const wxString& name, wxMBConv& conv)
 {
     bool badconv = false;
@@ -326,6 +377,109 @@ static wxFileOffset RoundUpSize(wxFileOffset size, int factor = 1)
     return ((size + chunk - 1) / chunk) * chunk;
 }
 
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Sparse files
+
+// The map of the regions of a sparse file whose data is stored in the tar,
+// anything between them is a hole which reads as zeros.
+//
+class wxTarSparseMap
+{
+public:
+    wxTarSparseMap() : m_realsize(0), m_datasize(0) { }
+
+    bool Add(wxFileOffset offset, wxFileOffset size);
+    bool SetRealSize(wxFileOffset size);
+
+    wxFileOffset GetRealSize() const { return m_realsize; }
+    wxFileOffset GetDataSize() const { return m_datasize; }
+
+    struct Region
+    {
+        wxFileOffset offset;    // offset of the region within the file
+        wxFileOffset size;      // its size
+        wxFileOffset datapos;   // offset of its data within the tar entry
+    };
+
+    // Find the region containing the offset or the first one after it
+    const Region *Find(wxFileOffset offset) const;
+
+    // The offset within the stored data corresponding to the file offset
+    wxFileOffset GetDataPos(wxFileOffset offset) const;
+
+private:
+    std::vector<Region> m_regions;
+    wxFileOffset m_realsize;
+    wxFileOffset m_datasize;
+};
+
+bool wxTarSparseMap::Add(wxFileOffset offset, wxFileOffset size)
+{
+    // the regions must be in order and not overlap
+    wxFileOffset end = m_regions.empty() ? 0 : m_regions.back().offset
+                                               + m_regions.back().size;
+    if (offset < end || size < 0)
+        return false;
+
+    // GNU tar terminates the map with an empty region at the end of the file
+    if (size) {
+        Region region = { offset, size, m_datasize };
+        m_regions.push_back(region);
+        m_datasize += size;
+    }
+
+    return true;
+}
+
+bool wxTarSparseMap::SetRealSize(wxFileOffset size)
+{
+    m_realsize = size;
+    return m_regions.empty() ||
+           m_regions.back().offset + m_regions.back().size <= size;
+}
+
+const wxTarSparseMap::Region *wxTarSparseMap::Find(wxFileOffset offset) const
+{
+    std::vector<Region>::const_iterator it = std::partition_point(
+        m_regions.begin(), m_regions.end(),
+        [offset](const Region& r) { return r.offset + r.size <= offset; });
+
+    return it != m_regions.end() ? &*it : nullptr;
+}
+
+wxFileOffset wxTarSparseMap::GetDataPos(wxFileOffset offset) const
+{
+    const Region *region = Find(offset);
+
+    if (!region)
+        return m_datasize;
+    if (offset <= region->offset)
+        return region->datapos;
+    return region->datapos + offset - region->offset;
+}
+
+// Parse a decimal number from a sparse map in a pax header, skipping the
+// separator following it.
+//
+static bool wxTarParseDecimal(const char*& p, wxFileOffset& n, char sep)
+{
+    if (!isdigit((unsigned char)*p))
+        return false;
+
+    n = 0;
+    while (isdigit((unsigned char)*p))
+        n = n * 10 + (*p++ - '0');
+
+    if (sep && *p == sep)
+        p++;
+    else if (*p)
+        return false;
+
+    return true;
+}
+
 #ifdef __UNIX__
 
 static wxString wxTarUserName(int uid)
@@ -457,7 +611,8 @@ wxTarEntry::wxTarEntry(const wxString& name /*=wxEmptyString*/,
     m_UserName(wxGetTarUser().uname),
     m_GroupName(wxGetTarUser().gname),
     m_DevMajor(~0),
-    m_DevMinor(~0)
+    m_DevMinor(~0),
+    m_Sparse(nullptr)
 {
     if (!name.empty())
         SetName(name);
@@ -465,6 +620,7 @@ wxTarEntry::wxTarEntry(const wxString& name /*=wxEmptyString*/,
 
 wxTarEntry::~wxTarEntry()
 {
+    delete m_Sparse;
 }
 
 wxTarEntry::wxTarEntry(const wxTarEntry& e)
@@ -484,7 +640,8 @@ wxTarEntry::wxTarEntry(const wxTarEntry& e)
     m_UserName(e.m_UserName),
     m_GroupName(e.m_GroupName),
     m_DevMajor(e.m_DevMajor),
-    m_DevMinor(e.m_DevMinor)
+    m_DevMinor(e.m_DevMinor),
+    m_Sparse(e.m_Sparse ? new wxTarSparseMap(*e.m_Sparse) : nullptr)
 {
 }
 
@@ -507,6 +664,8 @@ wxTarEntry& wxTarEntry::operator=(const wxTarEntry& e)
         m_GroupName = e.m_GroupName;
         m_DevMajor = e.m_DevMajor;
         m_DevMinor = e.m_DevMinor;
+        delete m_Sparse;
+        m_Sparse = e.m_Sparse ? new wxTarSparseMap(*e.m_Sparse) : nullptr;
     }
     return *this;
 }
@@ -641,9 +800,11 @@ void wxTarInputStream::Init()
     m_pos = wxInvalidOffset;
     m_offset = 0;
     m_size = wxInvalidOffset;
+    m_datapos = 0;
     m_sumType = SUM_UNKNOWN;
     m_tarType = TYPE_USTAR;
     m_hdr = new wxTarHeaderBlock;
+    m_sparse = nullptr;
     m_HeaderRecs = nullptr;
     m_GlobalHeaderRecs = nullptr;
     m_lasterror = m_parent_i_stream->GetLastError();
@@ -652,6 +813,7 @@ void wxTarInputStream::Init()
 wxTarInputStream::~wxTarInputStream()
 {
     delete m_hdr;
+    delete m_sparse;
     delete m_HeaderRecs;
     delete m_GlobalHeaderRecs;
 }
@@ -667,16 +829,26 @@ wxTarEntry *wxTarInputStream::GetNextEntry()
 
     entry->SetMode(GetHeaderNumber(TAR_MODE));
     entry->SetUserId(GetHeaderNumber(TAR_UID));
-    entry->SetGroupId(GetHeaderNumber(TAR_UID));
+    entry->SetGroupId(GetHeaderNumber(TAR_GID));
     entry->SetSize(GetHeaderNumber(TAR_SIZE));
 
+    if (!ReadSparseMap(*entry)) {
+        m_lasterror = wxSTREAM_READ_ERROR;
+        return nullptr;
+    }
+
     entry->SetOffset(m_offset);
 
     entry->SetDateTime(GetHeaderDate(wxT("mtime")));
     entry->SetAccessTime(GetHeaderDate(wxT("atime")));
     entry->SetCreateTime(GetHeaderDate(wxT("ctime")));
 
-    entry->SetTypeFlag(*m_hdr->Get(TAR_TYPEFLAG));
+    // old GNU sparse files are regular files once their holes are filled in
+    int typeflag = *m_hdr->Get(TAR_TYPEFLAG);
+    if (typeflag == 'S' && entry->IsSparse())
+        typeflag = wxTAR_REGTYPE;
+
+    entry->SetTypeFlag(typeflag);
     bool isDir = entry->IsDir();
 
     entry->SetLinkName(GetHeaderString(TAR_LINKNAME));
@@ -698,6 +870,10 @@ wxTarEntry *wxTarInputStream::GetNextEntry()
 
     m_size = GetDataSize(*entry);
     m_pos = 0;
+    m_datapos = 0;
+
+    delete m_sparse;
+    m_sparse = entry->m_Sparse ? new wxTarSparseMap(*entry->m_Sparse) : nullptr;
 
     return entry.release();
 }
@@ -713,6 +889,10 @@ bool wxTarInputStream::OpenEntry(wxTarEntry& entry)
         m_offset = offset;
         m_size = GetDataSize(entry);
         m_pos = 0;
+        m_datapos = 0;
+        delete m_sparse;
+        m_sparse = entry.m_Sparse ? new wxTarSparseMap(*entry.m_Sparse)
+                                  : nullptr;
         m_lasterror = wxSTREAM_NO_ERROR;
         return true;
     } else {
@@ -734,8 +914,15 @@ bool wxTarInputStream::CloseEntry()
     if (!IsOpened())
         return true;
 
-    wxFileOffset size = RoundUpSize(m_size);
-    wxFileOffset remainder = size - m_pos;
+    // for sparse files only the data of their non-hole regions is stored
+    wxFileOffset size, remainder;
+    if (m_sparse) {
+        size = RoundUpSize(m_sparse->GetDataSize());
+        remainder = size - m_datapos;
+    } else {
+        size = RoundUpSize(m_size);
+        remainder = size - m_pos;
+    }
 
     if (remainder && m_parent_i_stream->IsSeekable()) {
         wxLogNull nolog;
@@ -745,7 +932,7 @@ bool wxTarInputStream::CloseEntry()
     }
 
     if (remainder) {
-        const int BUFSIZE = 8192;
+        const int BUFSIZE = 65536;
         wxCharBuffer buf(BUFSIZE);
 
         while (remainder > 0 && m_parent_i_stream->IsOk())
@@ -757,6 +944,9 @@ bool wxTarInputStream::CloseEntry()
     m_offset += size;
     m_lasterror = m_parent_i_stream->GetLastError();
 
+    delete m_sparse;
+    m_sparse = nullptr;
+
     return IsOk();
 }
 
@@ -843,7 +1033,11 @@ wxString wxTarInputStream::GetExtendedHeader(const wxString& key) const
 
 wxString wxTarInputStream::GetHeaderPath() const
 {
-    wxString path(GetExtendedHeader(wxS("path")));
+    // pax sparse files have the real name here, the path is a made up one
+    wxString path(GetExtendedHeader(wxS("GNU.sparse.name")));
+
+    if (path.empty())
+        path = GetExtendedHeader(wxS("path"));
 
     if (!path.empty())
         return path;
@@ -882,7 +1076,7 @@ wxTarNumber wxTarInputStream::GetHeaderNumber(int id) const
         wxString::const_iterator p = value.begin();
         while (p != value.end() && *p == ' ')
             ++p;
-        while (isdigit(*p))
+        while (p != value.end() && isdigit(*p))
             n = n * 10 + (*p++ - '0');
         return n;
     } else {
@@ -975,6 +1169,157 @@ bool wxTarInputStream::ReadExtendedHeader(wxTarHeaderRecords*& recs)
     return true;
 }
 
+// Sparse files are stored either using the old GNU format, where the map
+// of the regions with data is in the header block and extension blocks
+// following it, or using pax extended headers. For the latter, GNU tar
+// versions 0.1 (the map is in a header) and 1.0 (the map is at the start of
+// the data) are supported. Version 0.0, which uses repeated header records,
+// is not and such files are read as they are stored, without the holes.
+//
+bool wxTarInputStream::ReadSparseMap(wxTarEntry& entry)
+{
+    std::unique_ptr<wxTarSparseMap> map(new wxTarSparseMap);
+    wxFileOffset datasize = entry.GetSize();
+    wxString sparseMap;
+    bool ok;
+
+    // parse a decimal number from a pax extended header
+    const auto getNumber = [this](const char *key, wxFileOffset& n) -> bool
+    {
+        const wxString value = GetExtendedHeader(key);
+        const wxScopedCharBuffer buf = value.utf8_str();
+        const char *p = buf;
+        return wxTarParseDecimal(p, n, 0);
+    };
+
+    wxFileOffset realsize = 0;
+
+    if (m_tarType == TYPE_GNUTAR && *m_hdr->Get(TAR_TYPEFLAG) == 'S') {
+        ok = ReadGnuSparseMap(*map);
+    }
+    else if (m_tarType != TYPE_USTAR) {
+        return true;
+    }
+    else if (!(sparseMap = GetExtendedHeader(wxS("GNU.sparse.map"))).empty()) {
+        const wxScopedCharBuffer buf = sparseMap.utf8_str();
+        const char *p = buf;
+        wxFileOffset offset, size;
+
+        ok = true;
+        while (ok && *p)
+            ok = wxTarParseDecimal(p, offset, ',') &&
+                 wxTarParseDecimal(p, size, ',') &&
+                 map->Add(offset, size);
+
+        ok = ok && getNumber("GNU.sparse.size", realsize)
+                && map->SetRealSize(realsize);
+    }
+    else if (GetExtendedHeader(wxS("GNU.sparse.major")) == wxS("1")) {
+        ok = ReadPaxSparseMap(*map, datasize)
+                && getNumber("GNU.sparse.realsize", realsize)
+                && map->SetRealSize(realsize);
+    }
+    else {
+        if (!GetExtendedHeader(wxS("GNU.sparse.numblocks")).empty())
+            wxLogWarning(_("unsupported sparse file format in tar entry"));
+        return true;
+    }
+
+    if (!ok || map->GetDataSize() != datasize) {
+        wxLogError(_("invalid sparse map in tar entry"));
+        return false;
+    }
+
+    entry.SetSize(map->GetRealSize());
+    entry.m_Sparse = map.release();
+    return true;
+}
+
+bool wxTarInputStream::ReadGnuSparseMap(wxTarSparseMap& map)
+{
+    wxTarNumber realsize =
+        m_hdr->GetNumber(m_hdr->At(GNU_REALSIZE_POS), GNU_NUMBER_LEN);
+
+    // the first few entries of the map are in the header itself
+    char block[TAR_BLOCKSIZE];
+    m_hdr->Pack(block);
+
+    const char *p = block + GNU_SPARSE_POS;
+    int count = GNU_SPARSE_COUNT;
+    bool extended = block[GNU_ISEXTENDED_POS] != 0;
+
+    for (;;) {
+        for (int i = 0; i < count && *p; i++, p += 2 * GNU_NUMBER_LEN) {
+            wxTarNumber offset = m_hdr->GetNumber(p, GNU_NUMBER_LEN);
+            wxTarNumber size = m_hdr->GetNumber(p + GNU_NUMBER_LEN,
+                                                GNU_NUMBER_LEN);
+            if (!map.Add(offset, size))
+                return false;
+        }
+
+        if (!extended)
+            break;
+
+        // the rest are in extension blocks following the header
+        if (m_parent_i_stream->Read(block, TAR_BLOCKSIZE).LastRead()
+                != TAR_BLOCKSIZE)
+            return false;
+        m_offset += TAR_BLOCKSIZE;
+
+        p = block;
+        count = GNU_SPARSE_EXT_COUNT;
+        extended = block[GNU_SPARSE_EXT_ISEXTENDED_POS] != 0;
+    }
+
+    return map.SetRealSize(realsize);
+}
+
+// In the pax format 1.0 the map is stored at the start of the entry's data
+// as decimal numbers, each followed by a newline: the number of regions and
+// then the offset and size of each one. It's padded to a whole block.
+//
+bool wxTarInputStream::ReadPaxSparseMap(wxTarSparseMap& map,
+                                        wxFileOffset& datasize)
+{
+    std::string text;
+    size_t pos = 0;
+
+    // read the next number, reading in more blocks as needed
+    const auto getNumber = [&](wxFileOffset& n) -> bool
+    {
+        while (text.find('\012', pos) == std::string::npos) {
+            if ((wxFileOffset)text.size() + TAR_BLOCKSIZE > datasize)
+                return false;
+
+            char block[TAR_BLOCKSIZE];
+            if (m_parent_i_stream->Read(block, TAR_BLOCKSIZE).LastRead()
+                    != TAR_BLOCKSIZE)
+                return false;
+
+            text.append(block, TAR_BLOCKSIZE);
+        }
+
+        const char *p = text.c_str() + pos;
+        const char *start = p;
+        if (!wxTarParseDecimal(p, n, '\012') || p[-1] != '\012')
+            return false;
+
+        pos += p - start;
+        return true;
+    };
+
+    wxFileOffset count, offset, size;
+    bool ok = getNumber(count);
+
+    for (wxFileOffset i = 0; ok && i < count; i++)
+        ok = getNumber(offset) && getNumber(size) && map.Add(offset, size);
+
+    m_offset += text.size();
+    datasize -= text.size();
+
+    return ok;
+}
+
 wxFileOffset wxTarInputStream::OnSysSeek(wxFileOffset pos, wxSeekMode mode)
 {
     if (!IsOpened()) {
@@ -990,13 +1335,50 @@ wxFileOffset wxTarInputStream::OnSysSeek(wxFileOffset pos, wxSeekMode mode)
         case wxFromEnd:     pos += m_size; break;
     }
 
-    if (pos < 0 || m_parent_i_stream->SeekI(m_offset + pos) == wxInvalidOffset)
+    wxFileOffset datapos = m_sparse ? m_sparse->GetDataPos(pos) : pos;
+
+    if (pos < 0 ||
+            m_parent_i_stream->SeekI(m_offset + datapos) == wxInvalidOffset)
         return wxInvalidOffset;
 
     m_pos = pos;
+    m_datapos = datapos;
     return m_pos;
 }
 
+// Read from a sparse entry, filling in the holes with zeros. The stored data
+// is always read sequentially, since the regions are in order.
+//
+size_t wxTarInputStream::ReadSparse(void *buffer, size_t size)
+{
+    char *p = static_cast<char*>(buffer);
+    size_t done = 0;
+
+    while (done < size) {
+        const wxTarSparseMap::Region *region = m_sparse->Find(m_pos);
+        wxFileOffset left = size - done;
+        size_t n;
+
+        if (!region || m_pos < region->offset) {
+            wxFileOffset hole = (region ? region->offset : m_size) - m_pos;
+            n = size_t(wxMin(left, hole));
+            memset(p + done, 0, n);
+        } else {
+            wxFileOffset avail = region->offset + region->size - m_pos;
+            n = m_parent_i_stream->Read(p + done,
+                                        size_t(wxMin(left, avail))).LastRead();
+            m_datapos += n;
+            if (!n)
+                break;
+        }
+
+        done += n;
+        m_pos += n;
+    }
+
+    return done;
+}
+
 size_t wxTarInputStream::OnSysRead(void *buffer, size_t size)
 {
     if (!IsOpened()) {
@@ -1011,8 +1393,14 @@ size_t wxTarInputStream::OnSysRead(void *buffer, size_t size)
     else if (m_pos + size > m_size + (size_t)0)
         size = m_size - m_pos;
 
-    size_t lastread = m_parent_i_stream->Read(buffer, size).LastRead();
-    m_pos += lastread;
+    size_t lastread;
+
+    if (m_sparse) {
+        lastread = ReadSparse(buffer, size);
+    } else {
+        lastread = m_parent_i_stream->Read(buffer, size).LastRead();
+        m_pos += lastread;
+    }
 
     if (m_pos >= m_size) {
         m_lasterror = wxSTREAM_EOF;
@@ -1029,6 +1417,155 @@ size_t wxTarInputStream::OnSysRead(void *buffer, size_t size)
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+// Pipeline writing the output on a background thread, so that the parent
+// stream (for example, when it compresses the data) works concurrently with
+// the code producing the tar
+
+#if wxUSE_THREADS
+
+class wxTarPipeline : public wxThread
+{
+public:
+    wxTarPipeline(wxOutputStream& out, size_t bufSize);
+    virtual ~wxTarPipeline();
+
+    // Queue the buffer for writing and replace it with an empty one of the
+    // same size, return false if writing has failed.
+    bool Write(char*& buf, size_t len);
+
+    // Wait until all the queued buffers have been written.
+    bool Flush();
+
+    // Flush and terminate the thread.
+    bool Stop();
+
+protected:
+    ExitCode Entry() override;
+
+private:
+    // maximum number of buffers waiting to be written
+    enum { MAX_QUEUED = 4 };
+
+    struct Block { char *data; size_t len; };
+
+    wxOutputStream& m_out;
+    const size_t m_bufSize;
+
+    wxMutex m_mutex;
+    wxCondition m_cond;
+    std::deque<Block> m_queue;
+    std::vector<char*> m_free;
+    bool m_busy;
+    bool m_stop;
+    bool m_error;
+
+    wxDECLARE_NO_COPY_CLASS(wxTarPipeline);
+};
+
+wxTarPipeline::wxTarPipeline(wxOutputStream& out, size_t bufSize)
+  : wxThread(wxTHREAD_JOINABLE),
+    m_out(out),
+    m_bufSize(bufSize),
+    m_cond(m_mutex),
+    m_busy(false),
+    m_stop(false),
+    m_error(false)
+{
+}
+
+wxTarPipeline::~wxTarPipeline()
+{
+    for (size_t i = 0; i < m_free.size(); i++)
+        delete [] m_free[i];
+    for (size_t i = 0; i < m_queue.size(); i++)
+        delete [] m_queue[i].data;
+}
+
+bool wxTarPipeline::Write(char*& buf, size_t len)
+{
+    wxMutexLocker lock(m_mutex);
+
+    while (m_queue.size() >= MAX_QUEUED && !m_error)
+        m_cond.Wait();
+    if (m_error)
+        return false;
+
+    Block block = { buf, len };
+    m_queue.push_back(block);
+    m_cond.Broadcast();
+
+    if (m_free.empty()) {
+        buf = new char[m_bufSize];
+    } else {
+        buf = m_free.back();
+        m_free.pop_back();
+    }
+
+    return true;
+}
+
+bool wxTarPipeline::Flush()
+{
+    wxMutexLocker lock(m_mutex);
+
+    while (!m_queue.empty() || m_busy)
+        m_cond.Wait();
+
+    return !m_error;
+}
+
+bool wxTarPipeline::Stop()
+{
+    {
+        wxMutexLocker lock(m_mutex);
+        m_stop = true;
+        m_cond.Broadcast();
+    }
+
+    Wait();
+    return !m_error;
+}
+
+wxThread::ExitCode wxTarPipeline::Entry()
+{
+    for (;;) {
+        Block block;
+        bool error;
+
+        {
+            wxMutexLocker lock(m_mutex);
+            while (m_queue.empty() && !m_stop)
+                m_cond.Wait();
+            if (m_queue.empty())
+                break;
+
+            block = m_queue.front();
+            m_queue.pop_front();
+            m_busy = true;
+            error = m_error;
+        }
+
+        // once writing has failed the rest is just discarded
+        if (!error)
+            error = m_out.Write(block.data, block.len).LastWrite() != block.len;
+
+        {
+            wxMutexLocker lock(m_mutex);
+            m_free.push_back(block.data);
+            m_busy = false;
+            if (error)
+                m_error = true;
+            m_cond.Broadcast();
+        }
+    }
+
+    return nullptr;
+}
+
+#endif // wxUSE_THREADS
+
+
 /////////////////////////////////////////////////////////////////////////////
 // Output stream
 
@@ -1067,14 +1604,169 @@ void wxTarOutputStream::Init(wxTarFormat format)
     m_extendedSize = 0;
     m_lasterror = m_parent_o_stream->GetLastError();
     m_endrecWritten = false;
+    m_buf = nullptr;
+    m_bufSize = DEFAULT_BUFFER_SIZE;
+    m_bufLen = 0;
+    m_pipeline = nullptr;
 }
 
 wxTarOutputStream::~wxTarOutputStream()
 {
     Close();
+    SetPipelined(false);
     delete m_hdr;
     delete m_hdr2;
     delete [] m_extendedHdr;
+    delete [] m_buf;
+}
+
+void wxTarOutputStream::SetBufferSize(size_t size)
+{
+    bool pipelined = IsPipelined();
+
+    FlushBuffer();
+    SetPipelined(false);
+
+    delete [] m_buf;
+    m_buf = nullptr;
+    m_bufSize = size;
+
+    if (pipelined)
+        SetPipelined();
+}
+
+bool wxTarOutputStream::SetPipelined(bool pipelined)
+{
+#if wxUSE_THREADS
+    if (pipelined == IsPipelined())
+        return true;
+
+    bool ok = FlushBuffer();
+
+    if (pipelined) {
+        if (!ok)
+            return false;
+
+        AllocBuffer();
+        m_pipeline = new wxTarPipeline(*m_parent_o_stream, m_bufSize);
+        if (m_pipeline->Run() != wxTHREAD_NO_ERROR) {
+            delete m_pipeline;
+            m_pipeline = nullptr;
+            return false;
+        }
+    } else {
+        if (!m_pipeline->Stop() && ok) {
+            m_lasterror = wxSTREAM_WRITE_ERROR;
+            ok = false;
+        }
+        delete m_pipeline;
+        m_pipeline = nullptr;
+    }
+
+    return ok;
+#else // !wxUSE_THREADS
+    return !pipelined;
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+}
+
+// The output is buffered so that the parent stream is written in whole
+// records, i.e. in multiples of the blocking factor, as tar normally does,
+// except when seeking back to update a header requires flushing it early.
+//
+void wxTarOutputStream::AllocBuffer()
+{
+    if (!m_buf) {
+        m_bufSize = size_t(RoundUpSize(wxMax(m_bufSize, size_t(1)),
+                                       wxMax(m_BlockingFactor, 1)));
+        m_buf = new char[m_bufSize];
+        m_bufLen = 0;
+    }
+}
+
+bool wxTarOutputStream::WriteRaw(const void *buffer, size_t size)
+{
+    if (!IsOk())
+        return false;
+
+    AllocBuffer();
+    const char *p = static_cast<const char*>(buffer);
+
+    while (size) {
+        // large writes can go straight through when there's nothing buffered
+        if (!m_bufLen && !m_pipeline && size >= m_bufSize) {
+            size_t n = size - size % m_bufSize;
+            if (m_parent_o_stream->Write(p, n).LastWrite() != n) {
+                m_lasterror = wxSTREAM_WRITE_ERROR;
+                return false;
+            }
+            p += n;
+            size -= n;
+            continue;
+        }
+
+        size_t n = wxMin(m_bufSize - m_bufLen, size);
+        memcpy(m_buf + m_bufLen, p, n);
+        m_bufLen += n;
+        p += n;
+        size -= n;
+
+        if (m_bufLen == m_bufSize && !WriteBuffer())
+            return false;
+    }
+
+    return true;
+}
+
+bool wxTarOutputStream::WriteZeros(size_t size)
+{
+    static const char zeros[TAR_BLOCKSIZE] = { 0 };
+    bool ok = true;
+
+    while (size && ok) {
+        size_t n = wxMin(size, sizeof(zeros));
+        ok = WriteRaw(zeros, n);
+        size -= n;
+    }
+
+    return ok;
+}
+
+// Pass the buffered data to the parent stream, or to the pipeline thread
+//
+bool wxTarOutputStream::WriteBuffer()
+{
+    if (!m_bufLen)
+        return true;
+
+    bool ok;
+#if wxUSE_THREADS
+    if (m_pipeline)
+        ok = m_pipeline->Write(m_buf, m_bufLen);
+    else
+#endif
+        ok = m_parent_o_stream->Write(m_buf, m_bufLen).LastWrite() == m_bufLen;
+
+    m_bufLen = 0;
+    if (!ok)
+        m_lasterror = wxSTREAM_WRITE_ERROR;
+    return ok;
+}
+
+// Write all the pending data, this must be done before accessing the parent
+// stream directly
+//
+bool wxTarOutputStream::FlushBuffer()
+{
+    bool ok = WriteBuffer();
+
+#if wxUSE_THREADS
+    if (m_pipeline && !m_pipeline->Flush()) {
+        m_lasterror = wxSTREAM_WRITE_ERROR;
+        ok = false;
+    }
+#endif
+
+    return ok;
 }
 
 bool wxTarOutputStream::PutNextEntry(wxTarEntry *entry)
@@ -1086,6 +1778,7 @@ bool wxTarOutputStream::PutNextEntry(wxTarEntry *entry)
 
     if (!m_tarsize) {
         wxLogNull nolog;
+        FlushBuffer();
         m_tarstart = m_parent_o_stream->TellO();
     }
 
@@ -1161,18 +1854,17 @@ bool wxTarOutputStream::CloseEntry()
 
     if (m_pos < m_maxpos) {
         wxASSERT(m_parent_o_stream->IsSeekable());
-        m_parent_o_stream->SeekO(m_datapos + m_maxpos);
-        m_lasterror = m_parent_o_stream->GetLastError();
+        if (FlushBuffer()) {
+            m_parent_o_stream->SeekO(m_datapos + m_maxpos);
+            m_lasterror = m_parent_o_stream->GetLastError();
+        }
         m_pos = m_maxpos;
     }
 
     if (IsOk()) {
         wxFileOffset size = RoundUpSize(m_pos);
-        if (size > m_pos) {
-            m_hdr->Clear(size - m_pos);
-            m_parent_o_stream->Write(m_hdr, size - m_pos);
-            m_lasterror = m_parent_o_stream->GetLastError();
-        }
+        if (size > m_pos)
+            WriteZeros(size - m_pos);
         m_tarsize += size;
     }
 
@@ -1193,15 +1885,14 @@ bool wxTarOutputStream::Close()
     if (!CloseEntry() || (m_tarsize == 0 && m_endrecWritten))
         return false;
 
-    m_hdr->Clear();
-    int count = (RoundUpSize(m_tarsize + 2 * TAR_BLOCKSIZE, m_BlockingFactor)
-                    - m_tarsize) / TAR_BLOCKSIZE;
-    while (count--)
-        m_parent_o_stream->Write(m_hdr, TAR_BLOCKSIZE);
+    WriteZeros(RoundUpSize(m_tarsize + 2 * TAR_BLOCKSIZE, m_BlockingFactor)
+                - m_tarsize);
+
+    if (FlushBuffer())
+        m_lasterror = m_parent_o_stream->GetLastError();
 
     m_tarsize = 0;
     m_tarstart = wxInvalidOffset;
-    m_lasterror = m_parent_o_stream->GetLastError();
     m_endrecWritten = true;
     return IsOk();
 }
@@ -1275,12 +1966,14 @@ bool wxTarOutputStream::WriteHeaders(wxTarEntry& entry)
 
         m_hdr2->SetOctal(TAR_CHKSUM, m_hdr2->Sum());
 
-        m_hdr2->Write(*m_parent_o_stream);
+        char block[TAR_BLOCKSIZE];
+        m_hdr2->Pack(block);
+        WriteRaw(block, TAR_BLOCKSIZE);
         m_tarsize += TAR_BLOCKSIZE;
 
         size_t rounded = RoundUpSize(length);
         memset(m_extendedHdr + length, 0, rounded - length);
-        m_parent_o_stream->Write(m_extendedHdr, rounded);
+        WriteRaw(m_extendedHdr, rounded);
         m_tarsize += rounded;
 
         *m_extendedHdr = 0;
@@ -1299,9 +1992,10 @@ bool wxTarOutputStream::WriteHeaders(wxTarEntry& entry)
         m_badfit.clear();
     }
 
-    m_hdr->Write(*m_parent_o_stream);
+    char block[TAR_BLOCKSIZE];
+    m_hdr->Pack(block);
+    WriteRaw(block, TAR_BLOCKSIZE);
     m_tarsize += TAR_BLOCKSIZE;
-    m_lasterror = m_parent_o_stream->GetLastError();
 
     return IsOk();
 }
@@ -1346,7 +2040,7 @@ bool wxTarOutputStream::ModifyHeader()
     wxFileOffset sizePos = wxInvalidOffset;
 
     if (!m_large && m_headpos != wxInvalidOffset
-            && m_parent_o_stream->IsSeekable())
+            && m_parent_o_stream->IsSeekable() && FlushBuffer())
     {
         wxLogNull nolog;
         originalPos = m_parent_o_stream->TellO();
@@ -1355,7 +2049,10 @@ bool wxTarOutputStream::ModifyHeader()
                 m_parent_o_stream->SeekO(m_headpos + m_hdr->Offset(TAR_SIZE));
     }
 
-    if (sizePos == wxInvalidOffset || !m_hdr->SetOctal(TAR_SIZE, m_pos)) {
+    // use the GNU base-256 encoding for sizes of 8GB and more, as it's too
+    // late to add an extended header for them now
+    if (sizePos == wxInvalidOffset || (!m_hdr->SetOctal(TAR_SIZE, m_pos)
+                                       && !m_hdr->SetBinary(TAR_SIZE, m_pos))) {
         wxLogError(_("incorrect size given for tar entry"));
         m_lasterror = wxSTREAM_WRITE_ERROR;
         return false;
@@ -1380,7 +2077,8 @@ void wxTarOutputStream::SetHeaderPath(const wxString& name)
 
 bool wxTarOutputStream::SetHeaderNumber(int id, wxTarNumber n)
 {
-    if (m_hdr->SetOctal(id, n)) {
+    // without extended headers use the GNU base-256 encoding for big numbers
+    if (m_hdr->SetOctal(id, n) || (!m_pax && m_hdr->SetBinary(id, n))) {
         return true;
     } else {
         SetExtendedHeader(m_hdr->Name(id), wxLongLong(n).ToString());
@@ -1468,7 +2166,8 @@ void wxTarOutputStream::SetExtendedHeader(const wxString& key,
 
 void wxTarOutputStream::Sync()
 {
-    m_parent_o_stream->Sync();
+    if (FlushBuffer())
+        m_parent_o_stream->Sync();
 }
 
 wxFileOffset wxTarOutputStream::OnSysSeek(wxFileOffset pos, wxSeekMode mode)
@@ -1477,7 +2176,7 @@ wxFileOffset wxTarOutputStream::OnSysSeek(wxFileOffset pos, wxSeekMode mode)
         wxLogError(_("tar entry not open"));
         m_lasterror = wxSTREAM_WRITE_ERROR;
     }
-    if (!IsOk() || m_datapos == wxInvalidOffset)
+    if (!IsOk() || m_datapos == wxInvalidOffset || !FlushBuffer())
         return wxInvalidOffset;
 
     switch (mode) {
@@ -1502,15 +2201,14 @@ size_t wxTarOutputStream::OnSysWrite(const void *buffer, size_t size)
     if (!IsOk() || !size)
         return 0;
 
-    size_t lastwrite = m_parent_o_stream->Write(buffer, size).LastWrite();
-    m_pos += lastwrite;
+    if (!WriteRaw(buffer, size))
+        return 0;
+
+    m_pos += size;
     if (m_pos > m_maxpos)
         m_maxpos = m_pos;
 
-    if (lastwrite != size)
-        m_lasterror = wxSTREAM_WRITE_ERROR;
-
-    return lastwrite;
+    return size;
 }
 
 #endif // wxUSE_TARSTREAM
@@ -17,12 +17,73 @@
 
 #ifndef WX_PRECOMP
     #include "wx/stream.h"
+    #include "wx/intl.h"
+    #include "wx/log.h"
+    #include "wx/utils.h"
 #endif
 
 #include <stdio.h>
 
 #if wxUSE_FILE
 
+#if defined(__UNIX__)
+    #include <sys/mman.h>
+    #include <sys/uio.h>
+    #include <errno.h>
+    #include <limits.h>
+
+    #include <vector>
+
+    #ifndef IOV_MAX
+        #define IOV_MAX 16
+    #endif
+#elif defined(__WINDOWS__)
+    #include "wx/msw/private.h"
+#endif
+
+#ifdef __UNIX__
+
+namespace
+{
+
+// Copy the buffers to the array of iovec structs.
+template <typename T>
+std::vector<iovec> MakeIOVecs(const T *vec, size_t count)
+{
+    std::vector<iovec> iov(count);
+    for ( size_t n = 0; n < count; n++ )
+    {
+        iov[n].iov_base = const_cast<void*>(vec[n].data);
+        iov[n].iov_len = vec[n].size;
+    }
+
+    return iov;
+}
+
+// Skip the given number of bytes processed by readv() or writev() in the
+// buffers starting from the given one, return the index of the first buffer
+// which wasn't processed completely.
+size_t AdvanceIOVecs(std::vector<iovec>& iov, size_t first, size_t done)
+{
+    for ( ; first < iov.size(); first++ )
+    {
+        if ( done < iov[first].iov_len )
+        {
+            iov[first].iov_base = static_cast<char*>(iov[first].iov_base) + done;
+            iov[first].iov_len -= done;
+            break;
+        }
+
+        done -= iov[first].iov_len;
+    }
+
+    return first;
+}
+
+} // anonymous namespace
+
+#endif // __UNIX__
+
 // ----------------------------------------------------------------------------
 // wxFileInputStream
 // ----------------------------------------------------------------------------
@@ -92,6 +153,57 @@ size_t wxFileInputStream::OnSysRead(void *buffer, size_t size)
     return ret;
 }
 
+wxInputStream&
+wxFileInputStream::ReadV(const wxStreamIOVec *vec, size_t count)
+{
+#ifdef __UNIX__
+    // The data put back into the stream must be returned first, so use the
+    // generic implementation if there is any.
+    if ( !m_wback && m_file->IsOpened() )
+    {
+        m_lastcount = 0;
+
+        std::vector<iovec> iov = MakeIOVecs(vec, count);
+        size_t first = AdvanceIOVecs(iov, 0, 0);
+        while ( first < iov.size() )
+        {
+            const int num = static_cast<int>(wxMin(iov.size() - first,
+                                                   size_t(IOV_MAX)));
+            const ssize_t ret = ::readv(m_file->fd(), &iov[first], num);
+            if ( ret == -1 )
+            {
+                if ( errno == EINTR )
+                    continue;
+
+                wxLogSysError(_("can't read from file descriptor %d"),
+                              m_file->fd());
+                m_lasterror = wxSTREAM_READ_ERROR;
+                break;
+            }
+
+            if ( !ret )
+            {
+                m_lasterror = wxSTREAM_EOF;
+                break;
+            }
+
+            m_lasterror = wxSTREAM_NO_ERROR;
+            m_lastcount += ret;
+
+            first = AdvanceIOVecs(iov, first, ret);
+
+            // As Read(), don't block if we can't read more data now.
+            if ( !CanRead() )
+                break;
+        }
+
+        return *this;
+    }
+#endif // __UNIX__
+
+    return wxInputStream::ReadV(vec, count);
+}
+
 wxFileOffset wxFileInputStream::OnSysSeek(wxFileOffset pos, wxSeekMode mode)
 {
     return m_file->Seek(pos, mode);
@@ -157,6 +269,45 @@ size_t wxFileOutputStream::OnSysWrite(const void *buffer, size_t size)
     return ret;
 }
 
+wxOutputStream&
+wxFileOutputStream::WriteV(const wxStreamConstIOVec *vec, size_t count)
+{
+#ifdef __UNIX__
+    if ( m_file->IsOpened() )
+    {
+        m_lastcount = 0;
+
+        std::vector<iovec> iov = MakeIOVecs(vec, count);
+        size_t first = AdvanceIOVecs(iov, 0, 0);
+        while ( first < iov.size() )
+        {
+            const int num = static_cast<int>(wxMin(iov.size() - first,
+                                                   size_t(IOV_MAX)));
+            const ssize_t ret = ::writev(m_file->fd(), &iov[first], num);
+            if ( ret == -1 )
+            {
+                if ( errno == EINTR )
+                    continue;
+
+                wxLogSysError(_("can't write to file descriptor %d"),
+                              m_file->fd());
+                m_lasterror = wxSTREAM_WRITE_ERROR;
+                break;
+            }
+
+            m_lasterror = wxSTREAM_NO_ERROR;
+            m_lastcount += ret;
+
+            first = AdvanceIOVecs(iov, first, ret);
+        }
+
+        return *this;
+    }
+#endif // __UNIX__
+
+    return wxOutputStream::WriteV(vec, count);
+}
+
 wxFileOffset wxFileOutputStream::OnSysTell() const
 {
     return m_file->Tell();
@@ -259,6 +410,255 @@ bool wxFileStream::IsOk() const
     return wxFileOutputStream::IsOk() && wxFileInputStream::IsOk();
 }
 
+// ----------------------------------------------------------------------------
+// wxMappedFileInputStream
+// ----------------------------------------------------------------------------
+
+wxMappedFileInputStream::wxMappedFileInputStream(const wxString& fileName,
+                                                 wxMappedFileAccess access)
+{
+    m_data = nullptr;
+    m_size = 0;
+    m_pos = 0;
+    m_mapped = false;
+
+    wxFile file(fileName, wxFile::read);
+    const wxFileOffset length = file.IsOpened() ? file.Length()
+                                                : wxInvalidOffset;
+
+    // Also check that the file can be addressed at all, which is not
+    // necessarily the case for big files in 32 bit builds.
+    if ( length == wxInvalidOffset ||
+            static_cast<wxFileOffset>(static_cast<size_t>(length)) != length )
+    {
+        m_lasterror = wxSTREAM_READ_ERROR;
+        return;
+    }
+
+    m_size = static_cast<size_t>(length);
+
+    // Empty files can't be mapped, but there is nothing to read in them
+    // anyhow.
+    if ( !m_size )
+        return;
+
+    if ( DoMap(file) )
+    {
+        m_mapped = true;
+        SetAccessHint(access);
+        return;
+    }
+
+    // Fall back to reading the entire file in memory if it can't be mapped,
+    // e.g. because the file system doesn't support it: this is less
+    // efficient, but still allows using the same API for accessing it.
+    char* const data = new char[m_size];
+    if ( file.Read(data, m_size) != static_cast<ssize_t>(m_size) )
+    {
+        delete [] data;
+        m_size = 0;
+        m_lasterror = wxSTREAM_READ_ERROR;
+        return;
+    }
+
+    m_data = data;
+}
+
+wxMappedFileInputStream::~wxMappedFileInputStream()
+{
+    if ( !m_mapped )
+    {
+        delete [] m_data;
+        return;
+    }
+
+#if defined(__UNIX__)
+    munmap(const_cast<char*>(m_data), m_size);
+#elif defined(__WINDOWS__) && defined(wxGetOSFHandle)
+    ::UnmapViewOfFile(m_data);
+#endif
+}
+
+bool wxMappedFileInputStream::DoMap(wxFile& file)
+{
+#if defined(__UNIX__)
+    void* const data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE,
+                            file.fd(), 0);
+    if ( data == MAP_FAILED )
+        return false;
+
+    m_data = static_cast<const char*>(data);
+    return true;
+#elif defined(__WINDOWS__) && defined(wxGetOSFHandle)
+    const HANDLE hMapping = ::CreateFileMapping(wxGetOSFHandle(file.fd()),
+                                                nullptr, PAGE_READONLY,
+                                                0, 0, nullptr);
+    if ( !hMapping )
+        return false;
+
+    const void* const data = ::MapViewOfFile(hMapping, FILE_MAP_READ,
+                                             0, 0, m_size);
+
+    // The view keeps a reference to the mapping object, so we don't need to
+    // keep it open ourselves.
+    ::CloseHandle(hMapping);
+
+    if ( !data )
+        return false;
+
+    m_data = static_cast<const char*>(data);
+    return true;
+#else
+    wxUnusedVar(file);
+
+    return false;
+#endif
+}
+
+bool wxMappedFileInputStream::SetAccessHint(wxMappedFileAccess access)
+{
+#if defined(__UNIX__) && defined(POSIX_MADV_NORMAL)
+    if ( !m_mapped )
+        return false;
+
+    int advice = POSIX_MADV_NORMAL;
+    switch ( access )
+    {
+        case wxMAPPED_ACCESS_NORMAL:
+            advice = POSIX_MADV_NORMAL;
+            break;
+
+        case wxMAPPED_ACCESS_SEQUENTIAL:
+            advice = POSIX_MADV_SEQUENTIAL;
+            break;
+
+        case wxMAPPED_ACCESS_RANDOM:
+            advice = POSIX_MADV_RANDOM;
+            break;
+    }
+
+    return posix_madvise(const_cast<char*>(m_data), m_size, advice) == 0;
+#else
+    wxUnusedVar(access);
+
+    return false;
+#endif
+}
+
+bool wxMappedFileInputStream::CanRead() const
+{
+    return m_wbackcur < m_wbacksize || m_pos < m_size;
+}
+
+char wxMappedFileInputStream::Peek()
+{
+    if ( m_wbackcur < m_wbacksize )
+        return m_wback[m_wbackcur];
+
+    if ( m_pos == m_size )
+    {
+        m_lasterror = wxSTREAM_EOF;
+        return 0;
+    }
+
+    return m_data[m_pos];
+}
+
+const void* wxMappedFileInputStream::PeekData(size_t* len) const
+{
+    wxCHECK_MSG( len, nullptr, wxS("null length pointer") );
+
+    // Any data pushed back using Ungetch() comes before the file data.
+    if ( m_wbackcur < m_wbacksize )
+    {
+        *len = m_wbacksize - m_wbackcur;
+        return m_wback + m_wbackcur;
+    }
+
+    *len = m_size - m_pos;
+    return m_data + m_pos;
+}
+
+size_t wxMappedFileInputStream::Skip(size_t len)
+{
+    size_t skipped = 0;
+
+    if ( m_wbackcur < m_wbacksize )
+    {
+        skipped = wxMin(len, m_wbacksize - m_wbackcur);
+
+        m_wbackcur += skipped;
+        if ( m_wbackcur == m_wbacksize )
+        {
+            free(m_wback);
+            m_wback = nullptr;
+            m_wbacksize = 0;
+            m_wbackcur = 0;
+        }
+
+        len -= skipped;
+    }
+
+    if ( len && m_pos == m_size && !skipped )
+    {
+        m_lasterror = wxSTREAM_EOF;
+        return 0;
+    }
+
+    const size_t fromFile = wxMin(len, m_size - m_pos);
+    m_pos += fromFile;
+
+    return skipped + fromFile;
+}
+
+size_t wxMappedFileInputStream::OnSysRead(void *buffer, size_t size)
+{
+    const size_t count = wxMin(size, m_size - m_pos);
+    if ( !count )
+    {
+        m_lasterror = wxSTREAM_EOF;
+        return 0;
+    }
+
+    memcpy(buffer, m_data + m_pos, count);
+    m_pos += count;
+
+    return count;
+}
+
+wxFileOffset
+wxMappedFileInputStream::OnSysSeek(wxFileOffset pos, wxSeekMode mode)
+{
+    const wxFileOffset size = static_cast<wxFileOffset>(m_size);
+
+    wxFileOffset newPos;
+    switch ( mode )
+    {
+        case wxFromStart:
+            newPos = pos;
+            break;
+
+        case wxFromCurrent:
+            newPos = static_cast<wxFileOffset>(m_pos) + pos;
+            break;
+
+        case wxFromEnd:
+            newPos = size + pos;
+            break;
+
+        default:
+            wxFAIL_MSG( wxS("invalid seek mode") );
+            return wxInvalidOffset;
+    }
+
+    if ( newPos < 0 || newPos > size )
+        return wxInvalidOffset;
+
+    m_pos = static_cast<size_t>(newPos);
+
+    return newPos;
+}
+
 #endif // wxUSE_FILE
 
 #if wxUSE_FFILE
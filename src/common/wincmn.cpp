@@ -2780,8 +2780,28 @@ bool wxWindowBase::SendIdleEvents(wxIdleEvent& event)
     OnInternalIdle();
 
     // should we send idle event to this window?
-    if (wxIdleEvent::GetMode() == wxIDLE_PROCESS_ALL ||
-        HasExtraStyle(wxWS_EX_PROCESS_IDLE))
+    bool sendIdle;
+    switch ( wxIdleEvent::GetMode() )
+    {
+        case wxIDLE_PROCESS_ALL:
+            sendIdle = true;
+            break;
+
+        case wxIDLE_PROCESS_HANDLED:
+            // Checking for the handlers is much faster than searching for
+            // them in the event tables when sending the event, which matters
+            // for the windows with many children.
+            sendIdle = HasExtraStyle(wxWS_EX_PROCESS_IDLE) ||
+                        HasHandlersFor(wxEVT_IDLE);
+            break;
+
+        case wxIDLE_PROCESS_SPECIFIED:
+        default:
+            sendIdle = HasExtraStyle(wxWS_EX_PROCESS_IDLE);
+            break;
+    }
+
+    if ( sendIdle )
     {
         event.SetEventObject(this);
         HandleWindowEvent(event);
@@ -24,8 +24,13 @@
 #include "wx/zstream.h"
 #include "wx/mstream.h"
 #include "wx/wfstream.h"
+#include "wx/tokenzr.h"
+#if wxUSE_THREADS
+    #include "wx/thread.h"
+#endif
 #include "zlib.h"
 
+#include <atomic>
 #include <memory>
 #include <unordered_map>
 
@@ -1800,6 +1805,38 @@ wxZipEntry *wxZipInputStream::GetNextEntry()
     return entry.release();
 }
 
+wxFileOffset wxZipInputStream::GetCentralPosition()
+{
+    if (m_position == wxInvalidOffset)
+        if (!LoadEndRecord())
+            return wxInvalidOffset;
+
+    if (!m_parentSeekable || m_signature != CENTRAL_MAGIC)
+        return wxInvalidOffset;
+
+    return m_position;
+}
+
+wxZipEntry *wxZipInputStream::GetEntryAt(wxFileOffset pos)
+{
+    if (m_position == wxInvalidOffset)
+        if (!LoadEndRecord())
+            return nullptr;
+
+    wxCHECK(m_parentSeekable, nullptr);
+
+    if (!AtHeader())
+        CloseEntry();
+
+    if (QuietSeek(*m_parent_i_stream, pos) == wxInvalidOffset)
+        return nullptr;
+
+    m_position = pos;
+    m_signature = ReadSignature();
+
+    return GetNextEntry();
+}
+
 wxStreamError wxZipInputStream::ReadCentral()
 {
     if (!AtHeader())
@@ -2624,4 +2661,448 @@ size_t wxZipOutputStream::OnSysWrite(const void *buffer, size_t size)
     return m_comp->LastWrite();
 }
 
+
+/////////////////////////////////////////////////////////////////////////////
+// Helpers for the parallel reader and writer
+
+namespace
+{
+
+unsigned wxZipGetThreadCount(unsigned numThreads, size_t numEntries)
+{
+#if wxUSE_THREADS
+    if ( !numThreads )
+    {
+        const int numCPUs = wxThread::GetCPUCount();
+        numThreads = numCPUs > 0 ? numCPUs : 1;
+    }
+#else
+    numThreads = 1;
+#endif
+
+    // There is no point in having more threads than entries.
+    if ( numThreads > numEntries )
+        numThreads = numEntries ? static_cast<unsigned>(numEntries) : 1;
+
+    return numThreads;
+}
+
+#if wxUSE_THREADS
+
+class wxZipWorkerThread : public wxThread
+{
+public:
+    explicit wxZipWorkerThread(const std::function<void ()>& work)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_work(work)
+    {
+    }
+
+protected:
+    virtual ExitCode Entry() override
+    {
+        m_work();
+        return nullptr;
+    }
+
+private:
+    const std::function<void ()> m_work;
+};
+
+typedef std::vector<std::unique_ptr<wxZipWorkerThread>> wxZipWorkerThreads;
+
+// Returns the threads which could be started, possibly fewer than requested.
+wxZipWorkerThreads
+wxZipStartThreads(unsigned numThreads, const std::function<void ()>& work)
+{
+    wxZipWorkerThreads threads;
+    for ( unsigned n = 0; n < numThreads; n++ )
+    {
+        std::unique_ptr<wxZipWorkerThread> thread(new wxZipWorkerThread(work));
+        if ( thread->Run() != wxTHREAD_NO_ERROR )
+            break;
+
+        threads.push_back(std::move(thread));
+    }
+
+    return threads;
+}
+
+void wxZipWaitThreads(wxZipWorkerThreads& threads)
+{
+    for ( auto& thread : threads )
+        thread->Wait();
+
+    threads.clear();
+}
+
+#endif // wxUSE_THREADS
+
+// Get the path under dir to extract the entry to, refusing the names which
+// would result in a path outside of it.
+bool wxZipGetExtractPath(const wxString& dir,
+                         const wxZipEntry& entry,
+                         wxFileName& path)
+{
+    const wxString& name = entry.GetInternalName();
+
+    path.AssignDir(dir);
+
+    wxStringTokenizer tk(name, wxS("/\\"), wxTOKEN_STRTOK);
+    while ( tk.HasMoreTokens() )
+    {
+        const wxString part = tk.GetNextToken();
+        if ( part == wxS(".") )
+            continue;
+
+        if ( part == wxS("..") || part.find(wxS(':')) != wxString::npos )
+            break;
+
+        if ( !tk.HasMoreTokens() && !entry.IsDir() )
+            path.SetFullName(part);
+        else
+            path.AppendDir(part);
+    }
+
+    if ( tk.HasMoreTokens() || (!entry.IsDir() && !path.HasName()) )
+    {
+        wxLogError(_("Not extracting zip entry \"%s\" with unsafe name."),
+                   name);
+        return false;
+    }
+
+    return true;
+}
+
+// Deflate a single entry into a complete zip archive in the given stream.
+bool wxZipCompressEntry(wxZipEntry *entry,
+                        const wxZipParallelWriter::DataFunc& func,
+                        int level,
+                        wxOutputStream& stream)
+{
+    wxZipOutputStream zip(stream, level, wxConvUTF8);
+
+    return zip.PutNextEntry(entry) && (!func || func(zip)) && zip.Close();
+}
+
+// Copy the only entry of the archive created by wxZipCompressEntry() to the
+// output without recompressing it.
+bool wxZipCopyCompressed(wxZipOutputStream& zip, wxMemoryOutputStream& buffer)
+{
+    wxMemoryInputStream
+        stream(buffer.GetOutputStreamBuffer()->GetBufferStart(),
+               buffer.GetLength());
+    wxZipInputStream zipIn(stream, wxConvUTF8);
+
+    wxZipEntry * const entry = zipIn.GetNextEntry();
+
+    return entry && zip.CopyEntry(entry, zipIn);
+}
+
+} // anonymous namespace
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Parallel reader
+
+wxZipParallelReader::wxZipParallelReader(const wxString& filename,
+                                         wxMBConv& conv)
+    : m_filename(filename),
+      m_conv(conv),
+      m_ok(false)
+{
+    wxFileInputStream file(filename);
+    if ( !file.IsOk() )
+        return;
+
+    // This reads the central directory as the file stream is seekable.
+    wxZipInputStream zip(file, conv);
+
+    wxZipEntry *entry;
+    while ( (entry = zip.GetNextEntry()) != nullptr )
+        m_entries.emplace_back(entry);
+
+    m_ok = zip.GetLastError() == wxSTREAM_EOF;
+}
+
+bool wxZipParallelReader::ReadEntries(const EntryFunc& func,
+                                      unsigned numThreads)
+{
+    return DoReadEntries
+           (
+                [this, &func](size_t n, wxInputStream& stream)
+                {
+                    return func(*m_entries[n], stream);
+                },
+                numThreads
+           );
+}
+
+bool wxZipParallelReader::DoReadEntries(const IndexFunc& func,
+                                        unsigned numThreads)
+{
+    wxCHECK_MSG( IsOk(), false, wxS("invalid zip file") );
+
+    std::atomic<size_t> next(0);
+    std::atomic<bool> failed(false);
+
+    // Each worker uses its own file stream, so that the entries can be read
+    // independently of each other by seeking to them.
+    const auto work = [&]()
+    {
+        wxFileInputStream file(m_filename);
+        if ( !file.IsOk() )
+        {
+            failed = true;
+            return;
+        }
+
+        wxZipInputStream zip(file, m_conv);
+
+        while ( !failed )
+        {
+            const size_t n = next++;
+            if ( n >= m_entries.size() )
+                break;
+
+            if ( !zip.OpenEntry(*m_entries[n]) ||
+                    !func(n, zip) ||
+                        zip.GetLastError() == wxSTREAM_READ_ERROR )
+            {
+                failed = true;
+                break;
+            }
+
+            zip.CloseEntry();
+        }
+    };
+
+    numThreads = wxZipGetThreadCount(numThreads, m_entries.size());
+
+#if wxUSE_THREADS
+    // The current thread is used as one of the workers too.
+    wxZipWorkerThreads threads = wxZipStartThreads(numThreads - 1, work);
+#endif
+
+    work();
+
+#if wxUSE_THREADS
+    wxZipWaitThreads(threads);
+#endif
+
+    return !failed;
+}
+
+bool wxZipParallelReader::ExtractTo(const wxString& dir, unsigned numThreads)
+{
+    wxCHECK_MSG( IsOk(), false, wxS("invalid zip file") );
+
+    // Check all the names and create the directories before starting to
+    // extract anything, so that the workers only have to create the files.
+    std::vector<wxFileName> paths(m_entries.size());
+    for ( size_t n = 0; n < m_entries.size(); n++ )
+    {
+        const wxZipEntry& entry = *m_entries[n];
+        if ( !wxZipGetExtractPath(dir, entry, paths[n]) )
+            return false;
+
+        if ( !wxFileName::Mkdir(paths[n].GetPath(), wxS_DIR_DEFAULT,
+                                wxPATH_MKDIR_FULL) )
+            return false;
+    }
+
+    return DoReadEntries
+           (
+                [this, &paths](size_t n, wxInputStream& stream)
+                {
+                    const wxZipEntry& entry = *m_entries[n];
+                    if ( entry.IsDir() )
+                        return true;
+
+                    const wxFileName& path = paths[n];
+
+                    {
+                        wxFileOutputStream file(path.GetFullPath());
+                        if ( !file.IsOk() || !file.Write(stream).IsOk() )
+                            return false;
+
+                        if ( !file.Close() )
+                            return false;
+                    }
+
+                    const wxDateTime dt = entry.GetDateTime();
+                    if ( dt.IsValid() )
+                        path.SetTimes(nullptr, &dt, nullptr);
+
+                    return true;
+                },
+                numThreads
+           );
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Parallel writer
+
+void wxZipParallelWriter::AddEntry(wxZipEntry *entry, const DataFunc& func)
+{
+    wxCHECK_RET( entry, wxS("null zip entry") );
+
+    Job job;
+    job.entry.reset(entry);
+    job.func = func;
+    m_jobs.push_back(std::move(job));
+}
+
+bool wxZipParallelWriter::AddFile(const wxString& filename,
+                                  const wxString& name)
+{
+    const wxFileName fn(filename);
+    if ( !fn.FileExists() )
+    {
+        wxLogError(_("File \"%s\" doesn't exist."), filename);
+        return false;
+    }
+
+    AddEntry
+    (
+        new wxZipEntry(name, fn.GetModificationTime(),
+                       static_cast<wxFileOffset>(fn.GetSize().GetValue())),
+        [filename](wxOutputStream& stream)
+        {
+            wxFileInputStream file(filename);
+            if ( !file.IsOk() )
+                return false;
+
+            stream.Write(file);
+
+            return file.GetLastError() == wxSTREAM_EOF && stream.IsOk();
+        }
+    );
+
+    return true;
+}
+
+bool wxZipParallelWriter::DoWriteSequentially()
+{
+    bool ok = true;
+    for ( auto& job : m_jobs )
+    {
+        if ( !m_zip.PutNextEntry(job.entry.release()) ||
+                (job.func && !job.func(m_zip)) ||
+                    !m_zip.CloseEntry() )
+        {
+            ok = false;
+            break;
+        }
+    }
+
+    m_jobs.clear();
+
+    return ok;
+}
+
+bool wxZipParallelWriter::Write(unsigned numThreads)
+{
+    numThreads = wxZipGetThreadCount(numThreads, m_jobs.size());
+
+#if wxUSE_THREADS
+    if ( numThreads < 2 )
+        return DoWriteSequentially();
+
+    enum JobState
+    {
+        Job_Pending,
+        Job_Done,
+        Job_Failed
+    };
+
+    const size_t count = m_jobs.size();
+    const int level = m_zip.GetLevel();
+
+    // Limit the number of compressed entries kept in memory while waiting
+    // for the preceding ones to be written.
+    const size_t maxInFlight = 2*numThreads;
+
+    std::vector<std::unique_ptr<wxMemoryOutputStream>> buffers(count);
+    std::vector<JobState> states(count, Job_Pending);
+
+    // All the variables below are protected by this mutex.
+    wxMutex mutex;
+    wxCondition condDone(mutex),
+                condSpace(mutex);
+    size_t next = 0,
+           written = 0;
+    bool stop = false;
+
+    const auto work = [&]()
+    {
+        for ( ;; )
+        {
+            size_t n;
+            {
+                wxMutexLocker lock(mutex);
+                while ( !stop && next < count && next >= written + maxInFlight )
+                    condSpace.Wait();
+
+                if ( stop || next >= count )
+                    return;
+
+                n = next++;
+            }
+
+            Job& job = m_jobs[n];
+
+            std::unique_ptr<wxMemoryOutputStream>
+                buffer(new wxMemoryOutputStream);
+            const bool ok = wxZipCompressEntry(job.entry.release(), job.func,
+                                               level, *buffer);
+
+            wxMutexLocker lock(mutex);
+            buffers[n] = std::move(buffer);
+            states[n] = ok ? Job_Done : Job_Failed;
+            condDone.Broadcast();
+        }
+    };
+
+    wxZipWorkerThreads threads = wxZipStartThreads(numThreads, work);
+    if ( threads.empty() )
+        return DoWriteSequentially();
+
+    // Write out the entries in order as soon as they become available.
+    bool ok = true;
+    for ( size_t n = 0; n < count && ok; n++ )
+    {
+        std::unique_ptr<wxMemoryOutputStream> buffer;
+        {
+            wxMutexLocker lock(mutex);
+            while ( states[n] == Job_Pending )
+                condDone.Wait();
+
+            buffer = std::move(buffers[n]);
+            ok = states[n] == Job_Done;
+        }
+
+        if ( ok )
+            ok = wxZipCopyCompressed(m_zip, *buffer);
+
+        wxMutexLocker lock(mutex);
+        written = n + 1;
+        if ( !ok )
+            stop = true;
+        condSpace.Broadcast();
+    }
+
+    wxZipWaitThreads(threads);
+
+    m_jobs.clear();
+
+    return ok;
+#else // !wxUSE_THREADS
+    wxUnusedVar(numThreads);
+
+    return DoWriteSequentially();
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+}
+
 #endif // wxUSE_ZIPSTREAM
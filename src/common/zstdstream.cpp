@@ -0,0 +1,430 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/common/zstdstream.cpp
+// Purpose:     Implementation of Zstandard stream classes
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ============================================================================
+// declarations
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+// for compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+
+#if wxUSE_LIBZSTD && wxUSE_STREAMS
+
+#include "wx/zstdstream.h"
+
+#ifndef WX_PRECOMP
+    #include "wx/log.h"
+    #include "wx/translation.h"
+#endif // WX_PRECOMP
+
+#include <zstd.h>
+
+namespace wxPrivate
+{
+
+// ----------------------------------------------------------------------------
+// Private helpers
+// ----------------------------------------------------------------------------
+
+// Decompression context together with the buffer for the compressed data.
+struct wxZstdDecoder
+{
+    wxZstdDecoder()
+        : ctx(ZSTD_createDCtx()),
+          bufSize(ZSTD_DStreamInSize()),
+          buf(new wxUint8[bufSize])
+    {
+        in.src = buf;
+        in.size = 0;
+        in.pos = 0;
+
+        inFrame = false;
+        mayHaveOutput = false;
+    }
+
+    ~wxZstdDecoder()
+    {
+        delete [] buf;
+        ZSTD_freeDCtx(ctx);
+    }
+
+    ZSTD_DCtx* const ctx;
+    const size_t bufSize;
+    wxUint8* const buf;
+    ZSTD_inBuffer in;
+
+    // True while in the middle of a frame, i.e. if reaching the end of the
+    // underlying stream now would mean that it is truncated.
+    bool inFrame;
+
+    // True if the last call filled the output buffer completely, in which
+    // case the decoder may have more data for us even without any input.
+    bool mayHaveOutput;
+
+    wxDECLARE_NO_COPY_CLASS(wxZstdDecoder);
+};
+
+// Compression context together with the buffer for the compressed data.
+struct wxZstdEncoder
+{
+    wxZstdEncoder()
+        : ctx(ZSTD_createCCtx()),
+          bufSize(ZSTD_CStreamOutSize()),
+          buf(new wxUint8[bufSize])
+    {
+        out.dst = buf;
+        out.size = bufSize;
+        out.pos = 0;
+
+        finished = false;
+    }
+
+    ~wxZstdEncoder()
+    {
+        delete [] buf;
+        ZSTD_freeCCtx(ctx);
+    }
+
+    ZSTD_CCtx* const ctx;
+    const size_t bufSize;
+    wxUint8* const buf;
+    ZSTD_outBuffer out;
+
+    // Set once the frame has been ended, to avoid starting a new one.
+    bool finished;
+
+    wxDECLARE_NO_COPY_CLASS(wxZstdEncoder);
+};
+
+} // namespace wxPrivate
+
+using namespace wxPrivate;
+
+// ============================================================================
+// implementation
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Functions
+// ----------------------------------------------------------------------------
+
+wxVersionInfo wxGetLibZstdVersionInfo()
+{
+    const unsigned ver = ZSTD_versionNumber();
+
+    return wxVersionInfo
+           (
+            "libzstd",
+            ver / 10000,
+            (ver % 10000) / 100,
+            ver % 100
+           );
+}
+
+// ----------------------------------------------------------------------------
+// wxZstdInputStream: decompression
+// ----------------------------------------------------------------------------
+
+void wxZstdInputStream::Init()
+{
+    m_decoder = new wxZstdDecoder;
+    m_pos = 0;
+
+    if ( !m_decoder->ctx )
+    {
+        wxLogError(_("Failed to allocate memory for Zstandard decompression."));
+        m_lasterror = wxSTREAM_READ_ERROR;
+    }
+}
+
+wxZstdInputStream::~wxZstdInputStream()
+{
+    delete m_decoder;
+}
+
+bool wxZstdInputStream::SetDictionary(const char *data, size_t datalen)
+{
+    return m_decoder->ctx &&
+            !ZSTD_isError(ZSTD_DCtx_loadDictionary(m_decoder->ctx,
+                                                   data, datalen));
+}
+
+bool wxZstdInputStream::SetDictionary(const wxMemoryBuffer &buf)
+{
+    return SetDictionary((char*)buf.GetData(), buf.GetDataLen());
+}
+
+size_t wxZstdInputStream::OnSysRead(void* outbuf, size_t size)
+{
+    ZSTD_outBuffer out;
+    out.dst = outbuf;
+    out.size = size;
+    out.pos = 0;
+
+    ZSTD_inBuffer& in = m_decoder->in;
+
+    // Decompress input as long as we don't have any errors (including EOF, as
+    // it doesn't make sense to continue after it either) and have space to
+    // decompress it to.
+    while ( m_lasterror == wxSTREAM_NO_ERROR && out.pos < out.size )
+    {
+        // Get more input data if needed.
+        if ( in.pos == in.size && !m_decoder->mayHaveOutput )
+        {
+            m_parent_i_stream->Read(m_decoder->buf, m_decoder->bufSize);
+            in.size = m_parent_i_stream->LastRead();
+            in.pos = 0;
+
+            if ( !in.size )
+            {
+                if ( m_parent_i_stream->GetLastError() == wxSTREAM_EOF )
+                {
+                    // We have reached end of the underlying stream, which is
+                    // only fine if it happened between the frames.
+                    if ( !m_decoder->inFrame )
+                    {
+                        m_lasterror = wxSTREAM_EOF;
+                        break;
+                    }
+
+                    wxLogError(_("Zstandard decompression error: %s"),
+                               _("input is truncated"));
+                }
+
+                m_lasterror = wxSTREAM_READ_ERROR;
+                return 0;
+            }
+        }
+
+        // Do decompress, continuing with the next frame, if any, after the
+        // end of the current one.
+        const size_t rc = ZSTD_decompressStream(m_decoder->ctx, &out, &in);
+        if ( ZSTD_isError(rc) )
+        {
+            wxLogError(_("Zstandard decompression error: %s"),
+                       ZSTD_getErrorName(rc));
+
+            m_lasterror = wxSTREAM_READ_ERROR;
+            return 0;
+        }
+
+        m_decoder->inFrame = rc != 0;
+        m_decoder->mayHaveOutput = out.pos == out.size;
+    }
+
+    // Return the number of bytes actually read, this may be less than the
+    // requested size if we hit EOF.
+    m_pos += out.pos;
+    return out.pos;
+}
+
+// ----------------------------------------------------------------------------
+// wxZstdOutputStream: compression
+// ----------------------------------------------------------------------------
+
+void wxZstdOutputStream::Init(int level)
+{
+    m_encoder = new wxZstdEncoder;
+    m_pos = 0;
+
+    if ( !m_encoder->ctx )
+    {
+        wxLogError(_("Failed to allocate memory for Zstandard compression."));
+        m_lasterror = wxSTREAM_WRITE_ERROR;
+        return;
+    }
+
+    if ( level == -1 )
+        level = ZSTD_CLEVEL_DEFAULT;
+
+    const size_t rc = ZSTD_CCtx_setParameter(m_encoder->ctx,
+                                             ZSTD_c_compressionLevel,
+                                             level);
+    if ( ZSTD_isError(rc) )
+    {
+        wxLogError(_("Failed to initialize Zstandard compression: %s"),
+                   ZSTD_getErrorName(rc));
+        m_lasterror = wxSTREAM_WRITE_ERROR;
+    }
+}
+
+wxZstdOutputStream::~wxZstdOutputStream()
+{
+    Close();
+
+    delete m_encoder;
+}
+
+/* static */
+int wxZstdOutputStream::GetMaxLevel()
+{
+    return ZSTD_maxCLevel();
+}
+
+bool wxZstdOutputStream::SetDictionary(const char *data, size_t datalen)
+{
+    return m_encoder->ctx &&
+            !ZSTD_isError(ZSTD_CCtx_loadDictionary(m_encoder->ctx,
+                                                   data, datalen));
+}
+
+bool wxZstdOutputStream::SetDictionary(const wxMemoryBuffer &buf)
+{
+    return SetDictionary((char*)buf.GetData(), buf.GetDataLen());
+}
+
+bool wxZstdOutputStream::SetThreadCount(unsigned numThreads)
+{
+    // This fails if the library was built without multithreading support,
+    // in which case the data is still compressed, just in this thread only.
+    return m_encoder->ctx &&
+            !ZSTD_isError(ZSTD_CCtx_setParameter(m_encoder->ctx,
+                                                 ZSTD_c_nbWorkers,
+                                                 static_cast<int>(numThreads)));
+}
+
+size_t wxZstdOutputStream::OnSysWrite(const void *inbuf, size_t size)
+{
+    ZSTD_inBuffer in;
+    in.src = inbuf;
+    in.size = size;
+    in.pos = 0;
+
+    // Compress as long as we have any input data, but stop at first error as
+    // it's useless to try to continue after it (or even starting if the stream
+    // had already been in an error state).
+    while ( m_lasterror == wxSTREAM_NO_ERROR && in.pos < in.size )
+    {
+        const size_t rc = ZSTD_compressStream2(m_encoder->ctx,
+                                               &m_encoder->out, &in,
+                                               ZSTD_e_continue);
+        if ( ZSTD_isError(rc) )
+        {
+            wxLogError(_("Zstandard compression error: %s"),
+                       ZSTD_getErrorName(rc));
+
+            m_lasterror = wxSTREAM_WRITE_ERROR;
+            return 0;
+        }
+
+        // Flush the output buffer if necessary.
+        if ( m_encoder->out.pos == m_encoder->out.size && !UpdateOutput() )
+            return 0;
+    }
+
+    if ( m_lasterror != wxSTREAM_NO_ERROR )
+        return 0;
+
+    m_pos += size;
+    return size;
+}
+
+bool wxZstdOutputStream::UpdateOutput()
+{
+    ZSTD_outBuffer& out = m_encoder->out;
+
+    m_parent_o_stream->Write(m_encoder->buf, out.pos);
+    if ( m_parent_o_stream->LastWrite() != out.pos )
+    {
+        m_lasterror = wxSTREAM_WRITE_ERROR;
+        return false;
+    }
+
+    out.pos = 0;
+
+    return true;
+}
+
+bool wxZstdOutputStream::DoFlush(bool finish)
+{
+    // Nothing to do if the frame was already ended, and flushing now would
+    // start a new one.
+    if ( m_encoder->finished )
+        return true;
+
+    ZSTD_inBuffer in;
+    in.src = nullptr;
+    in.size = 0;
+    in.pos = 0;
+
+    while ( m_lasterror == wxSTREAM_NO_ERROR )
+    {
+        const size_t rc = ZSTD_compressStream2(m_encoder->ctx,
+                                               &m_encoder->out, &in,
+                                               finish ? ZSTD_e_end
+                                                      : ZSTD_e_flush);
+        if ( ZSTD_isError(rc) )
+        {
+            wxLogError(_("Zstandard compression error when flushing output: %s"),
+                       ZSTD_getErrorName(rc));
+
+            m_lasterror = wxSTREAM_WRITE_ERROR;
+            break;
+        }
+
+        if ( !UpdateOutput() )
+            break;
+
+        // Zero return value indicates that everything was flushed.
+        if ( !rc )
+            return true;
+    }
+
+    return false;
+}
+
+bool wxZstdOutputStream::Close()
+{
+    if ( !DoFlush(true) )
+        return false;
+
+    m_encoder->finished = true;
+
+    return wxFilterOutputStream::Close() && IsOk();
+}
+
+// ----------------------------------------------------------------------------
+// wxZstdClassFactory: allow creating streams from extension/MIME type
+// ----------------------------------------------------------------------------
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxZstdClassFactory, wxFilterClassFactory);
+
+static wxZstdClassFactory g_wxZstdClassFactory;
+
+wxZstdClassFactory::wxZstdClassFactory()
+{
+    if ( this == &g_wxZstdClassFactory )
+        PushFront();
+}
+
+const wxChar * const *
+wxZstdClassFactory::GetProtocols(wxStreamProtocolType type) const
+{
+    static const wxChar *mime[] = { wxT("application/zstd"), nullptr };
+    static const wxChar *encs[] = { wxT("zstd"), nullptr };
+    static const wxChar *exts[] = { wxT(".zst"), nullptr };
+
+    const wxChar* const* ret = nullptr;
+    switch ( type )
+    {
+        case wxSTREAM_PROTOCOL: ret = encs; break;
+        case wxSTREAM_MIMETYPE: ret = mime; break;
+        case wxSTREAM_ENCODING: ret = encs; break;
+        case wxSTREAM_FILEEXT:  ret = exts; break;
+    }
+
+    return ret;
+}
+
+#endif // wxUSE_LIBZSTD && wxUSE_STREAMS
@@ -23,6 +23,12 @@
     #include "wx/utils.h"
 #endif
 
+#include "wx/datstrm.h"
+#include "wx/wfstream.h"
+
+#include <algorithm>
+#include <vector>
+
 
 // normally, the compiler options should contain -I../zlib, but it is
 // apparently not the case for all MSW makefiles and so, unless we use
@@ -274,6 +280,817 @@ bool wxZlibInputStream::SetDictionary(const wxMemoryBuffer &buf)
 }
 
 
+//////////////////////////////
+// wxIndexedGzipInputStream
+//////////////////////////////
+
+namespace wxPrivate
+{
+
+// The size of the window, i.e. the maximal distance of back references in the
+// deflate data, which needs to be saved in each checkpoint.
+const size_t GZINDEX_WINDOW_SIZE = 32768;
+
+// The signature of the saved index files.
+const char GZINDEX_SIGNATURE[8] = { 'w', 'x', 'G', 'Z', 'I', 'D', 'X', '2' };
+
+// The amount of compressed data at the beginning and at the end of the stream
+// used to check that the saved index corresponds to it.
+const size_t GZINDEX_CHECK_SIZE = 4096;
+
+// Format of the compressed data, determined from the flags or the data itself.
+enum wxGzipIndexFormat
+{
+    GZINDEX_UNKNOWN,
+    GZINDEX_RAW,
+    GZINDEX_ZLIB,
+    GZINDEX_GZIP
+};
+
+// Checkpoint allowing to resume decompression in the middle of the stream.
+struct wxGzipIndexPoint
+{
+    // Offset of this point in the uncompressed data.
+    wxFileOffset out;
+
+    // Offset of the first byte after this point in the compressed data and
+    // the number of bits of the previous byte which still need to be used.
+    wxFileOffset in;
+    int bits;
+
+    // Compressed contents of the window preceding this point.
+    std::vector<unsigned char> window;
+
+    bool operator<(wxFileOffset offset) const { return out < offset; }
+};
+
+struct wxGzipIndexData
+{
+    wxGzipIndexData()
+    {
+        memset(&strm, 0, sizeof(strm));
+        initialized = false;
+
+        format = GZINDEX_UNKNOWN;
+        span = 0;
+        parentStart = wxInvalidOffset;
+
+        totalIn = 0;
+        totalOut = 0;
+        readPos = 0;
+        raw = false;
+        atEnd = false;
+
+        complete = false;
+        length = wxInvalidOffset;
+    }
+
+    ~wxGzipIndexData()
+    {
+        if ( initialized )
+            inflateEnd(&strm);
+    }
+
+    // Return the window bits to use for decompressing a new stream.
+    int GetWindowBits() const
+    {
+        switch ( format )
+        {
+            case GZINDEX_RAW:   return -MAX_WBITS;
+            case GZINDEX_ZLIB:  return MAX_WBITS;
+            case GZINDEX_GZIP:  return MAX_WBITS | ZSTREAM_GZIP;
+
+            case GZINDEX_UNKNOWN:
+                break;
+        }
+
+        return MAX_WBITS | ZSTREAM_AUTO;
+    }
+
+    // Return the size of the trailer following the compressed data.
+    size_t GetTrailerSize() const
+    {
+        switch ( format )
+        {
+            case GZINDEX_ZLIB:  return 4;
+            case GZINDEX_GZIP:  return 8;
+
+            case GZINDEX_RAW:
+            case GZINDEX_UNKNOWN:
+                break;
+        }
+
+        return 0;
+    }
+
+    // Return the offset of the last checkpoint or 0 if there are none.
+    wxFileOffset GetLastPointOffset() const
+    {
+        return points.empty() ? 0 : points.back().out;
+    }
+
+    z_stream strm;
+    bool initialized;
+
+    unsigned char inbuf[ZSTREAM_BUFFER_SIZE];
+
+    // Circular buffer containing the last decompressed data.
+    unsigned char window[GZINDEX_WINDOW_SIZE];
+
+    wxGzipIndexFormat format;
+    size_t span;
+
+    // Offset of the compressed data in the parent stream.
+    wxFileOffset parentStart;
+
+    // Total amount of compressed data consumed and decompressed data produced
+    // by inflate().
+    wxFileOffset totalIn;
+    wxFileOffset totalOut;
+
+    // Position of the first byte in the window not yet returned to the user.
+    size_t readPos;
+
+    // True if decompressing raw deflate data after restoring a checkpoint.
+    bool raw;
+
+    // True if the end of the compressed data was reached.
+    bool atEnd;
+
+    std::vector<wxGzipIndexPoint> points;
+
+    // True if the index covers the entire stream, whose length is known then.
+    bool complete;
+    wxFileOffset length;
+};
+
+} // namespace wxPrivate
+
+using namespace wxPrivate;
+
+wxIndexedGzipInputStream::wxIndexedGzipInputStream(wxInputStream& stream,
+                                                   int flags,
+                                                   size_t span)
+    : wxFilterInputStream(stream)
+{
+    Init(flags, span);
+}
+
+wxIndexedGzipInputStream::wxIndexedGzipInputStream(wxInputStream *stream,
+                                                   int flags,
+                                                   size_t span)
+    : wxFilterInputStream(stream)
+{
+    Init(flags, span);
+}
+
+void wxIndexedGzipInputStream::Init(int flags, size_t span)
+{
+    m_data = new wxGzipIndexData;
+    m_pos = 0;
+
+    // Points closer than the window size would be useless, as restoring
+    // each of them requires as much memory.
+    m_data->span = wxMax(span, GZINDEX_WINDOW_SIZE);
+
+    switch ( flags )
+    {
+        case wxZLIB_NO_HEADER:  m_data->format = GZINDEX_RAW; break;
+        case wxZLIB_ZLIB:       m_data->format = GZINDEX_ZLIB; break;
+        case wxZLIB_GZIP:       m_data->format = GZINDEX_GZIP; break;
+        case wxZLIB_AUTO:       m_data->format = GZINDEX_UNKNOWN; break;
+        default:                wxFAIL_MSG(wxT("Invalid zlib flag"));
+    }
+
+    // We can only seek if the parent stream allows it.
+    if ( m_parent_i_stream && m_parent_i_stream->IsSeekable() )
+        m_data->parentStart = m_parent_i_stream->TellI();
+
+    m_data->strm.next_out = m_data->window;
+    m_data->strm.avail_out = GZINDEX_WINDOW_SIZE;
+
+    if ( inflateInit2(&m_data->strm, m_data->GetWindowBits()) != Z_OK )
+    {
+        wxLogError(_("Can't initialize zlib inflate stream."));
+        m_lasterror = wxSTREAM_READ_ERROR;
+        return;
+    }
+
+    m_data->initialized = true;
+}
+
+wxIndexedGzipInputStream::~wxIndexedGzipInputStream()
+{
+    delete m_data;
+}
+
+wxFileOffset wxIndexedGzipInputStream::GetLength() const
+{
+    return m_data->length;
+}
+
+bool wxIndexedGzipInputStream::IsSeekable() const
+{
+    return m_data->parentStart != wxInvalidOffset;
+}
+
+bool wxIndexedGzipInputStream::IsIndexComplete() const
+{
+    return m_data->complete;
+}
+
+size_t wxIndexedGzipInputStream::GetCheckpointCount() const
+{
+    return m_data->points.size();
+}
+
+/* static */
+wxString wxIndexedGzipInputStream::GetIndexFileName(const wxString& filename)
+{
+    return filename + wxS(".gzidx");
+}
+
+bool wxIndexedGzipInputStream::BuildIndex()
+{
+    if ( m_data->complete )
+        return true;
+
+    const wxFileOffset pos = TellI();
+    if ( pos == wxInvalidOffset || !DoBuildIndex() )
+        return false;
+
+    return SeekI(pos) == pos;
+}
+
+bool wxIndexedGzipInputStream::DoBuildIndex()
+{
+    if ( m_data->complete )
+        return true;
+
+    // Continue from the last known point if we're before it, there is no
+    // need to decompress the already indexed data again.
+    const wxFileOffset last = m_data->GetLastPointOffset();
+    if ( last > m_pos && !RestoreCheckpoint(m_data->points.size() - 1) )
+        return false;
+
+    while ( !m_data->atEnd )
+    {
+        m_data->readPos = GZINDEX_WINDOW_SIZE - m_data->strm.avail_out;
+        m_pos = m_data->totalOut;
+
+        if ( !Decompress() )
+            break;
+    }
+
+    m_data->readPos = GZINDEX_WINDOW_SIZE - m_data->strm.avail_out;
+    m_pos = m_data->totalOut;
+
+    return m_data->complete;
+}
+
+size_t wxIndexedGzipInputStream::OnSysRead(void *buffer, size_t size)
+{
+    return DoRead(buffer, size);
+}
+
+size_t wxIndexedGzipInputStream::DoRead(void *buffer, size_t size)
+{
+    if ( !m_data->initialized )
+        m_lasterror = wxSTREAM_READ_ERROR;
+
+    unsigned char* out = static_cast<unsigned char*>(buffer);
+    size_t done = 0;
+
+    while ( done < size && m_lasterror == wxSTREAM_NO_ERROR )
+    {
+        // Return the data already decompressed into the window first.
+        const size_t
+            pending = GZINDEX_WINDOW_SIZE - m_data->strm.avail_out
+                        - m_data->readPos;
+        if ( pending )
+        {
+            const size_t count = wxMin(pending, size - done);
+            if ( out )
+            {
+                memcpy(out, m_data->window + m_data->readPos, count);
+                out += count;
+            }
+
+            m_data->readPos += count;
+            m_pos += count;
+            done += count;
+            continue;
+        }
+
+        if ( m_data->atEnd )
+        {
+            m_lasterror = wxSTREAM_EOF;
+            break;
+        }
+
+        Decompress();
+    }
+
+    return done;
+}
+
+bool wxIndexedGzipInputStream::FillInput()
+{
+    z_stream& strm = m_data->strm;
+    if ( strm.avail_in )
+        return true;
+
+    if ( !m_parent_i_stream->IsOk() )
+        return false;
+
+    m_parent_i_stream->Read(m_data->inbuf, sizeof(m_data->inbuf));
+    strm.next_in = m_data->inbuf;
+    strm.avail_in = m_parent_i_stream->LastRead();
+
+    if ( m_data->format == GZINDEX_UNKNOWN && m_data->totalIn == 0 &&
+            strm.avail_in >= 2 )
+    {
+        // We need to know the format for handling multiple members and
+        // checkpoints, so determine it from the magic bytes of gzip header.
+        m_data->format = m_data->inbuf[0] == 0x1f && m_data->inbuf[1] == 0x8b
+                            ? GZINDEX_GZIP
+                            : GZINDEX_ZLIB;
+    }
+
+    return strm.avail_in != 0;
+}
+
+bool wxIndexedGzipInputStream::Decompress()
+{
+    z_stream& strm = m_data->strm;
+
+    // Start filling the window from the beginning again when it's full: we
+    // only get here after all data in it was consumed, so this is safe.
+    if ( !strm.avail_out )
+    {
+        strm.next_out = m_data->window;
+        strm.avail_out = GZINDEX_WINDOW_SIZE;
+        m_data->readPos = 0;
+    }
+
+    if ( !FillInput() )
+    {
+        if ( m_parent_i_stream->Eof() )
+            wxLogError(_("Can't read inflate stream: unexpected EOF in underlying stream."));
+
+        m_lasterror = wxSTREAM_READ_ERROR;
+        return false;
+    }
+
+    // Stop at the next block boundary if it's time to create a checkpoint.
+    const bool wantPoint = !m_data->complete &&
+        m_data->totalOut >= m_data->GetLastPointOffset() +
+                                static_cast<wxFileOffset>(m_data->span);
+
+    const uInt availIn = strm.avail_in;
+    const uInt availOut = strm.avail_out;
+
+    const int err = inflate(&strm, wantPoint ? Z_BLOCK : Z_NO_FLUSH);
+
+    m_data->totalIn += availIn - strm.avail_in;
+    m_data->totalOut += availOut - strm.avail_out;
+
+    switch ( err )
+    {
+        case Z_OK:
+            // Bit 7 indicates the end of a block (or of the header) and bit 6
+            // that it was the last block, after which there is nothing to do.
+            if ( wantPoint &&
+                    (strm.data_type & 128) && !(strm.data_type & 64) &&
+                        m_data->totalOut > m_data->GetLastPointOffset() )
+            {
+                AddCheckpoint();
+            }
+            return true;
+
+        case Z_STREAM_END:
+            return OnStreamEnd();
+
+        case Z_BUF_ERROR:
+            // This is not fatal, just means that no progress was possible,
+            // which can't happen as we always have some input and some space
+            // for output, but still handle it.
+            return true;
+    }
+
+    wxString msg(strm.msg, *wxConvCurrent);
+    if ( msg.empty() )
+        msg = wxString::Format(_("zlib error %d"), err);
+    wxLogError(_("Can't read from inflate stream: %s"), msg);
+
+    m_lasterror = wxSTREAM_READ_ERROR;
+    return false;
+}
+
+bool wxIndexedGzipInputStream::OnStreamEnd()
+{
+    z_stream& strm = m_data->strm;
+
+    // When decompressing raw data after restoring a checkpoint, zlib doesn't
+    // know about the trailer, so skip it ourselves.
+    if ( m_data->raw )
+    {
+        for ( size_t skip = m_data->GetTrailerSize(); skip; )
+        {
+            if ( !FillInput() )
+            {
+                wxLogError(_("Can't read inflate stream: unexpected EOF in underlying stream."));
+                m_lasterror = wxSTREAM_READ_ERROR;
+                return false;
+            }
+
+            const uInt count = wxMin(static_cast<uInt>(skip), strm.avail_in);
+            strm.next_in += count;
+            strm.avail_in -= count;
+            m_data->totalIn += count;
+            skip -= count;
+        }
+    }
+
+    // Gzip files may consist of several members, which are decompressed as
+    // a single stream, but ignore anything else after the end of data.
+    if ( m_data->format == GZINDEX_GZIP && FillInput() &&
+            strm.next_in[0] == 0x1f )
+    {
+        if ( inflateReset2(&strm, m_data->GetWindowBits()) != Z_OK )
+        {
+            m_lasterror = wxSTREAM_READ_ERROR;
+            return false;
+        }
+
+        m_data->raw = false;
+        return true;
+    }
+
+    m_data->atEnd = true;
+
+    if ( !m_data->complete )
+    {
+        m_data->complete = true;
+        m_data->length = m_data->totalOut;
+    }
+
+    return false;
+}
+
+void wxIndexedGzipInputStream::AddCheckpoint()
+{
+    const z_stream& strm = m_data->strm;
+
+    wxGzipIndexPoint point;
+    point.out = m_data->totalOut;
+    point.in = m_data->totalIn;
+    point.bits = strm.data_type & 7;
+
+    // The window contains the last decompressed data ending at the current
+    // output position and, if it had been already filled before, continuing
+    // from the end of it.
+    const size_t pos = GZINDEX_WINDOW_SIZE - strm.avail_out;
+
+    unsigned char dict[GZINDEX_WINDOW_SIZE];
+    size_t len = pos;
+    if ( m_data->totalOut >= static_cast<wxFileOffset>(GZINDEX_WINDOW_SIZE) )
+    {
+        len = GZINDEX_WINDOW_SIZE - pos;
+        memcpy(dict, m_data->window + pos, len);
+        memcpy(dict + len, m_data->window, pos);
+        len = GZINDEX_WINDOW_SIZE;
+    }
+    else
+    {
+        memcpy(dict, m_data->window, len);
+    }
+
+    // Store the window compressed to reduce the memory used by the index.
+    uLongf size = compressBound(len);
+    point.window.resize(size);
+    if ( compress2(&point.window[0], &size, dict, len, Z_BEST_SPEED) != Z_OK )
+    {
+        // Not fatal, we just won't have this checkpoint.
+        return;
+    }
+
+    point.window.resize(size);
+
+    m_data->points.push_back(point);
+}
+
+bool wxIndexedGzipInputStream::RestoreCheckpoint(int n)
+{
+    z_stream& strm = m_data->strm;
+
+    wxFileOffset in = 0;
+    const wxGzipIndexPoint* point = nullptr;
+    if ( n != -1 )
+    {
+        point = &m_data->points[n];
+        in = point->in - (point->bits ? 1 : 0);
+    }
+
+    m_parent_i_stream->Reset();
+    if ( m_parent_i_stream->SeekI(m_data->parentStart + in) == wxInvalidOffset )
+        return false;
+
+    strm.next_in = m_data->inbuf;
+    strm.avail_in = 0;
+    strm.next_out = m_data->window;
+    strm.avail_out = GZINDEX_WINDOW_SIZE;
+
+    m_data->readPos = 0;
+    m_data->atEnd = false;
+
+    if ( !point )
+    {
+        if ( inflateReset2(&strm, m_data->GetWindowBits()) != Z_OK )
+            return false;
+
+        m_data->raw = false;
+        m_data->totalIn = 0;
+        m_data->totalOut = 0;
+        m_pos = 0;
+
+        return true;
+    }
+
+    if ( inflateReset2(&strm, -MAX_WBITS) != Z_OK )
+        return false;
+
+    m_data->raw = true;
+
+    if ( point->bits )
+    {
+        const int c = m_parent_i_stream->GetC();
+        if ( c == wxEOF )
+            return false;
+
+        inflatePrime(&strm, point->bits, c >> (8 - point->bits));
+    }
+
+    uLongf len = GZINDEX_WINDOW_SIZE;
+    if ( uncompress(m_data->window, &len,
+                    &point->window[0], point->window.size()) != Z_OK ||
+            inflateSetDictionary(&strm, m_data->window, len) != Z_OK )
+    {
+        return false;
+    }
+
+    // Continue filling the window after the dictionary, so that it still
+    // contains the previous data when we need to create the next checkpoint.
+    strm.next_out = m_data->window + len;
+    strm.avail_out = GZINDEX_WINDOW_SIZE - len;
+    m_data->readPos = len;
+
+    m_data->totalIn = point->in;
+    m_data->totalOut = point->out;
+    m_pos = point->out;
+
+    return true;
+}
+
+wxFileOffset
+wxIndexedGzipInputStream::OnSysSeek(wxFileOffset pos, wxSeekMode mode)
+{
+    if ( !IsSeekable() || !m_data->initialized )
+        return wxInvalidOffset;
+
+    // Clear the EOF error, if any, but not the real errors.
+    if ( m_lasterror == wxSTREAM_EOF )
+        m_lasterror = wxSTREAM_NO_ERROR;
+    if ( m_lasterror != wxSTREAM_NO_ERROR )
+        return wxInvalidOffset;
+
+    wxFileOffset target = pos;
+    switch ( mode )
+    {
+        case wxFromStart:
+            break;
+
+        case wxFromCurrent:
+            target += m_pos;
+            break;
+
+        case wxFromEnd:
+            // We need to know the length for this.
+            if ( !DoBuildIndex() )
+                return wxInvalidOffset;
+
+            target += m_data->length;
+            break;
+
+        default:
+            wxFAIL_MSG( wxS("invalid seek mode") );
+            return wxInvalidOffset;
+    }
+
+    if ( target < 0 || (m_data->complete && target > m_data->length) )
+        return wxInvalidOffset;
+
+    // Find the last checkpoint before the target position.
+    const std::vector<wxGzipIndexPoint>& points = m_data->points;
+    const int n = std::lower_bound(points.begin(), points.end(), target + 1)
+                    - points.begin() - 1;
+    const wxFileOffset start = n == -1 ? 0 : points[n].out;
+
+    // Don't restart from it if we can continue from the current position.
+    if ( target < m_pos || start > m_pos )
+    {
+        if ( !RestoreCheckpoint(n) )
+        {
+            wxLogError(_("Can't seek in inflate stream."));
+            m_lasterror = wxSTREAM_READ_ERROR;
+            return wxInvalidOffset;
+        }
+    }
+
+    // Finally decompress the data until the target position.
+    const wxFileOffset skip = target - m_pos;
+    if ( skip > 0 )
+    {
+        DoRead(nullptr, static_cast<size_t>(skip));
+
+        if ( m_pos != target )
+            return wxInvalidOffset;
+    }
+
+    return m_pos;
+}
+
+// Compute the length of the compressed data and the CRC of its beginning and
+// end, which include the gzip header and trailer, identifying the data the
+// index was created for. The position of the parent stream is preserved.
+static bool
+GetCompressedDataInfo(wxInputStream& parent,
+                      wxFileOffset start,
+                      wxFileOffset& length,
+                      wxUint32& crc)
+{
+    const wxFileOffset total = parent.GetLength();
+    if ( start == wxInvalidOffset || total == wxInvalidOffset || total < start )
+        return false;
+
+    length = total - start;
+
+    const wxFileOffset pos = parent.TellI();
+    if ( pos == wxInvalidOffset )
+        return false;
+
+    unsigned char buf[GZINDEX_CHECK_SIZE];
+    const size_t head = static_cast<size_t>(
+                            wxMin(length, wxFileOffset(GZINDEX_CHECK_SIZE)));
+
+    uLong sum = crc32(0, Z_NULL, 0);
+    bool ok = parent.SeekI(start) != wxInvalidOffset &&
+                parent.ReadAll(buf, head);
+    if ( ok )
+    {
+        sum = crc32(sum, buf, head);
+
+        if ( length > wxFileOffset(GZINDEX_CHECK_SIZE) )
+        {
+            ok = parent.SeekI(total - head) != wxInvalidOffset &&
+                    parent.ReadAll(buf, head);
+            if ( ok )
+                sum = crc32(sum, buf, head);
+        }
+    }
+
+    parent.Reset();
+    if ( parent.SeekI(pos) == wxInvalidOffset )
+        return false;
+
+    crc = static_cast<wxUint32>(sum);
+
+    return ok;
+}
+
+bool wxIndexedGzipInputStream::SaveIndex(wxOutputStream& stream) const
+{
+    wxFileOffset compressedLength;
+    wxUint32 crc;
+    if ( !m_parent_i_stream ||
+            !GetCompressedDataInfo(*m_parent_i_stream, m_data->parentStart,
+                                   compressedLength, crc) )
+        return false;
+
+    stream.Write(GZINDEX_SIGNATURE, sizeof(GZINDEX_SIGNATURE));
+
+    wxDataOutputStream out(stream);
+    out.Write64(static_cast<wxUint64>(compressedLength));
+    out.Write32(crc);
+    out.Write32(m_data->format);
+    out.Write64(static_cast<wxUint64>(m_data->span));
+    out.Write64(static_cast<wxUint64>(m_data->length));
+    out.Write32(static_cast<wxUint32>(m_data->points.size()));
+
+    for ( size_t n = 0; n < m_data->points.size(); n++ )
+    {
+        const wxGzipIndexPoint& point = m_data->points[n];
+
+        out.Write64(static_cast<wxUint64>(point.out));
+        out.Write64(static_cast<wxUint64>(point.in));
+        out.Write8(static_cast<wxUint8>(point.bits));
+        out.Write32(static_cast<wxUint32>(point.window.size()));
+        out.Write8(&point.window[0], point.window.size());
+    }
+
+    return stream.IsOk();
+}
+
+bool wxIndexedGzipInputStream::LoadIndex(wxInputStream& stream)
+{
+    char signature[sizeof(GZINDEX_SIGNATURE)];
+    if ( !stream.ReadAll(signature, sizeof(signature)) ||
+            memcmp(signature, GZINDEX_SIGNATURE, sizeof(signature)) != 0 )
+        return false;
+
+    wxDataInputStream in(stream);
+
+    // The index must have been created for exactly the same compressed data:
+    // we'd read garbage or fail to decompress it at all otherwise.
+    wxFileOffset compressedLength;
+    wxUint32 crc;
+    if ( !m_parent_i_stream ||
+            !GetCompressedDataInfo(*m_parent_i_stream, m_data->parentStart,
+                                   compressedLength, crc) )
+        return false;
+
+    if ( static_cast<wxFileOffset>(in.Read64()) != compressedLength ||
+            in.Read32() != crc || !stream.IsOk() )
+        return false;
+
+    // The index must have been created for the data in the same format.
+    const wxGzipIndexFormat format = static_cast<wxGzipIndexFormat>(in.Read32());
+    if ( m_data->format != GZINDEX_UNKNOWN && format != m_data->format )
+        return false;
+
+    const size_t span = static_cast<size_t>(in.Read64());
+    const wxFileOffset length = static_cast<wxFileOffset>(in.Read64());
+    const wxUint32 count = in.Read32();
+    if ( !stream.IsOk() )
+        return false;
+
+    // Don't trust the count and the sizes read from the index: it could be
+    // corrupted, so don't allocate anything before reading the data itself
+    // and never more than a compressed window can take.
+    const uLong maxWindowSize = compressBound(GZINDEX_WINDOW_SIZE);
+
+    std::vector<wxGzipIndexPoint> points;
+    for ( wxUint32 n = 0; n < count; n++ )
+    {
+        wxGzipIndexPoint point;
+        point.out = static_cast<wxFileOffset>(in.Read64());
+        point.in = static_cast<wxFileOffset>(in.Read64());
+        point.bits = in.Read8();
+
+        const wxUint32 size = in.Read32();
+        if ( !stream.IsOk() || !size || size > maxWindowSize ||
+                point.bits > 7 ||
+                point.in <= 0 || point.in > compressedLength ||
+                (n && point.out <= points.back().out) )
+            return false;
+
+        point.window.resize(size);
+        if ( !stream.ReadAll(&point.window[0], size) )
+            return false;
+
+        points.push_back(std::move(point));
+    }
+
+    // Check that the index is consistent with the data we already know.
+    if ( m_data->complete && length != m_data->length )
+        return false;
+
+    m_data->format = format;
+    m_data->span = span;
+    m_data->length = length;
+    m_data->complete = length != wxInvalidOffset;
+    m_data->points.swap(points);
+
+    return true;
+}
+
+#if wxUSE_FILE
+
+bool wxIndexedGzipInputStream::SaveIndex(const wxString& filename) const
+{
+    wxFileOutputStream stream(filename);
+    return stream.IsOk() && SaveIndex(stream) && stream.Close();
+}
+
+bool wxIndexedGzipInputStream::LoadIndex(const wxString& filename)
+{
+    wxFileInputStream stream(filename);
+    return stream.IsOk() && LoadIndex(stream);
+}
+
+#endif // wxUSE_FILE
+
+
 //////////////////////
 // wxZlibOutputStream
 //////////////////////
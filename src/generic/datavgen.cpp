@@ -54,6 +54,13 @@
 #include "wx/private/markupparser.h"
 #endif // wxUSE_ACCESSIBILITY
 
+#include <algorithm>
+#include <unordered_map>
+
+#if wxUSE_THREADS
+    #include "wx/thread.h"
+#endif // wxUSE_THREADS
+
 //-----------------------------------------------------------------------------
 // classes
 //-----------------------------------------------------------------------------
@@ -72,11 +79,11 @@ static const int PADDING_RIGHTLEFT = 3;
 namespace
 {
 
-// Flags for Walker() function defined below.
+// Flags for wxDataViewMainWindow::GetRowByItem().
 enum WalkFlags
 {
-    Walk_All,               // Visit all items.
-    Walk_ExpandedOnly       // Visit only expanded items.
+    Walk_All,               // Consider all items.
+    Walk_ExpandedOnly       // Consider only the items in expanded branches.
 };
 
 // The column is either the index of the column to be used for sorting or one
@@ -495,6 +502,7 @@ public:
     wxDataViewTreeNode(wxDataViewTreeNode *parent, const wxDataViewItem& item)
         : m_parent(parent),
           m_item(item),
+          m_indexInParent(0),
           m_branchData(nullptr)
     {
     }
@@ -533,12 +541,22 @@ public:
     void InsertChild(wxDataViewMainWindow* window,
                      wxDataViewTreeNode *node, unsigned index);
 
+    // Insert all the given nodes at once. If the children are not kept sorted,
+    // each node is inserted before the existing child with the corresponding
+    // index in positions, which must be in non-decreasing order.
+    void InsertChildren(wxDataViewMainWindow* window,
+                        const wxDataViewTreeNodes& nodes,
+                        const wxVector<unsigned>& positions);
+
     void RemoveChild(unsigned index)
     {
         wxCHECK_RET( m_branchData != nullptr, "leaf node doesn't have children" );
         m_branchData->RemoveChild(index);
     }
 
+    // Remove all the given child nodes, which must be distinct, in one pass.
+    void RemoveChildren(const wxDataViewTreeNodes& nodes);
+
     // returns position of child node for given item in children list or wxNOT_FOUND
     int FindChildByItem(const wxDataViewItem& item) const
     {
@@ -558,6 +576,31 @@ public:
     const wxDataViewItem & GetItem() const { return m_item; }
     void SetItem( const wxDataViewItem & item ) { m_item = item; }
 
+    // returns the position of this node in its parent children list, must
+    // not be called for the root node
+    unsigned GetIndexInParent() const
+    {
+        m_parent->UpdateRowOffsets();
+        return m_indexInParent;
+    }
+
+    // returns the number of rows occupied by the siblings preceding this node
+    // and their subtrees, must not be called for the root node
+    int GetRowOffsetInParent() const
+    {
+        m_parent->UpdateRowOffsets();
+        return m_parent->m_branchData->GetRowsBefore(m_indexInParent);
+    }
+
+    // returns the position of the child node whose row or subtree contains
+    // the given row, counted from the first child of this node
+    unsigned FindChildByRowOffset(int offset)
+    {
+        UpdateRowOffsets();
+
+        return m_branchData->FindChildByRowOffset(offset);
+    }
+
     int GetIndentLevel() const
     {
         int ret = 0;
@@ -645,7 +688,13 @@ public:
         wxASSERT( m_branchData->subTreeCount >= 0 );
 
         if( m_parent )
+        {
+            // Even if the parent is closed, the rows of its children must be
+            // updated, as they're still used by GetRowByItem().
+            m_parent->m_branchData->AddRowsToChild(m_indexInParent, num);
+
             m_parent->ChangeSubTreeCount(num);
+        }
     }
 
     void Resort(wxDataViewMainWindow* window);
@@ -659,6 +708,10 @@ public:
     }
 
 private:
+    // Update the sort order of the children before inserting new ones and
+    // return true if the new children should be inserted in this order.
+    bool ShouldInsertSorted(const SortOrder& sortOrder);
+
     // Called by the child after it has been updated to put it in the right
     // place among its siblings, depending on the sort order.
     //
@@ -667,31 +720,117 @@ private:
     void PutChildInSortOrder(wxDataViewMainWindow* window,
                              wxDataViewTreeNode* childNode);
 
+    // Recompute the row offsets of the children, if necessary.
+    void UpdateRowOffsets();
+
     wxDataViewTreeNode  *m_parent;
 
     // Corresponding model item.
     wxDataViewItem       m_item;
 
+    // Position of this node in its parent children list, only valid if the
+    // parent rowOffsetsValid is true.
+    unsigned             m_indexInParent;
+
     // Data specific to non-leaf (branch, inner) nodes. They are kept in a
     // separate struct in order to conserve memory.
     struct BranchNodeData
     {
         BranchNodeData()
             : open(false),
-              subTreeCount(0)
+              subTreeCount(0),
+              rowOffsetsValid(false)
         {
         }
 
         void InsertChild(wxDataViewTreeNode* node, unsigned index)
         {
+            // Appending a child, which is the most common case, doesn't
+            // change the offsets of the existing ones, so we can keep them.
+            if ( rowOffsetsValid && index == children.size() )
+            {
+                node->m_indexInParent = index;
+                AppendRowCount(1 + node->GetSubTreeCount());
+            }
+            else
+            {
+                rowOffsetsValid = false;
+            }
+
             children.insert(children.begin() + index, node);
         }
 
         void RemoveChild(unsigned index)
         {
+            // Similarly, removing the last child doesn't affect the others.
+            if ( rowOffsetsValid && index == children.size() - 1 )
+                rowCounts.pop_back();
+            else
+                rowOffsetsValid = false;
+
             children.erase(children.begin() + index);
         }
 
+        // Functions working with rowCounts, which must be valid. Notice that
+        // child indices are 0-based, while those in the tree are 1-based.
+        static unsigned LowestBit(unsigned i) { return i & (0u - i); }
+
+        // Return the number of rows occupied by the children preceding the
+        // given one and their subtrees.
+        int GetRowsBefore(unsigned index) const
+        {
+            int rows = 0;
+            for ( unsigned i = index; i > 0; i -= LowestBit(i) )
+                rows += rowCounts[i - 1];
+
+            return rows;
+        }
+
+        // Return the index of the child occupying the given row, which must
+        // be less than subTreeCount.
+        unsigned FindChildByRowOffset(int offset) const
+        {
+            const unsigned count = rowCounts.size();
+
+            unsigned step = 1;
+            while ( step <= count / 2 )
+                step *= 2;
+
+            // Find the number of children whose rows all precede the given
+            // one, which is also the index of the child containing it.
+            unsigned pos = 0;
+            for ( ; step; step /= 2 )
+            {
+                if ( pos + step <= count && rowCounts[pos + step - 1] <= offset )
+                {
+                    pos += step;
+                    offset -= rowCounts[pos - 1];
+                }
+            }
+
+            return pos;
+        }
+
+        // Add the given number of rows to the subtree of the given child.
+        void AddRowsToChild(unsigned index, int num)
+        {
+            // Nothing to do if the counts will be recomputed anyhow.
+            if ( !rowOffsetsValid )
+                return;
+
+            const unsigned count = rowCounts.size();
+            for ( unsigned i = index + 1; i <= count; i += LowestBit(i) )
+                rowCounts[i - 1] += num;
+        }
+
+        // Add the count of rows for the new last child.
+        void AppendRowCount(int rows)
+        {
+            const unsigned i = rowCounts.size() + 1;
+            rowCounts.push_back(rows + GetRowsBefore(i - 1)
+                                     - GetRowsBefore(i - LowestBit(i)));
+        }
+
         // Child nodes. Note that this may be empty even if m_hasChildren in
         // case this branch of the tree wasn't expanded and realized yet.
         wxDataViewTreeNodes  children;
@@ -707,6 +846,21 @@ private:
         // 0 for leaves and is the number of rows the subtree occupies for
         // branch nodes.
         int                  subTreeCount;
+
+        // Number of rows occupied by the children and their subtrees, i.e.
+        // 1 + subTreeCount for each child, stored as a Fenwick (binary
+        // indexed) tree: the element with 1-based index i contains the sum
+        // of the counts of the children in (i - LowestBit(i), i]. This allows
+        // to find the rows of the nodes and the nodes by rows, as well as to
+        // update the count of a child when its subtree changes, in O(log n).
+        //
+        // Appending or removing the last child is also done in O(log n), but
+        // inserting or removing children elsewhere, or reordering them, just
+        // sets rowOffsetsValid to false and the tree is then rebuilt in O(n)
+        // when it's needed, which is not worse than the cost of changing the
+        // children vector itself in this case.
+        wxVector<int>        rowCounts;
+        bool                 rowOffsetsValid;
     };
 
     BranchNodeData *m_branchData;
@@ -734,6 +888,8 @@ public:
     // notifications from wxDataViewModel
     bool ItemAdded( const wxDataViewItem &parent, const wxDataViewItem &item );
     bool ItemDeleted( const wxDataViewItem &parent, const wxDataViewItem &item );
+    bool ItemsAdded( const wxDataViewItem &parent, const wxDataViewItemArray &items );
+    bool ItemsDeleted( const wxDataViewItem &parent, const wxDataViewItemArray &items );
     bool ItemChanged( const wxDataViewItem &item )
     {
         return DoItemChanged(item, wxNOT_FOUND);
@@ -894,8 +1050,16 @@ public:
                       WalkFlags flags = Walk_All ) const;
 
     wxDataViewTreeNode * GetTreeNodeByRow( unsigned int row ) const;
-    // We did not need this temporarily
-    // wxDataViewTreeNode * GetTreeNodeByItem( const wxDataViewItem & item );
+
+    // Return the node corresponding to the given item or nullptr if the tree
+    // doesn't contain it, e.g. because its parent was never expanded.
+    wxDataViewTreeNode * GetTreeNodeByItem( const wxDataViewItem & item ) const;
+
+    // Add the node to, or remove it and all its children from, the map used
+    // by GetTreeNodeByItem(). These functions are only used by the code
+    // creating and destroying the nodes.
+    void RegisterTreeNode( wxDataViewTreeNode * node );
+    void UnregisterTreeNode( wxDataViewTreeNode * node );
 
     // Methods for building the mapping tree
     void BuildTree( wxDataViewModel  * model );
@@ -1066,6 +1230,9 @@ private:
     wxDataViewTreeNode * m_root;
     int m_count;
 
+    // Map from the model items to the corresponding tree nodes.
+    std::unordered_map<void*, wxDataViewTreeNode*> m_itemToNode;
+
     // This is the tree node under the cursor
     wxDataViewTreeNode * m_underMouse;
 
@@ -1094,6 +1261,10 @@ public:
         { return m_mainWindow->ItemAdded( parent , item ); }
     virtual bool ItemDeleted( const wxDataViewItem &parent, const wxDataViewItem &item ) override
         { return m_mainWindow->ItemDeleted( parent, item ); }
+    virtual bool ItemsAdded( const wxDataViewItem &parent, const wxDataViewItemArray &items ) override
+        { return m_mainWindow->ItemsAdded( parent, items ); }
+    virtual bool ItemsDeleted( const wxDataViewItem &parent, const wxDataViewItemArray &items ) override
+        { return m_mainWindow->ItemsDeleted( parent, items ); }
     virtual bool ItemChanged( const wxDataViewItem & item ) override
         { return m_mainWindow->ItemChanged(item);  }
     virtual bool ValueChanged( const wxDataViewItem & item , unsigned int col ) override
@@ -1849,16 +2020,272 @@ private:
     const SortOrder m_sortOrder;
 };
 
-} // anonymous namespace
+// Minimal number of items to sort using multiple threads.
+const size_t SORT_PARALLEL_MIN_COUNT = 100000;
 
-void wxDataViewTreeNode::InsertChild(wxDataViewMainWindow* window,
-                                     wxDataViewTreeNode *node, unsigned index)
+#if wxUSE_THREADS
+
+// Thread sorting a part of the indices array in SortIndices().
+template <typename Cmp>
+class wxDataViewSortThread : public wxThread
 {
-    if (!m_branchData)
-        m_branchData = new BranchNodeData;
+public:
+    wxDataViewSortThread(wxVector<size_t>::iterator first,
+                         wxVector<size_t>::iterator last,
+                         Cmp cmp)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_first(first),
+          m_last(last),
+          m_cmp(cmp)
+    {
+    }
 
-    const SortOrder sortOrder = window->GetSortOrder();
+protected:
+    virtual ExitCode Entry() override
+    {
+        std::sort(m_first, m_last, m_cmp);
+        return nullptr;
+    }
+
+private:
+    const wxVector<size_t>::iterator m_first,
+                                     m_last;
+    const Cmp m_cmp;
+};
+
+#endif // wxUSE_THREADS
+
+// Sort the given indices using the given comparator, which must be safe to
+// call from any thread.
+template <typename Cmp>
+void SortIndices(wxVector<size_t>& order, Cmp cmp)
+{
+#if wxUSE_THREADS
+    // For many items, sort the parts of the array in parallel and then merge
+    // them. Note that this only uses the keys already retrieved from the
+    // model, which is not supposed to be used from other threads.
+    const size_t count = order.size();
+    const int cpus = wxThread::GetCPUCount();
+    if ( count >= SORT_PARALLEL_MIN_COUNT && cpus > 1 )
+    {
+        const size_t parts = wxMin(static_cast<size_t>(cpus),
+                                   count / (SORT_PARALLEL_MIN_COUNT / 2));
+
+        wxVector<size_t> bounds(parts + 1);
+        for ( size_t n = 0; n <= parts; n++ )
+            bounds[n] = count * n / parts;
+
+        const auto sortPart = [&order, &bounds, cmp](size_t n)
+        {
+            std::sort(order.begin() + bounds[n],
+                      order.begin() + bounds[n + 1],
+                      cmp);
+        };
+
+        // Any part for which a thread couldn't be started is just sorted in
+        // this thread instead.
+        typedef wxDataViewSortThread<Cmp> SortThread;
+        wxVector<SortThread*> threads;
+        threads.reserve(parts - 1);
+        for ( size_t n = 1; n < parts; n++ )
+        {
+            SortThread* const thread = new SortThread(order.begin() + bounds[n],
+                                                      order.begin() + bounds[n + 1],
+                                                      cmp);
+            if ( thread->Run() != wxTHREAD_NO_ERROR )
+            {
+                delete thread;
+                sortPart(n);
+                continue;
+            }
+
+            threads.push_back(thread);
+        }
+
+        sortPart(0);
+
+        for ( auto thread : threads )
+        {
+            thread->Wait();
+            delete thread;
+        }
+
+        // Merge the sorted parts pairwise until there is only one left.
+        for ( size_t step = 1; step < parts; step *= 2 )
+        {
+            for ( size_t n = 0; n + step < parts; n += 2*step )
+            {
+                std::inplace_merge(order.begin() + bounds[n],
+                                   order.begin() + bounds[n + step],
+                                   order.begin() + bounds[wxMin(n + 2*step,
+                                                                parts)],
+                                   cmp);
+            }
+        }
+
+        return;
+    }
+#endif // wxUSE_THREADS
 
+    std::sort(order.begin(), order.end(), cmp);
+}
+
+// Sort the nodes in the given range using the given keys, one for each node.
+template <typename T>
+void SortNodesByKeys(wxDataViewTreeNodes::iterator first,
+                     const wxVector<T>& keys,
+                     bool ascending)
+{
+    const size_t count = keys.size();
+
+    wxVector<size_t> order(count);
+    for ( size_t n = 0; n < count; n++ )
+        order[n] = n;
+
+    SortIndices(order,
+                [first, &keys, ascending](size_t n1, size_t n2)
+                {
+                    if ( !ascending )
+                        std::swap(n1, n2);
+
+                    if ( keys[n1] < keys[n2] )
+                        return true;
+                    if ( keys[n2] < keys[n1] )
+                        return false;
+
+                    // As in wxDataViewModel::Compare(), use the item IDs to
+                    // order the items with the same value.
+                    return wxPtrToUInt(first[n1]->GetItem().GetID()) <
+                              wxPtrToUInt(first[n2]->GetItem().GetID());
+                });
+
+    const wxDataViewTreeNodes nodes(first, first + count);
+    for ( size_t n = 0; n < count; n++ )
+        first[n] = nodes[order[n]];
+}
+
+// Sort the nodes in the given range in the same order as the default
+// wxDataViewModel::Compare() would, but retrieving the value of each item
+// only once instead of doing it for each comparison.
+//
+// Returns false if the values are not all of the same type or if it's not one
+// of the types supported by Compare() itself, in which case the nodes are left
+// unchanged.
+bool SortNodesByValues(const wxDataViewModel* model,
+                       wxDataViewTreeNodes::iterator first,
+                       wxDataViewTreeNodes::iterator last,
+                       const SortOrder& sortOrder)
+{
+    const unsigned column = sortOrder.GetColumn();
+    const bool ascending = sortOrder.IsAscending();
+    const size_t count = last - first;
+
+    wxVector<wxVariant> values(count);
+    for ( size_t n = 0; n < count; n++ )
+    {
+        const wxDataViewItem& item = first[n]->GetItem();
+        if ( model->HasValue(item, column) )
+            model->GetValue(values[n], item, column);
+    }
+
+    const wxString type = count ? values[0].GetType() : wxString();
+    for ( size_t n = 1; n < count; n++ )
+    {
+        if ( values[n].GetType() != type )
+            return false;
+    }
+
+    if ( type == wxS("string") )
+    {
+        wxVector<wxString> keys;
+        keys.reserve(count);
+        for ( size_t n = 0; n < count; n++ )
+            keys.push_back(values[n].GetString());
+
+        SortNodesByKeys(first, keys, ascending);
+    }
+    else if ( type == wxS("long") )
+    {
+        wxVector<long> keys;
+        keys.reserve(count);
+        for ( size_t n = 0; n < count; n++ )
+            keys.push_back(values[n].GetLong());
+
+        SortNodesByKeys(first, keys, ascending);
+    }
+    else if ( type == wxS("double") )
+    {
+        wxVector<double> keys;
+        keys.reserve(count);
+        for ( size_t n = 0; n < count; n++ )
+            keys.push_back(values[n].GetDouble());
+
+        SortNodesByKeys(first, keys, ascending);
+    }
+#if wxUSE_DATETIME
+    else if ( type == wxS("datetime") )
+    {
+        wxVector<wxLongLong> keys;
+        keys.reserve(count);
+        for ( size_t n = 0; n < count; n++ )
+            keys.push_back(values[n].GetDateTime().GetValue());
+
+        SortNodesByKeys(first, keys, ascending);
+    }
+#endif // wxUSE_DATETIME
+    else if ( type == wxS("bool") )
+    {
+        wxVector<int> keys;
+        keys.reserve(count);
+        for ( size_t n = 0; n < count; n++ )
+            keys.push_back(values[n].GetBool());
+
+        SortNodesByKeys(first, keys, ascending);
+    }
+    else if ( type == wxS("wxDataViewIconText") )
+    {
+        wxVector<wxString> keys;
+        keys.reserve(count);
+        for ( size_t n = 0; n < count; n++ )
+        {
+            wxDataViewIconText iconText;
+            iconText << values[n];
+            keys.push_back(iconText.GetText());
+        }
+
+        SortNodesByKeys(first, keys, ascending);
+    }
+    else
+    {
+        // Custom types are compared by DoCompareValues() which we can't call.
+        return false;
+    }
+
+    return true;
+}
+
+// Sort the nodes in the given range using the specified sort order.
+void SortNodes(wxDataViewMainWindow* window,
+               wxDataViewTreeNodes::iterator first,
+               wxDataViewTreeNodes::iterator last,
+               const SortOrder& sortOrder)
+{
+    const wxDataViewModel* const model = window->GetModel();
+
+    // When sorting by a column using the default comparison, we can avoid
+    // calling Compare(), and so retrieving both values, for each pair of
+    // items compared, which is much faster for many items.
+    if ( sortOrder.UsesColumn() && model->UsesDefaultCompare() &&
+            SortNodesByValues(model, first, last, sortOrder) )
+        return;
+
+    std::sort(first, last, wxGenericTreeModelNodeCmp(window, sortOrder));
+}
+
+} // anonymous namespace
+
+bool wxDataViewTreeNode::ShouldInsertSorted(const SortOrder& sortOrder)
+{
     // Flag indicating whether we should retain existing sorted list when
     // inserting the child node.
     bool insertSorted = false;
@@ -1911,8 +2338,19 @@ void wxDataViewTreeNode::InsertChild(wxDataViewMainWindow* window,
         m_branchData->sortOrder = SortOrder();
     }
 
+    return insertSorted;
+}
+
+void wxDataViewTreeNode::InsertChild(wxDataViewMainWindow* window,
+                                     wxDataViewTreeNode *node, unsigned index)
+{
+    if (!m_branchData)
+        m_branchData = new BranchNodeData;
+
+    window->RegisterTreeNode(node);
 
-    if ( insertSorted )
+    const SortOrder sortOrder = window->GetSortOrder();
+    if ( ShouldInsertSorted(sortOrder) )
     {
         // Use binary search to find the correct position to insert at.
         wxGenericTreeModelNodeCmp cmp(window, sortOrder);
@@ -1936,6 +2374,83 @@ void wxDataViewTreeNode::InsertChild(wxDataViewMainWindow* window,
     }
 }
 
+void wxDataViewTreeNode::InsertChildren(wxDataViewMainWindow* window,
+                                        const wxDataViewTreeNodes& nodes,
+                                        const wxVector<unsigned>& positions)
+{
+    if (!m_branchData)
+        m_branchData = new BranchNodeData;
+
+    for ( size_t n = 0; n < nodes.size(); n++ )
+        window->RegisterTreeNode(nodes[n]);
+
+    wxDataViewTreeNodes& children = m_branchData->children;
+    const size_t oldCount = children.size();
+
+    const SortOrder sortOrder = window->GetSortOrder();
+    if ( ShouldInsertSorted(sortOrder) )
+    {
+        // Sorting just the new nodes and merging them with the existing ones
+        // is faster than inserting them one by one.
+        wxGenericTreeModelNodeCmp cmp(window, sortOrder);
+
+        children.insert(children.end(), nodes.begin(), nodes.end());
+        SortNodes(window, children.begin() + oldCount, children.end(), sortOrder);
+        std::inplace_merge(children.begin(),
+                           children.begin() + oldCount,
+                           children.end(),
+                           cmp);
+    }
+    else
+    {
+        wxASSERT( nodes.size() == positions.size() );
+
+        wxDataViewTreeNodes merged;
+        merged.reserve(oldCount + nodes.size());
+
+        size_t n = 0;
+        for ( size_t i = 0; i < oldCount; i++ )
+        {
+            while ( n < nodes.size() && positions[n] <= i )
+                merged.push_back(nodes[n++]);
+
+            merged.push_back(children[i]);
+        }
+
+        merged.insert(merged.end(), nodes.begin() + n, nodes.end());
+
+        children.swap(merged);
+    }
+
+    m_branchData->rowOffsetsValid = false;
+}
+
+void wxDataViewTreeNode::RemoveChildren(const wxDataViewTreeNodes& nodes)
+{
+    wxCHECK_RET( m_branchData != nullptr, "leaf node doesn't have children" );
+
+    wxDataViewTreeNodes& children = m_branchData->children;
+
+    wxVector<bool> removed(children.size(), false);
+    for ( size_t n = 0; n < nodes.size(); n++ )
+    {
+        wxCHECK_RET( nodes[n]->GetParent() == this, "not our child?" );
+
+        removed[nodes[n]->GetIndexInParent()] = true;
+    }
+
+    size_t count = 0;
+    for ( size_t i = 0; i < children.size(); i++ )
+    {
+        if ( !removed[i] )
+            children[count++] = children[i];
+    }
+
+    children.resize(count);
+
+    m_branchData->rowOffsetsValid = false;
+}
+
 
 void wxDataViewTreeNode::Resort(wxDataViewMainWindow* window)
 {
@@ -1956,11 +2471,13 @@ void wxDataViewTreeNode::Resort(wxDataViewMainWindow* window)
         // using model-specific sort order, which can change at any time.
         if ( m_branchData->sortOrder != sortOrder || !sortOrder.UsesColumn() )
         {
-            std::sort(m_branchData->children.begin(),
+            SortNodes(window,
+                      m_branchData->children.begin(),
                       m_branchData->children.end(),
-                      wxGenericTreeModelNodeCmp(window, sortOrder));
+                      sortOrder);
 
             m_branchData->sortOrder = sortOrder;
+            m_branchData->rowOffsetsValid = false;
         }
 
         // There may be open child nodes that also need a resort.
@@ -2000,16 +2517,9 @@ wxDataViewTreeNode::PutChildInSortOrder(wxDataViewMainWindow* window,
 
     // First find the node in the current child list
     int hi = nodes.size();
-    int oldLocation = wxNOT_FOUND;
-    for ( int index = 0; index < hi; ++index )
-    {
-        if ( nodes[index] == childNode )
-        {
-            oldLocation = index;
-            break;
-        }
-    }
-    wxCHECK_RET( oldLocation >= 0, "not our child?" );
+    const int oldLocation = childNode->GetIndexInParent();
+    wxCHECK_RET( oldLocation < hi && nodes[oldLocation] == childNode,
+                 "not our child?" );
 
     wxGenericTreeModelNodeCmp cmp(window, m_branchData->sortOrder);
 
@@ -2054,6 +2564,37 @@ wxDataViewTreeNode::PutChildInSortOrder(wxDataViewMainWindow* window,
     window->UpdateDisplay();
 }
 
+void wxDataViewTreeNode::UpdateRowOffsets()
+{
+    if ( m_branchData->rowOffsetsValid )
+        return;
+
+    const wxDataViewTreeNodes& nodes = m_branchData->children;
+    const unsigned len = nodes.size();
+
+    // Build the Fenwick tree in linear time by adding each element to the
+    // next one covering it.
+    wxVector<int>& counts = m_branchData->rowCounts;
+    counts.resize(len);
+
+    for ( unsigned i = 0; i < len; i++ )
+    {
+        wxDataViewTreeNode* const node = nodes[i];
+
+        counts[i] = 1 + node->GetSubTreeCount();
+        node->m_indexInParent = i;
+    }
+
+    for ( unsigned i = 1; i <= len; i++ )
+    {
+        const unsigned next = i + BranchNodeData::LowestBit(i);
+        if ( next <= len )
+            counts[next - 1] += counts[i - 1];
+    }
+
+    m_branchData->rowOffsetsValid = true;
+}
+
 
 //-----------------------------------------------------------------------------
 // wxDataViewMainWindow
@@ -3052,63 +3593,6 @@ void wxDataViewHeaderWindow::FinishEditing()
     win->FinishEditing();
 }
 
-//-----------------------------------------------------------------------------
-// Helper class for do operation on the tree node
-//-----------------------------------------------------------------------------
-
-namespace
-{
-
-class DoJob
-{
-public:
-    DoJob() { }
-    virtual ~DoJob() { }
-
-    // The return value control how the tree-walker tranverse the tree
-    enum
-    {
-        DONE,          // Job done, stop traversing and return
-        SKIP_SUBTREE,  // Ignore the current node's subtree and continue
-        CONTINUE       // Job not done, continue
-    };
-
-    virtual int operator() ( wxDataViewTreeNode * node ) = 0;
-};
-
-bool
-Walker(wxDataViewTreeNode * node, DoJob & func, WalkFlags flags = Walk_All)
-{
-    wxCHECK_MSG( node, false, "can't walk null node" );
-
-    switch( func( node ) )
-    {
-        case DoJob::DONE:
-            return true;
-        case DoJob::SKIP_SUBTREE:
-            return false;
-        case DoJob::CONTINUE:
-            break;
-    }
-
-    if ( node->HasChildren() && (flags != Walk_ExpandedOnly || node->IsOpen()) )
-    {
-        const wxDataViewTreeNodes& nodes = node->GetChildNodes();
-
-        for ( wxDataViewTreeNodes::const_iterator i = nodes.begin();
-              i != nodes.end();
-              ++i )
-        {
-            if ( Walker(*i, func, flags) )
-                return true;
-        }
-    }
-
-    return false;
-}
-
-} // anonymous namespace
-
 bool wxDataViewMainWindow::ItemAdded(const wxDataViewItem & parent, const wxDataViewItem & item)
 {
     if (IsVirtualList())
@@ -3253,24 +3737,13 @@ bool wxDataViewMainWindow::ItemDeleted(const wxDataViewItem& parent,
             return true;
 
         wxCHECK_MSG( parentNode->HasChildren(), false, "parent node doesn't have children?" );
-        const wxDataViewTreeNodes& parentsChildren = parentNode->GetChildNodes();
 
         // We can't use FindNode() to find 'item', because it was already
-        // removed from the model by the time ItemDeleted() is called, so we
-        // have to do it manually. We keep track of its position as well for
-        // later use.
-        int itemPosInNode = 0;
-        wxDataViewTreeNode *itemNode = nullptr;
-        for ( wxDataViewTreeNodes::const_iterator i = parentsChildren.begin();
-              i != parentsChildren.end();
-              ++i, ++itemPosInNode )
-        {
-            if( (*i)->GetItem() == item )
-            {
-                itemNode = *i;
-                break;
-            }
-        }
+        // removed from the model by the time ItemDeleted() is called, but we
+        // can still use our own map as it doesn't use the model.
+        wxDataViewTreeNode *itemNode = GetTreeNodeByItem(item);
+        if ( itemNode && itemNode->GetParent() != parentNode )
+            itemNode = nullptr;
 
         // If the parent wasn't expanded, it's possible that we didn't have a
         // node corresponding to 'item' and so there's nothing left to do.
@@ -3284,6 +3757,8 @@ bool wxDataViewMainWindow::ItemDeleted(const wxDataViewItem& parent,
             return true;
         }
 
+        const int itemPosInNode = itemNode->GetIndexInParent();
+
         if ( m_rowHeightCache )
             m_rowHeightCache->Remove(GetRowByItem(parent) + itemPosInNode);
 
@@ -3291,6 +3766,7 @@ bool wxDataViewMainWindow::ItemDeleted(const wxDataViewItem& parent,
         const int itemsDeleted = 1 + itemNode->GetSubTreeCount();
 
         parentNode->RemoveChild(itemPosInNode);
+        UnregisterTreeNode(itemNode);
         delete itemNode;
         parentNode->ChangeSubTreeCount(-itemsDeleted);
 
@@ -3347,6 +3823,257 @@ bool wxDataViewMainWindow::ItemDeleted(const wxDataViewItem& parent,
     return true;
 }
 
+bool wxDataViewMainWindow::ItemsAdded(const wxDataViewItem& parent,
+                                      const wxDataViewItemArray& items)
+{
+    // Virtual list models don't use the tree and there is nothing to gain
+    // from handling a single item specially.
+    if ( IsVirtualList() || items.size() < 2 )
+    {
+        for ( size_t n = 0; n < items.size(); n++ )
+        {
+            if ( !ItemAdded(parent, items[n]) )
+                return false;
+        }
+
+        return true;
+    }
+
+    // specific positions (rows) are unclear, so clear whole height cache
+    ClearRowHeightCache();
+
+    const FindNodeResult findResult = FindNode(parent);
+    wxDataViewTreeNode *parentNode = findResult.m_node;
+
+    // The checks below are the same as in ItemAdded(), see there.
+    if ( !findResult.m_subtreeRealized )
+        return true;
+
+    if ( !parentNode )
+        return false;
+
+    if ( !parentNode->HasChildren() )
+    {
+        parentNode->SetHasChildren(true);
+        return true;
+    }
+
+    if ( !parentNode->IsOpen() && parentNode->GetChildNodes().empty() )
+        return true;
+
+    wxDataViewModel* const model = GetModel();
+
+    std::unordered_map<void*, wxDataViewTreeNode*> newNodes;
+    for ( size_t n = 0; n < items.size(); n++ )
+    {
+        // Ignore the duplicate items, if any.
+        if ( newNodes.count(items[n].GetID()) )
+            continue;
+
+        wxDataViewTreeNode *itemNode = new wxDataViewTreeNode(parentNode, items[n]);
+        itemNode->SetHasChildren(model->IsContainer(items[n]));
+        newNodes[items[n].GetID()] = itemNode;
+    }
+
+    wxDataViewTreeNodes nodes;
+    nodes.reserve(newNodes.size());
+
+    wxVector<unsigned> positions;
+
+    if ( GetSortOrder().IsNone() )
+    {
+        // Insert each new node before the node of its next sibling in the
+        // model which we already have, as ItemAdded() does, but do it for all
+        // of them in a single pass over the model children, starting from the
+        // last one.
+        wxDataViewItemArray modelSiblings;
+        model->GetChildren(parent, modelSiblings);
+
+        positions.reserve(newNodes.size());
+
+        unsigned nextNodePos = parentNode->GetChildNodes().size();
+        for ( size_t n = modelSiblings.size(); n > 0; n-- )
+        {
+            const wxDataViewItem& sibling = modelSiblings[n - 1];
+
+            const auto it = newNodes.find(sibling.GetID());
+            if ( it != newNodes.end() )
+            {
+                if ( it->second )
+                {
+                    nodes.push_back(it->second);
+                    positions.push_back(nextNodePos);
+
+                    // Don't add the same node twice.
+                    it->second = nullptr;
+                }
+
+                continue;
+            }
+
+            const wxDataViewTreeNode* const
+                siblingNode = GetTreeNodeByItem(sibling);
+            if ( siblingNode && siblingNode->GetParent() == parentNode )
+                nextNodePos = siblingNode->GetIndexInParent();
+        }
+
+        std::reverse(nodes.begin(), nodes.end());
+        std::reverse(positions.begin(), positions.end());
+
+        // Any remaining nodes correspond to the items not in the model.
+        for ( const auto& kv : newNodes )
+        {
+            if ( kv.second )
+            {
+                wxFAIL_MSG( "adding non-existent item?" );
+                delete kv.second;
+            }
+        }
+    }
+    else
+    {
+        // Node list is or will be sorted, so insertion positions don't matter
+        // and we just append the new nodes if they're not sorted right now.
+        const unsigned endPos = parentNode->GetChildNodes().size();
+        for ( size_t n = 0; n < items.size(); n++ )
+        {
+            const auto it = newNodes.find(items[n].GetID());
+            if ( it->second )
+            {
+                nodes.push_back(it->second);
+                positions.push_back(endPos);
+                it->second = nullptr;
+            }
+        }
+    }
+
+    parentNode->ChangeSubTreeCount(+static_cast<int>(nodes.size()));
+    parentNode->InsertChildren(this, nodes, positions);
+
+    InvalidateCount();
+
+    // Update the selection for all the new rows, in increasing order, so that
+    // the rows of the items inserted before have already been accounted for.
+    wxVector<int> rows;
+    rows.reserve(nodes.size());
+    for ( size_t n = 0; n < nodes.size(); n++ )
+        rows.push_back(GetRowByItem(nodes[n]->GetItem()));
+
+    std::sort(rows.begin(), rows.end());
+    for ( size_t n = 0; n < rows.size(); n++ )
+        m_selection.OnItemsInserted(rows[n], 1);
+
+    GetOwner()->InvalidateColBestWidths();
+    UpdateDisplay();
+
+    return true;
+}
+
+bool wxDataViewMainWindow::ItemsDeleted(const wxDataViewItem& parent,
+                                        const wxDataViewItemArray& items)
+{
+    if ( IsVirtualList() || items.size() < 2 )
+    {
+        for ( size_t n = 0; n < items.size(); n++ )
+        {
+            if ( !ItemDeleted(parent, items[n]) )
+                return false;
+        }
+
+        return true;
+    }
+
+    const FindNodeResult findResult = FindNode(parent);
+    wxDataViewTreeNode *parentNode = findResult.m_node;
+
+    // The checks below are the same as in ItemDeleted(), see there.
+    if ( !findResult.m_subtreeRealized )
+        return true;
+
+    if ( !parentNode )
+        return true;
+
+    wxCHECK_MSG( parentNode->HasChildren(), false, "parent node doesn't have children?" );
+
+    wxDataViewTreeNodes nodes;
+    nodes.reserve(items.size());
+    for ( size_t n = 0; n < items.size(); n++ )
+    {
+        wxDataViewTreeNode* const itemNode = GetTreeNodeByItem(items[n]);
+        if ( itemNode && itemNode->GetParent() == parentNode )
+            nodes.push_back(itemNode);
+    }
+
+    // Guard against the same item being passed more than once.
+    std::sort(nodes.begin(), nodes.end());
+    nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+
+    if ( !nodes.empty() )
+    {
+        // Remember the rows occupied by the items being deleted before
+        // removing them: we need to update the selection and row heights.
+        wxVector<std::pair<int, int>> rows;
+        rows.reserve(nodes.size());
+
+        int itemsDeleted = 0;
+        for ( size_t n = 0; n < nodes.size(); n++ )
+        {
+            const int count = 1 + nodes[n]->GetSubTreeCount();
+            rows.push_back(std::make_pair(GetRowByItem(nodes[n]->GetItem()), count));
+            itemsDeleted += count;
+        }
+
+        std::sort(rows.begin(), rows.end());
+
+        if ( m_rowHeightCache )
+            m_rowHeightCache->Remove(rows.front().first);
+
+        parentNode->RemoveChildren(nodes);
+        for ( size_t n = 0; n < nodes.size(); n++ )
+        {
+            UnregisterTreeNode(nodes[n]);
+            delete nodes[n];
+        }
+
+        parentNode->ChangeSubTreeCount(-itemsDeleted);
+
+        InvalidateCount();
+
+        // Update the selection starting from the last row, so that the rows
+        // of the previous items remain valid.
+        if ( !m_selection.IsEmpty() )
+        {
+            for ( size_t n = rows.size(); n > 0; n-- )
+                m_selection.OnItemsDeleted(rows[n - 1].first, rows[n - 1].second);
+        }
+    }
+
+    // If the last children were removed, it's possible the parent node became
+    // a leaf. Let's ask the model about it.
+    if ( parentNode->GetChildNodes().empty() )
+    {
+        bool isContainer = GetModel()->IsContainer(parent);
+        parentNode->SetHasChildren(isContainer);
+
+        // If it's still a container, make sure we show "+" icon for it and
+        // not "-" one as there is nothing to collapse any more.
+        if ( isContainer && !nodes.empty() && parentNode->IsOpen() )
+            parentNode->ToggleOpen(this);
+    }
+
+    if ( nodes.empty() )
+        return true;
+
+    // Change the current row to the last row if the current exceed the max row number
+    if ( HasCurrentRow() && m_currentRow >= GetRowCount() )
+        ChangeCurrentRow(m_count - 1);
+
+    GetOwner()->InvalidateColBestWidths();
+    UpdateDisplay();
+
+    return true;
+}
+
 bool wxDataViewMainWindow::DoItemChanged(const wxDataViewItem & item, int view_column)
 {
     if ( !IsVirtualList() )
@@ -3872,73 +4599,61 @@ int wxDataViewMainWindow::QueryAndCacheLineHeight(unsigned int row, wxDataViewIt
 }
 
 
-namespace
+wxDataViewTreeNode * wxDataViewMainWindow::GetTreeNodeByRow(unsigned int row) const
 {
+    wxASSERT( !IsVirtualList() );
 
-class RowToTreeNodeJob: public DoJob
-{
-public:
-    // Note that we initialize m_current to -1 because the first node passed to
-    // our operator() will be the root node, which doesn't appear in the window
-    // and so doesn't count as a real row.
-    explicit RowToTreeNodeJob(int row)
-        : m_row(row), m_current(-1), m_ret(nullptr)
-    {
-    }
+    if ( row == (unsigned)-1 )
+        return nullptr;
 
-    virtual int operator() ( wxDataViewTreeNode * node ) override
-    {
-        if( m_current == m_row)
-        {
-            m_ret = node;
-            return DoJob::DONE;
-        }
+    // Row relative to the first child of the current node.
+    int rowInNode = static_cast<int>(row);
 
-        if( node->GetSubTreeCount() + m_current < m_row )
-        {
-            m_current += node->GetSubTreeCount() + 1;
-            return  DoJob::SKIP_SUBTREE;
-        }
-        else
-        {
-            // If the current node has only leaf children, we can find the
-            // desired node directly. This can speed up finding the node
-            // in some cases, and will have a very good effect for list views.
-            if ( node->HasChildren() &&
-                 (int)node->GetChildNodes().size() == node->GetSubTreeCount() )
-            {
-                const int index = m_row - m_current - 1;
-                m_ret = node->GetChildNodes()[index];
-                return DoJob::DONE;
-            }
+    wxDataViewTreeNode* node = m_root;
+    if ( rowInNode >= node->GetSubTreeCount() )
+        return nullptr;
 
-            m_current++;
+    for ( ;; )
+    {
+        // As the row is inside this node subtree, it must be open and so we
+        // can descend into the child containing the row.
+        const unsigned index = node->FindChildByRowOffset(rowInNode);
+        wxDataViewTreeNode* const child = node->GetChildNodes()[index];
 
-            return DoJob::CONTINUE;
-        }
-    }
+        rowInNode -= child->GetRowOffsetInParent();
+        if ( rowInNode == 0 )
+            return child;
 
-    wxDataViewTreeNode * GetResult() const
-        { return m_ret; }
+        // Skip the row of the child itself.
+        rowInNode--;
+        node = child;
+    }
+}
 
-private:
-    const int m_row;
-    int m_current;
-    wxDataViewTreeNode* m_ret;
-};
+wxDataViewTreeNode *
+wxDataViewMainWindow::GetTreeNodeByItem(const wxDataViewItem& item) const
+{
+    const auto it = m_itemToNode.find(item.GetID());
+    return it == m_itemToNode.end() ? nullptr : it->second;
+}
 
-} // anonymous namespace
-  //
-wxDataViewTreeNode * wxDataViewMainWindow::GetTreeNodeByRow(unsigned int row) const
+void wxDataViewMainWindow::RegisterTreeNode(wxDataViewTreeNode* node)
 {
-    wxASSERT( !IsVirtualList() );
+    m_itemToNode[node->GetItem().GetID()] = node;
+}
 
-    if ( row == (unsigned)-1 )
-        return nullptr;
+void wxDataViewMainWindow::UnregisterTreeNode(wxDataViewTreeNode* node)
+{
+    const auto it = m_itemToNode.find(node->GetItem().GetID());
+    if ( it != m_itemToNode.end() && it->second == node )
+        m_itemToNode.erase(it);
 
-    RowToTreeNodeJob job(static_cast<int>(row));
-    Walker( m_root , job );
-    return job.GetResult();
+    if ( node->HasChildren() )
+    {
+        const wxDataViewTreeNodes& nodes = node->GetChildNodes();
+        for ( size_t n = 0; n < nodes.size(); n++ )
+            UnregisterTreeNode(nodes[n]);
+    }
 }
 
 wxDataViewItem wxDataViewMainWindow::GetItemByRow(unsigned int row) const
@@ -4162,58 +4877,27 @@ wxDataViewMainWindow::FindNode( const wxDataViewItem & item )
         return result;
     }
 
-    // Compose the parent-chain for the item we are looking for
-    wxVector<wxDataViewItem> parentChain;
-    wxDataViewItem it( item );
-    while( it.IsOk() )
-    {
-        parentChain.push_back(it);
-        it = model->GetParent(it);
-    }
+    result.m_node = GetTreeNodeByItem(item);
+    if ( result.m_node )
+        return result;
 
-    // Find the item along the parent-chain.
-    // This algorithm is designed to speed up the node-finding method
-    wxDataViewTreeNode* node = m_root;
-    for( unsigned iter = parentChain.size()-1; ; --iter )
+    // We don't have this item, check if it's because its closest ancestor
+    // that we do have is a container which wasn't realized yet.
+    for ( wxDataViewItem it = model->GetParent(item); ; it = model->GetParent(it) )
     {
-        if( node->HasChildren() )
+        const wxDataViewTreeNode* const
+            node = it.IsOk() ? GetTreeNodeByItem(it) : m_root;
+        if ( node )
         {
-            if( node->GetChildNodes().empty() )
-            {
-                // Even though the item is a container, it doesn't have any
-                // child nodes in the control's representation yet.
+            // Even though the item is a container, it doesn't have any child
+            // nodes in the control's representation yet.
+            if ( node->HasChildren() && node->GetChildNodes().empty() )
                 result.m_subtreeRealized = false;
-                return result;
-            }
-
-            const wxDataViewTreeNodes& nodes = node->GetChildNodes();
-            bool found = false;
-
-            for (unsigned i = 0; i < nodes.size(); ++i)
-            {
-                wxDataViewTreeNode* currentNode = nodes[i];
-                if (currentNode->GetItem() == parentChain[iter])
-                {
-                    if (currentNode->GetItem() == item)
-                    {
-                        result.m_node = currentNode;
-                        return result;
-                    }
-
-                    node = currentNode;
-                    found = true;
-                    break;
-                }
-            }
-            if (!found)
-                return result;
-        }
-        else
-            return result;
 
-        if ( !iter )
             break;
+        }
     }
+
     return result;
 }
 
@@ -4332,60 +5016,6 @@ int wxDataViewMainWindow::RecalculateCount() const
     }
 }
 
-namespace
-{
-
-class ItemToRowJob : public DoJob
-{
-public:
-    // As with RowToTreeNodeJob above, we initialize m_current to -1 because
-    // the first node passed to our operator() is the root node which is not
-    // visible on screen and so we should return 0 for its first child node and
-    // not for the root itself.
-    ItemToRowJob(const wxDataViewItem& item, wxVector<wxDataViewItem>::reverse_iterator iter)
-        : m_item(item), m_iter(iter), m_current(-1)
-    {
-    }
-
-    // Maybe binary search will help to speed up this process
-    virtual int operator() ( wxDataViewTreeNode * node) override
-    {
-        if( node->GetItem() == m_item )
-        {
-            return DoJob::DONE;
-        }
-
-        // Is this node the next (grand)parent of the item we're looking for?
-        if( node->GetItem() == *m_iter )
-        {
-            // Search for the next (grand)parent now and skip this item itself.
-            ++m_iter;
-            ++m_current;
-            return DoJob::CONTINUE;
-        }
-        else
-        {
-            // Skip this node and all its currently visible children.
-            m_current += node->GetSubTreeCount() + 1;
-            return DoJob::SKIP_SUBTREE;
-        }
-
-    }
-
-    int GetResult() const
-        { return m_current; }
-
-private:
-    const wxDataViewItem m_item;
-    wxVector<wxDataViewItem>::reverse_iterator m_iter;
-
-    // The row corresponding to the last node seen in our operator().
-    int m_current;
-
-};
-
-} // anonymous namespace
-
 int
 wxDataViewMainWindow::GetRowByItem(const wxDataViewItem & item,
                                    WalkFlags flags) const
@@ -4403,25 +5033,26 @@ wxDataViewMainWindow::GetRowByItem(const wxDataViewItem & item,
         if( !item.IsOk() )
             return -1;
 
-        // Compose the parent-chain of the item we are looking for
-        wxVector<wxDataViewItem> parentChain;
-        wxDataViewItem it( item );
-        while( it.IsOk() )
+        const wxDataViewTreeNode* node = GetTreeNodeByItem(item);
+        if ( !node )
+            return -1;
+
+        // Start from -1 because the root node is not visible on screen and so
+        // its first child must have the row 0.
+        int row = -1;
+        for ( ;; )
         {
-            parentChain.push_back(it);
-            it = model->GetParent(it);
-        }
+            row += node->GetRowOffsetInParent() + 1;
 
-        // add an 'invalid' item to represent our 'invisible' root node
-        parentChain.push_back(wxDataViewItem());
+            node = node->GetParent();
+            if ( node == m_root )
+                break;
 
-        // the parent chain was created by adding the deepest parent first.
-        // so if we want to start at the root node, we have to iterate backwards through the vector
-        ItemToRowJob job( item, parentChain.rbegin() );
-        if ( !Walker( m_root, job, flags ) )
-            return -1;
+            if ( flags == Walk_ExpandedOnly && !node->IsOpen() )
+                return -1;
+        }
 
-        return job.GetResult();
+        return row;
     }
 }
 
@@ -4471,6 +5102,7 @@ void wxDataViewMainWindow::DestroyTree()
     if (!IsVirtualList())
     {
         wxDELETE(m_root);
+        m_itemToNode.clear();
         m_count = 0;
     }
 }
@@ -26,6 +26,7 @@
 #ifndef WX_PRECOMP
     #include "wx/utils.h"
     #include "wx/dcclient.h"
+    #include "wx/dcmemory.h"
     #include "wx/settings.h"
     #include "wx/log.h"
     #include "wx/textctrl.h"
@@ -46,6 +47,7 @@
 #include "wx/renderer.h"
 #include "wx/headerctrl.h"
 #include "wx/scopeguard.h"
+#include "wx/idlesched.h"
 
 #if wxUSE_CLIPBOARD
     #include "wx/clipbrd.h"
@@ -61,6 +63,8 @@ const char wxGridNameStr[] = "grid";
 // Required for wxIs... functions
 #include <ctype.h>
 
+#include <algorithm>
+
 // ----------------------------------------------------------------------------
 // globals
 // ----------------------------------------------------------------------------
@@ -1306,6 +1310,304 @@ void wxGridRowOrColAttrData::UpdateAttrRowsOrCols( size_t pos, int numRowsOrCols
     }
 }
 
+// ----------------------------------------------------------------------------
+// wxGridBlockAttrData
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Update the range [first, last] of rows or columns after inserting (if count
+// is positive) or deleting (otherwise) count of them at pos. Inserting inside
+// the range extends it. Returns false if the range was deleted entirely.
+bool UpdateBlockRange(int& first, int& last, int pos, int count)
+{
+    if ( count > 0 )
+    {
+        if ( first >= pos )
+            first += count;
+        if ( last >= pos )
+            last += count;
+    }
+    else if ( count < 0 )
+    {
+        // The deleted range is [pos, posEnd).
+        const int posEnd = pos - count;
+
+        if ( first >= posEnd )
+            first += count;
+        else if ( first > pos )
+            first = pos;
+
+        if ( last >= posEnd )
+            last += count;
+        else if ( last >= pos )
+            last = pos - 1;
+    }
+
+    return first <= last;
+}
+
+} // anonymous namespace
+
+wxGridBlockAttrData::~wxGridBlockAttrData()
+{
+    for ( const auto& entry : m_entries )
+        entry.attr->DecRef();
+}
+
+void
+wxGridBlockAttrData::SetAttr(wxGridCellAttr *attr,
+                             const wxGridBlockCoords& blockOrig)
+{
+    wxASSERT_MSG( !attr || !attr->HasSize(),
+                  "block attributes can't be used for multicells" );
+
+    const wxGridBlockCoords block = blockOrig.Canonicalize();
+
+    const auto isAbove = [](const Entry& e1, const Entry& e2)
+    {
+        return e1.block.GetTopRow() < e2.block.GetTopRow();
+    };
+
+    // Only the blocks starting at or above the bottom row can overlap it.
+    const size_t end = GetCountStartingAtOrAbove(block.GetBottomRow());
+
+    std::vector<size_t> overlapping;
+    if ( end )
+        DoFindOverlapping(1, 0, m_maxBottoms.size() / 2, end, block,
+                          overlapping);
+
+    if ( overlapping.empty() )
+    {
+        if ( !attr )
+            return;
+
+        // We take ownership of the attribute, so don't IncRef() it.
+        const Entry entry{block, attr};
+        const size_t pos = GetCountStartingAtOrAbove(block.GetTopRow());
+        m_entries.insert(m_entries.begin() + pos, entry);
+
+        // Adding the blocks from top to bottom is common, avoid rebuilding
+        // the entire tree in this case if it still has space for them.
+        if ( pos == m_entries.size() - 1 && pos < m_maxBottoms.size() / 2 )
+            UpdateTree(pos);
+        else
+            RebuildTree();
+
+        return;
+    }
+
+    // Remove the block from all the existing ones overlapping it: this
+    // splits each of them in up to 4 parts sharing the same attribute.
+    std::vector<Entry> parts;
+    for ( const size_t n : overlapping )
+    {
+        Entry& entry = m_entries[n];
+
+        const wxGridBlockDiffResult
+            diff = entry.block.Difference(block, wxHORIZONTAL);
+        for ( const auto& part : diff.m_parts )
+        {
+            if ( part == wxGridNoBlockCoords )
+                continue;
+
+            entry.attr->IncRef();
+            parts.push_back({part, entry.attr});
+        }
+
+        entry.attr->DecRef();
+        entry.attr = nullptr;
+    }
+
+    // We take ownership of the attribute, so don't IncRef() it.
+    if ( attr )
+        parts.push_back({block, attr});
+
+    std::sort(parts.begin(), parts.end(), isAbove);
+
+    // The remaining blocks are still sorted, so just merge the new ones with
+    // them instead of sorting everything again.
+    m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(),
+                                   [](const Entry& entry)
+                                   {
+                                      return entry.attr == nullptr;
+                                   }),
+                    m_entries.end());
+
+    std::vector<Entry> entries;
+    entries.reserve(m_entries.size() + parts.size());
+    std::merge(m_entries.begin(), m_entries.end(),
+               parts.begin(), parts.end(),
+               std::back_inserter(entries),
+               isAbove);
+
+    m_entries.swap(entries);
+
+    RebuildTree();
+}
+
+wxGridCellAttr *wxGridBlockAttrData::GetAttr(int row, int col) const
+{
+    if ( m_entries.empty() )
+        return nullptr;
+
+    // Only the blocks starting at or above the row can contain it.
+    const int n = DoFind(1, 0, m_maxBottoms.size() / 2,
+                         GetCountStartingAtOrAbove(row), row, col);
+    if ( n == -1 )
+        return nullptr;
+
+    wxGridCellAttr* const attr = m_entries[n].attr;
+    attr->IncRef();
+
+    return attr;
+}
+
+int
+wxGridBlockAttrData::DoFind(int node, int first, int last, int end,
+                            int row, int col) const
+{
+    // Skip the subtrees without any blocks extending down to this row.
+    if ( first >= end || m_maxBottoms[node] < row )
+        return -1;
+
+    if ( last - first == 1 )
+    {
+        if ( !m_entries[first].block.Contains(wxGridCellCoords(row, col)) )
+            return -1;
+
+        return first;
+    }
+
+    const int middle = (first + last) / 2;
+
+    const int n = DoFind(2*node, first, middle, end, row, col);
+    if ( n != -1 )
+        return n;
+
+    return DoFind(2*node + 1, middle, last, end, row, col);
+}
+
+void
+wxGridBlockAttrData::DoFindOverlapping(int node, int first, int last, int end,
+                                       const wxGridBlockCoords& block,
+                                       std::vector<size_t>& found) const
+{
+    if ( first >= end || m_maxBottoms[node] < block.GetTopRow() )
+        return;
+
+    if ( last - first == 1 )
+    {
+        if ( m_entries[first].block.Intersects(block) )
+            found.push_back(first);
+
+        return;
+    }
+
+    const int middle = (first + last) / 2;
+
+    DoFindOverlapping(2*node, first, middle, end, block, found);
+    DoFindOverlapping(2*node + 1, middle, last, end, block, found);
+}
+
+size_t wxGridBlockAttrData::GetCountStartingAtOrAbove(int row) const
+{
+    const auto it = std::upper_bound(m_entries.begin(), m_entries.end(), row,
+                                     [](int r, const Entry& entry)
+                                     {
+                                        return r < entry.block.GetTopRow();
+                                     });
+
+    return it - m_entries.begin();
+}
+
+void wxGridBlockAttrData::UpdateAttrRows( size_t pos, int numRows )
+{
+    std::vector<Entry> entries;
+    entries.reserve(m_entries.size());
+
+    for ( auto entry : m_entries )
+    {
+        int top = entry.block.GetTopRow(),
+            bottom = entry.block.GetBottomRow();
+
+        if ( !UpdateBlockRange(top, bottom, static_cast<int>(pos), numRows) )
+        {
+            entry.attr->DecRef();
+            continue;
+        }
+
+        entry.block.SetTopRow(top);
+        entry.block.SetBottomRow(bottom);
+        entries.push_back(entry);
+    }
+
+    m_entries.swap(entries);
+
+    // Shifting the rows preserves the order of the blocks, even if several of
+    // them are collapsed to the same top row when deleting the rows.
+    RebuildTree();
+}
+
+void wxGridBlockAttrData::UpdateAttrCols( size_t pos, int numCols )
+{
+    std::vector<Entry> entries;
+    entries.reserve(m_entries.size());
+
+    for ( auto entry : m_entries )
+    {
+        int left = entry.block.GetLeftCol(),
+            right = entry.block.GetRightCol();
+
+        if ( !UpdateBlockRange(left, right, static_cast<int>(pos), numCols) )
+        {
+            entry.attr->DecRef();
+            continue;
+        }
+
+        entry.block.SetLeftCol(left);
+        entry.block.SetRightCol(right);
+        entries.push_back(entry);
+    }
+
+    m_entries.swap(entries);
+
+    // The rows didn't change, so the order of the blocks is still correct.
+    RebuildTree();
+}
+
+void wxGridBlockAttrData::RebuildTree()
+{
+    m_maxBottoms.clear();
+    if ( m_entries.empty() )
+        return;
+
+    // Use a complete binary tree with the leaves corresponding to the blocks
+    // and unused leaves having -1 which never matches any row.
+    size_t numLeaves = 1;
+    while ( numLeaves < m_entries.size() )
+        numLeaves *= 2;
+
+    m_maxBottoms.resize(2*numLeaves, -1);
+    for ( size_t n = 0; n < m_entries.size(); n++ )
+        m_maxBottoms[numLeaves + n] = m_entries[n].block.GetBottomRow();
+
+    for ( size_t node = numLeaves - 1; node > 0; node-- )
+        m_maxBottoms[node] = wxMax(m_maxBottoms[2*node],
+                                   m_maxBottoms[2*node + 1]);
+}
+
+void wxGridBlockAttrData::UpdateTree(size_t n)
+{
+    size_t node = m_maxBottoms.size() / 2 + n;
+    m_maxBottoms[node] = m_entries[n].block.GetBottomRow();
+
+    for ( node /= 2; node > 0; node /= 2 )
+        m_maxBottoms[node] = wxMax(m_maxBottoms[2*node],
+                                   m_maxBottoms[2*node + 1]);
+}
+
 // ----------------------------------------------------------------------------
 // wxGridCellAttrProvider
 // ----------------------------------------------------------------------------
@@ -1341,55 +1643,46 @@ wxGridCellAttr *wxGridCellAttrProvider::GetAttr(int row, int col,
                 {
                     // Basically implement old version.
                     // Also check merge cache, so we don't have to re-merge every time..
-                    wxGridCellAttr *attrcell = m_data->m_cellAttrs.GetAttr(row, col);
-                    wxGridCellAttr *attrrow = m_data->m_rowAttrs.GetAttr(row);
-                    wxGridCellAttr *attrcol = m_data->m_colAttrs.GetAttr(col);
+                    // Order is important: the attributes are sorted by
+                    // decreasing priority.
+                    wxGridCellAttr* const attrs[] =
+                    {
+                        m_data->m_cellAttrs.GetAttr(row, col),
+                        m_data->m_blockAttrs.GetAttr(row, col),
+                        m_data->m_colAttrs.GetAttr(col),
+                        m_data->m_rowAttrs.GetAttr(row),
+                    };
+
+                    int numAttrs = 0;
+                    for ( wxGridCellAttr* a : attrs )
+                    {
+                        if ( a )
+                        {
+                            attr = a;
+                            numAttrs++;
+                        }
+                    }
 
-                    if ((attrcell != attrrow) && (attrrow != attrcol) && (attrcell != attrcol))
+                    if ( numAttrs > 1 )
                     {
                         // Two or more are non null
                         attr = new wxGridCellAttr;
                         attr->SetKind(wxGridCellAttr::Merged);
 
-                        // Order is important..
-                        if (attrcell)
+                        for ( wxGridCellAttr* a : attrs )
                         {
-                            attr->MergeWith(attrcell);
-                            attrcell->DecRef();
-                        }
-                        if (attrcol)
-                        {
-                            attr->MergeWith(attrcol);
-                            attrcol->DecRef();
-                        }
-                        if (attrrow)
-                        {
-                            attr->MergeWith(attrrow);
-                            attrrow->DecRef();
+                            if ( a )
+                            {
+                                attr->MergeWith(a);
+                                a->DecRef();
+                            }
                         }
 
                         // store merge attr if cache implemented
                         //attr->IncRef();
                         //m_data->m_mergeAttr.SetAttr(attr, row, col);
                     }
-                    else
-                    {
-                        // one or none is non null return it or null.
-                        if (attrrow)
-                            attr = attrrow;
-                        if (attrcol)
-                        {
-                            if (attr)
-                                attr->DecRef();
-                            attr = attrcol;
-                        }
-                        if (attrcell)
-                        {
-                            if (attr)
-                                attr->DecRef();
-                            attr = attrcell;
-                        }
-                    }
+                    //else: one or none is non null, attr is it or null.
                 }
                 break;
 
@@ -1441,11 +1734,21 @@ void wxGridCellAttrProvider::SetColAttr(wxGridCellAttr *attr, int col)
     m_data->m_colAttrs.SetAttr(attr, col);
 }
 
+void wxGridCellAttrProvider::SetAttrForBlock(wxGridCellAttr *attr,
+                                             const wxGridBlockCoords& block)
+{
+    if ( !m_data )
+        InitData();
+
+    m_data->m_blockAttrs.SetAttr(attr, block);
+}
+
 void wxGridCellAttrProvider::UpdateAttrRows( size_t pos, int numRows )
 {
     if ( m_data )
     {
         m_data->m_cellAttrs.UpdateAttrRows( pos, numRows );
+        m_data->m_blockAttrs.UpdateAttrRows( pos, numRows );
 
         m_data->m_rowAttrs.UpdateAttrRowsOrCols( pos, numRows );
     }
@@ -1456,6 +1759,7 @@ void wxGridCellAttrProvider::UpdateAttrCols( size_t pos, int numCols )
     if ( m_data )
     {
         m_data->m_cellAttrs.UpdateAttrCols( pos, numCols );
+        m_data->m_blockAttrs.UpdateAttrCols( pos, numCols );
 
         m_data->m_colAttrs.UpdateAttrRowsOrCols( pos, numCols );
     }
@@ -1767,6 +2071,23 @@ void wxGridTableBase::SetColAttr(wxGridCellAttr *attr, int col)
     }
 }
 
+void wxGridTableBase::SetAttrForBlock(wxGridCellAttr *attr,
+                                      const wxGridBlockCoords& block)
+{
+    if ( m_attrProvider )
+    {
+        if ( attr )
+            attr->SetKind(wxGridCellAttr::Cell);
+        m_attrProvider->SetAttrForBlock(attr, block);
+    }
+    else
+    {
+        // as we take ownership of the pointer and don't store it, we must
+        // free it now
+        wxSafeDecRef(attr);
+    }
+}
+
 bool wxGridTableBase::InsertRows( size_t WXUNUSED(pos),
                                   size_t WXUNUSED(numRows) )
 {
@@ -1856,6 +2177,13 @@ wxString wxGridTableBase::GetCornerLabelValue() const
     return wxString();
 }
 
+bool
+wxGridTableBase::GetValuesBlock( const wxGridBlockCoords& WXUNUSED(block),
+                                 std::vector<wxString>& WXUNUSED(values) )
+{
+    return false;
+}
+
 wxString wxGridTableBase::GetTypeName( int WXUNUSED(row), int WXUNUSED(col) )
 {
     return wxGRID_VALUE_STRING;
@@ -2402,11 +2730,21 @@ void wxGridWindow::OnPaint( wxPaintEvent &WXUNUSED(event) )
     wxRegion reg = GetUpdateRegion();
 
     wxGridCellCoordsVector dirtyCells = m_owner->CalcCellsExposed( reg , this );
-    m_owner->DrawGridCellArea( dc, dirtyCells );
 
-    m_owner->DrawGridSpace( dc, this );
+    // Frozen windows are never scrolled in at least one direction and are
+    // typically small, so there is no need to use the cache for them.
+    if ( m_type == wxGridWindowNormal && m_owner->IsRenderCacheEnabled() )
+    {
+        DrawUsingRenderCache( dc, reg );
+    }
+    else
+    {
+        m_owner->DrawGridCellArea( dc, dirtyCells );
+
+        m_owner->DrawGridSpace( dc, this );
 
-    m_owner->DrawAllGridWindowLines( dc, reg, this );
+        m_owner->DrawAllGridWindowLines( dc, reg, this );
+    }
 
     m_owner->DrawOverlaySelection( dc, this );
 
@@ -2416,6 +2754,105 @@ void wxGridWindow::OnPaint( wxPaintEvent &WXUNUSED(event) )
     m_owner->DrawHighlight( dc, dirtyCells );
 }
 
+void wxGridWindow::DrawUsingRenderCache(wxDC& dc, const wxRegion& reg)
+{
+    const wxSize size = GetClientSize();
+    if ( size.x <= 0 || size.y <= 0 )
+        return;
+
+    const double scale = dc.GetContentScaleFactor();
+    const wxPoint origin = m_owner->CalcUnscrolledPosition(wxPoint(0, 0));
+
+    if ( !m_cacheBitmap.IsOk() ||
+            m_cacheBitmap.GetLogicalSize() != size ||
+                m_cacheBitmap.GetScaleFactor() != scale )
+    {
+        m_cacheBitmap.CreateWithLogicalSize(size, scale);
+        m_cacheBitmapOld = wxBitmap();
+        m_cacheValid.Clear();
+    }
+    else if ( origin != m_cacheOrigin && !m_cacheValid.IsEmpty() )
+    {
+        // Move the part of the cached contents which is still visible after
+        // scrolling to its new position.
+        if ( !m_cacheBitmapOld.IsOk() )
+            m_cacheBitmapOld.CreateWithLogicalSize(size, scale);
+
+        wxSwap(m_cacheBitmapOld, m_cacheBitmap);
+
+        wxMemoryDC dcCache(m_cacheBitmap);
+        dcCache.DrawBitmap(m_cacheBitmapOld, m_cacheOrigin - origin);
+    }
+
+    m_cacheOrigin = origin;
+    m_cacheValid.Intersect(wxRect(origin, size));
+
+    // Draw the parts which are not in the cache yet.
+    wxRegion regDraw(reg);
+    {
+        wxRegion regValid(m_cacheValid);
+        regValid.Offset(-origin.x, -origin.y);
+        regDraw.Subtract(regValid);
+    }
+
+    wxMemoryDC dcCache(m_cacheBitmap);
+    if ( !regDraw.IsEmpty() )
+    {
+        m_owner->PrepareDCFor(dcCache, this);
+        dcCache.SetDeviceClippingRegion(regDraw);
+
+        m_owner->DrawGridCellArea(dcCache,
+                                  m_owner->CalcCellsExposed(regDraw, this));
+        m_owner->DrawGridSpace(dcCache, this);
+        m_owner->DrawAllGridWindowLines(dcCache, regDraw, this);
+
+        dcCache.DestroyClippingRegion();
+        dcCache.SetDeviceOrigin(0, 0);
+
+        regDraw.Offset(origin.x, origin.y);
+        m_cacheValid.Union(regDraw);
+    }
+
+    // And copy everything from the cache to the window.
+    for ( wxRegionIterator it(reg); it; ++it )
+    {
+        const wxRect r = it.GetRect();
+        dc.Blit(dc.DeviceToLogicalX(r.x), dc.DeviceToLogicalY(r.y),
+                r.width, r.height, &dcCache, r.x, r.y);
+    }
+}
+
+void wxGridWindow::InvalidateRenderCache(const wxRect *rect)
+{
+    if ( m_cacheValid.IsEmpty() )
+        return;
+
+    if ( rect )
+    {
+        wxRect r(*rect);
+        r.Offset(m_owner->CalcUnscrolledPosition(wxPoint(0, 0)));
+        m_cacheValid.Subtract(r);
+    }
+    else
+    {
+        m_cacheValid.Clear();
+    }
+}
+
+void wxGridWindow::ResetRenderCache()
+{
+    m_cacheBitmap = wxBitmap();
+    m_cacheBitmapOld = wxBitmap();
+    m_cacheValid.Clear();
+}
+
+void wxGridWindow::Refresh(bool eraseb, const wxRect *rect)
+{
+    InvalidateRenderCache(rect);
+
+    wxGridSubwindow::Refresh(eraseb, rect);
+}
+
 void wxGrid::Render( wxDC& dc,
                      const wxPoint& position,
                      const wxSize& size,
@@ -2879,6 +3316,8 @@ wxGrid::~wxGrid()
     // half destroyed grid
     HideCellEditControl();
 
+    CancelAutoSizeRefinement();
+
     // Must do this or ~wxScrollHelper will pop the wrong event handler
     SetTargetWindow(this);
     ClearAttrCache();
@@ -3092,6 +3531,9 @@ wxGrid::SetTable(wxGridTableBase *table,
             // Don't hold on to attributes cached from the old table
             ClearAttrCache();
 
+            CancelAutoSizeRefinement();
+            ClearPrefetchedValues();
+
             m_table->SetView(nullptr);
             if( m_ownTable )
                 delete m_table;
@@ -3108,9 +3550,9 @@ wxGrid::SetTable(wxGridTableBase *table,
 
         // kill row and column size arrays
         m_colWidths.Empty();
-        m_colRights.Empty();
+        m_colPositions.Clear();
         m_rowHeights.Empty();
-        m_rowBottoms.Empty();
+        m_rowPositions.Clear();
     }
 
     if (table)
@@ -3210,6 +3652,7 @@ void wxGrid::Init()
     m_cellHighlightROPenWidth = 1;
     m_gridFrozenBorderColour = wxSystemSettings::SelectLightDark(*wxBLACK, *wxWHITE);
     m_gridFrozenBorderPenWidth = 2;
+    m_renderCacheEnabled = false;
 
     m_canDragRowMove = false;
     m_canDragColMove = false;
@@ -3265,6 +3708,10 @@ void wxGrid::Init()
     m_yScrollPixelsPerLine = GRID_SCROLL_LINE_Y;
 
     m_tabBehaviour = Tab_Stop;
+
+    m_autoSizeSamples = 0;
+    m_autoSizeRefine = false;
+    m_autoSizeTaskId = 0;
 }
 
 // ----------------------------------------------------------------------------
@@ -3281,35 +3728,23 @@ void wxGrid::Init()
 void wxGrid::InitRowHeights()
 {
     m_rowHeights.Empty();
-    m_rowBottoms.Empty();
 
     m_rowHeights.Alloc( m_numRows );
-    m_rowBottoms.Alloc( m_numRows );
 
     m_rowHeights.Add( m_defaultRowHeight, m_numRows );
 
-    for ( int i = 0; i < m_numRows; i++ )
-    {
-        int rowBottom = ( GetRowPos( i ) + 1 ) * m_defaultRowHeight;
-        m_rowBottoms.Add( rowBottom );
-    }
+    m_rowPositions.Init( m_rowHeights, m_rowAt );
 }
 
 void wxGrid::InitColWidths()
 {
     m_colWidths.Empty();
-    m_colRights.Empty();
 
     m_colWidths.Alloc( m_numCols );
-    m_colRights.Alloc( m_numCols );
 
     m_colWidths.Add( m_defaultColWidth, m_numCols );
 
-    for ( int i = 0; i < m_numCols; i++ )
-    {
-        int colRight = ( GetColPos( i ) + 1 ) * m_defaultColWidth;
-        m_colRights.Add( colRight );
-    }
+    m_colPositions.Init( m_colWidths, m_colAt );
 }
 
 int wxGrid::GetColWidth(int col) const
@@ -3323,16 +3758,18 @@ int wxGrid::GetColWidth(int col) const
 
 int wxGrid::GetColLeft(int col) const
 {
-    if ( m_colRights.IsEmpty() )
+    if ( m_colPositions.IsEmpty() )
         return GetColPos( col ) * m_defaultColWidth;
 
-    return m_colRights[col] - GetColWidth(col);
+    return m_colPositions.GetStart(m_colPositions.GetPos(col));
 }
 
 int wxGrid::GetColRight(int col) const
 {
-    return m_colRights.IsEmpty() ? (GetColPos( col ) + 1) * m_defaultColWidth
-                                 : m_colRights[col];
+    if ( m_colPositions.IsEmpty() )
+        return (GetColPos( col ) + 1) * m_defaultColWidth;
+
+    return m_colPositions.GetEnd(m_colPositions.GetPos(col));
 }
 
 int wxGrid::GetRowHeight(int row) const
@@ -3347,16 +3784,18 @@ int wxGrid::GetRowHeight(int row) const
 
 int wxGrid::GetRowTop(int row) const
 {
-    if ( m_rowBottoms.IsEmpty() )
+    if ( m_rowPositions.IsEmpty() )
         return GetRowPos( row ) * m_defaultRowHeight;
 
-    return m_rowBottoms[row] - GetRowHeight(row);
+    return m_rowPositions.GetStart(m_rowPositions.GetPos(row));
 }
 
 int wxGrid::GetRowBottom(int row) const
 {
-    return m_rowBottoms.IsEmpty() ? (GetRowPos( row ) + 1) * m_defaultRowHeight
-                                  : m_rowBottoms[row];
+    if ( m_rowPositions.IsEmpty() )
+        return (GetRowPos( row ) + 1) * m_defaultRowHeight;
+
+    return m_rowPositions.GetEnd(m_rowPositions.GetPos(row));
 }
 
 void wxGrid::CalcDimensions()
@@ -3484,6 +3923,12 @@ bool wxGrid::Redimension( const wxGridTableMessage& msg )
     // cell than stored in the cache after adding/removing rows/columns.
     ClearAttrCache();
 
+    // For the same reason, stop auto sizing the columns or rows in the
+    // background as we could be measuring wrong cells now and forget the
+    // prefetched cell values.
+    CancelAutoSizeRefinement();
+    ClearPrefetchedValues();
+
     // By the same reasoning, the editor should be dismissed if columns are
     // added or removed. And for consistency, it should IMHO always be
     // removed, not only if the cell "underneath" it actually changes.
@@ -3527,20 +3972,7 @@ bool wxGrid::Redimension( const wxGridTableMessage& msg )
             if ( !m_rowHeights.IsEmpty() )
             {
                 m_rowHeights.Insert( m_defaultRowHeight, pos, numRows );
-                m_rowBottoms.Insert( 0, pos, numRows );
-
-                int bottom = 0;
-                if ( pos > 0 )
-                    bottom = m_rowBottoms[GetRowAt( pos - 1 )];
-
-                int rowPos;
-                for ( rowPos = pos; rowPos < m_numRows; rowPos++ )
-                {
-                    i = GetRowAt( rowPos );
-
-                    bottom += GetRowHeight(i);
-                    m_rowBottoms[i] = bottom;
-                }
+                m_rowPositions.Init( m_rowHeights, m_rowAt );
             }
 
             UpdateCurrentCellOnRedim();
@@ -3581,20 +4013,7 @@ bool wxGrid::Redimension( const wxGridTableMessage& msg )
             if ( !m_rowHeights.IsEmpty() )
             {
                 m_rowHeights.Add( m_defaultRowHeight, numRows );
-                m_rowBottoms.Add( 0, numRows );
-
-                int bottom = 0;
-                if ( oldNumRows > 0 )
-                    bottom = m_rowBottoms[oldNumRows - 1];
-
-                int rowPos;
-                for ( rowPos = oldNumRows; rowPos < m_numRows; rowPos++ )
-                {
-                    i = GetRowAt( rowPos );
-
-                    bottom += GetRowHeight(i);
-                    m_rowBottoms[i] = bottom;
-                }
+                m_rowPositions.Init( m_rowHeights, m_rowAt );
             }
 
             UpdateCurrentCellOnRedim();
@@ -3634,17 +4053,7 @@ bool wxGrid::Redimension( const wxGridTableMessage& msg )
             if ( !m_rowHeights.IsEmpty() )
             {
                 m_rowHeights.RemoveAt( pos, numRows );
-                m_rowBottoms.RemoveAt( pos, numRows );
-
-                int h = 0;
-                int rowPos;
-                for ( rowPos = 0; rowPos < m_numRows; rowPos++ )
-                {
-                    i = GetRowAt( rowPos );
-
-                    h += GetRowHeight(i);
-                    m_rowBottoms[i] = h;
-                }
+                m_rowPositions.Init( m_rowHeights, m_rowAt );
             }
 
             UpdateCurrentCellOnRedim();
@@ -3706,20 +4115,7 @@ bool wxGrid::Redimension( const wxGridTableMessage& msg )
             if ( !m_colWidths.IsEmpty() )
             {
                 m_colWidths.Insert( m_defaultColWidth, pos, numCols );
-                m_colRights.Insert( 0, pos, numCols );
-
-                int right = 0;
-                if ( pos > 0 )
-                    right = m_colRights[GetColAt( pos - 1 )];
-
-                int colPos;
-                for ( colPos = pos; colPos < m_numCols; colPos++ )
-                {
-                    i = GetColAt( colPos );
-
-                    right += GetColWidth(i);
-                    m_colRights[i] = right;
-                }
+                m_colPositions.Init( m_colWidths, m_colAt );
             }
 
             // See comment for wxGRIDTABLE_NOTIFY_COLS_APPENDED case explaining
@@ -3765,20 +4161,7 @@ bool wxGrid::Redimension( const wxGridTableMessage& msg )
             if ( !m_colWidths.IsEmpty() )
             {
                 m_colWidths.Add( m_defaultColWidth, numCols );
-                m_colRights.Add( 0, numCols );
-
-                int right = 0;
-                if ( oldNumCols > 0 )
-                    right = m_colRights[GetColAt( oldNumCols - 1 )];
-
-                int colPos;
-                for ( colPos = oldNumCols; colPos < m_numCols; colPos++ )
-                {
-                    i = GetColAt( colPos );
-
-                    right += GetColWidth(i);
-                    m_colRights[i] = right;
-                }
+                m_colPositions.Init( m_colWidths, m_colAt );
             }
 
             // Notice that this must be called after updating m_colWidths above
@@ -3824,17 +4207,7 @@ bool wxGrid::Redimension( const wxGridTableMessage& msg )
             if ( !m_colWidths.IsEmpty() )
             {
                 m_colWidths.RemoveAt( pos, numCols );
-                m_colRights.RemoveAt( pos, numCols );
-
-                int w = 0;
-                int colPos;
-                for ( colPos = 0; colPos < m_numCols; colPos++ )
-                {
-                    i = GetColAt( colPos );
-
-                    w += GetColWidth(i);
-                    m_colRights[i] = w;
-                }
+                m_colPositions.Init( m_colWidths, m_colAt );
             }
 
             // See comment for wxGRIDTABLE_NOTIFY_COLS_APPENDED case explaining
@@ -5449,24 +5822,11 @@ void wxGrid::DoEndMoveRow(int pos)
 
 void wxGrid::RefreshAfterRowPosChange()
 {
-    // recalculate the row bottoms as the row positions have changed,
-    // unless we calculate them dynamically because all rows heights are the
-    // same and it's easy to do
+    // recalculate the row positions as the rows order has changed, unless
+    // we calculate them dynamically because all rows heights are the same and
+    // it's easy to do
     if ( !m_rowHeights.empty() )
-    {
-        int rowBottom = 0;
-        for ( int rowPos = 0; rowPos < m_numRows; rowPos++ )
-        {
-            int rowID = GetRowAt( rowPos );
-
-            // Ignore the currently hidden rows.
-            const int height = m_rowHeights[rowID];
-            if ( height > 0 )
-                rowBottom += height;
-
-            m_rowBottoms[rowID] = rowBottom;
-        }
-    }
+        m_rowPositions.Init( m_rowHeights, m_rowAt );
 
     // and make the changes visible
     RefreshArea(wxGA_Cells | wxGA_RowLabels);
@@ -5509,6 +5869,10 @@ int wxGrid::GetRowPos(int idx) const
     if ( m_rowAt.IsEmpty() )
         return idx;
 
+    // use the inverse mapping if we have it to avoid the linear search
+    if ( !m_rowPositions.IsEmpty() )
+        return m_rowPositions.GetPos(idx);
+
     int pos = m_rowAt.Index(idx);
     wxASSERT_MSG( pos != wxNOT_FOUND, "invalid row index" );
 
@@ -5550,24 +5914,11 @@ void wxGrid::DoEndMoveCol(int pos)
 
 void wxGrid::RefreshAfterColPosChange()
 {
-    // recalculate the column rights as the column positions have changed,
+    // recalculate the column positions as the columns order has changed,
     // unless we calculate them dynamically because all columns widths are the
     // same and it's easy to do
     if ( !m_colWidths.empty() )
-    {
-        int colRight = 0;
-        for ( int colPos = 0; colPos < m_numCols; colPos++ )
-        {
-            int colID = GetColAt( colPos );
-
-            // Ignore the currently hidden columns.
-            const int width = m_colWidths[colID];
-            if ( width > 0 )
-                colRight += width;
-
-            m_colRights[colID] = colRight;
-        }
-    }
+        m_colPositions.Init( m_colWidths, m_colAt );
 
     int areas = wxGA_Cells;
 
@@ -5613,6 +5964,10 @@ int wxGrid::GetColPos(int idx) const
     if ( m_colAt.IsEmpty() )
         return idx;
 
+    // use the inverse mapping if we have it to avoid the linear search
+    if ( !m_colPositions.IsEmpty() )
+        return m_colPositions.GetPos(idx);
+
     int pos = m_colAt.Index(idx);
     wxASSERT_MSG( pos != wxNOT_FOUND, "invalid column index" );
 
@@ -5978,6 +6333,22 @@ void wxGrid::Refresh(bool eraseb, const wxRect* rect)
     // EndBatch() will do all this on the last nested one anyway.
     if ( ShouldRefresh() )
     {
+        // Refreshing the grid refreshes its children too, but without
+        // calling their Refresh(), so invalidate the cache here.
+        if ( m_gridWin )
+        {
+            if ( rect )
+            {
+                wxRect rectGridWin(*rect);
+                rectGridWin.Offset(-m_gridWin->GetPosition());
+                m_gridWin->InvalidateRenderCache(&rectGridWin);
+            }
+            else
+            {
+                m_gridWin->InvalidateRenderCache();
+            }
+        }
+
         wxScrolledCanvas::Refresh(eraseb, rect);
 
         // Notice that this function expects the rectangle to be relative
@@ -6202,7 +6573,6 @@ void wxGrid::OnDPIChanged(wxDPIChangedEvent& event)
     // inside InitPixelFields() above).
     if ( !m_rowHeights.empty() )
     {
-        int total = 0;
         for ( unsigned i = 0; i < m_rowHeights.size(); ++i )
         {
             int height = m_rowHeights[i];
@@ -6211,12 +6581,10 @@ void wxGrid::OnDPIChanged(wxDPIChangedEvent& event)
             if ( height <= 0 )
                 continue;
 
-            height = event.ScaleY(height);
-            total += height;
-
-            m_rowHeights[i] = height;
-            m_rowBottoms[i] = total;
+            m_rowHeights[i] = event.ScaleY(height);
         }
+
+        m_rowPositions.Init( m_rowHeights, m_rowAt );
     }
 
     // Similarly for columns, except that here we need to update the native
@@ -6226,7 +6594,6 @@ void wxGrid::OnDPIChanged(wxDPIChangedEvent& event)
         colHeader = m_useNativeHeader ? GetGridColHeader() : nullptr;
     if ( !m_colWidths.empty() )
     {
-        int total = 0;
         for ( unsigned i = 0; i < m_colWidths.size(); ++i )
         {
             int width = m_colWidths[i];
@@ -6234,14 +6601,18 @@ void wxGrid::OnDPIChanged(wxDPIChangedEvent& event)
             if ( width <= 0 )
                 continue;
 
-            width = event.ScaleX(width);
-            total += width;
+            m_colWidths[i] = event.ScaleX(width);
+        }
 
-            m_colWidths[i] = width;
-            m_colRights[i] = total;
+        m_colPositions.Init( m_colWidths, m_colAt );
 
-            if ( colHeader )
-                colHeader->UpdateColumn(i);
+        if ( colHeader )
+        {
+            for ( unsigned i = 0; i < m_colWidths.size(); ++i )
+            {
+                if ( m_colWidths[i] > 0 )
+                    colHeader->UpdateColumn(i);
+            }
         }
     }
     else if ( colHeader )
@@ -6705,6 +7076,29 @@ void wxGrid::DrawGridCellArea( wxDC& dc, const wxGridCellCoordsVector& cells )
         return;
 
     int i, numCells = cells.size();
+    if ( !numCells )
+        return;
+
+    // Get the values of all the cells we're going to draw at once: this is
+    // much faster than getting them one by one for some virtual tables. Only
+    // do it if the cells mostly fill their bounding block, as it should
+    // normally be the case, to avoid fetching the values of many cells that
+    // we don't need.
+    int top = m_numRows, left = m_numCols, bottom = -1, right = -1;
+    for ( const auto& cell : cells )
+    {
+        top = wxMin(top, cell.GetRow());
+        left = wxMin(left, cell.GetCol());
+        bottom = wxMax(bottom, cell.GetRow());
+        right = wxMax(right, cell.GetCol());
+    }
+
+    const wxLongLong_t
+        blockSize = static_cast<wxLongLong_t>(bottom - top + 1)*(right - left + 1);
+    if ( blockSize <= 2*numCells )
+        PrefetchValues(wxGridBlockCoords(top, left, bottom, right));
+
+    wxON_BLOCK_EXIT_THIS0(wxGrid::ClearPrefetchedValues);
     wxGridCellCoordsVector redrawCells;
 
     for ( i = numCells - 1; i >= 0; i-- )
@@ -6816,10 +7210,43 @@ void wxGrid::DrawGridCellArea( wxDC& dc, const wxGridCellCoordsVector& cells )
 
     numCells = redrawCells.size();
 
-    for ( i = numCells - 1; i >= 0; i-- )
+    for ( i = numCells - 1; i >= 0; i-- )
+    {
+        DrawCell( dc, redrawCells[i] );
+    }
+}
+
+void wxGrid::PrefetchValues(const wxGridBlockCoords& block)
+{
+    ClearPrefetchedValues();
+
+    if ( !m_table )
+        return;
+
+    if ( !m_table->GetValuesBlock(block, m_prefetchedValues) )
+    {
+        m_prefetchedValues.clear();
+        return;
+    }
+
+    const size_t
+        numCells = static_cast<size_t>(block.GetBottomRow() - block.GetTopRow() + 1)
+                    * (block.GetRightCol() - block.GetLeftCol() + 1);
+    if ( m_prefetchedValues.size() != numCells )
     {
-        DrawCell( dc, redrawCells[i] );
+        wxFAIL_MSG( "wrong number of values returned by GetValuesBlock()" );
+
+        m_prefetchedValues.clear();
+        return;
     }
+
+    m_prefetchedBlock = block;
+}
+
+void wxGrid::ClearPrefetchedValues()
+{
+    m_prefetchedValues.clear();
+    m_prefetchedBlock = wxGridBlockCoords();
 }
 
 void wxGrid::DrawGridSpace( wxDC& dc, wxGridWindow *gridWindow )
@@ -8324,9 +8751,8 @@ wxGridCellCoords wxGrid::XYToCell(int x, int y, wxGridWindow *gridWindow) const
 }
 
 // compute row or column from some (unscrolled) coordinate value, using either
-// m_defaultRowHeight/m_defaultColWidth or binary search on array of
-// m_rowBottoms/m_colRights to do it quickly in O(log n) time.
-// NOTE: This may not work correctly for reordered columns.
+// m_defaultRowHeight/m_defaultColWidth or m_rowPositions/m_colPositions to do
+// it quickly in O(log n) time.
 int wxGrid::PosToLinePos(int coord,
                          bool clipToMinMax,
                          const wxGridOperations& oper,
@@ -8345,8 +8771,8 @@ int wxGrid::PosToLinePos(int coord,
 
     // check for the simplest case: if we have no explicit line sizes
     // configured, then we already know the line this position falls in
-    const wxArrayInt& lineEnds = oper.GetLineEnds(this);
-    if ( lineEnds.empty() )
+    const wxGridLinePositions& linePositions = oper.GetLinePositions(this);
+    if ( linePositions.IsEmpty() )
     {
         if ( maxPos < (numLines + minPos) )
             return maxPos;
@@ -8354,45 +8780,21 @@ int wxGrid::PosToLinePos(int coord,
         return clipToMinMax ? numLines + minPos - 1 : -1;
     }
 
-    // binary search is quite efficient and we can't really make any assumptions
-    // on where to start here since row and columns could be of size 0 if they are
-    // hidden. While this could be made more efficient, some profiling will be
-    // necessary to determine if it really is a performance bottleneck
     maxPos = numLines + minPos - 1;
+    if ( maxPos < 0 )
+        return wxNOT_FOUND;
 
-    // check if the position is beyond the last column
-    const int lineAtMaxPos = oper.GetLineAt(this, maxPos);
-    if ( coord >= lineEnds[lineAtMaxPos] )
+    // check if the position is beyond the last line
+    if ( coord >= linePositions.GetEnd(maxPos) )
         return clipToMinMax ? maxPos : wxNOT_FOUND;
 
     // or before the first one
-    const int lineAt0 = oper.GetLineAt(this, minPos);
-    if ( coord < oper.GetLineStartPos(this, lineAt0) )
+    if ( coord < linePositions.GetStart(minPos) )
         return clipToMinMax ? minPos : wxNOT_FOUND;
-    else if ( coord < lineEnds[lineAt0] )
-        return minPos;
-
-    // finally do perform the binary search
-    while ( minPos < maxPos )
-    {
-        wxCHECK_MSG( lineEnds[oper.GetLineAt(this, minPos)] <= coord &&
-                        coord < lineEnds[oper.GetLineAt(this, maxPos)],
-                     -1,
-                     "wxGrid: internal error in PosToLinePos()" );
-
-        if ( coord >= lineEnds[oper.GetLineAt(this, maxPos - 1)] )
-            return maxPos;
-        else
-            maxPos--;
-
-        const int median = minPos + (maxPos - minPos + 1) / 2;
-        if ( coord < lineEnds[oper.GetLineAt(this, median)] )
-            maxPos = median;
-        else
-            minPos = median;
-    }
 
-    return maxPos;
+    // otherwise find the line containing this position in the tree, which
+    // correctly skips the hidden lines of 0 size
+    return linePositions.FindPos(coord);
 }
 
 int
@@ -9677,6 +10079,17 @@ void wxGrid::EnableGridLines( bool enable )
     }
 }
 
+void wxGrid::EnableRenderCache(bool enable)
+{
+    if ( enable == m_renderCacheEnabled )
+        return;
+
+    m_renderCacheEnabled = enable;
+
+    if ( !enable && m_gridWin )
+        m_gridWin->ResetRenderCache();
+}
+
 void wxGrid::DoClipGridLines(bool& var, bool clip)
 {
     if ( clip != var )
@@ -10109,6 +10522,20 @@ void wxGrid::SetColAttr(int col, wxGridCellAttr *attr)
     }
 }
 
+void wxGrid::SetAttrForBlock(const wxGridBlockCoords& block,
+                             wxGridCellAttr *attr)
+{
+    if ( CanHaveAttributes() )
+    {
+        m_table->SetAttrForBlock(attr, block);
+        ClearAttrCache();
+    }
+    else
+    {
+        wxSafeDecRef(attr);
+    }
+}
+
 void wxGrid::SetCellBackgroundColour( int row, int col, const wxColour& colour )
 {
     if ( CanHaveAttributes() )
@@ -10350,7 +10777,7 @@ void wxGrid::SetDefaultRowSize( int height, bool resizeExistingRows )
         // arrays (which also allows us to take advantage of
         // some speed optimisations)
         m_rowHeights.Empty();
-        m_rowBottoms.Empty();
+        m_rowPositions.Clear();
         CalcDimensions();
     }
 }
@@ -10452,10 +10879,7 @@ void wxGrid::DoSetRowSize( int row, int height )
         return;
 
 
-    for ( int rowPos = GetRowPos(row); rowPos < m_numRows; rowPos++ )
-    {
-        m_rowBottoms[GetRowAt(rowPos)] += diff;
-    }
+    m_rowPositions.Add(m_rowPositions.GetPos(row), diff);
 
     InvalidateBestSize();
 
@@ -10519,7 +10943,7 @@ void wxGrid::SetDefaultColSize( int width, bool resizeExistingCols )
         // arrays (which also allows us to take advantage of
         // some speed optimisations)
         m_colWidths.Empty();
-        m_colRights.Empty();
+        m_colPositions.Clear();
 
         CalcDimensions();
     }
@@ -10600,10 +11024,7 @@ void wxGrid::DoSetColSize( int col, int width )
     }
     //else: will be refreshed when the header is redrawn
 
-    for ( int colPos = GetColPos(col); colPos < m_numCols; colPos++ )
-    {
-        m_colRights[GetColAt(colPos)] += diff;
-    }
+    m_colPositions.Add(m_colPositions.GetPos(col), diff);
 
     InvalidateBestSize();
 
@@ -10732,30 +11153,19 @@ void wxGrid::SetNativeHeaderColOrder()
 // auto sizing
 // ----------------------------------------------------------------------------
 
-void
-wxGrid::AutoSizeColOrRow(int colOrRow, bool setAsMin, wxGridDirection direction)
+wxCoord
+wxGrid::GetBestCellsExtent(int colOrRow,
+                           wxGridDirection direction,
+                           wxDC& dc,
+                           int first,
+                           int last,
+                           const std::vector<int>* lines,
+                           bool* exact)
 {
     const bool column = direction == wxGRID_COLUMN;
 
-    // We don't support auto-sizing hidden rows or columns, this doesn't seem
-    // to make much sense.
-    if ( column )
-    {
-        if ( GetColWidth(colOrRow) == 0 )
-            return;
-    }
-    else
-    {
-        if ( GetRowHeight(colOrRow) == 0 )
-            return;
-    }
-
-    // We need to create wxClientDC here, and not wxInfoDC, as we have to pass
-    // a wxDC, and not just wxReadOnlyDC, to the virtual functions of
-    // wxGridCellRenderer that we call below.
-    wxClientDC dc(m_gridWin);
-
-    AcceptCellEditControlIfShown();
+    if ( exact )
+        *exact = false;
 
     // initialize both of them just to avoid compiler warnings even if only
     // really needs to be initialized here
@@ -10781,9 +11191,10 @@ wxGrid::AutoSizeColOrRow(int colOrRow, bool setAsMin, wxGridDirection direction)
     wxGridCellRendererPtr renderer;
 
     wxCoord extent, extentMax = 0;
-    int max = column ? m_numRows : m_numCols;
-    for ( int rowOrCol = 0; rowOrCol < max; rowOrCol++ )
+    for ( int n = first; n < last; n++ )
     {
+        const int rowOrCol = lines ? (*lines)[n] : n;
+
         if ( column )
         {
             if ( !IsRowShown(rowOrCol) )
@@ -10831,10 +11242,11 @@ wxGrid::AutoSizeColOrRow(int colOrRow, bool setAsMin, wxGridDirection direction)
 
                 if ( extent != wxDefaultCoord )
                 {
-                    extentMax = extent;
+                    if ( exact )
+                        *exact = true;
 
                     // No need to check all the values.
-                    break;
+                    return extent;
                 }
             }
         }
@@ -10864,6 +11276,99 @@ wxGrid::AutoSizeColOrRow(int colOrRow, bool setAsMin, wxGridDirection direction)
         }
     }
 
+    return extentMax;
+}
+
+std::vector<int> wxGrid::GetAutoSizeSamples(wxGridDirection direction) const
+{
+    const bool column = direction == wxGRID_COLUMN;
+    const int numLines = column ? m_numRows : m_numCols;
+    const int numFrozen = column ? m_numFrozenRows : m_numFrozenCols;
+
+    std::vector<int> lines;
+    lines.reserve(m_autoSizeSamples + 100);
+
+    // Always measure the cells which are currently visible, including those
+    // in the frozen area, as it would look bad if they didn't fit.
+    for ( int pos = 0; pos < numFrozen; pos++ )
+        lines.push_back(column ? GetRowAt(pos) : GetColAt(pos));
+
+    const wxPoint
+        topLeft = CalcGridWindowUnscrolledPosition(wxPoint(0, 0), m_gridWin);
+    const wxSize size = m_gridWin->GetClientSize();
+
+    const int posFirst = column ? YToPos(topLeft.y, m_gridWin)
+                                : XToPos(topLeft.x, m_gridWin);
+    const int posLast = column ? YToPos(topLeft.y + size.y, m_gridWin)
+                               : XToPos(topLeft.x + size.x, m_gridWin);
+    if ( posFirst != wxNOT_FOUND && posLast != wxNOT_FOUND )
+    {
+        for ( int pos = posFirst; pos <= posLast; pos++ )
+            lines.push_back(column ? GetRowAt(pos) : GetColAt(pos));
+    }
+
+    // And sample the other ones evenly.
+    for ( int n = 0; n < m_autoSizeSamples; n++ )
+    {
+        lines.push_back(static_cast<int>(
+            static_cast<wxLongLong_t>(n) * numLines / m_autoSizeSamples));
+    }
+
+    std::sort(lines.begin(), lines.end());
+    lines.erase(std::unique(lines.begin(), lines.end()), lines.end());
+
+    return lines;
+}
+
+void
+wxGrid::AutoSizeColOrRow(int colOrRow, bool setAsMin, wxGridDirection direction)
+{
+    const bool column = direction == wxGRID_COLUMN;
+
+    // We don't support auto-sizing hidden rows or columns, this doesn't seem
+    // to make much sense.
+    if ( column )
+    {
+        if ( GetColWidth(colOrRow) == 0 )
+            return;
+    }
+    else
+    {
+        if ( GetRowHeight(colOrRow) == 0 )
+            return;
+    }
+
+    // We need to create wxClientDC here, and not wxInfoDC, as we have to pass
+    // a wxDC, and not just wxReadOnlyDC, to the virtual functions of
+    // wxGridCellRenderer that we call below.
+    wxClientDC dc(m_gridWin);
+
+    AcceptCellEditControlIfShown();
+
+    m_textExtentCache.Start();
+    wxON_BLOCK_EXIT_OBJ0(m_textExtentCache, wxGridTextExtentCache::Stop);
+
+    // Measuring all cells may take a long time for big grids, so measure just
+    // a sample of them if requested.
+    const int numLines = column ? m_numRows : m_numCols;
+    bool sampled = false;
+
+    wxCoord extentMax;
+    if ( m_autoSizeSamples > 0 && numLines > m_autoSizeSamples )
+    {
+        const std::vector<int> lines = GetAutoSizeSamples(direction);
+
+        bool exact;
+        extentMax = GetBestCellsExtent(colOrRow, direction, dc,
+                                       0, static_cast<int>(lines.size()),
+                                       &lines, &exact);
+        sampled = !exact;
+    }
+    else
+    {
+        extentMax = GetBestCellsExtent(colOrRow, direction, dc, 0, numLines);
+    }
+
     // now also compare with the column label extent
     wxCoord extentLabel;
     dc.SetFont( GetLabelFont() );
@@ -10983,6 +11488,10 @@ wxGrid::AutoSizeColOrRow(int colOrRow, bool setAsMin, wxGridDirection direction)
         else
             SetRowMinimalHeight(colOrRow, extentMax);
     }
+
+    // Measure the rest of the cells later if we didn't do it now.
+    if ( sampled && m_autoSizeRefine )
+        ScheduleAutoSizeRefinement(colOrRow, direction, setAsMin);
 }
 
 wxCoord wxGrid::CalcColOrRowLabelAreaMinSize(wxGridDirection direction)
@@ -11042,6 +11551,11 @@ void wxGrid::AutoSizeColumns(bool setAsMin)
 {
     wxGridUpdateLocker locker(this);
 
+    // Keep the cached text extents for all columns, as the same strings may
+    // occur in several of them.
+    m_textExtentCache.Start();
+    wxON_BLOCK_EXIT_OBJ0(m_textExtentCache, wxGridTextExtentCache::Stop);
+
     for ( int col = 0; col < m_numCols; col++ )
         AutoSizeColumn(col, setAsMin);
 }
@@ -11050,10 +11564,157 @@ void wxGrid::AutoSizeRows(bool setAsMin)
 {
     wxGridUpdateLocker locker(this);
 
+    m_textExtentCache.Start();
+    wxON_BLOCK_EXIT_OBJ0(m_textExtentCache, wxGridTextExtentCache::Stop);
+
     for ( int row = 0; row < m_numRows; row++ )
         AutoSizeRow(row, setAsMin);
 }
 
+void wxGrid::SetAutoSizeSampling(int numSamples, bool refineInIdleTime)
+{
+    wxCHECK_RET( numSamples >= 0, "invalid number of samples" );
+
+    m_autoSizeSamples = numSamples;
+    m_autoSizeRefine = refineInIdleTime;
+
+    if ( !numSamples || !refineInIdleTime )
+        CancelAutoSizeRefinement();
+}
+
+void wxGrid::ScheduleAutoSizeRefinement(int colOrRow,
+                                        wxGridDirection direction,
+                                        bool setAsMin)
+{
+    AutoSizeRefinement refinement;
+    refinement.colOrRow = colOrRow;
+    refinement.direction = direction;
+    refinement.setAsMin = setAsMin;
+    refinement.next = 0;
+    refinement.size = direction == wxGRID_COLUMN ? GetColWidth(colOrRow)
+                                                 : GetRowHeight(colOrRow);
+
+    // If this column or row is already being refined, just restart it.
+    bool found = false;
+    for ( auto& r : m_autoSizeRefinements )
+    {
+        if ( r.colOrRow == colOrRow && r.direction == direction )
+        {
+            r = refinement;
+            found = true;
+            break;
+        }
+    }
+
+    if ( !found )
+        m_autoSizeRefinements.push_back(refinement);
+
+    if ( !m_autoSizeTaskId )
+    {
+        // Keep the cached text extents until we're done.
+        m_textExtentCache.Start();
+
+        // Use lower than default priority as this is less important than
+        // anything else that could be happening in idle time.
+        m_autoSizeTaskId = wxIdleTaskScheduler::Get().AddTask
+            (
+                [this]()
+                {
+                    if ( DoRefineAutoSize() )
+                        return wxIDLE_TASK_MORE;
+
+                    // Check that we hadn't been cancelled in the meanwhile.
+                    if ( m_autoSizeTaskId )
+                    {
+                        m_autoSizeTaskId = 0;
+                        m_textExtentCache.Stop();
+                    }
+
+                    return wxIDLE_TASK_DONE;
+                },
+                -1
+            );
+    }
+}
+
+void wxGrid::CancelAutoSizeRefinement()
+{
+    m_autoSizeRefinements.clear();
+
+    if ( m_autoSizeTaskId )
+    {
+        wxIdleTaskScheduler::Get().RemoveTask(m_autoSizeTaskId);
+        m_autoSizeTaskId = 0;
+        m_textExtentCache.Stop();
+    }
+}
+
+bool wxGrid::DoRefineAutoSize()
+{
+    // The number of cells to measure at once: this should be small enough to
+    // allow the idle task scheduler to keep the UI responsive.
+    static const int CHUNK_SIZE = 200;
+
+    if ( m_autoSizeRefinements.empty() )
+        return false;
+
+    AutoSizeRefinement& r = m_autoSizeRefinements.front();
+
+    const bool column = r.direction == wxGRID_COLUMN;
+    const int numLines = column ? m_numRows : m_numCols;
+    const int size = column ? GetColWidth(r.colOrRow)
+                            : GetRowHeight(r.colOrRow);
+
+    // Stop if the size was changed by something else in the meanwhile, we
+    // don't want to override it.
+    if ( size != r.size || r.next >= numLines )
+    {
+        m_autoSizeRefinements.erase(m_autoSizeRefinements.begin());
+        return !m_autoSizeRefinements.empty();
+    }
+
+    const int last = wxMin(r.next + CHUNK_SIZE, numLines);
+
+    wxCoord extent;
+    {
+        wxClientDC dc(m_gridWin);
+        extent = GetBestCellsExtent(r.colOrRow, r.direction, dc, r.next, last);
+    }
+
+    r.next = last;
+
+    if ( extent )
+    {
+        // Use the same margin as AutoSizeColOrRow().
+        extent += FromDIP(column ? 10 : 6);
+
+        if ( extent > size )
+        {
+            r.size = extent;
+
+            const int colOrRow = r.colOrRow;
+            const bool setAsMin = r.setAsMin;
+
+            // Note that "r" may be invalidated by the calls below if they
+            // result in cancelling the refinement.
+            if ( column )
+            {
+                SetColSize(colOrRow, extent);
+                if ( setAsMin )
+                    SetColMinimalWidth(colOrRow, extent);
+            }
+            else
+            {
+                SetRowSize(colOrRow, extent);
+                if ( setAsMin )
+                    SetRowMinimalHeight(colOrRow, extent);
+            }
+        }
+    }
+
+    return !m_autoSizeRefinements.empty();
+}
+
 void wxGrid::AutoSize()
 {
     wxGridUpdateLocker locker(this);
@@ -11146,6 +11807,9 @@ void wxGrid::SetCellValue( int row, int col, const wxString& s )
 
     if ( m_table )
     {
+        // The prefetched values, if any, are not valid any longer.
+        ClearPrefetchedValues();
+
         m_table->SetValue( row, col, s );
         if ( ShouldRefresh() )
         {
@@ -11510,10 +12174,23 @@ bool wxGrid::CopySelection()
         return false;
     }
 
+    // Get the values from the table in blocks of rows, this is much faster
+    // for the tables supporting it than getting them one by one.
+    static const int PREFETCH_ROWS = 1000;
+    wxON_BLOCK_EXIT_THIS0(wxGrid::ClearPrefetchedValues);
+
     bool firstRow = true;
     wxString buf;
     for (int row = sel.GetTopRow(); row <= sel.GetBottomRow(); row++)
     {
+        if ( (row - sel.GetTopRow()) % PREFETCH_ROWS == 0 )
+        {
+            PrefetchValues(wxGridBlockCoords(row, sel.GetLeftCol(),
+                                             wxMin(row + PREFETCH_ROWS - 1,
+                                                   sel.GetBottomRow()),
+                                             sel.GetRightCol()));
+        }
+
         if (firstRow)
             firstRow = false;
         else
@@ -11964,6 +12641,164 @@ int wxGridSizesInfo::GetSize(unsigned pos) const
     return it->second;
 }
 
+// ----------------------------------------------------------------------------
+// wxGridLinePositions
+// ----------------------------------------------------------------------------
+
+void wxGridLinePositions::Clear()
+{
+    m_tree.clear();
+    m_posOf.clear();
+    m_topBit = 0;
+}
+
+void wxGridLinePositions::Init(const wxArrayInt& sizes, const wxArrayInt& lineAt)
+{
+    const int count = static_cast<int>(sizes.size());
+
+    wxASSERT_MSG( lineAt.empty() || static_cast<int>(lineAt.size()) == count,
+                  "line order array size mismatch" );
+
+    m_tree.assign(count + 1, 0);
+
+    if ( lineAt.empty() )
+    {
+        m_posOf.clear();
+    }
+    else
+    {
+        m_posOf.assign(count, 0);
+        for ( int pos = 0; pos < count; pos++ )
+            m_posOf[lineAt[pos]] = pos;
+    }
+
+    // Build the tree in linear time: first store the sizes themselves and
+    // then propagate each partial sum to its parent.
+    for ( int pos = 0; pos < count; pos++ )
+    {
+        // Hidden lines have negative size but don't take any space.
+        const int size = sizes[lineAt.empty() ? pos : lineAt[pos]];
+        m_tree[pos + 1] = size > 0 ? size : 0;
+    }
+
+    for ( int i = 1; i <= count; i++ )
+    {
+        const int parent = i + (i & -i);
+        if ( parent <= count )
+            m_tree[parent] += m_tree[i];
+    }
+
+    m_topBit = 1;
+    while ( 2*m_topBit <= count )
+        m_topBit *= 2;
+}
+
+void wxGridLinePositions::Add(int pos, int diff)
+{
+    const int count = GetCount();
+
+    wxCHECK_RET( pos >= 0 && pos < count, "invalid line position" );
+
+    for ( int i = pos + 1; i <= count; i += i & -i )
+        m_tree[i] += diff;
+}
+
+int wxGridLinePositions::GetEnd(int pos) const
+{
+    wxCHECK_MSG( pos >= 0 && pos < GetCount(), 0, "invalid line position" );
+
+    int end = 0;
+    for ( int i = pos + 1; i > 0; i -= i & -i )
+        end += m_tree[i];
+
+    return end;
+}
+
+int wxGridLinePositions::FindPos(int coord) const
+{
+    // Find the greatest number of lines whose total size doesn't exceed the
+    // given coordinate: this is the position of the line containing it, as
+    // all lines before it end before or at this coordinate. Note that hidden
+    // lines are skipped automatically because they don't change the sum.
+    const int count = GetCount();
+
+    int pos = 0;
+    for ( int step = m_topBit; step > 0; step /= 2 )
+    {
+        const int next = pos + step;
+        if ( next <= count && m_tree[next] <= coord )
+        {
+            pos = next;
+            coord -= m_tree[next];
+        }
+    }
+
+    return pos;
+}
+
+// ----------------------------------------------------------------------------
+// wxGridTextExtentCache
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Don't let the cache grow indefinitely when measuring huge grids with mostly
+// unique strings, it's not useful in this case anyhow.
+const size_t MAX_CACHED_FONTS = 8;
+const size_t MAX_CACHED_STRINGS = 100000;
+
+} // anonymous namespace
+
+void wxGridTextExtentCache::Stop()
+{
+    wxCHECK_RET( m_users > 0, "unbalanced wxGridTextExtentCache::Stop()" );
+
+    if ( !--m_users )
+        m_fonts.clear();
+}
+
+wxSize
+wxGridTextExtentCache::GetMultiLineTextExtent(const wxReadOnlyDC& dc,
+                                              const wxString& text)
+{
+    if ( !IsActive() )
+        return dc.GetMultiLineTextExtent(text);
+
+    const wxFont& font = dc.GetFont();
+
+    Extents* extents = nullptr;
+    for ( auto& fontExtents : m_fonts )
+    {
+        if ( fontExtents.first == font )
+        {
+            extents = &fontExtents.second;
+            break;
+        }
+    }
+
+    if ( !extents )
+    {
+        if ( m_fonts.size() == MAX_CACHED_FONTS )
+            m_fonts.erase(m_fonts.begin());
+
+        m_fonts.emplace_back(font, Extents());
+        extents = &m_fonts.back().second;
+    }
+
+    const auto it = extents->find(text);
+    if ( it != extents->end() )
+        return it->second;
+
+    if ( extents->size() == MAX_CACHED_STRINGS )
+        extents->clear();
+
+    const wxSize size = dc.GetMultiLineTextExtent(text);
+    extents->emplace(text, size);
+
+    return size;
+}
+
 // ----------------------------------------------------------------------------
 // drop target
 // ----------------------------------------------------------------------------
@@ -134,7 +134,7 @@ wxGridPrivate::TryGetValueAsDate(wxDateTime& result,
 
     }
 
-    const wxString text = table->GetValue(row, col);
+    const wxString text = grid.GetCellValue(row, col);
 
     wxString::const_iterator end;
 
@@ -214,7 +214,7 @@ wxSize wxGridCellDateRenderer::GetBestSize(wxGrid& grid,
                                            wxDC& dc,
                                            int row, int col)
 {
-    return DoGetBestSize(attr, dc, GetString(grid, row, col));
+    return DoGetBestSize(grid, attr, dc, GetString(grid, row, col));
 }
 
 wxSize wxGridCellDateRenderer::GetMaxBestSize(wxGrid& WXUNUSED(grid),
@@ -321,7 +321,7 @@ wxString wxGridCellEnumRenderer::GetString(const wxGrid& grid, int row, int col)
     }
     else
     {
-        text = table->GetValue(row, col);
+        text = grid.GetCellValue(row, col);
     }
 
 
@@ -353,7 +353,7 @@ wxSize wxGridCellEnumRenderer::GetBestSize(wxGrid& grid,
                                             wxDC& dc,
                                             int row, int col)
 {
-    return DoGetBestSize(attr, dc, GetString(grid, row, col));
+    return DoGetBestSize(grid, attr, dc, GetString(grid, row, col));
 }
 
 // ----------------------------------------------------------------------------
@@ -608,12 +608,21 @@ wxSize wxGridCellStringRenderer::DoGetBestSize(const wxGridCellAttr& attr,
     return dc.GetMultiLineTextExtent(text);
 }
 
+wxSize wxGridCellStringRenderer::DoGetBestSize(wxGrid& grid,
+                                               const wxGridCellAttr& attr,
+                                               wxReadOnlyDC& dc,
+                                               const wxString& text)
+{
+    dc.SetFont(attr.GetFont());
+    return grid.GetCellTextExtent(dc, text);
+}
+
 wxSize wxGridCellStringRenderer::GetBestSize(wxGrid& grid,
                                              wxGridCellAttr& attr,
                                              wxDC& dc,
                                              int row, int col)
 {
-    return DoGetBestSize(attr, dc, grid.GetCellValue(row, col));
+    return DoGetBestSize(grid, attr, dc, grid.GetCellValue(row, col));
 }
 
 void wxGridCellStringRenderer::Draw(wxGrid& grid,
@@ -730,7 +739,7 @@ wxString wxGridCellNumberRenderer::GetString(const wxGrid& grid, int row, int co
     }
     else
     {
-        text = table->GetValue(row, col);
+        text = grid.GetCellValue(row, col);
     }
 
     return text;
@@ -760,7 +769,7 @@ wxSize wxGridCellNumberRenderer::GetBestSize(wxGrid& grid,
                                              wxDC& dc,
                                              int row, int col)
 {
-    return DoGetBestSize(attr, dc, GetString(grid, row, col));
+    return DoGetBestSize(grid, attr, dc, GetString(grid, row, col));
 }
 
 wxSize wxGridCellNumberRenderer::GetMaxBestSize(wxGrid& WXUNUSED(grid),
@@ -819,7 +828,7 @@ wxString wxGridCellFloatRenderer::GetString(const wxGrid& grid, int row, int col
     }
     else
     {
-        text = table->GetValue(row, col);
+        text = grid.GetCellValue(row, col);
         hasDouble = wxNumberFormatter::FromString(text, &val);
     }
 
@@ -889,7 +898,7 @@ wxSize wxGridCellFloatRenderer::GetBestSize(wxGrid& grid,
                                             wxDC& dc,
                                             int row, int col)
 {
-    return DoGetBestSize(attr, dc, GetString(grid, row, col));
+    return DoGetBestSize(grid, attr, dc, GetString(grid, row, col));
 }
 
 void wxGridCellFloatRenderer::SetParameters(const wxString& params)
@@ -1027,7 +1036,7 @@ void wxGridCellBoolRenderer::Draw(wxGrid& grid,
     }
     else
     {
-        wxString cellval( grid.GetTable()->GetValue(row, col) );
+        wxString cellval( grid.GetCellValue(row, col) );
         value = wxGridCellBoolEditor::IsTrueValue(cellval);
     }
 
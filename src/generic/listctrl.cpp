@@ -1618,9 +1618,12 @@ void wxListMainWindow::SetReportView(bool inReportView)
 
 void wxListMainWindow::CacheLineData(size_t line)
 {
-    wxGenericListCtrl *listctrl = GetListCtrl();
+    FillLineData(GetDummyLine(), line);
+}
 
-    wxListLineData *ld = GetDummyLine();
+void wxListMainWindow::FillLineData(wxListLineData *ld, size_t line)
+{
+    wxGenericListCtrl *listctrl = GetListCtrl();
 
     size_t countCol = GetColumnCount();
     for ( size_t col = 0; col < countCol; col++ )
@@ -1637,6 +1640,72 @@ void wxListMainWindow::CacheLineData(size_t line)
     ld->SetAttr(listctrl->OnGetItemAttr(line));
 }
 
+void wxListMainWindow::CacheLinesData(size_t from, size_t to)
+{
+    // Don't let the cache grow too big even if the window is huge.
+    static const size_t MAX_CACHED_LINES = 1000;
+
+    if ( to - from >= MAX_CACHED_LINES )
+        to = from + MAX_CACHED_LINES - 1;
+
+    std::vector<std::unique_ptr<CachedLine>> linesCache(to - from + 1);
+    for ( size_t line = from; line <= to; line++ )
+    {
+        std::unique_ptr<CachedLine>& cached = linesCache[line - from];
+
+        if ( GetCachedLine(line) )
+        {
+            cached = std::move(m_linesCache[line - m_linesCacheFrom]);
+            continue;
+        }
+
+        cached.reset(new CachedLine(this));
+        FillLineData(&cached->data, line);
+
+        // Make a copy of the attribute to ensure it remains valid.
+        if ( wxItemAttr* const attr = cached->data.GetAttr() )
+        {
+            cached->attr.reset(new wxItemAttr(*attr));
+            cached->data.SetAttr(cached->attr.get());
+        }
+    }
+
+    m_linesCache.swap(linesCache);
+    m_linesCacheFrom = from;
+}
+
+wxListLineData *wxListMainWindow::GetCachedLine(size_t line)
+{
+    if ( line < m_linesCacheFrom || line - m_linesCacheFrom >= m_linesCache.size() )
+        return nullptr;
+
+    CachedLine* const cached = m_linesCache[line - m_linesCacheFrom].get();
+    if ( !cached )
+        return nullptr;
+
+    // The cached data is useless if the number of columns has changed.
+    if ( cached->data.m_items.size() != (size_t)GetColumnCount() )
+    {
+        ResetLinesCache();
+        return nullptr;
+    }
+
+    return &cached->data;
+}
+
+void wxListMainWindow::ResetLinesCache(size_t from, size_t to)
+{
+    if ( from > to )
+        wxSwap(from, to);
+
+    for ( size_t line = wxMax(from, m_linesCacheFrom);
+          line <= to && line - m_linesCacheFrom < m_linesCache.size();
+          line++ )
+    {
+        m_linesCache[line - m_linesCacheFrom].reset();
+    }
+}
+
 wxListLineData *wxListMainWindow::GetDummyLine() const
 {
     wxASSERT_MSG( !IsEmpty(), wxT("invalid line index") );
@@ -1695,11 +1764,138 @@ wxCoord wxListMainWindow::GetLineHeight() const
     return m_lineHeight;
 }
 
+wxCoord wxListMainWindow::GetLineHeight(size_t line) const
+{
+    // lines after the last item, which may be drawn when extending the rules
+    // and alternate colour, always have the default height
+    if ( !m_lineHeightCache || line >= GetItemCount() )
+        return GetLineHeight();
+
+    CacheLineHeights(line + 1);
+
+    int height = 0;
+    m_lineHeightCache->GetLineHeight(line, height);
+
+    return height;
+}
+
 wxCoord wxListMainWindow::GetLineY(size_t line) const
 {
     wxASSERT_MSG( InReportView(), wxT("only works in report mode") );
 
-    return LINE_SPACING + line * GetLineHeight();
+    if ( !m_lineHeightCache )
+        return LINE_SPACING + line * GetLineHeight();
+
+    const size_t count = wxMin(line, GetItemCount());
+
+    int y = 0;
+    if ( count )
+    {
+        CacheLineHeights(count);
+
+        int height = 0;
+        m_lineHeightCache->GetLineInfo(count - 1, y, height);
+        y += height;
+    }
+
+    return LINE_SPACING + y + (line - count) * GetLineHeight();
+}
+
+size_t wxListMainWindow::GetLineAt(int y) const
+{
+    wxASSERT_MSG( InReportView(), wxT("only works in report mode") );
+
+    if ( !m_lineHeightCache )
+        return y / GetLineHeight();
+
+    y -= LINE_SPACING;
+    if ( y < 0 )
+        return 0;
+
+    const size_t count = GetItemCount();
+    CacheLineHeights(count);
+
+    unsigned int line;
+    if ( m_lineHeightCache->GetLineAt(y, line) )
+        return line;
+
+    // the position is below the last item
+    return count + (y - GetLineY(count) + LINE_SPACING) / GetLineHeight();
+}
+
+void wxListMainWindow::CacheLineHeights(size_t count) const
+{
+    for ( ; m_lineHeightCacheCount < count; m_lineHeightCacheCount++ )
+    {
+        int height = GetListCtrl()->OnGetItemHeight(m_lineHeightCacheCount);
+        if ( height < 0 )
+            height = GetLineHeight();
+
+        m_lineHeightCache->Put(m_lineHeightCacheCount, height);
+    }
+}
+
+void wxListMainWindow::EnableVariableLineHeight(bool enable)
+{
+    if ( enable == HasVariableLineHeight() )
+        return;
+
+    if ( enable )
+        m_lineHeightCache.reset(new HeightCache());
+    else
+        m_lineHeightCache.reset();
+
+    m_lineHeightCacheCount = 0;
+
+    ResetVisibleLinesRange();
+    m_dirty = true;
+}
+
+void wxListMainWindow::InvalidateLineHeights(size_t from)
+{
+    if ( !m_lineHeightCache || from >= m_lineHeightCacheCount )
+        return;
+
+    m_lineHeightCache->Remove(from);
+    m_lineHeightCacheCount = from;
+
+    // the positions of all the following lines may have changed
+    ResetVisibleLinesRange();
+    m_dirty = true;
+}
+
+bool wxListMainWindow::UpdateLineHeights(size_t from, size_t to)
+{
+    if ( !m_lineHeightCache || from >= m_lineHeightCacheCount )
+        return false;
+
+    // the heights of the lines not cached yet will be retrieved when needed
+    to = wxMin(to, m_lineHeightCacheCount - 1);
+
+    bool changed = false;
+    for ( size_t line = from; line <= to; line++ )
+    {
+        int height = GetListCtrl()->OnGetItemHeight(line);
+        if ( height < 0 )
+            height = GetLineHeight();
+
+        int heightOld = 0;
+        m_lineHeightCache->GetLineHeight(line, heightOld);
+        if ( height != heightOld )
+        {
+            m_lineHeightCache->Put(line, height);
+            changed = true;
+        }
+    }
+
+    if ( changed )
+    {
+        // the positions of all the following lines have changed
+        ResetVisibleLinesRange();
+        m_dirty = true;
+    }
+
+    return changed;
 }
 
 wxRect wxListMainWindow::GetLineRect(size_t line) const
@@ -1711,7 +1907,7 @@ wxRect wxListMainWindow::GetLineRect(size_t line) const
     rect.x = HEADER_OFFSET_X;
     rect.y = GetLineY(line);
     rect.width = GetHeaderWidth();
-    rect.height = GetLineHeight();
+    rect.height = GetLineHeight(line);
 
     return rect;
 }
@@ -1738,7 +1934,7 @@ wxRect wxListMainWindow::GetLineLabelRect(size_t line) const
     rect.x = image_x + HEADER_OFFSET_X;
     rect.y = GetLineY(line);
     rect.width = GetColumnWidth(0) - image_x;
-    rect.height = GetLineHeight();
+    rect.height = GetLineHeight(line);
 
     return rect;
 }
@@ -1915,7 +2111,7 @@ void wxListMainWindow::RefreshLines( size_t lineFrom, size_t lineTo )
         rect.x = 0;
         rect.y = GetLineY(lineFrom);
         rect.width = GetClientSize().x;
-        rect.height = GetLineY(lineTo) - rect.y + GetLineHeight();
+        rect.height = GetLineY(lineTo) - rect.y + GetLineHeight(lineTo);
 
         GetListCtrl()->CalcScrolledPosition( rect.x, rect.y, &rect.x, &rect.y );
         RefreshRect( rect );
@@ -2026,8 +2222,6 @@ void wxListMainWindow::OnPaint( wxPaintEvent &WXUNUSED(event) )
 
     if ( InReportView() )
     {
-        int lineHeight = GetLineHeight();
-
         size_t visibleFrom, visibleTo;
         const size_t linesPerPage = (unsigned int) m_linesPerPage;
         GetVisibleLinesRange(&visibleFrom, &visibleTo);
@@ -2039,7 +2233,10 @@ void wxListMainWindow::OnPaint( wxPaintEvent &WXUNUSED(event) )
         if ( m_extendRulesAndAlternateColour )
         {
             colAlt = GetListCtrl()->GetAlternateRowColour();
-            visibleEnd = wxMax(linesPerPage, visibleTo);
+            if ( HasVariableLineHeight() )
+                visibleEnd = wxMax(GetLineAt(GetClientSize().y - dev_y), visibleTo);
+            else
+                visibleEnd = wxMax(linesPerPage, visibleTo);
         }
         else
         {
@@ -2060,6 +2257,10 @@ void wxListMainWindow::OnPaint( wxPaintEvent &WXUNUSED(event) )
             evCache.m_item.m_itemId =
             evCache.m_itemIndex = visibleTo;
             GetParent()->GetEventHandler()->ProcessEvent( evCache );
+
+            // and then retrieve the data of all the visible lines at once
+            if ( visibleFrom <= visibleTo )
+                CacheLinesData(visibleFrom, visibleTo);
         }
 
         for ( size_t line = visibleFrom; line <= visibleEnd; line++ )
@@ -2108,8 +2309,9 @@ void wxListMainWindow::OnPaint( wxPaintEvent &WXUNUSED(event) )
             {
                 dc.SetPen(pen);
                 dc.SetBrush( *wxTRANSPARENT_BRUSH );
-                dc.DrawLine(0 - dev_x, i * lineHeight,
-                            clientSize.x - dev_x, i * lineHeight);
+                const wxCoord y = GetLineY(i);
+                dc.DrawLine(0 - dev_x, y,
+                            clientSize.x - dev_x, y);
             }
 
             // Draw last horizontal rule
@@ -2117,8 +2319,9 @@ void wxListMainWindow::OnPaint( wxPaintEvent &WXUNUSED(event) )
             {
                 dc.SetPen( pen );
                 dc.SetBrush( *wxTRANSPARENT_BRUSH );
-                dc.DrawLine(0 - dev_x, (m_lineTo + 1) * lineHeight,
-                            clientSize.x - dev_x , (m_lineTo + 1) * lineHeight );
+                const wxCoord y = GetLineY(m_lineTo + 1);
+                dc.DrawLine(0 - dev_x, y,
+                            clientSize.x - dev_x , y );
             }
         }
 
@@ -2502,7 +2705,7 @@ void wxListMainWindow::OnMouse( wxMouseEvent &event )
 
     if ( InReportView() )
     {
-        current = y / GetLineHeight();
+        current = GetLineAt(y);
         if ( current < count )
             hitResult = HitTestLine(current, x, y);
     }
@@ -2817,7 +3020,13 @@ bool wxListMainWindow::ScrollList(int WXUNUSED(dx), int dy)
 
     int hLine = GetLineHeight();
 
-    GetListCtrl()->Scroll(-1, top + dy / hLine);
+    // notice that the scroll unit is the default line height, so the scroll
+    // position is not the same as the top line if the lines heights differ
+    const int pos = HasVariableLineHeight()
+                        ? GetListCtrl()->GetScrollPos(wxVERTICAL)
+                        : (int)top;
+
+    GetListCtrl()->Scroll(-1, pos + dy / hLine);
 
 #if defined(__WXMAC__) || defined(__WXUNIVERSAL__)
     // see comment in MoveToItem() for why we do this
@@ -3310,6 +3519,7 @@ void wxListMainWindow::SetImages( wxWithImages *images, const int which )
         m_small_images = images;
         m_small_spacing = width + 14;
         m_lineHeight = 0;  // ensure that the line height will be recalc'd
+        InvalidateLineHeights();
     }
 }
 
@@ -3746,6 +3956,9 @@ void wxListMainWindow::SetItemCount(long count)
     m_selStore.SetItemCount(count);
     m_countVirt = count;
 
+    ResetLinesCache();
+    InvalidateLineHeights(count);
+
     ResetVisibleLinesRange();
 
     // scrollbars must be reset
@@ -4010,8 +4223,9 @@ void wxListMainWindow::RecalculatePositions()
 
     if ( InReportView() )
     {
-        // all lines have the same height and we scroll one line per step
-        int entireHeight = count * lineHeight + LINE_SPACING;
+        // we scroll by the default line height per step, i.e. one line per
+        // step unless variable line height support is enabled
+        int entireHeight = GetLineY(count);
 
         m_linesPerPage = clientHeight / lineHeight;
 
@@ -4296,6 +4510,7 @@ void wxListMainWindow::DeleteItem( long lindex )
     {
         m_countVirt--;
         m_selStore.OnItemDelete(index);
+        ResetLinesCache();
     }
     else
     {
@@ -4305,6 +4520,8 @@ void wxListMainWindow::DeleteItem( long lindex )
         m_lines.erase(iter);
     }
 
+    InvalidateLineHeights(index);
+
     // we need to refresh the (vert) scrollbar as the number of items changed
     m_dirty = true;
 
@@ -4386,12 +4603,15 @@ void wxListMainWindow::DoDeleteAllItems()
     {
         m_countVirt = 0;
         m_selStore.Clear();
+        ResetLinesCache();
     }
     else
     {
         m_selCount = 0;
     }
 
+    InvalidateLineHeights();
+
     if ( InReportView() )
         ResetVisibleLinesRange();
 
@@ -4504,7 +4724,7 @@ long wxListMainWindow::HitTest( int x, int y, int &flags ) const
 
     if ( InReportView() )
     {
-        size_t current = y / GetLineHeight();
+        size_t current = GetLineAt(y);
         if ( current < count )
         {
             flags = HitTestLine(current, x, y);
@@ -4576,12 +4796,17 @@ void wxListMainWindow::InsertItem( wxListItem &item )
             m_small_images->GetImageLogicalSize(this, image, imageWidth, imageHeight);
 
             if ( imageHeight > m_lineHeight )
+            {
                 m_lineHeight = 0;
+                InvalidateLineHeights();
+            }
         }
     }
 
     m_lines.insert( m_lines.begin() + id, std::move(line) );
 
+    InvalidateLineHeights(id);
+
     m_dirty = true;
 
     // If an item is selected at or below the point of insertion, we need to
@@ -4699,6 +4924,8 @@ void wxListMainWindow::SortItems( wxListCtrlCompare fn, wxIntPtr data )
 
     std::sort(m_lines.begin(), m_lines.end(), wxListLineComparator(fn, data));
 
+    InvalidateLineHeights();
+
     m_dirty = true;
 }
 
@@ -4745,15 +4972,30 @@ void wxListMainWindow::GetVisibleLinesRange(size_t *from, size_t *to)
         size_t count = GetItemCount();
         if ( count )
         {
-            m_lineFrom = GetListCtrl()->GetScrollPos(wxVERTICAL);
+            if ( HasVariableLineHeight() )
+            {
+                // the scroll unit is the default line height, so we need to
+                // find the lines at the top and bottom of the window
+                const int y = GetListCtrl()->GetScrollPos(wxVERTICAL) *
+                                GetLineHeight();
+
+                m_lineFrom = GetLineAt(y);
+                m_lineTo = GetLineAt(y + GetClientSize().y);
+            }
+            else
+            {
+                m_lineFrom = GetListCtrl()->GetScrollPos(wxVERTICAL);
+
+                // we redraw one extra line but this is needed to make the
+                // redrawing logic work when there is a fractional number of
+                // lines on screen
+                m_lineTo = m_lineFrom + m_linesPerPage;
+            }
 
             // this may happen if SetScrollbars() hadn't been called yet
             if ( m_lineFrom >= count )
                 m_lineFrom = count - 1;
 
-            // we redraw one extra line but this is needed to make the redrawing
-            // logic work when there is a fractional number of lines on screen
-            m_lineTo = m_lineFrom + m_linesPerPage;
             if ( m_lineTo >= count )
                 m_lineTo = count - 1;
         }
@@ -5785,12 +6027,40 @@ void wxGenericListCtrl::SetItemCount(long count)
 
 void wxGenericListCtrl::RefreshItem(long item)
 {
-    m_mainWin->RefreshLine(item);
+    // The item data must have changed, so don't use the cached one any more.
+    m_mainWin->ResetLinesCache(item, item);
+
+    // If its height changed, all the following items moved too.
+    if ( m_mainWin->UpdateLineHeights(item, item) )
+        m_mainWin->RefreshAfter(item);
+    else
+        m_mainWin->RefreshLine(item);
 }
 
 void wxGenericListCtrl::RefreshItems(long itemFrom, long itemTo)
 {
-    m_mainWin->RefreshLines(itemFrom, itemTo);
+    m_mainWin->ResetLinesCache(itemFrom, itemTo);
+
+    if ( m_mainWin->UpdateLineHeights(wxMin(itemFrom, itemTo),
+                                      wxMax(itemFrom, itemTo)) )
+        m_mainWin->RefreshAfter(wxMin(itemFrom, itemTo));
+    else
+        m_mainWin->RefreshLines(itemFrom, itemTo);
+}
+
+void wxGenericListCtrl::EnableVariableLineHeight(bool enable)
+{
+    m_mainWin->EnableVariableLineHeight(enable);
+}
+
+bool wxGenericListCtrl::HasVariableLineHeight() const
+{
+    return m_mainWin->HasVariableLineHeight();
+}
+
+int wxGenericListCtrl::OnGetItemHeight(long WXUNUSED(item)) const
+{
+    return -1;
 }
 
 void wxGenericListCtrl::EnableBellOnNoMatch( bool on )
@@ -5806,6 +6076,11 @@ void wxGenericListCtrl::EnableBellOnNoMatch( bool on )
 //
 void wxGenericListCtrl::Refresh(bool eraseBackground, const wxRect *rect)
 {
+    // Refreshing is also commonly used for updating virtual controls after
+    // their data changes.
+    if ( m_mainWin )
+        m_mainWin->ResetLinesCache();
+
     if (!rect)
     {
         // The easy case, no rectangle specified.
@@ -23,6 +23,8 @@
 
 #include "wx/generic/private/rowheightcache.h"
 
+#include <algorithm>
+
 // ============================================================================
 // implementation
 // ============================================================================
@@ -189,27 +191,83 @@ unsigned int RowRanges::CountTo(unsigned int row) const
 // HeightCache
 // ----------------------------------------------------------------------------
 
-bool HeightCache::GetLineInfo(unsigned int row, int &start, int &height)
+int HeightCache::FindRun(unsigned int row) const
 {
-    int y = 0;
-    bool found = false;
+    // Find the first run starting after the row, the row can only be in the
+    // run preceding it.
+    auto it = std::upper_bound(m_runs.begin(), m_runs.end(), row,
+                               [](unsigned int r, const HeightRun& run)
+                               {
+                                   return r < run.from;
+                               });
+    if ( it == m_runs.begin() )
+        return -1;
+
+    --it;
+    if ( row >= it->to )
+        return -1;
+
+    return static_cast<int>(it - m_runs.begin());
+}
 
-    for ( const auto& kv : m_heightToRowRange )
+void HeightCache::UpdateStarts()
+{
+    for ( ; m_firstDirty < m_runs.size(); m_firstDirty++ )
     {
-        int rowHeight = kv.first;
-        const RowRanges& rowRanges = kv.second;
-        if (rowRanges.Has(row))
+        HeightRun& run = m_runs[m_firstDirty];
+        if ( m_firstDirty == 0 )
         {
-            height = rowHeight;
-            found = true;
+            run.start = 0;
+            run.countBefore = 0;
+        }
+        else
+        {
+            const HeightRun& prev = m_runs[m_firstDirty - 1];
+            run.start = prev.GetEnd();
+            run.countBefore = prev.countBefore + prev.to - prev.from;
         }
-        y += rowHeight * (rowRanges.CountTo(row));
     }
-    if (found)
+}
+
+void HeightCache::MergeRuns(size_t idx)
+{
+    if ( idx + 1 < m_runs.size() )
+    {
+        const HeightRun& next = m_runs[idx + 1];
+        if ( next.from == m_runs[idx].to && next.height == m_runs[idx].height )
+        {
+            m_runs[idx].to = next.to;
+            m_runs.erase(m_runs.begin() + idx + 1);
+        }
+    }
+
+    if ( idx > 0 )
     {
-        start = y;
+        HeightRun& prev = m_runs[idx - 1];
+        if ( prev.to == m_runs[idx].from && prev.height == m_runs[idx].height )
+        {
+            prev.to = m_runs[idx].to;
+            m_runs.erase(m_runs.begin() + idx);
+            idx--;
+        }
     }
-    return found;
+
+    if ( m_firstDirty > idx )
+        m_firstDirty = idx;
+}
+
+bool HeightCache::GetLineInfo(unsigned int row, int &start, int &height)
+{
+    const int idx = FindRun(row);
+    if ( idx == -1 )
+        return false;
+
+    UpdateStarts();
+
+    const HeightRun& run = m_runs[idx];
+    height = run.height;
+    start = run.start + static_cast<int>(row - run.from)*run.height;
+    return true;
 }
 
 bool HeightCache::GetLineStart(unsigned int row, int &start)
@@ -220,92 +278,148 @@ bool HeightCache::GetLineStart(unsigned int row, int &start)
 
 bool HeightCache::GetLineHeight(unsigned int row, int &height)
 {
-    for ( const auto& kv : m_heightToRowRange )
-    {
-        int rowHeight = kv.first;
-        const RowRanges& rowRanges = kv.second;
-        if (rowRanges.Has(row))
-        {
-            height = rowHeight;
-            return true;
-        }
-    }
-    return false;
+    const int idx = FindRun(row);
+    if ( idx == -1 )
+        return false;
+
+    height = m_runs[idx].height;
+    return true;
 }
 
 bool HeightCache::GetLineAt(int y, unsigned int &row)
 {
-    unsigned int total = 0;
+    if ( y < 0 || m_runs.empty() )
+        return false;
 
-    for ( const auto& kv : m_heightToRowRange )
+    UpdateStarts();
+
+    // Find the first run ending after the given position.
+    auto it = std::upper_bound(m_runs.begin(), m_runs.end(), y,
+                               [](int pos, const HeightRun& run)
+                               {
+                                   return pos < run.GetEnd();
+                               });
+    if ( it == m_runs.end() )
     {
-        const RowRanges& rowRanges = kv.second;
-        total += rowRanges.CountAll();
+        // given y point is after the last row
+        return false;
     }
 
-    if (total == 0)
+    if ( it->countBefore != it->from )
     {
+        // the positions are not meaningful if the HeightCache has gaps, which
+        // is an invalid state
         return false;
     }
 
-    int lo = 0;
-    int hi = total;
-    int start, height;
-    while (lo < hi)
+    row = it->from + static_cast<unsigned int>((y - it->start) / it->height);
+    return true;
+}
+
+void HeightCache::Put(unsigned int row, int height)
+{
+    // Check for the most common case of adding the rows one after another
+    // first.
+    if ( m_runs.empty() || row >= m_runs.back().to )
     {
-        int mid = (lo + hi) / 2;
-        if (GetLineInfo(mid, start, height))
+        if ( !m_runs.empty() &&
+                m_runs.back().to == row && m_runs.back().height == height )
         {
-            if (start + height <= y)
-            {
-                lo = mid + 1;
-            }
-            else
-            {
-                hi = mid;
-            }
-        }
-        else
-        {
-            // should never happen, except the HeightCache has gaps which is an
-            // invalid state
-            return false;
+            // This doesn't change the start of any run.
+            m_runs.back().to++;
+            return;
         }
+
+        HeightRun run;
+        run.from = row;
+        run.to = row + 1;
+        run.height = height;
+        run.start = 0;
+        run.countBefore = 0;
+
+        m_runs.push_back(run);
+        return;
     }
-    if (GetLineInfo(lo, start, height))
+
+    size_t idx;
+    const int found = FindRun(row);
+    if ( found != -1 )
     {
-        if (y < start)
+        idx = static_cast<size_t>(found);
+
+        HeightRun& run = m_runs[idx];
+        if ( run.height == height )
+            return;
+
+        // Split the existing run to replace the height of this row only.
+        HeightRun before = run,
+                  after = run;
+        before.to = row;
+        after.from = row + 1;
+
+        run.from = row;
+        run.to = row + 1;
+        run.height = height;
+
+        if ( after.from < after.to )
+            m_runs.insert(m_runs.begin() + idx + 1, after);
+        if ( before.from < before.to )
         {
-            // given y point is before the first row
-            return false;
+            m_runs.insert(m_runs.begin() + idx, before);
+            idx++;
         }
-        row = lo;
-        return true;
     }
-    else
+    else // Insert a new run before the first one starting after this row.
     {
-        // given y point is after the last row
-        return false;
+        auto it = std::upper_bound(m_runs.begin(), m_runs.end(), row,
+                                   [](unsigned int r, const HeightRun& run)
+                                   {
+                                       return r < run.from;
+                                   });
+
+        HeightRun run;
+        run.from = row;
+        run.to = row + 1;
+        run.height = height;
+        run.start = 0;
+        run.countBefore = 0;
+
+        it = m_runs.insert(it, run);
+        idx = static_cast<size_t>(it - m_runs.begin());
     }
-}
 
-void HeightCache::Put(unsigned int row, int height)
-{
-    m_heightToRowRange[height].Add(row);
+    MergeRuns(idx);
 }
 
 void HeightCache::Remove(unsigned int row)
 {
-    for ( auto& kv : m_heightToRowRange )
+    // Find the first run ending after the row.
+    auto it = std::upper_bound(m_runs.begin(), m_runs.end(), row,
+                               [](unsigned int r, const HeightRun& run)
+                               {
+                                   return r < run.to;
+                               });
+    if ( it == m_runs.end() )
+        return;
+
+    if ( it->from < row )
     {
-        RowRanges& rowRanges = kv.second;
-        rowRanges.Remove(row);
+        // This run includes the row, so cut it off at the row index.
+        it->to = row;
+        ++it;
     }
+
+    m_runs.erase(it, m_runs.end());
+
+    // The starts of the remaining runs don't change.
+    if ( m_firstDirty > m_runs.size() )
+        m_firstDirty = m_runs.size();
 }
 
 void HeightCache::Clear()
 {
-    m_heightToRowRange.clear();
+    m_runs.clear();
+    m_firstDirty = 0;
 }
 
 HeightCache::~HeightCache()
@@ -385,6 +385,61 @@ wxSemaError wxSemaphoreInternal::Post()
     return wxSEMA_NO_ERROR;
 }
 
+// --------------------------------------------------------------------------
+// wxRWLock
+// --------------------------------------------------------------------------
+
+// a trivial wrapper around slim reader/writer lock which doesn't need to be
+// destroyed and never fails to be initialized
+class wxRWLockInternal
+{
+public:
+    wxRWLockInternal() { ::InitializeSRWLock(&m_lock); }
+
+    bool IsOk() const { return true; }
+
+    wxMutexError LockRead()
+    {
+        ::AcquireSRWLockShared(&m_lock);
+        return wxMUTEX_NO_ERROR;
+    }
+
+    wxMutexError TryLockRead()
+    {
+        return ::TryAcquireSRWLockShared(&m_lock) ? wxMUTEX_NO_ERROR
+                                                  : wxMUTEX_BUSY;
+    }
+
+    wxMutexError UnlockRead()
+    {
+        ::ReleaseSRWLockShared(&m_lock);
+        return wxMUTEX_NO_ERROR;
+    }
+
+    wxMutexError LockWrite()
+    {
+        ::AcquireSRWLockExclusive(&m_lock);
+        return wxMUTEX_NO_ERROR;
+    }
+
+    wxMutexError TryLockWrite()
+    {
+        return ::TryAcquireSRWLockExclusive(&m_lock) ? wxMUTEX_NO_ERROR
+                                                     : wxMUTEX_BUSY;
+    }
+
+    wxMutexError UnlockWrite()
+    {
+        ::ReleaseSRWLockExclusive(&m_lock);
+        return wxMUTEX_NO_ERROR;
+    }
+
+private:
+    SRWLOCK m_lock;
+
+    wxDECLARE_NO_COPY_CLASS(wxRWLockInternal);
+};
+
 // ----------------------------------------------------------------------------
 // wxThread implementation
 // ----------------------------------------------------------------------------
@@ -0,0 +1,529 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/unix/asyncfile_uring.cpp
+// Purpose:     io_uring-based wxAsyncFile backend
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// for compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+
+#if wxUSE_FILE && wxUSE_THREADS
+
+#include "wx/asyncfile.h"
+#include "wx/private/asyncfile.h"
+
+#ifdef wxHAS_ASYNC_FILE_IO_URING
+
+#ifndef WX_PRECOMP
+    #include "wx/log.h"
+    #include "wx/translation.h"
+#endif // WX_PRECOMP
+
+#include "wx/evtloopsrc.h"
+
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <deque>
+#include <unordered_map>
+
+using namespace wxPrivate;
+
+namespace
+{
+
+// ----------------------------------------------------------------------------
+// io_uring system calls, which don't have wrappers in libc
+// ----------------------------------------------------------------------------
+
+inline int wxIoUringSetup(unsigned entries, io_uring_params* params)
+{
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+inline int wxIoUringEnter(int ring, unsigned toSubmit, unsigned minComplete,
+                          unsigned flags)
+{
+    return static_cast<int>(syscall(__NR_io_uring_enter, ring, toSubmit,
+                                    minComplete, flags, nullptr, 0));
+}
+
+inline int wxIoUringRegister(int ring, unsigned opcode, void* arg,
+                             unsigned numArgs)
+{
+    return static_cast<int>(syscall(__NR_io_uring_register, ring, opcode,
+                                    arg, numArgs));
+}
+
+// ----------------------------------------------------------------------------
+// wxAsyncFileImplIoUring
+// ----------------------------------------------------------------------------
+
+class wxAsyncFileImplIoUring : public wxAsyncFileImpl,
+                               private wxEventLoopSourceHandler
+{
+public:
+    wxAsyncFileImplIoUring(wxAsyncFile& file, int fd)
+        : wxAsyncFileImpl(file, fd)
+    {
+        m_ring = -1;
+        m_eventfd = -1;
+        m_source = nullptr;
+
+        m_sqRing = MAP_FAILED;
+        m_cqRing = MAP_FAILED;
+        m_sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+        m_sqRingSize = 0;
+        m_cqRingSize = 0;
+        m_sqesSize = 0;
+    }
+
+    ~wxAsyncFileImplIoUring()
+    {
+        if ( m_source )
+        {
+            CancelAll();
+            WaitAll();
+
+            delete m_source;
+        }
+
+        if ( m_sqes != MAP_FAILED )
+            munmap(m_sqes, m_sqesSize);
+        if ( m_cqRing != MAP_FAILED && m_cqRing != m_sqRing )
+            munmap(m_cqRing, m_cqRingSize);
+        if ( m_sqRing != MAP_FAILED )
+            munmap(m_sqRing, m_sqRingSize);
+
+        if ( m_eventfd != -1 )
+            close(m_eventfd);
+        if ( m_ring != -1 )
+            close(m_ring);
+    }
+
+    // Create the ring and register it with the event loop, return false if
+    // io_uring can't be used.
+    bool Init();
+
+    wxAsyncFileBackend GetBackend() const override
+    {
+        return wxASYNC_FILE_BACKEND_IO_URING;
+    }
+
+    bool Cancel(long id) override;
+    void CancelAll() override;
+    void WaitAll() override;
+
+protected:
+    bool DoSubmit(const wxAsyncFileRequest& req) override;
+
+private:
+    // State of a submitted request.
+    struct Operation
+    {
+        wxAsyncFileRequest req;
+
+        // Number of bytes transferred so far.
+        size_t done;
+
+        // Set if cancelling this request was requested.
+        bool cancelled;
+    };
+
+    // Size of the submission queue and the maximal number of operations in
+    // flight: the completion queue is twice bigger, so there is always space
+    // for the completions of both the operations and their cancellations.
+    enum { QUEUE_SIZE = 64 };
+
+    // Don't try to transfer more than this in a single operation.
+    enum { MAX_CHUNK = 1 << 30 };
+
+    // Push the operation with the given parameters to the submission queue
+    // and submit it, return false and set errno on error.
+    bool PushSqe(unsigned char opcode, wxUint64 userData, wxUint64 addr,
+                 unsigned len, wxFileOffset offset);
+
+    // Submit the next chunk of the given operation.
+    bool SubmitChunk(long id, const Operation& op);
+
+    // Start the operations waiting for space in the submission queue.
+    void SubmitQueued();
+
+    // Process all the available completions.
+    void ReapCompletions();
+
+    // Called with the result of the given operation chunk.
+    void OnCompletion(long id, int res);
+
+    // wxEventLoopSourceHandler methods.
+    void OnReadWaiting() override;
+    void OnWriteWaiting() override { }
+    void OnExceptionWaiting() override { }
+
+    int m_ring;
+    int m_eventfd;
+    wxEventLoopSource* m_source;
+
+    // Memory mapped rings and the pointers into them.
+    void* m_sqRing;
+    void* m_cqRing;
+    io_uring_sqe* m_sqes;
+    size_t m_sqRingSize,
+           m_cqRingSize,
+           m_sqesSize;
+
+    unsigned* m_sqTail;
+    unsigned m_sqMask;
+    unsigned* m_sqArray;
+
+    unsigned* m_cqHead;
+    unsigned* m_cqTail;
+    unsigned m_cqMask;
+    io_uring_cqe* m_cqes;
+
+    // Operations submitted to the kernel, indexed by their request IDs.
+    std::unordered_map<long, Operation> m_inflight;
+
+    // Operations waiting until there is space in the submission queue.
+    std::deque<Operation> m_queued;
+};
+
+bool wxAsyncFileImplIoUring::Init()
+{
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+
+    m_ring = wxIoUringSetup(QUEUE_SIZE, &params);
+    if ( m_ring == -1 )
+    {
+        // This is expected with older kernels or when io_uring is disabled,
+        // so don't log any errors and just fall back on the other backend.
+        return false;
+    }
+
+    // IORING_OP_READ and IORING_OP_WRITE were added in the same kernel
+    // version as this feature, there is no need to use a more precise check.
+    if ( !(params.features & IORING_FEAT_RW_CUR_POS) )
+        return false;
+
+    m_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    m_cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+    const bool singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if ( singleMmap )
+        m_sqRingSize = m_cqRingSize = wxMax(m_sqRingSize, m_cqRingSize);
+
+    m_sqRing = mmap(nullptr, m_sqRingSize, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, m_ring, IORING_OFF_SQ_RING);
+    if ( m_sqRing == MAP_FAILED )
+        return false;
+
+    if ( singleMmap )
+    {
+        m_cqRing = m_sqRing;
+    }
+    else
+    {
+        m_cqRing = mmap(nullptr, m_cqRingSize, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, m_ring, IORING_OFF_CQ_RING);
+        if ( m_cqRing == MAP_FAILED )
+            return false;
+    }
+
+    m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    m_sqes = static_cast<io_uring_sqe*>
+             (
+                mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, m_ring, IORING_OFF_SQES)
+             );
+    if ( m_sqes == MAP_FAILED )
+        return false;
+
+    char* const sq = static_cast<char*>(m_sqRing);
+    m_sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    m_sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    m_sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+    char* const cq = static_cast<char*>(m_cqRing);
+    m_cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    m_cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    m_cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    m_cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+    // The kernel signals this eventfd whenever a completion is posted, which
+    // allows the event loop to wake up and process it.
+    m_eventfd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if ( m_eventfd == -1 )
+        return false;
+
+    if ( wxIoUringRegister(m_ring, IORING_REGISTER_EVENTFD, &m_eventfd, 1) != 0 )
+        return false;
+
+    m_source = wxEventLoopBase::AddSourceForFD(m_eventfd, this,
+                                               wxEVENT_SOURCE_INPUT);
+
+    return m_source != nullptr;
+}
+
+bool wxAsyncFileImplIoUring::PushSqe(unsigned char opcode,
+                                     wxUint64 userData,
+                                     wxUint64 addr,
+                                     unsigned len,
+                                     wxFileOffset offset)
+{
+    // We're the only producer, so the tail can be read without any barrier,
+    // while the kernel only consumes the entries during io_uring_enter() as
+    // we don't use SQPOLL, so the queue is always empty here.
+    const unsigned tail = *m_sqTail;
+    const unsigned index = tail & m_sqMask;
+
+    io_uring_sqe* const sqe = &m_sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = opcode;
+    sqe->fd = m_fd;
+    sqe->off = offset;
+    sqe->addr = addr;
+    sqe->len = len;
+    sqe->user_data = userData;
+
+    m_sqArray[index] = index;
+    __atomic_store_n(m_sqTail, tail + 1, __ATOMIC_RELEASE);
+
+    int rc;
+    while ( (rc = wxIoUringEnter(m_ring, 1, 0, 0)) == -1 && errno == EINTR )
+        ;
+
+    if ( rc != 1 )
+    {
+        // The entry hasn't been consumed, so take it back to avoid submitting
+        // it later.
+        const int err = rc == -1 ? errno : EAGAIN;
+        __atomic_store_n(m_sqTail, tail, __ATOMIC_RELEASE);
+        errno = err;
+        return false;
+    }
+
+    return true;
+}
+
+bool wxAsyncFileImplIoUring::SubmitChunk(long id, const Operation& op)
+{
+    const size_t len = wxMin(op.req.count - op.done, size_t(MAX_CHUNK));
+
+    return PushSqe(op.req.write ? IORING_OP_WRITE : IORING_OP_READ,
+                   static_cast<wxUint64>(id),
+                   reinterpret_cast<wxUIntPtr>(op.req.buffer) + op.done,
+                   static_cast<unsigned>(len),
+                   op.req.offset + static_cast<wxFileOffset>(op.done));
+}
+
+bool wxAsyncFileImplIoUring::DoSubmit(const wxAsyncFileRequest& req)
+{
+    Operation op;
+    op.req = req;
+    op.done = 0;
+    op.cancelled = false;
+
+    if ( m_inflight.size() >= QUEUE_SIZE || !m_queued.empty() )
+    {
+        m_queued.push_back(op);
+        return true;
+    }
+
+    if ( !SubmitChunk(req.id, op) )
+    {
+        wxLogSysError(_("Failed to start asynchronous file I/O"));
+        return false;
+    }
+
+    m_inflight[req.id] = op;
+    return true;
+}
+
+void wxAsyncFileImplIoUring::SubmitQueued()
+{
+    while ( !m_queued.empty() && m_inflight.size() < QUEUE_SIZE )
+    {
+        const Operation op = m_queued.front();
+        m_queued.pop_front();
+
+        if ( SubmitChunk(op.req.id, op) )
+            m_inflight[op.req.id] = op;
+        else
+            Complete(op.req, 0, errno, false);
+    }
+}
+
+bool wxAsyncFileImplIoUring::Cancel(long id)
+{
+    for ( auto it = m_queued.begin(); it != m_queued.end(); ++it )
+    {
+        if ( it->req.id == id )
+        {
+            const wxAsyncFileRequest req = it->req;
+            m_queued.erase(it);
+
+            Complete(req, 0, 0, true);
+            return true;
+        }
+    }
+
+    const auto it = m_inflight.find(id);
+    if ( it == m_inflight.end() )
+        return false;
+
+    Operation& op = it->second;
+    if ( !op.cancelled )
+    {
+        // The result of the cancellation itself is not interesting, the
+        // operation completes with an error if it was cancelled and normally
+        // if it was too late to do it, so use 0 to ignore it.
+        if ( !PushSqe(IORING_OP_ASYNC_CANCEL, 0, static_cast<wxUint64>(id),
+                      0, 0) )
+            return false;
+
+        op.cancelled = true;
+    }
+
+    return true;
+}
+
+void wxAsyncFileImplIoUring::CancelAll()
+{
+    while ( !m_queued.empty() )
+    {
+        const wxAsyncFileRequest req = m_queued.front().req;
+        m_queued.pop_front();
+
+        Complete(req, 0, 0, true);
+    }
+
+    for ( auto& kv : m_inflight )
+    {
+        Operation& op = kv.second;
+        if ( !op.cancelled &&
+                PushSqe(IORING_OP_ASYNC_CANCEL, 0,
+                        static_cast<wxUint64>(kv.first), 0, 0) )
+            op.cancelled = true;
+    }
+}
+
+void wxAsyncFileImplIoUring::WaitAll()
+{
+    while ( !m_inflight.empty() || !m_queued.empty() )
+    {
+        if ( m_inflight.empty() )
+        {
+            SubmitQueued();
+            continue;
+        }
+
+        if ( wxIoUringEnter(m_ring, 0, 1, IORING_ENTER_GETEVENTS) == -1 &&
+                errno != EINTR )
+        {
+            wxLogSysError(_("Failed to wait for asynchronous file I/O"));
+            break;
+        }
+
+        ReapCompletions();
+    }
+}
+
+void wxAsyncFileImplIoUring::ReapCompletions()
+{
+    unsigned head = *m_cqHead;
+    for ( ;; )
+    {
+        if ( head == __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE) )
+            break;
+
+        const io_uring_cqe& cqe = m_cqes[head & m_cqMask];
+        const wxUint64 userData = cqe.user_data;
+        const int res = cqe.res;
+
+        __atomic_store_n(m_cqHead, ++head, __ATOMIC_RELEASE);
+
+        if ( userData )
+            OnCompletion(static_cast<long>(userData), res);
+    }
+
+    SubmitQueued();
+}
+
+void wxAsyncFileImplIoUring::OnCompletion(long id, int res)
+{
+    const auto it = m_inflight.find(id);
+    wxCHECK_RET( it != m_inflight.end(), "Unknown io_uring completion" );
+
+    Operation& op = it->second;
+
+    unsigned long error = 0;
+    bool cancelled = false;
+    if ( res < 0 )
+    {
+        if ( op.cancelled && (res == -ECANCELED || res == -EINTR) )
+            cancelled = true;
+        else
+            error = -res;
+    }
+    else if ( res > 0 )
+    {
+        op.done += res;
+
+        // Continue with the rest of the data unless we're done or the
+        // operation was cancelled.
+        if ( op.done < op.req.count && !op.cancelled )
+        {
+            if ( SubmitChunk(id, op) )
+                return;
+
+            error = errno;
+        }
+
+        cancelled = op.cancelled && op.done < op.req.count;
+    }
+    //else: end of file, nothing to do
+
+    const Operation done = op;
+    m_inflight.erase(it);
+
+    Complete(done.req, done.done, error, cancelled);
+}
+
+void wxAsyncFileImplIoUring::OnReadWaiting()
+{
+    // Reset the event counter before processing the completions, so that we
+    // don't miss the notifications for any new ones.
+    eventfd_t value;
+    eventfd_read(m_eventfd, &value);
+
+    ReapCompletions();
+}
+
+} // anonymous namespace
+
+/* static */
+wxAsyncFileImpl* wxAsyncFileImpl::CreateIoUring(wxAsyncFile& file, int fd)
+{
+    wxAsyncFileImplIoUring* const impl = new wxAsyncFileImplIoUring(file, fd);
+    if ( !impl->Init() )
+    {
+        delete impl;
+        return nullptr;
+    }
+
+    return impl;
+}
+
+#endif // wxHAS_ASYNC_FILE_IO_URING
+
+#endif // wxUSE_FILE && wxUSE_THREADS
@@ -82,6 +82,18 @@
 #include <atomic>
 #include <exception>
 
+// under Linux we use futexes to implement wxSemaphore without any system calls
+// in the uncontended case
+#ifdef __LINUX__
+    #include <limits.h>
+    #include <linux/futex.h>
+    #include <sys/syscall.h>
+
+    #if defined(SYS_futex) && defined(FUTEX_WAIT_BITSET_PRIVATE)
+        #define wxHAS_FUTEX
+    #endif
+#endif
+
 #define THR_ID_CAST(id)  (reinterpret_cast<void*>(id))
 #define THR_ID(thr)      THR_ID_CAST((thr)->GetId())
 
@@ -561,6 +573,198 @@ wxCondError wxConditionInternal::Broadcast()
 // wxSemaphoreInternal
 // ---------------------------------------------------------------------------
 
+#ifdef wxHAS_FUTEX
+
+namespace
+{
+
+// wait until the value at the given address changes from the expected one or
+// the given absolute timeout (as measured by CLOCK_MONOTONIC) expires, which
+// may be null to wait indefinitely
+inline int wxFutexWait(std::atomic<int>* addr, int expected, const timespec* ts)
+{
+    return syscall(SYS_futex, reinterpret_cast<int*>(addr),
+                   FUTEX_WAIT_BITSET_PRIVATE, expected, ts,
+                   nullptr, FUTEX_BITSET_MATCH_ANY);
+}
+
+inline void wxFutexWake(std::atomic<int>* addr, int count)
+{
+    syscall(SYS_futex, reinterpret_cast<int*>(addr),
+            FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+}
+
+} // anonymous namespace
+
+// this implementation only uses a single atomic operation when the semaphore
+// is not contended and only enters the kernel if there are threads to wake up
+// or if the count is zero and we have to wait
+class wxSemaphoreInternal
+{
+public:
+    wxSemaphoreInternal(int initialcount, int maxcount);
+
+    bool IsOk() const { return m_isOk; }
+
+    wxSemaError Wait() { return DoWait(nullptr); }
+    wxSemaError TryWait() { return TryDecrement() ? wxSEMA_NO_ERROR : wxSEMA_BUSY; }
+    wxSemaError WaitTimeout(unsigned long milliseconds);
+
+    wxSemaError Post();
+
+private:
+    // decrement the count if it's positive and return true or return false
+    // if it is zero
+    bool TryDecrement();
+
+    // wait for the count to become positive and decrement it, timeout may be
+    // null to wait indefinitely
+    wxSemaError DoWait(const timespec* timeout);
+
+    // the futex word, must have the same representation as int
+    std::atomic<int> m_count;
+
+    // the number of threads blocked in DoWait()
+    std::atomic<int> m_numWaiters;
+
+    int m_maxcount;
+
+    bool m_isOk;
+
+    wxDECLARE_NO_COPY_CLASS(wxSemaphoreInternal);
+};
+
+static_assert(sizeof(std::atomic<int>) == sizeof(int),
+              "futex word must be an int");
+
+wxSemaphoreInternal::wxSemaphoreInternal(int initialcount, int maxcount)
+                   : m_count(0),
+                     m_numWaiters(0),
+                     m_maxcount(0)
+{
+    if ( (initialcount < 0 || maxcount < 0) ||
+            ((maxcount > 0) && (initialcount > maxcount)) )
+    {
+        wxFAIL_MSG( wxT("wxSemaphore: invalid initial or maximal count") );
+
+        m_isOk = false;
+    }
+    else
+    {
+        m_maxcount = maxcount;
+        m_count = initialcount;
+
+        m_isOk = true;
+    }
+}
+
+bool wxSemaphoreInternal::TryDecrement()
+{
+    int count = m_count.load(std::memory_order_relaxed);
+    while ( count > 0 )
+    {
+        if ( m_count.compare_exchange_weak(count, count - 1) )
+            return true;
+    }
+
+    return false;
+}
+
+wxSemaError wxSemaphoreInternal::DoWait(const timespec* timeout)
+{
+    if ( TryDecrement() )
+        return wxSEMA_NO_ERROR;
+
+    wxLogTrace(TRACE_SEMA,
+               wxT("Thread %p waiting for semaphore to become signalled"),
+               THR_ID_CAST(wxThread::GetCurrentId()));
+
+    // this must be done before checking the count again below to ensure that
+    // Post() either sees us waiting or we see the count incremented by it
+    m_numWaiters++;
+
+    wxSemaError rc = wxSEMA_NO_ERROR;
+    while ( !TryDecrement() )
+    {
+        if ( wxFutexWait(&m_count, 0, timeout) == 0 )
+            continue;
+
+        switch ( errno )
+        {
+            case EAGAIN:    // the count changed before we started waiting
+            case EINTR:     // interrupted by a signal
+                continue;
+
+            case ETIMEDOUT:
+                // we could have been woken up at the same time as the
+                // timeout expired, so check the count for the last time
+                rc = TryDecrement() ? wxSEMA_NO_ERROR : wxSEMA_TIMEOUT;
+                break;
+
+            default:
+                wxLogSysError(_("Failed to wait for a semaphore"));
+                rc = wxSEMA_MISC_ERROR;
+        }
+
+        break;
+    }
+
+    m_numWaiters--;
+
+    wxLogTrace(TRACE_SEMA,
+               wxT("Thread %p finished waiting for semaphore, rc = %d"),
+               THR_ID_CAST(wxThread::GetCurrentId()), rc);
+
+    return rc;
+}
+
+wxSemaError wxSemaphoreInternal::WaitTimeout(unsigned long milliseconds)
+{
+    timespec ts;
+    if ( clock_gettime(CLOCK_MONOTONIC, &ts) != 0 )
+    {
+        wxLogSysError(_("Failed to get the current time"));
+        return wxSEMA_MISC_ERROR;
+    }
+
+    ts.tv_sec += milliseconds / 1000;
+    ts.tv_nsec += (milliseconds % 1000) * 1000000L;
+    if ( ts.tv_nsec >= 1000000000L )
+    {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000L;
+    }
+
+    return DoWait(&ts);
+}
+
+wxSemaError wxSemaphoreInternal::Post()
+{
+    int count = m_count.load(std::memory_order_relaxed);
+    do
+    {
+        if ( m_maxcount > 0 && count >= m_maxcount )
+            return wxSEMA_OVERFLOW;
+
+        if ( count == INT_MAX )
+            return wxSEMA_OVERFLOW;
+    }
+    while ( !m_count.compare_exchange_weak(count, count + 1) );
+
+    if ( m_numWaiters.load() > 0 )
+    {
+        wxLogTrace(TRACE_SEMA,
+                   wxT("Thread %p about to signal semaphore, count = %d"),
+                   THR_ID_CAST(wxThread::GetCurrentId()), count + 1);
+
+        wxFutexWake(&m_count, 1);
+    }
+
+    return wxSEMA_NO_ERROR;
+}
+
+#else // !wxHAS_FUTEX
+
 // we implement the semaphores using mutexes and conditions instead of using
 // the sem_xxx() POSIX functions because they're not widely available and also
 // because it's impossible to implement WaitTimeout() using them
@@ -695,6 +899,103 @@ wxSemaError wxSemaphoreInternal::Post()
                                               : wxSEMA_MISC_ERROR;
 }
 
+#endif // wxHAS_FUTEX/!wxHAS_FUTEX
+
+// ===========================================================================
+// wxRWLock implementation
+// ===========================================================================
+
+// ---------------------------------------------------------------------------
+// wxRWLockInternal
+// ---------------------------------------------------------------------------
+
+// this is a simple wrapper around pthread_rwlock_t, which already doesn't
+// make any system calls when there is no contention in all the common
+// implementations
+class wxRWLockInternal
+{
+public:
+    wxRWLockInternal();
+    ~wxRWLockInternal();
+
+    bool IsOk() const { return m_isOk; }
+
+    wxMutexError LockRead()
+        { return HandleResult(pthread_rwlock_rdlock(&m_lock), "rdlock"); }
+    wxMutexError TryLockRead()
+        { return HandleResult(pthread_rwlock_tryrdlock(&m_lock), "tryrdlock"); }
+    wxMutexError UnlockRead()
+        { return HandleResult(pthread_rwlock_unlock(&m_lock), "unlock"); }
+
+    wxMutexError LockWrite()
+        { return HandleResult(pthread_rwlock_wrlock(&m_lock), "wrlock"); }
+    wxMutexError TryLockWrite()
+        { return HandleResult(pthread_rwlock_trywrlock(&m_lock), "trywrlock"); }
+    wxMutexError UnlockWrite()
+        { return HandleResult(pthread_rwlock_unlock(&m_lock), "unlock"); }
+
+private:
+    // convert the result of pthread_rwlock_xxx() call to wx return code
+    static wxMutexError HandleResult(int err, const char* func);
+
+    pthread_rwlock_t m_lock;
+    bool m_isOk;
+
+    wxDECLARE_NO_COPY_CLASS(wxRWLockInternal);
+};
+
+wxRWLockInternal::wxRWLockInternal()
+{
+    int err = pthread_rwlock_init(&m_lock, nullptr /* default attributes */);
+
+    m_isOk = err == 0;
+    if ( !m_isOk )
+    {
+        wxLogApiError(wxT("pthread_rwlock_init()"), err);
+    }
+}
+
+wxRWLockInternal::~wxRWLockInternal()
+{
+    if ( m_isOk )
+    {
+        int err = pthread_rwlock_destroy(&m_lock);
+        if ( err != 0 )
+        {
+            wxLogApiError(wxT("pthread_rwlock_destroy()"), err);
+        }
+    }
+}
+
+/* static */
+wxMutexError wxRWLockInternal::HandleResult(int err, const char* func)
+{
+    switch ( err )
+    {
+        case 0:
+            return wxMUTEX_NO_ERROR;
+
+        case EBUSY:
+            // not an error: the lock is already held, but we're prepared for
+            // this when using one of the "try" functions
+            return wxMUTEX_BUSY;
+
+        case EDEADLK:
+            wxFAIL_MSG( wxT("read-write lock deadlock prevented") );
+            return wxMUTEX_DEAD_LOCK;
+
+        case EPERM:
+            // we don't hold the lock
+            return wxMUTEX_UNLOCKED;
+
+        default:
+            wxLogApiError(wxString::Format(wxT("pthread_rwlock_%s()"), func),
+                          err);
+    }
+
+    return wxMUTEX_MISC_ERROR;
+}
+
 // ===========================================================================
 // wxThread implementation
 // ===========================================================================
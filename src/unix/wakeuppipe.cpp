@@ -26,12 +26,24 @@
 
 #include <errno.h>
 
+#ifdef wxHAS_EVENTFD
+    #include <sys/eventfd.h>
+    #include <unistd.h>
+#endif
+
 // ----------------------------------------------------------------------------
 // constants
 // ----------------------------------------------------------------------------
 
 #define TRACE_EVENTS wxT("events")
 
+// the size of the data written to wake up the pipe
+#ifdef wxHAS_EVENTFD
+    static const int WAKEUP_DATA_SIZE = sizeof(wxUint64);
+#else
+    static const int WAKEUP_DATA_SIZE = 1;
+#endif
+
 // ============================================================================
 // wxWakeUpPipe implementation
 // ============================================================================
@@ -40,6 +52,30 @@
 // initialization
 // ----------------------------------------------------------------------------
 
+#ifdef wxHAS_EVENTFD
+
+wxWakeUpPipe::wxWakeUpPipe()
+{
+    m_pipeIsEmpty = true;
+
+    m_eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if ( m_eventFd == -1 )
+    {
+        wxLogSysError(_("Failed to create wake up pipe used by event loop."));
+        return;
+    }
+
+    wxLogTrace(TRACE_EVENTS, wxT("Wake up eventfd %d created"), m_eventFd);
+}
+
+wxWakeUpPipe::~wxWakeUpPipe()
+{
+    if ( m_eventFd != -1 )
+        close(m_eventFd);
+}
+
+#else // !wxHAS_EVENTFD
+
 wxWakeUpPipe::wxWakeUpPipe()
 {
     m_pipeIsEmpty = true;
@@ -61,6 +97,8 @@ wxWakeUpPipe::wxWakeUpPipe()
                m_pipe[wxPipe::Read], m_pipe[wxPipe::Write]);
 }
 
+#endif // wxHAS_EVENTFD/!wxHAS_EVENTFD
+
 // ----------------------------------------------------------------------------
 // wakeup handling
 // ----------------------------------------------------------------------------
@@ -71,7 +109,12 @@ void wxWakeUpPipe::WakeUpNoLock()
     if ( !m_pipeIsEmpty )
       return;
 
+#ifdef wxHAS_EVENTFD
+    const wxUint64 value = 1;
+    if ( write(m_eventFd, &value, sizeof(value)) != (ssize_t)sizeof(value) )
+#else
     if ( write(m_pipe[wxPipe::Write], "s", 1) != 1 )
+#endif
     {
         // don't use wxLog here, we can be in another thread and this could
         // result in dead locks
@@ -89,14 +132,21 @@ void wxWakeUpPipe::OnReadWaiting()
     // got wakeup from child thread, remove the data that provoked it from the
     // pipe
 
+#ifdef wxHAS_EVENTFD
+    // reading from eventfd resets its counter to 0, whatever its value was
+    wxUint64 buf[1];
+#else
     char buf[4];
+#endif
+
     for ( ;; )
     {
-        const int size = read(GetReadFd(), buf, WXSIZEOF(buf));
+        const int size = read(GetReadFd(), buf, sizeof(buf));
 
         if ( size > 0 )
         {
-            wxASSERT_MSG( size == 1, "Too many writes to wake-up pipe?" );
+            wxASSERT_MSG( size == WAKEUP_DATA_SIZE,
+                          "Too many writes to wake-up pipe?" );
 
             break;
         }
@@ -22,6 +22,7 @@
 #endif
 
 #include "wx/wfstream.h"
+#include "wx/filename.h"
 #include "wx/datstrm.h"
 #include "wx/zstream.h"
 #include "wx/strconv.h"
@@ -485,6 +486,19 @@ void wxXmlDocument::DoCopy(const wxXmlDocument& doc)
 bool wxXmlDocument::Load(const wxString& filename, int flags,
                          wxXmlParseError* err)
 {
+    // Map the file in memory to let the parser use its contents directly,
+    // but only if it's a regular file of known size: special files, such as
+    // those under /proc, report their size as 0 and pipes don't have any, so
+    // just read them sequentially.
+    const wxULongLong size = wxFileName::GetSize(filename);
+    if (wxFileName::Exists(filename, wxFILE_EXISTS_REGULAR) &&
+            size != wxInvalidSize && size != 0)
+    {
+        wxMappedFileInputStream stream(filename);
+        if (stream.IsOk())
+            return Load(stream, flags, err);
+    }
+
     wxFileInputStream stream(filename);
     if (!stream.IsOk())
         return false;
@@ -847,12 +861,35 @@ bool wxXmlDocument::Load(wxInputStream& stream, int flags,
     XML_SetDefaultHandler(parser, DefaultHnd);
     XML_SetUnknownEncodingHandler(parser, UnknownEncodingHnd, nullptr);
 
+    // If the data is already in memory, parse it in place instead of copying
+    // it to our buffer first.
+    wxMappedFileInputStream* const
+        mapped = dynamic_cast<wxMappedFileInputStream*>(&stream);
+
     bool ok = true;
     do
     {
-        size_t len = stream.Read(buf, BUFSIZE).LastRead();
-        done = (len < BUFSIZE);
-        if (!XML_Parse(parser, buf, len, done))
+        const char* data = buf;
+        size_t len;
+        if (mapped)
+        {
+            data = static_cast<const char*>(mapped->PeekData(&len));
+
+            // XML_Parse() takes int length, so don't give it too much at once.
+            const size_t MAX_CHUNK = 0x40000000;
+            if (len > MAX_CHUNK)
+                len = MAX_CHUNK;
+
+            done = static_cast<wxFileOffset>(len) ==
+                        mapped->GetLength() - mapped->TellI();
+        }
+        else
+        {
+            len = stream.Read(buf, BUFSIZE).LastRead();
+            done = (len < BUFSIZE);
+        }
+
+        if (!XML_Parse(parser, data, len, done))
         {
             if (err)
             {
@@ -872,6 +909,11 @@ bool wxXmlDocument::Load(wxInputStream& stream, int flags,
             ok = false;
             break;
         }
+
+        // Only consume the data now, as it may be freed by Skip() if it was
+        // put back into the stream.
+        if (mapped)
+            mapped->Skip(len);
     } while (!done);
 
     if (ok)
@@ -228,6 +228,7 @@
 #include <wx/localedefs.h>
 #include <wx/log.h>
 #include <wx/longlong.h>
+#include <wx/lz4stream.h>
 #include <wx/lzmastream.h>
 #include <wx/math.h>
 #include <wx/matrix.h>
@@ -431,6 +432,7 @@
 #include <wx/xtitypes.h>
 #include <wx/xtixml.h>
 #include <wx/zipstrm.h>
+#include <wx/zstdstream.h>
 #include <wx/zstream.h>
 #include <wx/aui/auibar.h>
 #include <wx/aui/auibook.h>
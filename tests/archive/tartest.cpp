@@ -16,6 +16,10 @@
 
 #include "archivetest.h"
 #include "wx/tarstrm.h"
+#include "wx/mstream.h"
+
+#include <memory>
+#include <vector>
 
 using std::string;
 
@@ -69,4 +73,358 @@ CppUnit::Test *tartest::makeTest(
 CPPUNIT_TEST_SUITE_REGISTRATION(tartest);
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(tartest, "archive/tar");
 
+
+///////////////////////////////////////////////////////////////////////////////
+// Helpers for creating tars using features which wxTarOutputStream doesn't
+
+namespace
+{
+
+void SetTarOctal(string& block, size_t pos, size_t len, wxFileOffset n)
+{
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%0*llo", int(len - 1), (unsigned long long)n);
+    block.replace(pos, len - 1, buf);
+}
+
+string MakeTarHeader(const string& name, char type, wxFileOffset size,
+                     bool gnu = false)
+{
+    string block(512, '\0');
+    block.replace(0, name.length(), name);
+    SetTarOctal(block, 100, 8, 0644);
+    SetTarOctal(block, 108, 8, 0);
+    SetTarOctal(block, 116, 8, 0);
+    SetTarOctal(block, 124, 12, size);
+    SetTarOctal(block, 136, 12, 0);
+    block[156] = type;
+    block.replace(257, 8, gnu ? string("ustar  \0", 8) : string("ustar\0" "00", 8));
+    return block;
+}
+
+void SetTarChecksum(string& block)
+{
+    block.replace(148, 8, 8, ' ');
+    unsigned sum = 0;
+    for ( size_t i = 0; i < block.size(); i++ )
+        sum += static_cast<unsigned char>(block[i]);
+    SetTarOctal(block, 148, 8, sum);
+}
+
+string TarPad(const string& data)
+{
+    return data + string((512 - data.size() % 512) % 512, '\0');
+}
+
+string MakePaxRecord(const string& key, const string& value)
+{
+    // the length includes itself
+    size_t len = key.length() + value.length() + 3;
+    size_t total = len + wxString::Format("%zu", len).length();
+    total = len + wxString::Format("%zu", total).length();
+    return wxString::Format("%zu %s=%s\n", total, key, value).ToStdString();
+}
+
+string MakePaxHeader(const string& records)
+{
+    string hdr = MakeTarHeader("PaxHeaders/sparse.dat", 'x', records.size());
+    SetTarChecksum(hdr);
+    return hdr + TarPad(records);
+}
+
+// A sparse file with regions of data at every 2000 bytes, the last region
+// is empty and just marks the end of the file, as GNU tar does it.
+const int SPARSE_REGIONS = 7;
+const wxFileOffset SPARSE_SIZE = 15000;
+
+wxFileOffset SparseOffset(int n)
+{
+    return n == SPARSE_REGIONS - 1 ? SPARSE_SIZE : n * 2000;
+}
+
+wxFileOffset SparseLength(int n)
+{
+    return n == SPARSE_REGIONS - 1 ? 0 : 100 + n;
+}
+
+string SparseContents()
+{
+    string contents(SPARSE_SIZE, '\0');
+    for ( int n = 0; n < SPARSE_REGIONS; n++ )
+        contents.replace(SparseOffset(n), SparseLength(n),
+                         SparseLength(n), char('a' + n));
+    return contents;
+}
+
+string SparseData()
+{
+    string data;
+    for ( int n = 0; n < SPARSE_REGIONS; n++ )
+        data.append(SparseLength(n), char('a' + n));
+    return data;
+}
+
+string MakeSparseTar(const string& format)
+{
+    const string data = SparseData();
+    string tar;
+
+    if ( format == "gnu" )
+    {
+        // four map entries in the header and the rest in an extension block
+        string hdr = MakeTarHeader("sparse.dat", 'S', data.size(), true);
+        string ext(512, '\0');
+        for ( int n = 0; n < SPARSE_REGIONS; n++ )
+        {
+            string& block = n < 4 ? hdr : ext;
+            size_t pos = n < 4 ? 386 + n * 24 : (n - 4) * 24;
+            SetTarOctal(block, pos, 12, SparseOffset(n));
+            SetTarOctal(block, pos + 12, 12, SparseLength(n));
+        }
+        hdr[482] = 1;
+        SetTarOctal(hdr, 483, 12, SPARSE_SIZE);
+        SetTarChecksum(hdr);
+        tar = hdr + ext + TarPad(data);
+    }
+    else if ( format == "pax0.1" )
+    {
+        wxString map;
+        for ( int n = 0; n < SPARSE_REGIONS; n++ )
+            map << (n ? "," : "") << SparseOffset(n) << "," << SparseLength(n);
+
+        tar = MakePaxHeader(
+                MakePaxRecord("GNU.sparse.numblocks", "7") +
+                MakePaxRecord("GNU.sparse.map", map.ToStdString()) +
+                MakePaxRecord("GNU.sparse.size", "15000") +
+                MakePaxRecord("GNU.sparse.name", "sparse.dat"));
+
+        string hdr = MakeTarHeader("GNUSparseFile.0/sparse.dat", '0',
+                                   data.size());
+        SetTarChecksum(hdr);
+        tar += hdr + TarPad(data);
+    }
+    else // pax1.0
+    {
+        tar = MakePaxHeader(
+                MakePaxRecord("GNU.sparse.major", "1") +
+                MakePaxRecord("GNU.sparse.minor", "0") +
+                MakePaxRecord("GNU.sparse.name", "sparse.dat") +
+                MakePaxRecord("GNU.sparse.realsize", "15000"));
+
+        wxString map;
+        map << SPARSE_REGIONS << "\n";
+        for ( int n = 0; n < SPARSE_REGIONS; n++ )
+            map << SparseOffset(n) << "\n" << SparseLength(n) << "\n";
+        const string stored = TarPad(map.ToStdString()) + data;
+
+        string hdr = MakeTarHeader("GNUSparseFile.0/sparse.dat", '0',
+                                   stored.size());
+        SetTarChecksum(hdr);
+        tar += hdr + TarPad(stored);
+    }
+
+    // a normal entry following the sparse one
+    string hdr = MakeTarHeader("after.txt", '0', 5);
+    SetTarChecksum(hdr);
+    tar += hdr + TarPad("after") + string(1024, '\0');
+
+    return tar;
+}
+
+string ReadEntryData(wxInputStream& in)
+{
+    string data;
+    char buf[1000];
+    while ( in.Read(buf, sizeof(buf)).LastRead() )
+        data.append(buf, in.LastRead());
+    return data;
+}
+
+// Seekable output stream recording the sizes of the writes made to it.
+class WriteRecorder : public wxOutputStream
+{
+public:
+    WriteRecorder() : m_pos(0) { }
+
+    bool IsSeekable() const override { return true; }
+
+    string m_data;
+    std::vector<size_t> m_writes;
+
+protected:
+    size_t OnSysWrite(const void *buffer, size_t size) override
+    {
+        m_writes.push_back(size);
+        if ( m_pos + size > m_data.size() )
+            m_data.resize(m_pos + size);
+        m_data.replace(m_pos, size, static_cast<const char*>(buffer), size);
+        m_pos += size;
+        return size;
+    }
+
+    wxFileOffset OnSysSeek(wxFileOffset pos, wxSeekMode mode) override
+    {
+        switch ( mode )
+        {
+            case wxFromStart:   break;
+            case wxFromCurrent: pos += m_pos; break;
+            case wxFromEnd:     pos += m_data.size(); break;
+        }
+        m_pos = pos;
+        return pos;
+    }
+
+    wxFileOffset OnSysTell() const override { return m_pos; }
+
+private:
+    size_t m_pos;
+};
+
+} // anonymous namespace
+
+TEST_CASE("Tar::Sparse", "[archive][tar]")
+{
+    string format;
+    SECTION("GNU") { format = "gnu"; }
+    SECTION("PAX 0.1") { format = "pax0.1"; }
+    SECTION("PAX 1.0") { format = "pax1.0"; }
+
+    const string tar = MakeSparseTar(format);
+    const string contents = SparseContents();
+
+    wxMemoryInputStream in(tar.data(), tar.size());
+    wxTarInputStream arc(in);
+
+    std::unique_ptr<wxTarEntry> entry(arc.GetNextEntry());
+    REQUIRE( entry );
+    CHECK( entry->GetName(wxPATH_UNIX) == "sparse.dat" );
+    CHECK( entry->GetTypeFlag() == wxTAR_REGTYPE );
+    CHECK( entry->IsSparse() );
+    CHECK( entry->GetSize() == SPARSE_SIZE );
+    CHECK( ReadEntryData(arc) == contents );
+
+    // Seek into a hole, and then into the middle of a region.
+    REQUIRE( arc.OpenEntry(*entry) );
+    REQUIRE( arc.SeekI(3000) == 3000 );
+    char buf[1500];
+    REQUIRE( arc.Read(buf, sizeof(buf)).LastRead() == sizeof(buf) );
+    CHECK( string(buf, sizeof(buf)) == contents.substr(3000, sizeof(buf)) );
+
+    REQUIRE( arc.SeekI(8050) == 8050 );
+    CHECK( ReadEntryData(arc) == contents.substr(8050) );
+
+    // Check that the following entry is found correctly.
+    entry.reset(arc.GetNextEntry());
+    REQUIRE( entry );
+    CHECK( entry->GetName(wxPATH_UNIX) == "after.txt" );
+    CHECK( !entry->IsSparse() );
+    CHECK( ReadEntryData(arc) == "after" );
+
+    entry.reset(arc.GetNextEntry());
+    CHECK( !entry );
+    CHECK( arc.Eof() );
+}
+
+TEST_CASE("Tar::LargeNumbers", "[archive][tar]")
+{
+    const wxFileOffset size = wxFileOffset(10) << 30;
+
+    // Without pax extended headers, the numbers which don't fit the header
+    // are stored in the GNU base-256 format.
+    wxMemoryOutputStream out;
+    wxTarOutputStream tar(out, wxTAR_USTAR);
+
+    wxTarEntry *entry = new wxTarEntry("large.dat", wxDateTime::Now(), size);
+    entry->SetUserId(3000000);
+    REQUIRE( tar.PutNextEntry(entry) );
+    tar.Sync();
+
+    const wxStreamBuffer* const buf = out.GetOutputStreamBuffer();
+    REQUIRE( out.GetLength() == 512 );
+
+    const unsigned char* const
+        hdr = static_cast<const unsigned char*>(buf->GetBufferStart());
+    CHECK( hdr[124] == 0x80 );
+
+    wxMemoryInputStream in(hdr, 512);
+    wxTarInputStream arc(in);
+    std::unique_ptr<wxTarEntry> read(arc.GetNextEntry());
+    REQUIRE( read );
+    CHECK( read->GetSize() == size );
+    CHECK( read->GetUserId() == 3000000 );
+}
+
+TEST_CASE("Tar::Buffered", "[archive][tar]")
+{
+    const int NUM_ENTRIES = 20;
+
+    const auto makeData = [](int n)
+    {
+        string data;
+        for ( int i = 0; i < n * 300; i++ )
+            data += wxString::Format("%d:%d ", n, i).ToStdString();
+        return data;
+    };
+
+    size_t bufSize = wxTarOutputStream::DEFAULT_BUFFER_SIZE;
+    bool pipelined = false;
+
+    SECTION("Default") { }
+    SECTION("Small buffer") { bufSize = 1000; }
+#if wxUSE_THREADS
+    SECTION("Pipelined") { pipelined = true; }
+    SECTION("Pipelined small buffer") { bufSize = 1000; pipelined = true; }
+#endif // wxUSE_THREADS
+
+    // Write the entries either giving their sizes in advance or not, in which
+    // case the headers have to be updated after writing the data.
+    for ( int knownSize = 0; knownSize < 2; knownSize++ )
+    {
+        WriteRecorder out;
+        {
+            wxTarOutputStream tar(out);
+            tar.SetBufferSize(bufSize);
+            if ( pipelined )
+            {
+                REQUIRE( tar.SetPipelined() );
+                CHECK( tar.IsPipelined() );
+            }
+
+            for ( int n = 0; n < NUM_ENTRIES; n++ )
+            {
+                const string data = makeData(n);
+                REQUIRE( tar.PutNextEntry(wxString::Format("file%d.txt", n),
+                                          wxDateTime::Now(),
+                                          knownSize ? data.size()
+                                                    : wxInvalidOffset) );
+                REQUIRE( tar.WriteAll(data.data(), data.size()) );
+            }
+
+            REQUIRE( tar.Close() );
+        }
+
+        CHECK( out.m_data.size() % (10 * 512) == 0 );
+
+        // If there is no need to seek back, all writes are whole records.
+        if ( knownSize )
+        {
+            for ( size_t n = 0; n < out.m_writes.size(); n++ )
+                CHECK( out.m_writes[n] % (10 * 512) == 0 );
+        }
+
+        wxMemoryInputStream in(out.m_data.data(), out.m_data.size());
+        wxTarInputStream arc(in);
+        for ( int n = 0; n < NUM_ENTRIES; n++ )
+        {
+            std::unique_ptr<wxTarEntry> entry(arc.GetNextEntry());
+            REQUIRE( entry );
+            CHECK( entry->GetName() == wxString::Format("file%d.txt", n) );
+            CHECK( ReadEntryData(arc) == makeData(n) );
+        }
+
+        std::unique_ptr<wxTarEntry> entry(arc.GetNextEntry());
+        CHECK( !entry );
+    }
+}
+
 #endif // wxUSE_STREAMS
@@ -15,9 +15,13 @@
 #if wxUSE_STREAMS && wxUSE_ZIPSTREAM
 
 #include "archivetest.h"
+#include "testfile.h"
+#include "wx/mstream.h"
+#include "wx/wfstream.h"
 #include "wx/zipstrm.h"
 
 #include <memory>
+#include <vector>
 
 using std::string;
 
@@ -250,4 +254,195 @@ CppUnit::Test *ziptest::makeTest(
 CPPUNIT_TEST_SUITE_REGISTRATION(ziptest);
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(ziptest, "archive/zip");
 
+
+///////////////////////////////////////////////////////////////////////////////
+// Parallel reading and writing
+
+TEST_CASE("Zip::Parallel", "[archive][zip]")
+{
+    const int NUM_ENTRIES = 50;
+
+    // Use entries of different sizes, so that they are not finished in order.
+    const auto makeData = [](int n)
+    {
+        std::string data;
+        for ( int i = 0; i < (n % 7 + 1)*1000; i++ )
+            data += wxString::Format("%d:%d ", n, i).ToStdString();
+        return data;
+    };
+
+    TempFile tmp(wxFileName::CreateTempFileName("wxtest"));
+
+    {
+        wxFileOutputStream file(tmp.GetName());
+        wxZipOutputStream zip(file);
+
+        wxZipParallelWriter writer(zip);
+        writer.AddEntry(new wxZipEntry("dir/"));
+        for ( int n = 0; n < NUM_ENTRIES; n++ )
+        {
+            const std::string data = makeData(n);
+            writer.AddEntry
+            (
+                new wxZipEntry(wxString::Format("dir/file%d.txt", n)),
+                [data](wxOutputStream& stream)
+                {
+                    return stream.WriteAll(data.data(), data.size());
+                }
+            );
+        }
+
+        CHECK( writer.Write(4) );
+        CHECK( writer.GetEntryCount() == 0 );
+        CHECK( zip.Close() );
+    }
+
+    // The entries must have been written in the order in which they were
+    // added and be readable by the normal input stream.
+    {
+        wxFileInputStream file(tmp.GetName());
+        wxZipInputStream zip(file);
+
+        std::unique_ptr<wxZipEntry> entry(zip.GetNextEntry());
+        REQUIRE( entry );
+        CHECK( entry->IsDir() );
+
+        for ( int n = 0; n < NUM_ENTRIES; n++ )
+        {
+            entry.reset(zip.GetNextEntry());
+            REQUIRE( entry );
+            CHECK( entry->GetInternalName() ==
+                    wxString::Format("dir/file%d.txt", n) );
+        }
+    }
+
+    wxZipParallelReader reader(tmp.GetName());
+    REQUIRE( reader.IsOk() );
+    REQUIRE( reader.GetEntryCount() == NUM_ENTRIES + 1 );
+
+    // Each entry is only read by a single thread, so no locking is needed.
+    std::vector<std::string> contents(reader.GetEntryCount());
+    CHECK( reader.ReadEntries
+           (
+                [&](const wxZipEntry& entry, wxInputStream& stream)
+                {
+                    wxMemoryOutputStream mem;
+                    stream.Read(mem);
+
+                    size_t n = 0;
+                    while ( &reader.GetEntry(n) != &entry )
+                        n++;
+
+                    contents[n].assign
+                                (
+                                    static_cast<const char*>(
+                                        mem.GetOutputStreamBuffer()->GetBufferStart()),
+                                    mem.GetLength()
+                                );
+                    return true;
+                },
+                4
+           ) );
+
+    CHECK( contents[0].empty() );
+    for ( int n = 0; n < NUM_ENTRIES; n++ )
+        CHECK( contents[n + 1] == makeData(n) );
+
+    // Returning false from the callback stops reading.
+    CHECK_FALSE( reader.ReadEntries
+                 (
+                    [](const wxZipEntry&, wxInputStream&) { return false; }
+                 ) );
+
+    const wxString dir = wxFileName::CreateTempFileName("wxtest");
+    wxRemoveFile(dir);
+
+    CHECK( reader.ExtractTo(dir, 4) );
+
+    {
+        wxFileInputStream file(wxFileName(dir + "/dir", "file3.txt").GetFullPath());
+        REQUIRE( file.IsOk() );
+
+        wxMemoryOutputStream mem;
+        file.Read(mem);
+        CHECK( static_cast<size_t>(mem.GetLength()) == makeData(3).size() );
+    }
+
+    CHECK( wxFileName::Rmdir(dir, wxPATH_RMDIR_RECURSIVE) );
+
+    // Entries which would be extracted outside of the directory are refused.
+    {
+        wxFileOutputStream file(tmp.GetName());
+        wxZipOutputStream zip(file);
+        zip.PutNextEntry("../outside.txt");
+        zip.Write("data", 4);
+    }
+
+    wxZipParallelReader readerUnsafe(tmp.GetName());
+    REQUIRE( readerUnsafe.IsOk() );
+
+    wxLogNull noLog;
+    CHECK_FALSE( readerUnsafe.ExtractTo(dir) );
+    CHECK_FALSE( wxFileName::DirExists(dir) );
+}
+
 #endif // wxUSE_STREAMS && wxUSE_ZIPSTREAM
+
+///////////////////////////////////////////////////////////////////////////////
+// Reading entries from their central directory positions
+
+TEST_CASE("Zip::EntryAt", "[archive][zip]")
+{
+    wxMemoryOutputStream mem;
+    {
+        wxZipOutputStream zip(mem);
+        for ( int n = 0; n < 3; n++ )
+        {
+            const wxString name = wxString::Format("file%d.txt", n);
+            REQUIRE( zip.PutNextEntry(name) );
+            REQUIRE( zip.WriteAll(name.utf8_str(), name.length()) );
+        }
+        REQUIRE( zip.Close() );
+    }
+
+    wxMemoryInputStream in(mem);
+    wxZipInputStream zip(in);
+
+    std::vector<wxFileOffset> positions;
+    for ( ;; )
+    {
+        const wxFileOffset pos = zip.GetCentralPosition();
+        std::unique_ptr<wxZipEntry> entry(zip.GetNextEntry());
+        if ( !entry )
+        {
+            CHECK( pos == wxInvalidOffset );
+            break;
+        }
+
+        REQUIRE( pos != wxInvalidOffset );
+        positions.push_back(pos);
+    }
+
+    REQUIRE( positions.size() == 3 );
+
+    // Read the entries again in a different order.
+    for ( int n = 2; n >= 0; n-- )
+    {
+        std::unique_ptr<wxZipEntry> entry(zip.GetEntryAt(positions[n]));
+        REQUIRE( entry );
+
+        const wxString name = wxString::Format("file%d.txt", n);
+        CHECK( entry->GetName() == name );
+
+        REQUIRE( zip.OpenEntry(*entry) );
+        char buf[16];
+        REQUIRE( zip.ReadAll(buf, name.length()) );
+        CHECK( wxString(buf, name.length()) == name );
+    }
+
+    // GetNextEntry() continues after the last entry read.
+    delete zip.GetEntryAt(positions[0]);
+    std::unique_ptr<wxZipEntry> entry(zip.GetNextEntry());
+    REQUIRE( entry );
+    CHECK( entry->GetName() == "file1.txt" );
+}
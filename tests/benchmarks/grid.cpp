@@ -0,0 +1,196 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/grid.cpp
+// Purpose:     wxGrid benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/app.h"
+#include "wx/grid.h"
+
+#include "bench.h"
+
+#if wxUSE_GRID
+
+namespace
+{
+
+// Virtual table with the given number of rows which doesn't store anything.
+class HugeGridTable : public wxGridTableBase
+{
+public:
+    explicit HugeGridTable(int numRows) : m_numRows(numRows) { }
+
+    virtual int GetNumberRows() override { return m_numRows; }
+    virtual int GetNumberCols() override { return 10; }
+
+    virtual wxString GetValue(int row, int col) override
+        { return wxString::Format("%d:%d", row, col); }
+    virtual void SetValue(int, int, const wxString&) override { }
+
+    virtual bool InsertRows(size_t pos, size_t numRows) override
+    {
+        m_numRows += numRows;
+
+        if ( GetView() )
+        {
+            wxGridTableMessage msg(this, wxGRIDTABLE_NOTIFY_ROWS_INSERTED,
+                                   pos, numRows);
+            GetView()->ProcessTableMessage(msg);
+        }
+
+        return true;
+    }
+
+    virtual bool DeleteRows(size_t pos, size_t numRows) override
+    {
+        m_numRows -= numRows;
+
+        if ( GetView() )
+        {
+            wxGridTableMessage msg(this, wxGRIDTABLE_NOTIFY_ROWS_DELETED,
+                                   pos, numRows);
+            GetView()->ProcessTableMessage(msg);
+        }
+
+        return true;
+    }
+
+private:
+    int m_numRows;
+};
+
+wxGrid* gs_grid = nullptr;
+int gs_numRows = 0;
+
+// Used to generate the pseudo-random row indices cheaply.
+unsigned gs_seed = 0;
+
+int NextRow()
+{
+    gs_seed = gs_seed * 1103515245 + 12345;
+    return static_cast<int>((gs_seed >> 1) % static_cast<unsigned>(gs_numRows));
+}
+
+bool InitHugeGrid()
+{
+    // Use 10 million rows by default.
+    gs_numRows = Bench::GetNumericParameter(10000000);
+
+    gs_grid = new wxGrid(wxTheApp->GetTopWindow(), wxID_ANY);
+    gs_grid->SetTable(new HugeGridTable(gs_numRows), true /* take ownership */);
+
+    // Avoid measuring repainting, we're only interested in the geometry.
+    gs_grid->BeginBatch();
+
+    // Ensure that the grid uses non-default row heights.
+    gs_grid->SetRowSize(0, 2*gs_grid->GetDefaultRowSize());
+
+    return true;
+}
+
+void DoneHugeGrid()
+{
+    delete gs_grid;
+    gs_grid = nullptr;
+}
+
+// Number of rows between the blocks with attributes.
+const int BLOCK_ATTR_STEP = 10;
+
+bool InitBlockAttrGrid()
+{
+    if ( !InitHugeGrid() )
+        return false;
+
+    // Use one block for every BLOCK_ATTR_STEP rows, i.e. 1 million of them by
+    // default, and add them from top to bottom, as is usually done.
+    for ( int row = 0; row < gs_numRows; row += BLOCK_ATTR_STEP )
+    {
+        wxGridCellAttr* const attr = new wxGridCellAttr;
+        attr->SetBackgroundColour(*wxYELLOW);
+        gs_grid->SetAttrForBlock(wxGridBlockCoords(row, 0, row, 4), attr);
+    }
+
+    return true;
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC_WITH_INIT(GridSetRowSize, InitHugeGrid, DoneHugeGrid)
+{
+    const int h = gs_grid->GetDefaultRowSize();
+    for ( int n = 0; n < 1000; n++ )
+        gs_grid->SetRowSize(NextRow(), h + n % 10);
+
+    return true;
+}
+
+BENCHMARK_FUNC_WITH_INIT(GridYToRow, InitHugeGrid, DoneHugeGrid)
+{
+    const wxLongLong_t bottom = gs_grid->CellToRect(gs_numRows - 1, 0).GetBottom();
+
+    int found = 0;
+    for ( int n = 0; n < 1000; n++ )
+    {
+        const int y = static_cast<int>(NextRow() * bottom / gs_numRows);
+        if ( gs_grid->YToRow(y) != wxNOT_FOUND )
+            found++;
+    }
+
+    return found == 1000;
+}
+
+BENCHMARK_FUNC_WITH_INIT(GridCellToRect, InitHugeGrid, DoneHugeGrid)
+{
+    wxLongLong_t total = 0;
+    for ( int n = 0; n < 1000; n++ )
+        total += gs_grid->CellToRect(NextRow(), 0).y;
+
+    return total > 0;
+}
+
+BENCHMARK_FUNC_WITH_INIT(GridInsertDeleteRows, InitHugeGrid, DoneHugeGrid)
+{
+    const int row = NextRow();
+
+    return gs_grid->InsertRows(row, 10) && gs_grid->DeleteRows(row, 10);
+}
+
+// Retrieving the block attribute is logarithmic in the number of blocks as
+// only one of them spans each row here.
+BENCHMARK_FUNC_WITH_INIT(GridGetBlockAttr, InitBlockAttrGrid, DoneHugeGrid)
+{
+    wxGridTableBase* const table = gs_grid->GetTable();
+
+    int found = 0;
+    for ( int n = 0; n < 1000; n++ )
+    {
+        wxGridCellAttr* const
+            attr = table->GetAttr(NextRow(), 2, wxGridCellAttr::Any);
+        if ( attr )
+        {
+            found++;
+            attr->DecRef();
+        }
+    }
+
+    return found > 0;
+}
+
+// Setting the block attribute overlapping the existing blocks is linear in
+// their number, as all of them must be updated.
+BENCHMARK_FUNC_WITH_INIT(GridSetAttrForBlock, InitBlockAttrGrid, DoneHugeGrid)
+{
+    const int row = NextRow();
+
+    wxGridCellAttr* const attr = new wxGridCellAttr;
+    attr->SetBackgroundColour(*wxCYAN);
+    gs_grid->SetAttrForBlock(wxGridBlockCoords(row, 2, row + 1, 6), attr);
+
+    return true;
+}
+
+#endif // wxUSE_GRID
@@ -0,0 +1,116 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/rowheightcache.cpp
+// Purpose:     HeightCache benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/defs.h"
+
+#include "wx/generic/private/rowheightcache.h"
+
+#include "bench.h"
+
+namespace
+{
+
+HeightCache* gs_cache = nullptr;
+unsigned gs_numRows = 0;
+int gs_totalHeight = 0;
+
+// Used to generate the pseudo-random row indices cheaply.
+unsigned gs_seed = 0;
+
+unsigned NextRow()
+{
+    gs_seed = gs_seed * 1103515245 + 12345;
+    return (gs_seed >> 1) % gs_numRows;
+}
+
+// Use many different heights to create many short runs, which is the worst
+// case for the cache.
+int GetRowHeight(unsigned row)
+{
+    return 20 + static_cast<int>(row % 7);
+}
+
+bool InitHeightCache()
+{
+    // Use 1 million rows by default.
+    gs_numRows = static_cast<unsigned>(Bench::GetNumericParameter(1000000));
+
+    gs_cache = new HeightCache();
+
+    gs_totalHeight = 0;
+    for ( unsigned row = 0; row < gs_numRows; row++ )
+    {
+        gs_cache->Put(row, GetRowHeight(row));
+        gs_totalHeight += GetRowHeight(row);
+    }
+
+    return true;
+}
+
+void DoneHeightCache()
+{
+    delete gs_cache;
+    gs_cache = nullptr;
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC_WITH_INIT(HeightCacheFill, InitHeightCache, DoneHeightCache)
+{
+    // Fill the cache row by row, as wxDataViewCtrl does when scrolling.
+    HeightCache cache;
+    for ( unsigned row = 0; row < gs_numRows; row++ )
+        cache.Put(row, GetRowHeight(row));
+
+    int height = 0;
+    return cache.GetLineHeight(gs_numRows - 1, height);
+}
+
+BENCHMARK_FUNC_WITH_INIT(HeightCacheGetLineStart, InitHeightCache, DoneHeightCache)
+{
+    for ( int n = 0; n < 1000; n++ )
+    {
+        int start;
+        if ( !gs_cache->GetLineStart(NextRow(), start) )
+            return false;
+    }
+
+    return true;
+}
+
+BENCHMARK_FUNC_WITH_INIT(HeightCacheGetLineAt, InitHeightCache, DoneHeightCache)
+{
+    for ( int n = 0; n < 1000; n++ )
+    {
+        const int y = static_cast<int>(
+            static_cast<long long>(NextRow()) * gs_totalHeight / gs_numRows);
+
+        unsigned row;
+        if ( !gs_cache->GetLineAt(y, row) )
+            return false;
+    }
+
+    return true;
+}
+
+BENCHMARK_FUNC_WITH_INIT(HeightCacheChangeHeight, InitHeightCache, DoneHeightCache)
+{
+    // Change the height of a random row and then look up a position, which
+    // requires updating the runs following it.
+    const unsigned row = NextRow();
+    gs_cache->Put(row, GetRowHeight(row) + 1);
+
+    int start = 0;
+    if ( !gs_cache->GetLineStart(gs_numRows - 1, start) )
+        return false;
+
+    gs_cache->Put(row, GetRowHeight(row));
+
+    return true;
+}
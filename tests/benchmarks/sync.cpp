@@ -0,0 +1,405 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/sync.cpp
+// Purpose:     Synchronization objects benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "bench.h"
+
+#include "wx/msgqueue.h"
+#include "wx/thread.h"
+#include "wx/utils.h"
+
+#include <atomic>
+#include <vector>
+
+static const int NUM_ITER = 1000;
+
+// ----------------------------------------------------------------------------
+// Uncontended case: only the benchmark thread uses the objects
+// ----------------------------------------------------------------------------
+
+static wxMutex gs_mutex;
+static wxCriticalSection gs_critsect;
+static wxSemaphore gs_semaphore;
+static wxRWLock gs_rwlock;
+
+static int gs_counter = 0;
+
+BENCHMARK_FUNC(MutexLockUnlock)
+{
+    for ( int n = 0; n < NUM_ITER; n++ )
+    {
+        wxMutexLocker lock(gs_mutex);
+        gs_counter++;
+    }
+
+    return gs_counter > 0;
+}
+
+BENCHMARK_FUNC(CritSectEnterLeave)
+{
+    for ( int n = 0; n < NUM_ITER; n++ )
+    {
+        wxCriticalSectionLocker lock(gs_critsect);
+        gs_counter++;
+    }
+
+    return gs_counter > 0;
+}
+
+BENCHMARK_FUNC(SemaphorePostWait)
+{
+    for ( int n = 0; n < NUM_ITER; n++ )
+    {
+        if ( gs_semaphore.Post() != wxSEMA_NO_ERROR )
+            return false;
+
+        if ( gs_semaphore.Wait() != wxSEMA_NO_ERROR )
+            return false;
+    }
+
+    return true;
+}
+
+BENCHMARK_FUNC(RWLockReadLockUnlock)
+{
+    int numLocked = 0;
+    for ( int n = 0; n < NUM_ITER; n++ )
+    {
+        wxRWLockReadLocker lock(gs_rwlock);
+        if ( lock.IsOk() )
+            numLocked++;
+    }
+
+    return numLocked == NUM_ITER;
+}
+
+BENCHMARK_FUNC(RWLockWriteLockUnlock)
+{
+    for ( int n = 0; n < NUM_ITER; n++ )
+    {
+        wxRWLockWriteLocker lock(gs_rwlock);
+        gs_counter++;
+    }
+
+    return gs_counter > 0;
+}
+
+// ----------------------------------------------------------------------------
+// Contended case: background threads use the same objects continuously
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+std::atomic<bool> gs_stopContending;
+
+typedef void (*ContendingFunc)();
+
+// Thread continuously executing the given function until told to stop.
+class ContendingThread : public wxThread
+{
+public:
+    explicit ContendingThread(ContendingFunc func)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_func(func)
+    {
+    }
+
+protected:
+    virtual ExitCode Entry() override
+    {
+        while ( !gs_stopContending )
+            m_func();
+
+        return nullptr;
+    }
+
+private:
+    const ContendingFunc m_func;
+};
+
+std::vector<wxThread*> gs_contendingThreads;
+
+// Use as many background threads as there are other CPUs, but at least one.
+bool StartContendingThreads(ContendingFunc func)
+{
+    gs_stopContending = false;
+
+    const int numThreads = wxMax(wxThread::GetCPUCount() - 1, 1);
+    for ( int n = 0; n < numThreads; n++ )
+    {
+        wxThread* const thread = new ContendingThread(func);
+        if ( thread->Run() != wxTHREAD_NO_ERROR )
+        {
+            delete thread;
+            return false;
+        }
+
+        gs_contendingThreads.push_back(thread);
+    }
+
+    return true;
+}
+
+void StopContendingThreads()
+{
+    gs_stopContending = true;
+
+    for ( wxThread* thread : gs_contendingThreads )
+    {
+        thread->Wait();
+        delete thread;
+    }
+
+    gs_contendingThreads.clear();
+}
+
+void LockMutex()
+{
+    wxMutexLocker lock(gs_mutex);
+    gs_counter++;
+}
+
+void LockRead()
+{
+    wxRWLockReadLocker lock(gs_rwlock);
+    const int value = gs_counter;
+    wxUnusedVar(value);
+}
+
+bool InitMutexContended() { return StartContendingThreads(LockMutex); }
+bool InitRWLockContended() { return StartContendingThreads(LockRead); }
+
+} // anonymous namespace
+
+BENCHMARK_FUNC_WITH_INIT(MutexContended,
+                         InitMutexContended, StopContendingThreads)
+{
+    for ( int n = 0; n < NUM_ITER; n++ )
+    {
+        wxMutexLocker lock(gs_mutex);
+        gs_counter++;
+    }
+
+    return gs_counter > 0;
+}
+
+BENCHMARK_FUNC_WITH_INIT(RWLockReadContended,
+                         InitRWLockContended, StopContendingThreads)
+{
+    int numLocked = 0;
+    for ( int n = 0; n < NUM_ITER; n++ )
+    {
+        wxRWLockReadLocker lock(gs_rwlock);
+        if ( lock.IsOk() )
+            numLocked++;
+    }
+
+    return numLocked == NUM_ITER;
+}
+
+// ----------------------------------------------------------------------------
+// Ping-pong between two threads, measuring the wake up latency
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+wxSemaphore gs_ping, gs_pong;
+wxMessageQueue<int> gs_queuePing, gs_queuePong;
+wxBoundedMessageQueue<int> gs_boundedPing(16), gs_boundedPong(16);
+
+enum PingPongKind
+{
+    PingPong_Semaphore,
+    PingPong_MessageQueue,
+    PingPong_BoundedQueue
+};
+
+class PongThread : public wxThread
+{
+public:
+    explicit PongThread(PingPongKind kind)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_kind(kind)
+    {
+    }
+
+protected:
+    virtual ExitCode Entry() override
+    {
+        for ( ;; )
+        {
+            int msg;
+            switch ( m_kind )
+            {
+                case PingPong_Semaphore:
+                    gs_ping.Wait();
+                    if ( gs_stopContending )
+                        return nullptr;
+
+                    gs_pong.Post();
+                    break;
+
+                case PingPong_MessageQueue:
+                    if ( gs_queuePing.Receive(msg) != wxMSGQUEUE_NO_ERROR || !msg )
+                        return nullptr;
+
+                    gs_queuePong.Post(msg);
+                    break;
+
+                case PingPong_BoundedQueue:
+                    if ( gs_boundedPing.Receive(msg) != wxMSGQUEUE_NO_ERROR || !msg )
+                        return nullptr;
+
+                    gs_boundedPong.Post(msg);
+                    break;
+            }
+        }
+    }
+
+private:
+    const PingPongKind m_kind;
+};
+
+wxThread* gs_pongThread = nullptr;
+
+bool StartPongThread(PingPongKind kind)
+{
+    gs_stopContending = false;
+
+    gs_pongThread = new PongThread(kind);
+    if ( gs_pongThread->Run() != wxTHREAD_NO_ERROR )
+    {
+        delete gs_pongThread;
+        gs_pongThread = nullptr;
+        return false;
+    }
+
+    return true;
+}
+
+void StopPongThread()
+{
+    gs_stopContending = true;
+    gs_ping.Post();
+    gs_queuePing.Post(0);
+    gs_boundedPing.Post(0);
+
+    gs_pongThread->Wait();
+    delete gs_pongThread;
+    gs_pongThread = nullptr;
+
+    // Consume the extra message and semaphore count which could have been
+    // left unused by the thread.
+    gs_ping.TryWait();
+    gs_queuePing.Clear();
+
+    std::vector<int> unused;
+    gs_boundedPing.ReceiveMany(unused, 16);
+}
+
+bool InitSemaphorePingPong() { return StartPongThread(PingPong_Semaphore); }
+bool InitMessageQueuePingPong() { return StartPongThread(PingPong_MessageQueue); }
+bool InitBoundedQueuePingPong() { return StartPongThread(PingPong_BoundedQueue); }
+
+} // anonymous namespace
+
+BENCHMARK_FUNC_WITH_INIT(SemaphorePingPong,
+                         InitSemaphorePingPong, StopPongThread)
+{
+    for ( int n = 0; n < NUM_ITER; n++ )
+    {
+        gs_ping.Post();
+        if ( gs_pong.Wait() != wxSEMA_NO_ERROR )
+            return false;
+    }
+
+    return true;
+}
+
+BENCHMARK_FUNC_WITH_INIT(MessageQueuePingPong,
+                         InitMessageQueuePingPong, StopPongThread)
+{
+    for ( int n = 1; n <= NUM_ITER; n++ )
+    {
+        gs_queuePing.Post(n);
+
+        int msg;
+        if ( gs_queuePong.Receive(msg) != wxMSGQUEUE_NO_ERROR || msg != n )
+            return false;
+    }
+
+    return true;
+}
+
+BENCHMARK_FUNC_WITH_INIT(BoundedQueuePingPong,
+                         InitBoundedQueuePingPong, StopPongThread)
+{
+    for ( int n = 1; n <= NUM_ITER; n++ )
+    {
+        gs_boundedPing.Post(n);
+
+        int msg;
+        if ( gs_boundedPong.Receive(msg) != wxMSGQUEUE_NO_ERROR || msg != n )
+            return false;
+    }
+
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Throughput: a background thread posts messages as fast as possible
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+wxBoundedMessageQueue<int> gs_boundedThroughput(1024);
+
+void PostToBoundedQueue()
+{
+    gs_boundedThroughput.PostTimeout(10, 1);
+}
+
+bool InitBoundedQueueThroughput()
+{
+    return StartContendingThreads(PostToBoundedQueue);
+}
+
+void StopBoundedQueueThroughput()
+{
+    // Make sure the producers are not blocked on a full queue.
+    gs_stopContending = true;
+
+    std::vector<int> unused;
+    while ( gs_boundedThroughput.ReceiveMany(unused, 1024, 20) )
+        unused.clear();
+
+    StopContendingThreads();
+
+    while ( gs_boundedThroughput.ReceiveMany(unused, 1024) )
+        unused.clear();
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC_WITH_INIT(BoundedQueueReceiveMany,
+                         InitBoundedQueueThroughput, StopBoundedQueueThroughput)
+{
+    std::vector<int> msgs;
+    msgs.reserve(NUM_ITER);
+
+    while ( msgs.size() < NUM_ITER )
+    {
+        if ( !gs_boundedThroughput.ReceiveMany(msgs, NUM_ITER - msgs.size(), -1) )
+            return false;
+    }
+
+    return true;
+}
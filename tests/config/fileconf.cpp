@@ -18,10 +18,12 @@
 #ifndef WX_PRECOMP
 #endif // WX_PRECOMP
 
+#include "wx/file.h"
 #include "wx/fileconf.h"
 #include "wx/sstream.h"
 #include "wx/log.h"
 
+#include "testfile.h"
 #include "testlog.h"
 
 static const char *testconfig =
@@ -628,6 +630,60 @@ TEST_CASE("wxFileConfig::ReadFloat", "[fileconfig][config]")
     CHECK( f == -9876.5432f );
 }
 
+TEST_CASE("wxFileConfig::LocalFile", "[fileconfig][config]")
+{
+    TestFile tf;
+
+    // Use all kinds of line endings and don't sort the entries.
+    {
+        wxFile f(tf.GetName(), wxFile::write);
+        REQUIRE( f.Write("# comment\r\n"
+                         "b=2\r\n"
+                         "A=1\r"
+                         "\r\n"
+                         "[group]\n"
+                         "key = \"quoted\\tvalue\"\n"
+                         "[Group/sub]\n"
+                         "x=y") );
+    }
+
+    {
+        wxFileConfig fc("", "", tf.GetName(), "", wxCONFIG_USE_LOCAL_FILE);
+
+        CHECK( fc.Read("a", "") == "1" );
+        CHECK( fc.Read("/GROUP/key", "") == "quoted\tvalue" );
+        CHECK( fc.Read("/group/sub/X", "") == "y" );
+        CHECK( fc.GetNumberOfGroups() == 1 );
+
+        // The entries are still enumerated in alphabetical order.
+        wxString name;
+        long cookie;
+        REQUIRE( fc.GetFirstEntry(name, cookie) );
+        CHECK( name == "A" );
+        REQUIRE( fc.GetNextEntry(name, cookie) );
+        CHECK( name == "b" );
+        CHECK( !fc.GetNextEntry(name, cookie) );
+
+        CHECK( fc.Write("b", "3") );
+        CHECK( fc.Write("/group/new", "value") );
+    }
+
+    // Only the modified lines are changed when saving the file.
+    wxFile f(tf.GetName());
+    wxString contents;
+    REQUIRE( f.ReadAll(&contents) );
+    CHECK( wxTextFile::Translate(contents, wxTextFileType_Unix) ==
+           "# comment\n"
+           "b=3\n"
+           "A=1\n"
+           "\n"
+           "[group]\n"
+           "key = \"quoted\\tvalue\"\n"
+           "new=value\n"
+           "[Group/sub]\n"
+           "x=y\n" );
+}
+
 TEST_CASE("wxFileConfig::LongLong", "[fileconfig][config][longlong]")
 {
     wxFileConfig fc("", "", "", "", 0); // Don't use any files.
@@ -861,6 +861,378 @@ TEST_CASE_METHOD(MultiColumnsDataViewCtrlTestCase,
     CHECK( m_lastColumn->GetWidth() >= lastColumnMinWidth );
 }
 
+#ifdef wxHAS_GENERIC_DATAVIEWCTRL
+
+// Model with a single top level container containing leaf items identified by
+// numbers, which can be added and removed in bulk.
+class DataViewCtrlBulkTestModel : public wxDataViewModel
+{
+public:
+    explicit DataViewCtrlBulkTestModel(const wxVector<unsigned>& children)
+        : m_children(children)
+    {
+    }
+
+    static wxDataViewItem GetItem(unsigned n)
+    {
+        return wxDataViewItem(wxUIntToPtr(n));
+    }
+
+    static wxDataViewItem GetTopItem() { return GetItem(1); }
+
+    // Insert the given children at the specified position and notify about
+    // all of them at once, in the order given by the array.
+    void InsertChildren(size_t pos, const wxVector<unsigned>& children)
+    {
+        m_children.insert(m_children.begin() + pos,
+                          children.begin(), children.end());
+
+        wxDataViewItemArray items;
+        for ( size_t n = 0; n < children.size(); n++ )
+            items.push_back(GetItem(children[n]));
+
+        ItemsAdded(GetTopItem(), items);
+    }
+
+    void DeleteChildren(const wxVector<unsigned>& children)
+    {
+        wxDataViewItemArray items;
+        for ( size_t n = 0; n < children.size(); n++ )
+        {
+            m_children.erase(std::find(m_children.begin(), m_children.end(),
+                                       children[n]));
+            items.push_back(GetItem(children[n]));
+        }
+
+        ItemsDeleted(GetTopItem(), items);
+    }
+
+    void GetValue(wxVariant &variant, const wxDataViewItem &item,
+                  unsigned int WXUNUSED(col)) const override
+    {
+        variant = wxString::Format("%u", wxPtrToUInt(item.GetID()));
+    }
+
+    bool SetValue(const wxVariant &WXUNUSED(variant),
+                  const wxDataViewItem &WXUNUSED(item),
+                  unsigned int WXUNUSED(col)) override
+    {
+        return false;
+    }
+
+    wxDataViewItem GetParent(const wxDataViewItem &item) const override
+    {
+        return item == GetTopItem() ? wxDataViewItem() : GetTopItem();
+    }
+
+    bool IsContainer(const wxDataViewItem &item) const override
+    {
+        return !item.IsOk() || item == GetTopItem();
+    }
+
+    unsigned int GetChildren(const wxDataViewItem &item,
+                             wxDataViewItemArray &children) const override
+    {
+        if ( !item.IsOk() )
+        {
+            children.push_back(GetTopItem());
+            return 1;
+        }
+
+        for ( size_t n = 0; n < m_children.size(); n++ )
+            children.push_back(GetItem(m_children[n]));
+
+        return m_children.size();
+    }
+
+private:
+    wxVector<unsigned> m_children;
+};
+
+TEST_CASE("wxDVC::ItemsAddedDeleted", "[wxDataViewCtrl][add][delete]")
+{
+    std::unique_ptr<wxDataViewCtrl> dvc(new wxDataViewCtrl(wxTheApp->GetTopWindow(),
+                                                           wxID_ANY,
+                                                           wxDefaultPosition,
+                                                           wxSize(400, 400),
+                                                           wxDV_MULTIPLE));
+
+    DataViewCtrlBulkTestModel* const
+        model = new DataViewCtrlBulkTestModel({10, 11, 12, 13});
+    dvc->AssociateModel(model);
+    model->DecRef();
+
+    dvc->AppendTextColumn("Value", 0);
+
+    const wxDataViewItem top = DataViewCtrlBulkTestModel::GetTopItem();
+    dvc->Expand(top);
+
+    dvc->Select(DataViewCtrlBulkTestModel::GetItem(12));
+
+    // Check that all the items are shown in the model order, which also
+    // checks that the rows and the items can be mapped to each other.
+    auto checkRows = [&dvc, top](const wxVector<unsigned>& expected)
+    {
+        const wxRect topRect = dvc->GetItemRect(top);
+        REQUIRE( topRect.height > 0 );
+
+        wxDataViewItem item;
+        wxDataViewColumn* column;
+        for ( size_t n = 0; n <= expected.size(); n++ )
+        {
+            const wxPoint pos(topRect.x + 1,
+                              topRect.y + (n + 1)*topRect.height + 1);
+            dvc->HitTest(pos, item, column);
+
+            if ( n == expected.size() )
+            {
+                CHECK( !item.IsOk() );
+                break;
+            }
+
+            INFO("Item " << expected[n]);
+            CHECK( item == DataViewCtrlBulkTestModel::GetItem(expected[n]) );
+            CHECK( dvc->GetItemRect(item).y == pos.y - 1 );
+        }
+    };
+
+    checkRows({10, 11, 12, 13});
+
+    model->InsertChildren(1, {20, 21});
+    model->InsertChildren(6, {22, 23});
+    checkRows({10, 20, 21, 11, 12, 13, 22, 23});
+    CHECK( dvc->GetSelection() == DataViewCtrlBulkTestModel::GetItem(12) );
+
+    model->DeleteChildren({13, 20, 11, 23});
+    checkRows({10, 21, 12, 22});
+    CHECK( dvc->GetSelection() == DataViewCtrlBulkTestModel::GetItem(12) );
+
+    dvc->Collapse(top);
+    CHECK( dvc->GetItemRect(DataViewCtrlBulkTestModel::GetItem(21)).IsEmpty() );
+
+    model->DeleteChildren({10, 12});
+    dvc->Expand(top);
+    checkRows({21, 22});
+}
+
+// Model with a single top level container containing many containers with a
+// single leaf child each.
+class DataViewCtrlManyBranchesTestModel : public wxDataViewModel
+{
+public:
+    explicit DataViewCtrlManyBranchesTestModel(unsigned count)
+        : m_count(count)
+    {
+    }
+
+    static wxDataViewItem GetTopItem() { return wxDataViewItem(wxUIntToPtr(1)); }
+    static wxDataViewItem GetBranch(unsigned n) { return GetItem(2*n + 2); }
+    static wxDataViewItem GetLeaf(unsigned n) { return GetItem(2*n + 3); }
+
+    void GetValue(wxVariant &variant, const wxDataViewItem &item,
+                  unsigned int WXUNUSED(col)) const override
+    {
+        variant = wxString::Format("%u", wxPtrToUInt(item.GetID()));
+    }
+
+    bool SetValue(const wxVariant &WXUNUSED(variant),
+                  const wxDataViewItem &WXUNUSED(item),
+                  unsigned int WXUNUSED(col)) override
+    {
+        return false;
+    }
+
+    wxDataViewItem GetParent(const wxDataViewItem &item) const override
+    {
+        const unsigned id = wxPtrToUInt(item.GetID());
+        if ( id == 1 )
+            return wxDataViewItem();
+
+        return id % 2 ? GetItem(id - 1) : GetTopItem();
+    }
+
+    bool IsContainer(const wxDataViewItem &item) const override
+    {
+        return !item.IsOk() || wxPtrToUInt(item.GetID()) % 2 == 0 ||
+                    item == GetTopItem();
+    }
+
+    unsigned int GetChildren(const wxDataViewItem &item,
+                             wxDataViewItemArray &children) const override
+    {
+        if ( !item.IsOk() )
+        {
+            children.push_back(GetTopItem());
+            return 1;
+        }
+
+        if ( item != GetTopItem() )
+        {
+            children.push_back(GetItem(wxPtrToUInt(item.GetID()) + 1));
+            return 1;
+        }
+
+        for ( unsigned n = 0; n < m_count; n++ )
+            children.push_back(GetBranch(n));
+
+        return m_count;
+    }
+
+private:
+    static wxDataViewItem GetItem(unsigned id)
+    {
+        return wxDataViewItem(wxUIntToPtr(id));
+    }
+
+    const unsigned m_count;
+};
+
+// Expanding and collapsing the children of the same node one by one updates
+// the rows of their siblings incrementally, check that they remain correct.
+TEST_CASE("wxDVC::ExpandManyBranches", "[wxDataViewCtrl][expand]")
+{
+    std::unique_ptr<wxDataViewCtrl> dvc(new wxDataViewCtrl(wxTheApp->GetTopWindow(),
+                                                           wxID_ANY,
+                                                           wxDefaultPosition,
+                                                           wxSize(400, 400)));
+
+    const unsigned count = 100;
+    DataViewCtrlManyBranchesTestModel* const
+        model = new DataViewCtrlManyBranchesTestModel(count);
+    dvc->AssociateModel(model);
+    model->DecRef();
+
+    dvc->AppendTextColumn("Value", 0);
+
+    const wxDataViewItem top = DataViewCtrlManyBranchesTestModel::GetTopItem();
+    dvc->Expand(top);
+
+    const wxRect topRect = dvc->GetItemRect(top);
+    REQUIRE( topRect.height > 0 );
+
+    wxVector<bool> expanded(count, false);
+    auto checkRows = [&]()
+    {
+        int row = 1;
+        for ( unsigned n = 0; n < count; n++ )
+        {
+            INFO("Branch " << n);
+
+            const wxDataViewItem
+                branch = DataViewCtrlManyBranchesTestModel::GetBranch(n);
+            CHECK( dvc->GetItemRect(branch).y == topRect.y + row*topRect.height );
+            row++;
+
+            const wxDataViewItem
+                leaf = DataViewCtrlManyBranchesTestModel::GetLeaf(n);
+            if ( expanded[n] )
+            {
+                CHECK( dvc->GetItemRect(leaf).y == topRect.y + row*topRect.height );
+                row++;
+            }
+            else
+            {
+                CHECK( dvc->GetItemRect(leaf).IsEmpty() );
+            }
+        }
+    };
+
+    // Expand every other branch, starting from the last one.
+    for ( unsigned n = count; n > 0; n -= 2 )
+    {
+        dvc->Expand(DataViewCtrlManyBranchesTestModel::GetBranch(n - 1));
+        expanded[n - 1] = true;
+    }
+
+    checkRows();
+
+    // Then expand all the remaining ones and collapse some of them again.
+    for ( unsigned n = 0; n < count; n++ )
+    {
+        dvc->Expand(DataViewCtrlManyBranchesTestModel::GetBranch(n));
+        expanded[n] = true;
+    }
+
+    for ( unsigned n = 0; n < count; n += 3 )
+    {
+        dvc->Collapse(DataViewCtrlManyBranchesTestModel::GetBranch(n));
+        expanded[n] = false;
+    }
+
+    checkRows();
+}
+
+TEST_CASE("wxDVC::SortByValues", "[wxDataViewCtrl][sort]")
+{
+    std::unique_ptr<wxDataViewListCtrl> lc(new wxDataViewListCtrl(wxTheApp->GetTopWindow(),
+                                                                  wxID_ANY,
+                                                                  wxDefaultPosition,
+                                                                  wxSize(400, 400)));
+
+    wxDataViewColumn* const colText = lc->AppendTextColumn("Text");
+    wxDataViewColumn* const colNum =
+        new wxDataViewColumn("Number", new wxDataViewTextRenderer("long"), 1);
+    lc->AppendColumn(colNum, "long");
+
+    const struct
+    {
+        const char* text;
+        long num;
+    } data[] =
+    {
+        { "b", 2 },
+        { "c", 1 },
+        { "a", 2 },
+        { "b", 3 },
+    };
+
+    for ( const auto& d : data )
+    {
+        wxVector<wxVariant> values;
+        values.push_back(wxString(d.text));
+        values.push_back(d.num);
+        lc->AppendItem(values);
+    }
+
+    // Return the model rows in the order in which they're displayed.
+    auto getDisplayOrder = [&lc]()
+    {
+        wxVector<std::pair<int, int>> positions;
+        for ( int row = 0; row < static_cast<int>(lc->GetItemCount()); row++ )
+            positions.push_back(std::make_pair(lc->GetItemRect(lc->RowToItem(row)).y, row));
+
+        std::sort(positions.begin(), positions.end());
+
+        wxVector<int> order;
+        for ( size_t n = 0; n < positions.size(); n++ )
+            order.push_back(positions[n].second);
+
+        return order;
+    };
+
+    // The store created by the control itself uses the default comparison,
+    // but a store which could be derived from doesn't do it by default.
+    CHECK( lc->GetStore()->UsesDefaultCompare() );
+    wxObjectDataPtr<wxDataViewListStore> store(new wxDataViewListStore);
+    CHECK_FALSE( store->UsesDefaultCompare() );
+
+    colText->SetSortOrder(true);
+    lc->GetStore()->Resort();
+    CHECK( getDisplayOrder() == wxVector<int>{2, 0, 3, 1} );
+
+    // Items with the same value keep being ordered by their IDs, in the
+    // reverse order when sorting in descending order.
+    colText->SetSortOrder(false);
+    lc->GetStore()->Resort();
+    CHECK( getDisplayOrder() == wxVector<int>{1, 3, 0, 2} );
+
+    colNum->SetSortOrder(true);
+    lc->GetStore()->Resort();
+    CHECK( getDisplayOrder() == wxVector<int>{1, 0, 2, 3} );
+}
+
+#endif // wxHAS_GENERIC_DATAVIEWCTRL
+
 #if wxUSE_UIACTIONSIMULATOR
 
 TEST_CASE_METHOD(SingleSelectDataViewCtrlTestCase,
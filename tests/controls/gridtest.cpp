@@ -18,6 +18,7 @@
 
 #include "wx/grid.h"
 #include "wx/headerctrl.h"
+#include "wx/idlesched.h"
 #include "testableframe.h"
 #include "asserthelper.h"
 #include "wx/uiaction.h"
@@ -104,6 +105,9 @@ public:
     {
     }
 
+    using wxGrid::GetRowTop;
+    using wxGrid::GetRowBottom;
+
     wxGridCellAttr* CallGetCellAttr(int row, int col) const
     {
         return GetCellAttr(row, col);
@@ -1247,6 +1251,54 @@ TEST_CASE_METHOD(GridTestCase, "Grid::ColumnVisibility", "[grid]")
     CHECK( m_grid->IsColShown(1) );
 }
 
+TEST_CASE_METHOD(GridTestCase, "Grid::LinePositions", "[grid]")
+{
+    const int h = m_grid->GetDefaultRowSize();
+
+    m_grid->SetRowSize(2, 2*h);
+    m_grid->HideRow(4);
+
+    CHECK( m_grid->GetRowTop(3) == 4*h );
+    CHECK( m_grid->GetRowBottom(3) == 5*h );
+    CHECK( m_grid->GetRowTop(5) == 5*h );
+    CHECK( m_grid->GetRowBottom(9) == 10*h );
+
+    CHECK( m_grid->YToRow(0) == 0 );
+    CHECK( m_grid->YToRow(3*h) == 2 );
+    CHECK( m_grid->YToRow(4*h - 1) == 2 );
+    CHECK( m_grid->YToRow(4*h) == 3 );
+    CHECK( m_grid->YToRow(5*h) == 5 );
+    CHECK( m_grid->YToRow(10*h) == wxNOT_FOUND );
+    CHECK( m_grid->YToRow(10*h, true) == 9 );
+
+    SECTION("Reordered")
+    {
+        // Move the tall row to the top.
+        m_grid->SetRowPos(2, 0);
+
+        CHECK( m_grid->GetRowPos(2) == 0 );
+        CHECK( m_grid->GetRowPos(0) == 1 );
+        CHECK( m_grid->GetRowTop(0) == 2*h );
+        CHECK( m_grid->YToRow(h) == 2 );
+        CHECK( m_grid->YToRow(2*h) == 0 );
+
+        m_grid->SetRowSize(2, h);
+        CHECK( m_grid->GetRowTop(0) == h );
+        CHECK( m_grid->GetRowBottom(9) == 9*h );
+    }
+
+    SECTION("Inserted and deleted")
+    {
+        m_grid->InsertRows(0, 2);
+        CHECK( m_grid->GetRowTop(4) == 4*h );
+        CHECK( m_grid->YToRow(5*h) == 4 );
+
+        m_grid->DeleteRows(0, 3);
+        CHECK( m_grid->GetRowTop(1) == h );
+        CHECK( m_grid->GetRowBottom(8) == 9*h );
+    }
+}
+
 TEST_CASE_METHOD(GridTestCase, "Grid::LineFormatting", "[grid]")
 {
     CHECK(m_grid->GridLinesEnabled());
@@ -1836,6 +1888,29 @@ TEST_CASE_METHOD(GridTestCase, "Grid::AutoSizeColumn", "[grid]")
     }
 }
 
+TEST_CASE_METHOD(GridTestCase, "Grid::AutoSizeSampling", "[grid]")
+{
+    m_grid->AppendRows(1000);
+    m_grid->SetCellValue(777, 0, "This is a long string which is not sampled");
+
+    m_grid->AutoSizeColumn(0, false);
+    const int widthAll = m_grid->GetColSize(0);
+
+    m_grid->SetColSize(0, m_grid->GetDefaultColSize());
+    m_grid->SetAutoSizeSampling(10, true);
+    CHECK( m_grid->GetAutoSizeSampling() == 10 );
+
+    // The long string is neither visible nor sampled, so it's not measured.
+    m_grid->AutoSizeColumn(0, false);
+    CHECK( m_grid->GetColSize(0) < widthAll );
+
+    // But it is measured when we're idle.
+    while ( wxIdleTaskScheduler::Get().ProcessIdle() )
+        ;
+
+    CHECK( m_grid->GetColSize(0) == widthAll );
+}
+
 TEST_CASE_METHOD(GridTestCase, "Grid::DrawInvalidCell", "[grid][multicell]")
 {
     // Set up a multicell with inside an overflowing cell.
@@ -1955,6 +2030,69 @@ TEST_CASE_METHOD(GridTestCase, "Grid::CellAttribute", "[attr][cell][grid]")
     }
 }
 
+TEST_CASE_METHOD(GridTestCase, "Grid::AttrForBlock", "[attr][cell][grid]")
+{
+    const wxColour defColour = m_grid->GetDefaultCellBackgroundColour();
+
+    wxGridCellAttr* const attr = new wxGridCellAttr;
+    attr->SetBackgroundColour(*wxRED);
+    m_grid->SetAttrForBlock(wxGridBlockCoords(2, 0, 7, 1), attr);
+
+    CHECK( m_grid->GetCellBackgroundColour(1, 0) == defColour );
+    CHECK( m_grid->GetCellBackgroundColour(2, 0) == *wxRED );
+    CHECK( m_grid->GetCellBackgroundColour(7, 1) == *wxRED );
+    CHECK( m_grid->GetCellBackgroundColour(8, 1) == defColour );
+
+    SECTION("Priority")
+    {
+        // Cell attributes override the block ones...
+        m_grid->SetCellBackgroundColour(3, 0, *wxGREEN);
+        CHECK( m_grid->GetCellBackgroundColour(3, 0) == *wxGREEN );
+
+        // ... but other attributes of the block are still used.
+        m_grid->SetCellTextColour(4, 0, *wxBLUE);
+        CHECK( m_grid->GetCellBackgroundColour(4, 0) == *wxRED );
+        CHECK( m_grid->GetCellTextColour(4, 0) == *wxBLUE );
+    }
+
+    SECTION("Overlapping")
+    {
+        wxGridCellAttr* const attr2 = new wxGridCellAttr;
+        attr2->SetBackgroundColour(*wxGREEN);
+        m_grid->SetAttrForBlock(wxGridBlockCoords(4, 1, 5, 1), attr2);
+
+        CHECK( m_grid->GetCellBackgroundColour(4, 0) == *wxRED );
+        CHECK( m_grid->GetCellBackgroundColour(4, 1) == *wxGREEN );
+        CHECK( m_grid->GetCellBackgroundColour(5, 1) == *wxGREEN );
+        CHECK( m_grid->GetCellBackgroundColour(6, 1) == *wxRED );
+
+        m_grid->SetAttrForBlock(wxGridBlockCoords(3, 0, 5, 1), nullptr);
+        CHECK( m_grid->GetCellBackgroundColour(2, 1) == *wxRED );
+        CHECK( m_grid->GetCellBackgroundColour(4, 1) == defColour );
+        CHECK( m_grid->GetCellBackgroundColour(6, 0) == *wxRED );
+    }
+
+    SECTION("InsertDelete")
+    {
+        m_grid->InsertRows(5, 2);
+        CHECK( m_grid->GetCellBackgroundColour(5, 0) == *wxRED );
+        CHECK( m_grid->GetCellBackgroundColour(9, 0) == *wxRED );
+        CHECK( m_grid->GetCellBackgroundColour(10, 0) == defColour );
+
+        m_grid->InsertRows(0, 1);
+        CHECK( m_grid->GetCellBackgroundColour(2, 0) == defColour );
+        CHECK( m_grid->GetCellBackgroundColour(3, 0) == *wxRED );
+
+        m_grid->DeleteRows(0, 5);
+        CHECK( m_grid->GetCellBackgroundColour(0, 0) == *wxRED );
+        CHECK( m_grid->GetCellBackgroundColour(5, 0) == *wxRED );
+        CHECK( m_grid->GetCellBackgroundColour(6, 0) == defColour );
+
+        m_grid->DeleteCols(0, 1);
+        CHECK( m_grid->GetCellBackgroundColour(0, 0) == *wxRED );
+    }
+}
+
 namespace SetTable_ClearAttrCache
 {
 
@@ -2126,6 +2264,94 @@ TEST_CASE_METHOD(GridTestCase, "Grid::SetTable_ClearAttrCache", "[grid]")
 #endif // !__WXOSX__
 }
 
+namespace
+{
+
+// Table counting the calls to its value accessors.
+class BlockGridTable : public wxGridTableBase
+{
+public:
+    BlockGridTable() : m_valueCalls(0), m_blockCalls(0) { }
+
+    virtual int GetNumberRows() override { return 5; }
+    virtual int GetNumberCols() override { return 3; }
+
+    virtual wxString GetValue(int row, int col) override
+    {
+        m_valueCalls++;
+        return wxString::Format("%d:%d", row, col);
+    }
+
+    virtual void SetValue(int, int, const wxString&) override { }
+
+    virtual bool GetValuesBlock(const wxGridBlockCoords& block,
+                                std::vector<wxString>& values) override
+    {
+        m_blockCalls++;
+        for ( int row = block.GetTopRow(); row <= block.GetBottomRow(); row++ )
+        {
+            for ( int col = block.GetLeftCol(); col <= block.GetRightCol(); col++ )
+                values.push_back(wxString::Format("%d:%d", row, col));
+        }
+
+        return true;
+    }
+
+    int m_valueCalls,
+        m_blockCalls;
+};
+
+} // anonymous namespace
+
+TEST_CASE_METHOD(GridTestCase, "Grid::GetValuesBlock", "[grid]")
+{
+#if !defined(__WXOSX__)
+    BlockGridTable table;
+    m_grid->SetTable(&table);
+
+    SetTable_ClearAttrCache::UpdateGrid(m_grid);
+
+    // All the visible cells should have been retrieved at once.
+    CHECK( table.m_blockCalls > 0 );
+    CHECK( table.m_valueCalls == 0 );
+
+    // But the values shouldn't be cached outside of the repaint.
+    CHECK( m_grid->GetCellValue(1, 2) == "1:2" );
+    CHECK( table.m_valueCalls == 1 );
+
+    m_grid->SetTable(nullptr);
+#endif // !__WXOSX__
+}
+
+TEST_CASE_METHOD(GridTestCase, "Grid::RenderCache", "[grid]")
+{
+#if !defined(__WXOSX__)
+    using namespace SetTable_ClearAttrCache;
+
+    m_grid->EnableRenderCache();
+    CHECK( m_grid->IsRenderCacheEnabled() );
+
+    m_grid->SetCellRenderer(1, 1, new Renderer1);
+
+    drawCount1 = 0;
+    UpdateGrid(m_grid);
+    CHECK( drawCount1 == 1 );
+
+    // Changing another cell shouldn't redraw this one...
+    m_grid->SetCellValue(5, 0, "Changed");
+    m_grid->Update();
+    CHECK( drawCount1 == 1 );
+
+    // ... but changing it should.
+    m_grid->SetCellValue(1, 1, "Changed");
+    m_grid->Update();
+    CHECK( drawCount1 == 2 );
+
+    m_grid->EnableRenderCache(false);
+    CHECK( !m_grid->IsRenderCacheEnabled() );
+#endif // !__WXOSX__
+}
+
 #define CHECK_MULTICELL() CHECK_THAT( *m_grid, HasMulticellOnly(multi) )
 
 #define CHECK_NO_MULTICELL() CHECK_THAT( *m_grid, HasEmptyGrid() )
@@ -39,10 +39,14 @@ private:
     CPPUNIT_TEST_SUITE( VirtListCtrlTestCase );
         CPPUNIT_TEST( UpdateSelection );
         WXUISIM_TEST( DeselectedEvent );
+        CPPUNIT_TEST( RefreshItem );
+        CPPUNIT_TEST( VariableLineHeight );
     CPPUNIT_TEST_SUITE_END();
 
     void UpdateSelection();
     void DeselectedEvent();
+    void RefreshItem();
+    void VariableLineHeight();
 
     wxListCtrl *m_list;
 
@@ -149,4 +153,115 @@ void VirtListCtrlTestCase::DeselectedEvent()
 #endif
 }
 
+void VirtListCtrlTestCase::RefreshItem()
+{
+    // Virtual list control returning the items from the (changeable) data.
+    class DataListCtrl : public wxListCtrl
+    {
+    public:
+        DataListCtrl()
+            : wxListCtrl(wxTheApp->GetTopWindow(), wxID_ANY,
+                         wxPoint(0, 0), wxSize(400, 200),
+                         wxLC_REPORT | wxLC_VIRTUAL),
+              m_prefix("Old")
+        {
+            AppendColumn("Col0");
+            SetItemCount(10);
+        }
+
+        wxString m_prefix;
+
+    protected:
+        virtual wxString OnGetItemText(long item, long WXUNUSED(column)) const override
+        {
+            return wxString::Format("%s %ld", m_prefix, item);
+        }
+    };
+
+    std::unique_ptr<DataListCtrl> list(new DataListCtrl);
+
+    // Ensure the items are shown, and so possibly cached.
+    list->Refresh();
+    list->Update();
+    CPPUNIT_ASSERT_EQUAL( "Old 3", list->GetItemText(3) );
+
+    list->m_prefix = "New";
+    list->RefreshItem(3);
+    CPPUNIT_ASSERT_EQUAL( "New 3", list->GetItemText(3) );
+
+    list->RefreshItems(0, 9);
+    CPPUNIT_ASSERT_EQUAL( "New 4", list->GetItemText(4) );
+}
+
+void VirtListCtrlTestCase::VariableLineHeight()
+{
+    // Variable line height is only supported by the generic version.
+#if !(defined(__WXMSW__) || defined(__WXQT__)) || defined(__WXUNIVERSAL__)
+    // Virtual list control with the odd items twice as high as the even ones.
+    class TallListCtrl : public wxListCtrl
+    {
+    public:
+        TallListCtrl()
+            : wxListCtrl(wxTheApp->GetTopWindow(), wxID_ANY,
+                         wxPoint(0, 0), wxSize(400, 200),
+                         wxLC_REPORT | wxLC_VIRTUAL),
+              m_height(20)
+        {
+            AppendColumn("Col0");
+            EnableVariableLineHeight();
+            SetItemCount(10);
+        }
+
+        int m_height;
+
+    protected:
+        virtual wxString OnGetItemText(long item, long WXUNUSED(column)) const override
+        {
+            return wxString::Format("Item %ld", item);
+        }
+
+        virtual int OnGetItemHeight(long item) const override
+        {
+            return item % 2 ? 2*m_height : m_height;
+        }
+    };
+
+    std::unique_ptr<TallListCtrl> list(new TallListCtrl);
+    CPPUNIT_ASSERT( list->HasVariableLineHeight() );
+
+    wxRect rect0, rect1, rect3;
+    list->GetItemRect(0, rect0);
+    list->GetItemRect(1, rect1);
+    list->GetItemRect(3, rect3);
+    CPPUNIT_ASSERT_EQUAL( 20, rect0.height );
+    CPPUNIT_ASSERT_EQUAL( 40, rect1.height );
+    CPPUNIT_ASSERT_EQUAL( rect0.y + 20, rect1.y );
+    CPPUNIT_ASSERT_EQUAL( rect0.y + 80, rect3.y );
+
+    // Changing the heights is taken into account after refreshing the items.
+    list->m_height = 30;
+    list->RefreshItems(0, 9);
+    list->GetItemRect(3, rect3);
+    CPPUNIT_ASSERT_EQUAL( 60, rect3.height );
+    CPPUNIT_ASSERT_EQUAL( rect0.y + 120, rect3.y );
+
+    // Refreshing a single item only updates its own height, but still moves
+    // all the following items.
+    list->m_height = 20;
+    list->RefreshItem(1);
+    list->GetItemRect(1, rect1);
+    list->GetItemRect(3, rect3);
+    CPPUNIT_ASSERT_EQUAL( 40, rect1.height );
+    CPPUNIT_ASSERT_EQUAL( 60, rect3.height );
+    CPPUNIT_ASSERT_EQUAL( rect0.y + 100, rect3.y );
+
+    // And using the default height for all items after disabling it.
+    list->EnableVariableLineHeight(false);
+    list->GetItemRect(0, rect0);
+    list->GetItemRect(1, rect1);
+    CPPUNIT_ASSERT_EQUAL( rect0.height, rect1.height );
+    CPPUNIT_ASSERT_EQUAL( rect0.y + rect0.height, rect1.y );
+#endif
+}
+
 #endif // wxUSE_LISTCTRL
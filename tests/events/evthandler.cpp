@@ -14,6 +14,8 @@
 
 
 #include "wx/event.h"
+#include "wx/evtloopstats.h"
+#include "wx/scopeguard.h"
 
 // ----------------------------------------------------------------------------
 // test events and their handlers
@@ -510,6 +512,58 @@ TEST_CASE("Event::UnbindFromHandler", "[event][bind][unbind]")
     handler.ProcessEvent(e);
 }
 
+TEST_CASE("Event::HasHandlersFor", "[event][bind]")
+{
+    MyHandler handler;
+    CHECK( !handler.HasHandlersFor(MyEventType) );
+
+    handler.Bind(MyEventType, &MyHandler::OnMyEvent, &handler);
+    CHECK( handler.HasHandlersFor(MyEventType) );
+    CHECK( !handler.HasHandlersFor(wxEVT_IDLE) );
+
+    handler.Unbind(MyEventType, &MyHandler::OnMyEvent, &handler);
+    CHECK( !handler.HasHandlersFor(MyEventType) );
+
+    MyClassWithEventTable withTable;
+    CHECK( withTable.HasHandlersFor(wxEVT_IDLE) );
+    CHECK( !withTable.HasHandlersFor(wxEVT_THREAD) );
+}
+
+TEST_CASE("Event::Stats", "[event][stats]")
+{
+    CHECK( !wxEventLoopStats::Get() );
+
+    wxEventLoopStats::Enable();
+    wxON_BLOCK_EXIT1(wxEventLoopStats::Enable, false);
+
+    wxEventLoopStats* const stats = wxEventLoopStats::Get();
+    REQUIRE( stats );
+    stats->Reset();
+
+    MyHandler handler;
+    handler.Bind(MyEventType, [](MyEvent&) { wxMilliSleep(2); });
+
+    MyEvent e1, e2;
+    handler.ProcessEvent(e1);
+    handler.ProcessEvent(e2);
+
+    CHECK( stats->GetEventCount(MyEventType) == 2 );
+    CHECK( stats->GetHandlerTimes().GetCount() == 2 );
+    CHECK( stats->GetHandlerTimes().GetMax() >= 2000 );
+
+    const std::vector<wxEventLoopHandlerInfo>& slowest =
+        stats->GetSlowestHandlers();
+    REQUIRE( slowest.size() == 2 );
+    CHECK( slowest[0].eventType == MyEventType );
+    CHECK( slowest[0].duration >= slowest[1].duration );
+
+    stats->SetMaxSlowestHandlers(1);
+    CHECK( stats->GetSlowestHandlers().size() == 1 );
+
+    stats->Reset();
+    CHECK( stats->GetEventCount(MyEventType) == 0 );
+}
+
 // This is a compilation-time-only test: just check that a class inheriting
 // from wxEvtHandler non-publicly can use Bind() with its method, this used to
 // result in compilation errors.
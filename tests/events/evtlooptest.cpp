@@ -13,6 +13,7 @@
 #include "testprec.h"
 
 
+#include "wx/idlesched.h"
 #include "wx/timer.h"
 
 // ----------------------------------------------------------------------------
@@ -122,3 +123,56 @@ void EvtloopTestCase::TestExit()
     timerRun2.StartOnce(1);
     CPPUNIT_ASSERT_EQUAL( EXIT_CODE_OUTER_LOOP, loopOuter.Run() );
 }
+
+TEST_CASE("wxIdleTaskScheduler", "[evtloop][idle]")
+{
+    wxIdleTaskScheduler scheduler;
+    CHECK( !scheduler.HasTasks() );
+    CHECK( !scheduler.ProcessIdle() );
+
+    std::vector<int> calls;
+
+    int count = 0;
+    scheduler.AddTask([&]()
+        {
+            calls.push_back(1);
+            return ++count < 3 ? wxIDLE_TASK_MORE : wxIDLE_TASK_DONE;
+        });
+
+    const int idWait = scheduler.AddTask([&]()
+        {
+            calls.push_back(2);
+            return wxIDLE_TASK_WAIT;
+        }, 1);
+
+    CHECK( scheduler.HasTasks() );
+
+    // The task with higher priority runs first and the other one runs until
+    // it's done, as it's well within its time budget.
+    CHECK( !scheduler.ProcessIdle() );
+
+    const std::vector<int> expected{2, 1, 1, 1};
+    CHECK( calls == expected );
+
+    // The waiting task is not called until it's woken up.
+    calls.clear();
+    CHECK( !scheduler.ProcessIdle() );
+    CHECK( calls.empty() );
+
+    scheduler.WakeUp(idWait);
+    CHECK( !scheduler.ProcessIdle() );
+    REQUIRE( calls.size() == 1 );
+    CHECK( calls[0] == 2 );
+
+    CHECK( scheduler.RemoveTask(idWait) );
+    CHECK( !scheduler.RemoveTask(idWait) );
+    CHECK( !scheduler.HasTasks() );
+
+    // Check that the time slice is respected.
+    scheduler.SetTimeSlice(20);
+    scheduler.AddTask([]() { wxMilliSleep(5); return wxIDLE_TASK_MORE; }, 0, 100);
+
+    wxStopWatch sw;
+    CHECK( scheduler.ProcessIdle() );
+    CHECK( sw.Time() < 100 );
+}
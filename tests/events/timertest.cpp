@@ -137,3 +137,65 @@ void TimerEventTestCase::Multiple()
     // more than one
     CPPUNIT_ASSERT( numTicks > 1 );
 }
+
+#include "wx/task.h"
+
+#ifdef wxHAS_COROUTINES
+
+namespace
+{
+
+wxTask<int> DoubleAfterSleep(int n)
+{
+    co_await wxSleepAsync(50);
+
+    co_return 2*n;
+}
+
+wxTask<> SleepAndExit(wxEventLoopBase& loop, int& result)
+{
+    result = co_await DoubleAfterSleep(21);
+
+    loop.Exit();
+}
+
+wxTask<> AwaitInvalid(bool& failed)
+{
+    wxTask<int> invalid;
+    try
+    {
+        co_await invalid;
+    }
+    catch ( ... )
+    {
+        failed = true;
+    }
+}
+
+} // anonymous namespace
+
+TEST_CASE("wxTask::Sleep", "[timer][coroutine]")
+{
+    wxEventLoop loop;
+
+    int result = 0;
+    wxTask<> task = SleepAndExit(loop, result);
+    CHECK( !task.IsDone() );
+
+    loop.Run();
+
+    CHECK( task.IsDone() );
+    CHECK( result == 42 );
+}
+
+TEST_CASE("wxTask::Invalid", "[coroutine]")
+{
+    // This coroutine never suspends, so it completes immediately.
+    bool failed = false;
+    wxTask<> task = AwaitInvalid(failed);
+
+    CHECK( task.IsDone() );
+    CHECK( failed );
+}
+
+#endif // wxHAS_COROUTINES
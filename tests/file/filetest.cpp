@@ -15,10 +15,15 @@
 
 #if wxUSE_FILE
 
+#include "wx/app.h"
+#include "wx/asyncfile.h"
+#include "wx/evtloop.h"
 #include "wx/file.h"
 
 #include "testfile.h"
 
+#include <vector>
+
 // ----------------------------------------------------------------------------
 // tests implementation
 // ----------------------------------------------------------------------------
@@ -153,6 +158,134 @@ TEST_CASE("wxTempFile", "[file][temp]")
     CheckFileContents(name, dataNew);
 }
 
+#if wxUSE_THREADS
+
+TEST_CASE("wxAsyncFile", "[file][async]")
+{
+    wxAsyncFileBackend backend = wxASYNC_FILE_BACKEND_THREADS;
+    SECTION("Default") { backend = wxASYNC_FILE_BACKEND_DEFAULT; }
+    SECTION("Threads") { }
+
+    TestFile tf;
+
+    wxAsyncFile file;
+    REQUIRE( file.Open(tf.GetName(), wxFile::read_write, wxS_DEFAULT, backend) );
+    if ( backend == wxASYNC_FILE_BACKEND_THREADS )
+        CHECK( file.GetBackend() == wxASYNC_FILE_BACKEND_THREADS );
+
+    std::vector<wxAsyncFileEvent> events;
+    const auto onEvent = [&events](wxAsyncFileEvent& event)
+    {
+        events.push_back(event);
+    };
+    file.Bind(wxEVT_ASYNC_FILE_READ, onEvent);
+    file.Bind(wxEVT_ASYNC_FILE_WRITE, onEvent);
+
+    // Use more blocks than can be submitted at once to the kernel.
+    const size_t BLOCK_SIZE = 4096;
+    const size_t NUM_BLOCKS = 100;
+
+    std::string data;
+    for ( size_t n = 0; data.size() < BLOCK_SIZE*NUM_BLOCKS; n++ )
+        data += static_cast<char>('a' + n % 26 + n / BLOCK_SIZE % 7);
+    data.resize(BLOCK_SIZE*NUM_BLOCKS);
+
+    // Write the blocks in the reverse order.
+    for ( size_t n = NUM_BLOCKS; n > 0; n-- )
+    {
+        const size_t offset = (n - 1)*BLOCK_SIZE;
+        CHECK( file.WriteAt(offset, &data[offset], BLOCK_SIZE) > 0 );
+    }
+
+    file.WaitAll();
+    CHECK( file.GetPendingCount() == 0 );
+
+    wxTheApp->ProcessPendingEvents();
+    REQUIRE( events.size() == NUM_BLOCKS );
+    for ( const auto& event : events )
+    {
+        CHECK( event.GetEventType() == wxEVT_ASYNC_FILE_WRITE );
+        CHECK( event.IsOk() );
+        CHECK( event.GetCount() == BLOCK_SIZE );
+    }
+
+    CHECK( file.Length() == static_cast<wxFileOffset>(data.size()) );
+
+    // Read everything back, asking for more than available, and let the
+    // event loop deliver the completion.
+    events.clear();
+
+    std::string buf(data.size() + 10, '\0');
+    const long id = file.ReadAt(0, &buf[0], buf.size());
+    CHECK( id > 0 );
+
+    wxEventLoop loop;
+    wxEventLoopActivator activate(&loop);
+    for ( int n = 0; n < 10 && events.empty(); n++ )
+    {
+        loop.DispatchTimeout(1000);
+        wxTheApp->ProcessPendingEvents();
+    }
+
+    REQUIRE( events.size() == 1 );
+    CHECK( events[0].GetEventType() == wxEVT_ASYNC_FILE_READ );
+    CHECK( events[0].GetRequestId() == id );
+    CHECK( events[0].GetOffset() == 0 );
+    CHECK( events[0].GetRequestedCount() == buf.size() );
+    CHECK( events[0].GetCount() == data.size() );
+    CHECK( events[0].IsOk() );
+    CHECK( buf.compare(0, data.size(), data) == 0 );
+
+    // The completion events are sent for the cancelled requests too.
+    events.clear();
+    for ( size_t n = 0; n < NUM_BLOCKS; n++ )
+        CHECK( file.ReadAt(n*BLOCK_SIZE, &buf[n*BLOCK_SIZE], BLOCK_SIZE) > 0 );
+
+    file.CancelAll();
+    file.WaitAll();
+
+    wxTheApp->ProcessPendingEvents();
+    REQUIRE( events.size() == NUM_BLOCKS );
+    for ( const auto& event : events )
+    {
+        INFO( "Request " << event.GetRequestId() );
+        CHECK( (event.IsCancelled() || event.GetCount() == BLOCK_SIZE) );
+        CHECK( event.GetErrorCode() == 0 );
+    }
+
+    CHECK( file.Close() );
+    CHECK( !file.IsOpened() );
+}
+
+TEST_CASE("wxAsyncFile::Error", "[file][async]")
+{
+    TestFile tf;
+
+    wxAsyncFile file;
+    REQUIRE( file.Open(tf.GetName(), wxFile::write) );
+
+    std::vector<wxAsyncFileEvent> events;
+    file.Bind(wxEVT_ASYNC_FILE_READ, [&events](wxAsyncFileEvent& event)
+    {
+        events.push_back(event);
+    });
+
+    // Reading from a file opened for writing only must fail.
+    char buf[16];
+    CHECK( file.ReadAt(0, buf, sizeof(buf)) > 0 );
+
+    file.WaitAll();
+    wxTheApp->ProcessPendingEvents();
+
+    REQUIRE( events.size() == 1 );
+    CHECK( !events[0].IsOk() );
+    CHECK( !events[0].IsCancelled() );
+    CHECK( events[0].GetErrorCode() != 0 );
+    CHECK( events[0].GetCount() == 0 );
+}
+
+#endif // wxUSE_THREADS
+
 #ifdef __LINUX__
 
 // Check that GetSize() works correctly for special files.
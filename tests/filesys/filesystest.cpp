@@ -21,9 +21,16 @@
 
 #if wxUSE_FILESYSTEM
 
+#include "wx/fs_arc.h"
 #include "wx/fs_data.h"
 #include "wx/fs_mem.h"
+#include "wx/mstream.h"
 #include "wx/sstream.h"
+#include "wx/tarstrm.h"
+#include "wx/wfstream.h"
+#include "wx/zipstrm.h"
+
+#include "testfile.h"
 
 #include <memory>
 
@@ -270,6 +277,217 @@ TEST_CASE("wxFileSystem::MemoryFSHandler", "[filesys][memoryfshandler][find]")
 
     CHECK( fs.FindFirst(url) == url );
     CHECK( fs.FindNext() == "" );
+
+    // Adding many files between FindFirst() and FindNext() must not affect
+    // the search in progress, even if it results in the hash table rehashing.
+    wxMemoryFSHandler::AddFile("baz.txt", "baz contents");
+    wxString found = fs.FindFirst("memory:*.txt");
+
+    for ( int n = 0; n < 100; n++ )
+        wxMemoryFSHandler::AddFile(wxString::Format("file%d.dat", n), "data");
+
+    wxArrayString all;
+    for ( ; !found.empty(); found = fs.FindNext() )
+        all.push_back(found);
+
+    all.Sort();
+    REQUIRE( all.size() == 2 );
+    CHECK( all[0] == "memory:baz.txt" );
+    CHECK( all[1] == url );
+
+    std::unique_ptr<wxFSFile> file(fs.OpenFile("memory:baz.txt"));
+    REQUIRE( file );
+    CHECK( file->GetModificationTime().IsValid() );
+    CHECK( (wxDateTime::Now() - file->GetModificationTime()).GetSeconds() < 60 );
+
+    for ( int n = 0; n < 100; n++ )
+        wxMemoryFSHandler::RemoveFile(wxString::Format("file%d.dat", n));
+    wxMemoryFSHandler::RemoveFile("baz.txt");
+}
+
+
+TEST_CASE("wxFileSystem::MemoryFSHandlerNoCopy", "[filesys][memoryfshandler]")
+{
+    class AutoMemoryFSHandler
+    {
+    public:
+        AutoMemoryFSHandler()
+            : m_handler(new wxMemoryFSHandler())
+        {
+            wxFileSystem::AddHandler(m_handler.get());
+        }
+
+        ~AutoMemoryFSHandler()
+        {
+            wxFileSystem::RemoveHandler(m_handler.get());
+        }
+
+    private:
+        std::unique_ptr<wxMemoryFSHandler> const m_handler;
+    } autoMemoryFSHandler;
+
+    static const char staticData[] = "static contents";
+
+    wxMemoryBuffer buf;
+    buf.AppendData("buffer contents", 15);
+
+    wxMemoryFSHandler::AddStaticFileWithMimeType("static.txt",
+                                                 staticData,
+                                                 strlen(staticData),
+                                                 "text/plain");
+    wxMemoryFSHandler::AddFileWithMimeType("buffer.htm", buf, "text/html");
+
+    wxFileSystem fs;
+
+    // Check that the data is used directly, without being copied.
+    const auto checkFile = [&fs](const char* name,
+                                 const void* data,
+                                 const char* mimetype)
+    {
+        INFO("File " << name);
+
+        std::unique_ptr<wxFSFile> file(fs.OpenFile(wxString("memory:") + name));
+        REQUIRE( file.get() );
+
+        wxMemoryInputStream* const
+            mis = dynamic_cast<wxMemoryInputStream*>(file->GetStream());
+        REQUIRE( mis );
+        CHECK( mis->GetInputStreamBuffer()->GetBufferStart() == data );
+        CHECK( file->GetMimeType() == mimetype );
+    };
+
+    checkFile("static.txt", staticData, "text/plain");
+    checkFile("buffer.htm", buf.GetData(), "text/html");
+
+    // Adding a file with the same name again fails without replacing it.
+    {
+        wxLogNull noLog;
+        wxMemoryFSHandler::AddFile("buffer.htm", "other contents", 14);
+    }
+    checkFile("buffer.htm", buf.GetData(), "text/html");
+
+    // The stream remains usable even if the file is removed.
+    std::unique_ptr<wxFSFile> file(fs.OpenFile("memory:buffer.htm"));
+    REQUIRE( file.get() );
+
+    wxMemoryFSHandler::RemoveFile("static.txt");
+    wxMemoryFSHandler::RemoveFile("buffer.htm");
+    buf = wxMemoryBuffer();
+
+    CHECK( !fs.OpenFile("memory:static.txt") );
+
+    char contents[16] = { 0 };
+    CHECK( file->GetStream()->Read(contents, sizeof(contents)).LastRead() == 15 );
+    CHECK( wxString(contents) == "buffer contents" );
 }
 
+#if wxUSE_FS_ARCHIVE && wxUSE_ZIPSTREAM && wxUSE_TARSTREAM
+
+namespace
+{
+
+// Create an archive with a few files in the given format.
+void CreateTestArchive(wxArchiveOutputStream& arc)
+{
+    const char* const names[] = { "a.txt", "dir/b.txt", "dir/c.txt" };
+    for ( const char* name : names )
+    {
+        REQUIRE( arc.PutNextEntry(name) );
+        REQUIRE( arc.WriteAll(name, strlen(name)) );
+    }
+
+    REQUIRE( arc.Close() );
+}
+
+// Return the contents of the given file or empty string if it can't be opened.
+wxString ReadFSFile(wxFileSystem& fs, const wxString& location)
+{
+    std::unique_ptr<wxFSFile> file(fs.OpenFile(location));
+    if ( !file )
+        return wxString();
+
+    wxStringOutputStream sos;
+    sos.Write(*file->GetStream());
+    return sos.GetString();
+}
+
+} // anonymous namespace
+
+TEST_CASE("wxFileSystem::ArchiveFSHandler", "[filesys][archivefshandler]")
+{
+    TempFile zipFile("fsarctest.zip");
+    {
+        wxFileOutputStream out(zipFile.GetName());
+        wxZipOutputStream zip(out);
+        CreateTestArchive(zip);
+    }
+
+    TempFile tarFile("fsarctest.tar");
+    {
+        wxFileOutputStream out(tarFile.GetName());
+        wxTarOutputStream tar(out);
+        CreateTestArchive(tar);
+    }
+
+    // Install wxArchiveFSHandler just for the duration of this test.
+    class AutoArchiveFSHandler
+    {
+    public:
+        AutoArchiveFSHandler() : m_handler(new wxArchiveFSHandler())
+        {
+            wxFileSystem::AddHandler(m_handler.get());
+        }
+        ~AutoArchiveFSHandler()
+        {
+            wxFileSystem::RemoveHandler(m_handler.get());
+        }
+    private:
+        std::unique_ptr<wxArchiveFSHandler> const m_handler;
+    } autoArchiveFSHandler;
+
+    const size_t limit = wxArchiveFSHandler::GetCacheLimit();
+    CHECK( limit == wxArchiveFSHandler::DEFAULT_CACHE_LIMIT );
+
+    SECTION("Default") { }
+    SECTION("NoCache")
+    {
+        // Only the last used archive is kept in the cache.
+        wxArchiveFSHandler::SetCacheLimit(0);
+    }
+    SECTION("Shared")
+    {
+        wxArchiveFSHandler::EnableSharedCache();
+    }
+
+    for ( int n = 0; n < 2; n++ )
+    {
+        wxFileSystem fs;
+
+        CHECK( ReadFSFile(fs, "fsarctest.zip#zip:dir/b.txt") == "dir/b.txt" );
+        CHECK( ReadFSFile(fs, "fsarctest.tar#tar:dir/c.txt") == "dir/c.txt" );
+        CHECK( ReadFSFile(fs, "fsarctest.zip#zip:a.txt") == "a.txt" );
+        CHECK( ReadFSFile(fs, "fsarctest.tar#tar:a.txt") == "a.txt" );
+        CHECK( ReadFSFile(fs, "fsarctest.zip#zip:dir/c.txt") == "dir/c.txt" );
+        CHECK( ReadFSFile(fs, "fsarctest.zip#zip:nosuchfile") == "" );
+
+        wxString found = fs.FindFirst("fsarctest.zip#zip:dir/*.txt", wxFILE);
+        wxArrayString files;
+        while ( !found.empty() )
+        {
+            files.push_back(found);
+            found = fs.FindNext();
+        }
+
+        files.Sort();
+        REQUIRE( files.size() == 2 );
+        CHECK( files[0] == "fsarctest.zip#zip:dir/b.txt" );
+        CHECK( files[1] == "fsarctest.zip#zip:dir/c.txt" );
+    }
+
+    wxArchiveFSHandler::EnableSharedCache(false);
+    wxArchiveFSHandler::SetCacheLimit(limit);
+}
+
+#endif // wxUSE_FS_ARCHIVE && wxUSE_ZIPSTREAM && wxUSE_TARSTREAM
+
 #endif // wxUSE_FILESYSTEM
@@ -270,3 +270,59 @@ TEST_CASE("RowHeightCacheTestCase::TestHeightCache", "[dataview][heightcache]")
     CHECK(hc.GetLineAt(22180, row) == false);
     CHECK(row == 666);
 }
+
+// ----------------------------------------------------------------------------
+// TestHeightCacheChange
+// ----------------------------------------------------------------------------
+TEST_CASE("RowHeightCacheTestCase::TestHeightCacheChange", "[dataview][heightcache]")
+{
+    HeightCache hc;
+
+    // use many different heights: row i has height 10 + i % 5
+    int total = 0;
+    for (unsigned int i = 0; i < 100; i++)
+    {
+        hc.Put(i, 10 + i % 5);
+        total += 10 + i % 5;
+    }
+
+    int start = 0;
+    int height = 0;
+    unsigned int row = 666;
+
+    CHECK(hc.GetLineInfo(7, start, height) == true);
+    CHECK(start == 10 + 11 + 12 + 13 + 14 + 10 + 11);
+    CHECK(height == 12);
+
+    CHECK(hc.GetLineAt(total - 1, row) == true);
+    CHECK(row == 99);
+    CHECK(hc.GetLineAt(total, row) == false);
+
+    // change the height of a row in the middle: this must shift all the
+    // following rows
+    hc.Put(50, 100);
+
+    CHECK(hc.GetLineHeight(50, height) == true);
+    CHECK(height == 100);
+    CHECK(hc.GetLineHeight(51, height) == true);
+    CHECK(height == 11);
+
+    CHECK(hc.GetLineStart(99, start) == true);
+    CHECK(start == total - 14 + 100 - 10);
+
+    CHECK(hc.GetLineAt(start, row) == true);
+    CHECK(row == 99);
+
+    // and restore it
+    hc.Put(50, 10);
+
+    CHECK(hc.GetLineStart(99, start) == true);
+    CHECK(start == total - 14);
+
+    for (unsigned int i = 0; i < 100; i++)
+    {
+        CHECK(hc.GetLineStart(i, start) == true);
+        CHECK(hc.GetLineAt(start, row) == true);
+        CHECK(row == i);
+    }
+}
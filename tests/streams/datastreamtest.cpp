@@ -20,6 +20,7 @@
 #include <vector>
 
 #include "wx/datstrm.h"
+#include "wx/mstream.h"
 #include "wx/wfstream.h"
 #include "wx/math.h"
 
@@ -298,3 +299,104 @@ void DataStreamTestCase::NaNRW()
 }
 
 
+
+namespace
+{
+
+// Write the values using the functions writing a single value at a time.
+template <typename T>
+void WriteOneByOne(wxDataOutputStream& out, const std::vector<T>& values)
+{
+    for ( size_t n = 0; n < values.size(); n++ )
+        out << values[n];
+}
+
+} // anonymous namespace
+
+TEST_CASE("wxDataStream::Arrays", "[stream][datastream]")
+{
+    bool bigEndian = false;
+    SECTION("LE") { }
+    SECTION("BE") { bigEndian = true; }
+
+    // Use enough values to need more than one internal buffer.
+    const size_t count = 3000;
+
+    std::vector<wxUint16> values16(count);
+    std::vector<wxUint32> values32(count);
+    std::vector<wxUint64> values64(count);
+    std::vector<double> valuesDouble(count);
+    std::vector<float> valuesFloat(count);
+    for ( size_t n = 0; n < count; n++ )
+    {
+        values16[n] = static_cast<wxUint16>(n * 0x0101);
+        values32[n] = static_cast<wxUint32>(n * 0x01020304);
+        values64[n] = static_cast<wxUint64>(n) * wxULL(0x0102030405060708);
+        valuesDouble[n] = n / 7.;
+        valuesFloat[n] = static_cast<float>(n / 3.);
+    }
+
+    wxMemoryOutputStream memArrays;
+    wxMemoryOutputStream memValues;
+    {
+        wxDataOutputStream outArrays(memArrays);
+        wxDataOutputStream outValues(memValues);
+
+        outArrays.BigEndianOrdered(bigEndian);
+        outValues.BigEndianOrdered(bigEndian);
+        outArrays.UseBasicPrecisions();
+        outValues.UseBasicPrecisions();
+
+        outArrays.Write16(&values16[0], count);
+        outArrays.Write32(&values32[0], count);
+        outArrays.Write64(&values64[0], count);
+        outArrays.WriteDouble(&valuesDouble[0], count);
+        outArrays.WriteFloat(&valuesFloat[0], count);
+
+        WriteOneByOne(outValues, values16);
+        WriteOneByOne(outValues, values32);
+        WriteOneByOne(outValues, values64);
+        WriteOneByOne(outValues, valuesDouble);
+        WriteOneByOne(outValues, valuesFloat);
+    }
+
+    // Writing arrays must produce exactly the same data as writing the
+    // individual values.
+    const size_t len = memArrays.GetLength();
+    REQUIRE( len == count*(2 + 4 + 8 + 8 + 4) );
+    REQUIRE( static_cast<size_t>(memValues.GetLength()) == len );
+
+    std::vector<char> dataArrays(len);
+    std::vector<char> dataValues(len);
+    memArrays.CopyTo(&dataArrays[0], len);
+    memValues.CopyTo(&dataValues[0], len);
+    CHECK( dataArrays == dataValues );
+
+    // Check that the correct byte order was used.
+    CHECK( dataArrays[count*2 + 4] == (bigEndian ? 0x01 : 0x04) );
+
+    // And that reading the data back gives the original values.
+    wxMemoryInputStream memIn(&dataArrays[0], len);
+    wxDataInputStream in(memIn);
+    in.BigEndianOrdered(bigEndian);
+    in.UseBasicPrecisions();
+
+    std::vector<wxUint16> read16(count);
+    std::vector<wxUint32> read32(count);
+    std::vector<wxUint64> read64(count);
+    std::vector<double> readDouble(count);
+    std::vector<float> readFloat(count);
+
+    in.Read16(&read16[0], count);
+    in.Read32(&read32[0], count);
+    in.Read64(&read64[0], count);
+    in.ReadDouble(&readDouble[0], count);
+    in.ReadFloat(&readFloat[0], count);
+    CHECK( in.IsOk() );
+
+    CHECK( read16 == values16 );
+    CHECK( read32 == values32 );
+    CHECK( read64 == values64 );
+    CHECK( readDouble == valuesDouble );
+    CHECK( readFloat == valuesFloat );
+}
@@ -19,6 +19,9 @@
 #include "wx/wfstream.h"
 
 #include "bstream.h"
+#include "testfile.h"
+
+#include <vector>
 
 #define DATABUFFER_SIZE     1024
 
@@ -144,3 +147,194 @@ wxString fileStream::GetInFileName() const
 // Register the stream sub suite, by using some stream helper macro.
 // Note: Don't forget to connect it to the base suite (See: bstream.cpp => StreamCase::suite())
 STREAM_TEST_SUBSUITE_NAMED_REGISTRATION(fileStream)
+
+TEST_CASE("wxMappedFileInputStream", "[stream][file]")
+{
+    const wxString filename = wxS("mappedstream.test");
+
+    char buf[DATABUFFER_SIZE];
+    for ( size_t i = 0; i < DATABUFFER_SIZE; i++ )
+        buf[i] = static_cast<char>(i % 0xFF);
+
+    {
+        wxFileOutputStream out(filename);
+        REQUIRE( out.Write(buf, DATABUFFER_SIZE).IsOk() );
+    }
+
+    TempFile autoRemove(filename);
+
+    wxMappedFileInputStream in(filename);
+    REQUIRE( in.IsOk() );
+    CHECK( in.IsSeekable() );
+    CHECK( in.GetLength() == DATABUFFER_SIZE );
+    REQUIRE( in.GetDataLen() == DATABUFFER_SIZE );
+    CHECK( memcmp(in.GetData(), buf, DATABUFFER_SIZE) == 0 );
+
+    SECTION("Read")
+    {
+        char data[DATABUFFER_SIZE];
+        CHECK( in.Read(data, 100).LastRead() == 100 );
+        CHECK( in.TellI() == 100 );
+        CHECK( in.Read(data + 100, DATABUFFER_SIZE - 100).LastRead()
+                == DATABUFFER_SIZE - 100 );
+        CHECK( memcmp(data, buf, DATABUFFER_SIZE) == 0 );
+
+        CHECK_FALSE( in.CanRead() );
+        CHECK( in.Read(data, 1).LastRead() == 0 );
+        CHECK( in.Eof() );
+    }
+
+    SECTION("PeekData")
+    {
+        size_t len = 0;
+        const void* p = in.PeekData(&len);
+        CHECK( p == in.GetData() );
+        CHECK( len == DATABUFFER_SIZE );
+
+        CHECK( in.Skip(10) == 10 );
+        CHECK( in.TellI() == 10 );
+        CHECK( static_cast<char>(in.GetC()) == buf[10] );
+
+        p = in.PeekData(&len);
+        CHECK( len == DATABUFFER_SIZE - 11 );
+        CHECK( *static_cast<const char*>(p) == buf[11] );
+
+        CHECK( in.Skip(DATABUFFER_SIZE) == DATABUFFER_SIZE - 11 );
+        in.PeekData(&len);
+        CHECK( len == 0 );
+        CHECK_FALSE( in.CanRead() );
+        CHECK( in.Skip(1) == 0 );
+        CHECK( in.Eof() );
+    }
+
+    SECTION("Ungetch")
+    {
+        CHECK( in.Skip(5) == 5 );
+        CHECK( in.Ungetch("xyz", 3) == 3 );
+        CHECK( in.TellI() == 2 );
+        CHECK( in.Peek() == 'x' );
+
+        size_t len = 0;
+        const char* p = static_cast<const char*>(in.PeekData(&len));
+        REQUIRE( len == 3 );
+        CHECK( memcmp(p, "xyz", 3) == 0 );
+
+        CHECK( in.Skip(4) == 4 );
+        CHECK( in.TellI() == 6 );
+        CHECK( in.Peek() == buf[6] );
+    }
+
+    SECTION("Seek")
+    {
+        CHECK( in.SeekI(-10, wxFromEnd) == DATABUFFER_SIZE - 10 );
+        CHECK( static_cast<char>(in.GetC()) == buf[DATABUFFER_SIZE - 10] );
+        CHECK( in.SeekI(20) == 20 );
+        CHECK( in.Peek() == buf[20] );
+        CHECK( in.SeekI(DATABUFFER_SIZE + 1) == wxInvalidOffset );
+        CHECK( in.SeekI(-1) == wxInvalidOffset );
+    }
+
+    SECTION("AccessHint")
+    {
+        // Whether the hint is supported depends on the platform, but it
+        // must not affect the data.
+        in.SetAccessHint(wxMAPPED_ACCESS_RANDOM);
+        CHECK( in.SeekI(500) == 500 );
+        CHECK( static_cast<char>(in.GetC()) == buf[500] );
+    }
+}
+
+TEST_CASE("wxMappedFileInputStream::Special", "[stream][file]")
+{
+    SECTION("Empty")
+    {
+        const wxString filename = wxS("mappedstream-empty.test");
+        {
+            wxFile file(filename, wxFile::write);
+            REQUIRE( file.IsOpened() );
+        }
+
+        TempFile autoRemove(filename);
+
+        wxMappedFileInputStream in(filename);
+        REQUIRE( in.IsOk() );
+        CHECK( in.GetLength() == 0 );
+        CHECK_FALSE( in.CanRead() );
+        CHECK_FALSE( in.IsMapped() );
+
+        char c;
+        CHECK( in.Read(&c, 1).LastRead() == 0 );
+        CHECK( in.Eof() );
+    }
+
+    SECTION("Nonexistent")
+    {
+        wxLogNull noLog;
+
+        wxMappedFileInputStream in(wxS("no-such-file.test"));
+        CHECK_FALSE( in.IsOk() );
+    }
+}
+
+TEST_CASE("wxFileStream::ScatterGather", "[stream][file]")
+{
+    const wxString filename = wxS("filestream-iovec.test");
+    TempFile autoRemove(filename);
+
+    // Use more buffers than can be passed to writev() at once on some
+    // systems to check that they're all written.
+    std::vector<char> data(2000);
+    for ( size_t n = 0; n < data.size(); n++ )
+        data[n] = static_cast<char>(n % 251);
+
+    {
+        std::vector<wxStreamConstIOVec> outVec;
+        for ( size_t n = 0; n < data.size(); n += 2 )
+        {
+            outVec.push_back({&data[n], 1});
+            outVec.push_back({nullptr, 0});
+            outVec.push_back({&data[n + 1], 1});
+        }
+
+        wxFileOutputStream out(filename);
+        REQUIRE( out.IsOk() );
+        CHECK( out.WriteV(outVec.data(), outVec.size()).LastWrite() == 2000 );
+        CHECK( out.IsOk() );
+    }
+
+    wxFileInputStream in(filename);
+    REQUIRE( in.IsOk() );
+    REQUIRE( in.GetLength() == 2000 );
+
+    // The data put back into the stream must be read first.
+    char c = 0;
+    REQUIRE( in.Read(&c, 1).LastRead() == 1 );
+    CHECK( c == data[0] );
+    in.Ungetch(c);
+
+    char buf1[3],
+         buf2[997],
+         buf3[1500];
+    wxStreamIOVec inVec[] =
+    {
+        { buf1, sizeof(buf1) },
+        { buf2, sizeof(buf2) },
+        { buf3, sizeof(buf3) },
+    };
+
+    // As the Ungetch() buffer is not empty, the generic version is used.
+    CHECK( in.ReadV(inVec, WXSIZEOF(inVec)).LastRead() == 2000 );
+    CHECK( memcmp(buf1, &data[0], 3) == 0 );
+    CHECK( memcmp(buf2, &data[3], 997) == 0 );
+    CHECK( memcmp(buf3, &data[1000], 1000) == 0 );
+
+    // And now read using readv(), the last buffer can't be filled.
+    REQUIRE( in.SeekI(1) == 1 );
+    CHECK( in.ReadV(inVec, WXSIZEOF(inVec)).LastRead() == 1999 );
+    CHECK( memcmp(buf1, &data[1], 3) == 0 );
+    CHECK( memcmp(buf2, &data[4], 997) == 0 );
+    CHECK( memcmp(buf3, &data[1001], 999) == 0 );
+
+    CHECK( in.ReadV(inVec, WXSIZEOF(inVec)).LastRead() == 0 );
+    CHECK( in.Eof() );
+}
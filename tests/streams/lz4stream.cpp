@@ -0,0 +1,180 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/streams/lz4stream.cpp
+// Purpose:     Unit tests for LZ4 stream classes
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#include "testprec.h"
+
+
+#if wxUSE_LIBLZ4 && wxUSE_STREAMS
+
+#include "wx/mstream.h"
+#include "wx/lz4stream.h"
+
+#include "bstream.h"
+
+class LZ4Stream : public BaseStreamTestCase<wxLZ4InputStream, wxLZ4OutputStream>
+{
+public:
+    LZ4Stream();
+
+    CPPUNIT_TEST_SUITE(LZ4Stream);
+        // Base class stream tests.
+        CPPUNIT_TEST(Input_GetSizeFail);
+        CPPUNIT_TEST(Input_GetC);
+        CPPUNIT_TEST(Input_Read);
+        CPPUNIT_TEST(Input_Eof);
+        CPPUNIT_TEST(Input_LastRead);
+        CPPUNIT_TEST(Input_CanRead);
+        CPPUNIT_TEST(Input_SeekIFail);
+        CPPUNIT_TEST(Input_TellI);
+        CPPUNIT_TEST(Input_Peek);
+        CPPUNIT_TEST(Input_Ungetch);
+
+        CPPUNIT_TEST(Output_PutC);
+        CPPUNIT_TEST(Output_Write);
+        CPPUNIT_TEST(Output_LastWrite);
+        CPPUNIT_TEST(Output_SeekOFail);
+        CPPUNIT_TEST(Output_TellO);
+    CPPUNIT_TEST_SUITE_END();
+
+protected:
+    wxLZ4InputStream *DoCreateInStream() override;
+    wxLZ4OutputStream *DoCreateOutStream() override;
+
+private:
+    wxDECLARE_NO_COPY_CLASS(LZ4Stream);
+};
+
+STREAM_TEST_SUBSUITE_NAMED_REGISTRATION(LZ4Stream)
+
+LZ4Stream::LZ4Stream()
+{
+    // Disable TellI() and TellO() tests in the base class which don't work
+    // with the compressed streams.
+    m_bSimpleTellITest =
+    m_bSimpleTellOTest = true;
+}
+
+wxLZ4InputStream *LZ4Stream::DoCreateInStream()
+{
+    // Compress some data.
+    const char data[] = "This is just some test data for LZ4 streams unit test";
+    const size_t len = sizeof(data);
+
+    wxMemoryOutputStream outmem;
+    wxLZ4OutputStream outz(outmem);
+    outz.Write(data, len);
+    REQUIRE( outz.LastWrite() == len );
+    REQUIRE( outz.Close() );
+
+    wxMemoryInputStream* const inmem = new wxMemoryInputStream(outmem);
+    REQUIRE( inmem->IsOk() );
+
+    // Give ownership of the memory input stream to the LZ4 stream.
+    return new wxLZ4InputStream(inmem);
+}
+
+wxLZ4OutputStream *LZ4Stream::DoCreateOutStream()
+{
+    return new wxLZ4OutputStream(new wxMemoryOutputStream());
+}
+
+namespace
+{
+
+// Return the data big enough to span several internal buffers.
+std::string GetLZ4TestData()
+{
+    std::string data;
+    for ( int n = 0; n < 100000; n++ )
+        data += wxString::Format("line %d of LZ4 test\n", n).utf8_string();
+
+    return data;
+}
+
+std::string LZ4Decompress(wxInputStream& in, const wxMemoryBuffer& dict)
+{
+    wxLZ4InputStream zin(in);
+    if ( dict.GetDataLen() )
+        CHECK( zin.SetDictionary(dict) );
+
+    wxMemoryOutputStream out;
+    zin.Read(out);
+    CHECK( zin.GetLastError() == wxSTREAM_EOF );
+
+    const wxStreamBuffer* const buf = out.GetOutputStreamBuffer();
+    return std::string(static_cast<const char*>(buf->GetBufferStart()),
+                       buf->GetIntPosition());
+}
+
+} // anonymous namespace
+
+TEST_CASE("wxLZ4Stream::RoundTrip", "[stream][lz4]")
+{
+    const std::string data = GetLZ4TestData();
+
+    wxMemoryBuffer dict;
+
+    wxMemoryOutputStream mem;
+    {
+        wxLZ4OutputStream zout(mem, wxLZ4OutputStream::GetMaxLevel() / 2);
+
+        SECTION("Default") { }
+        SECTION("Dictionary")
+        {
+            const char* const text = "line of LZ4 test";
+            dict.AppendData(text, strlen(text));
+            REQUIRE( zout.SetDictionary(dict) );
+        }
+
+        REQUIRE( zout.WriteAll(data.data(), data.size()) );
+        REQUIRE( zout.Close() );
+    }
+
+    CHECK( mem.GetLength() < static_cast<wxFileOffset>(data.size()) );
+
+    wxMemoryInputStream in(mem);
+    CHECK( LZ4Decompress(in, dict) == data );
+}
+
+TEST_CASE("wxLZ4Stream::Frames", "[stream][lz4]")
+{
+    // Concatenated frames are decompressed as a single stream.
+    wxMemoryOutputStream mem;
+    for ( int n = 0; n < 2; n++ )
+    {
+        wxLZ4OutputStream zout(mem);
+        REQUIRE( zout.WriteAll("frame", 5) );
+    }
+
+    {
+        wxMemoryInputStream in(mem);
+        CHECK( LZ4Decompress(in, wxMemoryBuffer()) == "frameframe" );
+    }
+
+    // But truncated data results in an error.
+    wxMemoryInputStream in(mem.GetOutputStreamBuffer()->GetBufferStart(),
+                           mem.GetLength() - 1);
+    wxLZ4InputStream zin(in);
+
+    wxLogNull noLog;
+    char buf[16];
+    zin.Read(buf, sizeof(buf));
+    CHECK( zin.GetLastError() == wxSTREAM_READ_ERROR );
+}
+
+TEST_CASE("wxLZ4Stream::Factory", "[stream][lz4]")
+{
+    const wxFilterClassFactory* const
+        factory = wxFilterClassFactory::Find(".lz4", wxSTREAM_FILEEXT);
+    REQUIRE( factory );
+    CHECK( factory->CanHandle("project.lz4", wxSTREAM_FILEEXT) );
+    CHECK( factory->PopExtension("project.lz4") == "project" );
+}
+
+#endif // wxUSE_LIBLZ4 && wxUSE_STREAMS
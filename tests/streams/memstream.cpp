@@ -156,3 +156,41 @@ void memStream::Ctor_InFromOut()
 // Register the stream sub suite, by using some stream helper macro.
 // Note: Don't forget to connect it to the base suite (See: bstream.cpp => StreamCase::suite())
 STREAM_TEST_SUBSUITE_NAMED_REGISTRATION(memStream)
+
+TEST_CASE("wxStream::ScatterGather", "[stream]")
+{
+    wxMemoryOutputStream out;
+
+    const wxStreamConstIOVec outVec[] =
+    {
+        { "abc", 3 },
+        { nullptr, 0 },
+        { "defgh", 5 },
+    };
+
+    CHECK( out.WriteV(outVec, WXSIZEOF(outVec)).LastWrite() == 8 );
+    CHECK( out.IsOk() );
+    REQUIRE( out.GetLength() == 8 );
+
+    wxMemoryInputStream in(out);
+
+    char buf1[2],
+         buf2[4],
+         buf3[10];
+    wxStreamIOVec inVec[] =
+    {
+        { buf1, sizeof(buf1) },
+        { buf2, sizeof(buf2) },
+        { buf3, sizeof(buf3) },
+    };
+
+    // The last buffer can't be filled completely, so we should get only the
+    // remaining data in it.
+    CHECK( in.ReadV(inVec, WXSIZEOF(inVec)).LastRead() == 8 );
+    CHECK( memcmp(buf1, "ab", 2) == 0 );
+    CHECK( memcmp(buf2, "cdef", 4) == 0 );
+    CHECK( memcmp(buf3, "gh", 2) == 0 );
+
+    CHECK( in.ReadV(inVec, WXSIZEOF(inVec)).LastRead() == 0 );
+    CHECK( in.Eof() );
+}
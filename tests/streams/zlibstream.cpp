@@ -21,8 +21,13 @@
 #include "wx/mstream.h"
 #include "wx/txtstrm.h"
 #include "wx/buffer.h"
+#include "wx/filesys.h"
+#include "wx/fs_filter.h"
 
 #include "bstream.h"
+#include "testfile.h"
+
+#include <memory>
 
 using std::string;
 
@@ -548,3 +553,243 @@ void zlibStream::genExtTestData(wxTextOutputStream &out, const char *buf, int fl
 // Note: Don't forget to connect it to the base suite (See: bstream.cpp => StreamCase::suite())
 STREAM_TEST_SUBSUITE_NAMED_REGISTRATION(zlibStream)
 
+
+// ----------------------------------------------------------------------------
+// wxIndexedGzipInputStream tests
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Return the data big enough to have several checkpoints with a small span.
+std::string GetIndexedGzipTestData()
+{
+    std::string data;
+    unsigned long seed = 1;
+    for ( int n = 0; n < 100000; n++ )
+    {
+        seed = seed * 1103515245 + 12345;
+        data += wxString::Format("%d: %lu\n", n, (seed >> 8) % 1000000)
+                    .utf8_string();
+    }
+
+    return data;
+}
+
+void GzipCompress(wxOutputStream& out, const std::string& data)
+{
+    wxZlibOutputStream zout(out, -1, wxZLIB_GZIP);
+    REQUIRE( zout.WriteAll(data.data(), data.size()) );
+    REQUIRE( zout.Close() );
+}
+
+// Check that reading at the given offset returns the expected data.
+void CheckIndexedRead(wxInputStream& in, const std::string& data, size_t pos)
+{
+    INFO("Reading at " << pos);
+
+    char buf[100];
+    const size_t len = wxMin(sizeof(buf), data.size() - pos);
+
+    REQUIRE( in.SeekI(pos) == static_cast<wxFileOffset>(pos) );
+    REQUIRE( in.ReadAll(buf, len) );
+    CHECK( std::string(buf, len) == data.substr(pos, len) );
+    CHECK( in.TellI() == static_cast<wxFileOffset>(pos + len) );
+}
+
+} // anonymous namespace
+
+TEST_CASE("wxIndexedGzipInputStream::Seek", "[stream][zlib]")
+{
+    const std::string data = GetIndexedGzipTestData();
+
+    wxMemoryOutputStream mem;
+    GzipCompress(mem, data);
+
+    wxMemoryInputStream min(mem);
+    wxIndexedGzipInputStream in(min, wxZLIB_AUTO, 65536);
+    REQUIRE( in.IsSeekable() );
+    CHECK( !in.IsIndexComplete() );
+    CHECK( in.GetLength() == wxInvalidOffset );
+
+    // Seeking forward works even before the index is built.
+    CheckIndexedRead(in, data, 100000);
+    CheckIndexedRead(in, data, 10);
+
+    REQUIRE( in.BuildIndex() );
+    CHECK( in.IsIndexComplete() );
+    CHECK( in.GetLength() == static_cast<wxFileOffset>(data.size()) );
+    CHECK( in.GetCheckpointCount() > 5 );
+
+    // BuildIndex() doesn't change the current position.
+    CHECK( in.TellI() == 110 );
+
+    const size_t offsets[] = { 700000, 3, 65536, 65535, 400000, 0,
+                               data.size() - 10, 123456, data.size() / 2 };
+    for ( size_t n = 0; n < WXSIZEOF(offsets); n++ )
+        CheckIndexedRead(in, data, offsets[n]);
+
+    CHECK( in.SeekI(-5, wxFromEnd) ==
+            static_cast<wxFileOffset>(data.size() - 5) );
+    CHECK( in.SeekI(1, wxFromEnd) == wxInvalidOffset );
+
+    // Reading the entire stream from the start still works.
+    REQUIRE( in.SeekI(0) == 0 );
+    wxMemoryOutputStream out;
+    in.Read(out);
+    CHECK( in.GetLastError() == wxSTREAM_EOF );
+    CHECK( out.GetLength() == static_cast<wxFileOffset>(data.size()) );
+}
+
+TEST_CASE("wxIndexedGzipInputStream::Members", "[stream][zlib]")
+{
+    // Concatenated gzip members are decompressed as a single stream.
+    const std::string data = GetIndexedGzipTestData();
+    const std::string first = data.substr(0, 300000);
+    const std::string second = data.substr(300000);
+
+    wxMemoryOutputStream mem;
+    GzipCompress(mem, first);
+    GzipCompress(mem, second);
+
+    wxMemoryInputStream min(mem);
+    wxIndexedGzipInputStream in(min, wxZLIB_GZIP, 65536);
+    REQUIRE( in.BuildIndex() );
+    CHECK( in.GetLength() == static_cast<wxFileOffset>(data.size()) );
+
+    CheckIndexedRead(in, data, 299950);
+    CheckIndexedRead(in, data, 500000);
+    CheckIndexedRead(in, data, 250000);
+    CheckIndexedRead(in, data, data.size() - 1);
+}
+
+TEST_CASE("wxIndexedGzipInputStream::Index", "[stream][zlib]")
+{
+    const std::string data = GetIndexedGzipTestData();
+
+    wxMemoryOutputStream mem;
+    GzipCompress(mem, data);
+
+    wxMemoryOutputStream index;
+    {
+        wxMemoryInputStream min(mem);
+        wxIndexedGzipInputStream in(min, wxZLIB_AUTO, 65536);
+        REQUIRE( in.BuildIndex() );
+        REQUIRE( in.SaveIndex(index) );
+    }
+
+    wxMemoryInputStream min(mem);
+    wxIndexedGzipInputStream in(min, wxZLIB_AUTO, 65536);
+
+    SECTION("Valid")
+    {
+        wxMemoryInputStream indexIn(index);
+        REQUIRE( in.LoadIndex(indexIn) );
+        CHECK( in.IsIndexComplete() );
+        CHECK( in.GetLength() == static_cast<wxFileOffset>(data.size()) );
+
+        CheckIndexedRead(in, data, 600000);
+        CheckIndexedRead(in, data, 200000);
+    }
+
+    SECTION("Invalid")
+    {
+        wxMemoryInputStream indexIn("wxGZIDX0", 8);
+        CHECK( !in.LoadIndex(indexIn) );
+        CHECK( !in.IsIndexComplete() );
+        CHECK( in.GetCheckpointCount() == 0 );
+
+        // The stream is still usable without the index.
+        CheckIndexedRead(in, data, 600000);
+    }
+
+    SECTION("OtherData")
+    {
+        // The index for different data of the same length must be rejected.
+        std::string other = data;
+        other[100] = other[100] == 'x' ? 'y' : 'x';
+
+        wxMemoryOutputStream memOther;
+        GzipCompress(memOther, other);
+
+        wxMemoryInputStream minOther(memOther);
+        wxIndexedGzipInputStream inOther(minOther, wxZLIB_AUTO, 65536);
+
+        wxMemoryInputStream indexIn(index);
+        CHECK( !inOther.LoadIndex(indexIn) );
+        CHECK( inOther.GetCheckpointCount() == 0 );
+
+        CheckIndexedRead(inOther, other, 600000);
+    }
+
+    SECTION("Corrupted")
+    {
+        // Make the size of the first window, following the signature, the
+        // data length and checksum, format, span, length, count and the
+        // offsets of the point, huge.
+        wxMemoryBuffer buf;
+        buf.AppendData(index.GetOutputStreamBuffer()->GetBufferStart(),
+                       index.GetLength());
+
+        const size_t sizeOffset = 8 + 8 + 4 + 4 + 8 + 8 + 4 + 8 + 8 + 1;
+        REQUIRE( buf.GetDataLen() > sizeOffset + 4 );
+        memset(static_cast<char*>(buf.GetData()) + sizeOffset, 0xff, 4);
+
+        wxMemoryInputStream indexIn(buf.GetData(), buf.GetDataLen());
+        CHECK( !in.LoadIndex(indexIn) );
+        CHECK( in.GetCheckpointCount() == 0 );
+    }
+}
+
+TEST_CASE("wxIndexedGzipInputStream::FileSystem", "[stream][zlib][filesys]")
+{
+    const std::string data = GetIndexedGzipTestData();
+
+    // Use a name with the extension before ".gz" as wxFilterFSHandler uses
+    // it to determine the MIME type.
+    const wxString filename("zlibtest.txt.gz");
+
+    TempFile gzFile(filename);
+    {
+        wxFileOutputStream out(gzFile.GetName());
+        GzipCompress(out, data);
+    }
+
+    const wxString
+        indexName = wxIndexedGzipInputStream::GetIndexFileName(filename);
+    TempFile indexFile(indexName);
+    {
+        wxFileInputStream fin(gzFile.GetName());
+        wxIndexedGzipInputStream in(fin, wxZLIB_AUTO, 65536);
+        REQUIRE( in.BuildIndex() );
+        REQUIRE( in.SaveIndex(indexName) );
+    }
+
+    // Install wxFilterFSHandler just for the duration of this test.
+    class AutoFilterFSHandler
+    {
+    public:
+        AutoFilterFSHandler() : m_handler(new wxFilterFSHandler())
+        {
+            wxFileSystem::AddHandler(m_handler.get());
+        }
+        ~AutoFilterFSHandler()
+        {
+            wxFileSystem::RemoveHandler(m_handler.get());
+        }
+    private:
+        std::unique_ptr<wxFilterFSHandler> const m_handler;
+    } autoFilterFSHandler;
+
+    wxFileSystem fs;
+    std::unique_ptr<wxFSFile> file(fs.OpenFile(filename + "#gzip:"));
+    REQUIRE( file.get() );
+
+    // The index saved next to the file is used automatically.
+    wxInputStream* const in = file->GetStream();
+    REQUIRE( in->IsSeekable() );
+    CHECK( in->GetLength() == static_cast<wxFileOffset>(data.size()) );
+
+    CheckIndexedRead(*in, data, 700000);
+    CheckIndexedRead(*in, data, 1000);
+}
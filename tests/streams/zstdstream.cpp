@@ -0,0 +1,186 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/streams/zstdstream.cpp
+// Purpose:     Unit tests for Zstandard stream classes
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#include "testprec.h"
+
+
+#if wxUSE_LIBZSTD && wxUSE_STREAMS
+
+#include "wx/mstream.h"
+#include "wx/zstdstream.h"
+
+#include "bstream.h"
+
+class ZstdStream : public BaseStreamTestCase<wxZstdInputStream, wxZstdOutputStream>
+{
+public:
+    ZstdStream();
+
+    CPPUNIT_TEST_SUITE(ZstdStream);
+        // Base class stream tests.
+        CPPUNIT_TEST(Input_GetSizeFail);
+        CPPUNIT_TEST(Input_GetC);
+        CPPUNIT_TEST(Input_Read);
+        CPPUNIT_TEST(Input_Eof);
+        CPPUNIT_TEST(Input_LastRead);
+        CPPUNIT_TEST(Input_CanRead);
+        CPPUNIT_TEST(Input_SeekIFail);
+        CPPUNIT_TEST(Input_TellI);
+        CPPUNIT_TEST(Input_Peek);
+        CPPUNIT_TEST(Input_Ungetch);
+
+        CPPUNIT_TEST(Output_PutC);
+        CPPUNIT_TEST(Output_Write);
+        CPPUNIT_TEST(Output_LastWrite);
+        CPPUNIT_TEST(Output_SeekOFail);
+        CPPUNIT_TEST(Output_TellO);
+    CPPUNIT_TEST_SUITE_END();
+
+protected:
+    wxZstdInputStream *DoCreateInStream() override;
+    wxZstdOutputStream *DoCreateOutStream() override;
+
+private:
+    wxDECLARE_NO_COPY_CLASS(ZstdStream);
+};
+
+STREAM_TEST_SUBSUITE_NAMED_REGISTRATION(ZstdStream)
+
+ZstdStream::ZstdStream()
+{
+    // Disable TellI() and TellO() tests in the base class which don't work
+    // with the compressed streams.
+    m_bSimpleTellITest =
+    m_bSimpleTellOTest = true;
+}
+
+wxZstdInputStream *ZstdStream::DoCreateInStream()
+{
+    // Compress some data.
+    const char data[] = "This is just some test data for Zstandard streams unit test";
+    const size_t len = sizeof(data);
+
+    wxMemoryOutputStream outmem;
+    wxZstdOutputStream outz(outmem);
+    outz.Write(data, len);
+    REQUIRE( outz.LastWrite() == len );
+    REQUIRE( outz.Close() );
+
+    wxMemoryInputStream* const inmem = new wxMemoryInputStream(outmem);
+    REQUIRE( inmem->IsOk() );
+
+    // Give ownership of the memory input stream to the Zstandard stream.
+    return new wxZstdInputStream(inmem);
+}
+
+wxZstdOutputStream *ZstdStream::DoCreateOutStream()
+{
+    return new wxZstdOutputStream(new wxMemoryOutputStream());
+}
+
+namespace
+{
+
+// Return the data big enough to span several internal buffers.
+std::string GetZstdTestData()
+{
+    std::string data;
+    for ( int n = 0; n < 100000; n++ )
+        data += wxString::Format("line %d of Zstandard test\n", n).utf8_string();
+
+    return data;
+}
+
+std::string ZstdDecompress(wxInputStream& in, const wxMemoryBuffer& dict)
+{
+    wxZstdInputStream zin(in);
+    if ( dict.GetDataLen() )
+        CHECK( zin.SetDictionary(dict) );
+
+    wxMemoryOutputStream out;
+    zin.Read(out);
+    CHECK( zin.GetLastError() == wxSTREAM_EOF );
+
+    const wxStreamBuffer* const buf = out.GetOutputStreamBuffer();
+    return std::string(static_cast<const char*>(buf->GetBufferStart()),
+                       buf->GetIntPosition());
+}
+
+} // anonymous namespace
+
+TEST_CASE("wxZstdStream::RoundTrip", "[stream][zstd]")
+{
+    const std::string data = GetZstdTestData();
+
+    wxMemoryBuffer dict;
+
+    wxMemoryOutputStream mem;
+    {
+        wxZstdOutputStream zout(mem, wxZstdOutputStream::GetMaxLevel() / 2);
+
+        SECTION("Default") { }
+        SECTION("Threads")
+        {
+            // This may fail if the library doesn't support threads, but
+            // compressing must work in any case.
+            zout.SetThreadCount(2);
+        }
+        SECTION("Dictionary")
+        {
+            const char* const text = "line of Zstandard test";
+            dict.AppendData(text, strlen(text));
+            REQUIRE( zout.SetDictionary(dict) );
+        }
+
+        REQUIRE( zout.WriteAll(data.data(), data.size()) );
+        REQUIRE( zout.Close() );
+    }
+
+    CHECK( mem.GetLength() < static_cast<wxFileOffset>(data.size()) );
+
+    wxMemoryInputStream in(mem);
+    CHECK( ZstdDecompress(in, dict) == data );
+}
+
+TEST_CASE("wxZstdStream::Frames", "[stream][zstd]")
+{
+    // Concatenated frames are decompressed as a single stream.
+    wxMemoryOutputStream mem;
+    for ( int n = 0; n < 2; n++ )
+    {
+        wxZstdOutputStream zout(mem);
+        REQUIRE( zout.WriteAll("frame", 5) );
+    }
+
+    {
+        wxMemoryInputStream in(mem);
+        CHECK( ZstdDecompress(in, wxMemoryBuffer()) == "frameframe" );
+    }
+
+    // But truncated data results in an error.
+    wxMemoryInputStream in(mem.GetOutputStreamBuffer()->GetBufferStart(),
+                           mem.GetLength() - 1);
+    wxZstdInputStream zin(in);
+
+    wxLogNull noLog;
+    char buf[16];
+    zin.Read(buf, sizeof(buf));
+    CHECK( zin.GetLastError() == wxSTREAM_READ_ERROR );
+}
+
+TEST_CASE("wxZstdStream::Factory", "[stream][zstd]")
+{
+    const wxFilterClassFactory* const
+        factory = wxFilterClassFactory::Find(".zst", wxSTREAM_FILEEXT);
+    REQUIRE( factory );
+    CHECK( factory->CanHandle("project.zst", wxSTREAM_FILEEXT) );
+    CHECK( factory->PopExtension("project.zst") == "project" );
+}
+
+#endif // wxUSE_LIBZSTD && wxUSE_STREAMS
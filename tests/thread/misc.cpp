@@ -418,3 +418,95 @@ void MiscThreadTestCase::TestThreadConditions()
         nFinished++;
     }
 }
+
+TEST_CASE("wxSemaphore::Count", "[thread][semaphore]")
+{
+    wxSemaphore sem(0, 2);
+    REQUIRE( sem.IsOk() );
+
+    CHECK( sem.TryWait() == wxSEMA_BUSY );
+    CHECK( sem.WaitTimeout(10) == wxSEMA_TIMEOUT );
+
+    CHECK( sem.Post() == wxSEMA_NO_ERROR );
+    CHECK( sem.Post() == wxSEMA_NO_ERROR );
+    CHECK( sem.Post() == wxSEMA_OVERFLOW );
+
+    CHECK( sem.Wait() == wxSEMA_NO_ERROR );
+    CHECK( sem.WaitTimeout(10) == wxSEMA_NO_ERROR );
+    CHECK( sem.TryWait() == wxSEMA_BUSY );
+}
+
+TEST_CASE("wxRWLock", "[thread][rwlock]")
+{
+    wxRWLock lock;
+    REQUIRE( lock.IsOk() );
+
+    SECTION("Readers")
+    {
+        wxRWLockReadLocker reader1(lock);
+        CHECK( reader1.IsOk() );
+
+        // Another read lock can be acquired while this one is held...
+        CHECK( lock.TryLockRead() == wxMUTEX_NO_ERROR );
+        CHECK( lock.UnlockRead() == wxMUTEX_NO_ERROR );
+
+        // ... but not a write one.
+        CHECK( lock.TryLockWrite() == wxMUTEX_BUSY );
+    }
+
+    SECTION("Writer")
+    {
+        {
+            wxRWLockWriteLocker writer(lock);
+            CHECK( writer.IsOk() );
+
+            CHECK( lock.TryLockRead() == wxMUTEX_BUSY );
+        }
+
+        CHECK( lock.TryLockWrite() == wxMUTEX_NO_ERROR );
+        CHECK( lock.UnlockWrite() == wxMUTEX_NO_ERROR );
+    }
+
+    SECTION("Threads")
+    {
+        // Check that writers running in several threads exclude each other.
+        class WriterThread : public wxThread
+        {
+        public:
+            WriterThread(wxRWLock& lock, int& counter)
+                : wxThread(wxTHREAD_JOINABLE),
+                  m_lock(lock),
+                  m_counter(counter)
+            {
+            }
+
+        protected:
+            virtual ExitCode Entry() override
+            {
+                for ( int n = 0; n < 1000; n++ )
+                {
+                    wxRWLockWriteLocker writer(m_lock);
+                    m_counter++;
+                }
+
+                return nullptr;
+            }
+
+        private:
+            wxRWLock& m_lock;
+            int& m_counter;
+        };
+
+        int counter = 0;
+        WriterThread thread1(lock, counter),
+                     thread2(lock, counter);
+        REQUIRE( thread1.Run() == wxTHREAD_NO_ERROR );
+        REQUIRE( thread2.Run() == wxTHREAD_NO_ERROR );
+
+        thread1.Wait();
+        thread2.Wait();
+
+        wxRWLockReadLocker reader(lock);
+        CHECK( counter == 2000 );
+    }
+}
@@ -215,3 +215,101 @@ TEST_CASE("wxMessageQueue::NonCopyable", "[msgqueue]")
 
     CHECK( queue.ReceiveTimeout(0, nc2) == wxMSGQUEUE_TIMEOUT );
 }
+
+TEST_CASE("wxBoundedMessageQueue::Capacity", "[msgqueue]")
+{
+    wxBoundedMessageQueue<std::unique_ptr<int>> queue(3);
+    REQUIRE( queue.IsOk() );
+    CHECK( queue.GetCapacity() == 4 );
+
+    for ( int n = 0; n < 4; n++ )
+        CHECK( queue.TryPost(std::unique_ptr<int>(new int(n))) == wxMSGQUEUE_NO_ERROR );
+
+    std::unique_ptr<int> extra(new int(4));
+    CHECK( queue.TryPost(std::move(extra)) == wxMSGQUEUE_TIMEOUT );
+    CHECK( queue.PostTimeout(10, std::unique_ptr<int>()) == wxMSGQUEUE_TIMEOUT );
+
+    std::unique_ptr<int> msg;
+    CHECK( queue.Receive(msg) == wxMSGQUEUE_NO_ERROR );
+    CHECK( *msg == 0 );
+
+    std::vector<std::unique_ptr<int>> msgs;
+    CHECK( queue.ReceiveMany(msgs, 2) == 2 );
+    REQUIRE( msgs.size() == 2 );
+    CHECK( *msgs[0] == 1 );
+    CHECK( *msgs[1] == 2 );
+
+    // The remaining message is destroyed together with the queue.
+}
+
+TEST_CASE("wxBoundedMessageQueue::Threads", "[msgqueue]")
+{
+    typedef wxBoundedMessageQueue<int> BoundedQueue;
+
+    class ProducerThread : public wxThread
+    {
+    public:
+        ProducerThread(BoundedQueue& queue, int first, int count)
+            : wxThread(wxTHREAD_JOINABLE),
+              m_queue(queue), m_first(first), m_count(count)
+        {
+        }
+
+        virtual void *Entry() override
+        {
+            for ( int n = 0; n < m_count; n++ )
+            {
+                if ( m_queue.Post(m_first + n) != wxMSGQUEUE_NO_ERROR )
+                    return (wxThread::ExitCode)wxMSGQUEUE_MISC_ERROR;
+            }
+
+            return (wxThread::ExitCode)wxMSGQUEUE_NO_ERROR;
+        }
+
+    private:
+        BoundedQueue& m_queue;
+        const int m_first;
+        const int m_count;
+    };
+
+    static const int NUM_THREADS = 4;
+    static const int NUM_MSGS = 10000;
+
+    BoundedQueue queue(16);
+    REQUIRE( queue.IsOk() );
+
+    std::vector<std::unique_ptr<ProducerThread>> threads;
+    for ( int n = 0; n < NUM_THREADS; n++ )
+    {
+        threads.emplace_back(new ProducerThread(queue, n*NUM_MSGS, NUM_MSGS));
+        REQUIRE( threads.back()->Run() == wxTHREAD_NO_ERROR );
+    }
+
+    // Check that we receive every message exactly once and that messages
+    // from each producer arrive in order.
+    std::vector<int> next(NUM_THREADS);
+    for ( int n = 0; n < NUM_THREADS; n++ )
+        next[n] = n*NUM_MSGS;
+
+    int received = 0;
+    std::vector<int> msgs;
+    while ( received < NUM_THREADS*NUM_MSGS )
+    {
+        msgs.clear();
+        const size_t count = queue.ReceiveMany(msgs, 100, 10000);
+        REQUIRE( count > 0 );
+
+        for ( int msg : msgs )
+        {
+            CHECK( msg == next[msg / NUM_MSGS]++ );
+        }
+
+        received += static_cast<int>(count);
+    }
+
+    for ( auto& thread : threads )
+        CHECK( thread->Wait() == (wxThread::ExitCode)wxMSGQUEUE_NO_ERROR );
+
+    int msg;
+    CHECK( queue.ReceiveTimeout(0, msg) == wxMSGQUEUE_TIMEOUT );
+}
@@ -19,11 +19,19 @@
 
 #include "wx/xml/xml.h"
 #include "wx/sstream.h"
+#include "wx/wfstream.h"
+
+#include "testfile.h"
 
 #include <stdarg.h>
 
 #include <memory>
 
+#ifdef __UNIX__
+    #include <sys/stat.h>
+    #include <thread>
+#endif
+
 // ----------------------------------------------------------------------------
 // helpers for testing XML tree
 // ----------------------------------------------------------------------------
@@ -610,6 +618,84 @@ void XmlTestCase::Doctype()
     CPPUNIT_ASSERT( !dt.IsValid() );
 }
 
+TEST_CASE("XML::LoadFile", "[xml]")
+{
+    const wxString filename = wxS("xmltest-load.xml");
+    TempFile autoRemove(filename);
+
+    const char* const xml =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        "<root>\n"
+        "  <child attr=\"value\">text</child>\n"
+        "</root>\n";
+
+    {
+        wxFileOutputStream out(filename);
+        REQUIRE( out.Write(xml, strlen(xml)).IsOk() );
+    }
+
+    // Loading the file uses its mapping, check that it works in the same
+    // way as loading it from a normal stream.
+    wxXmlDocument doc;
+    REQUIRE( doc.Load(filename) );
+    CHECK( doc.GetRoot()->GetName() == "root" );
+
+    const wxXmlNode* const child = doc.GetRoot()->GetChildren();
+    REQUIRE( child );
+    CHECK( child->GetName() == "child" );
+    CHECK( child->GetAttribute("attr") == "value" );
+    CHECK( child->GetNodeContent() == "text" );
+
+    wxMappedFileInputStream in(filename);
+    REQUIRE( in.IsOk() );
+
+    // Parsing must start from the current position.
+    char c = 0;
+    REQUIRE( in.Read(&c, 1).LastRead() == 1 );
+    in.Ungetch(c);
+
+    wxXmlDocument doc2;
+    REQUIRE( doc2.Load(in) );
+    CHECK( doc2.GetRoot()->GetName() == "root" );
+
+    // Check that errors are reported correctly too.
+    {
+        wxFileOutputStream out(filename);
+        REQUIRE( out.Write("<root><child></root>", 20).IsOk() );
+    }
+
+    wxXmlParseError err;
+    CHECK_FALSE( doc.Load(filename, wxXMLDOC_NONE, &err) );
+    CHECK( err.line == 1 );
+}
+
+#ifdef __UNIX__
+
+TEST_CASE("XML::LoadPipe", "[xml]")
+{
+    // Files which can't be mapped, such as pipes, must still be loadable.
+    const wxString filename = wxS("xmltest-load.fifo");
+    TempFile autoRemove(filename);
+
+    REQUIRE( mkfifo(filename.fn_str(), 0600) == 0 );
+
+    std::thread writer([filename]()
+    {
+        wxFileOutputStream out(filename);
+        out.Write("<root><child/></root>", 21);
+    });
+
+    wxXmlDocument doc;
+    const bool loaded = doc.Load(filename);
+    writer.join();
+
+    REQUIRE( loaded );
+    CHECK( doc.GetRoot()->GetName() == "root" );
+    CHECK( doc.GetRoot()->GetChildren()->GetName() == "child" );
+}
+
+#endif // __UNIX__
+
 // This test is disabled by default as it requires the environment variable
 // below to be defined to point to a XML file to load.
 TEST_CASE("XML::Load", "[xml][.]")